@@ -4,6 +4,8 @@
 #include <array>
 #include <iostream>
 #include <numeric>
+#include <optional>
+#include <string>
 
 
 namespace impl {
@@ -23,6 +25,11 @@ namespace {
 #endif
 
 
+std::string FormatCounter(const std::optional<double>& value) {
+	return value ? std::to_string(*value) : std::string("-");
+}
+
+
 void PrintCases() {
 	constexpr std::string_view headerName = "Name";
 	constexpr std::string_view headerLatency = "Latency (" MATHTER_TIME_MEASURE ")";
@@ -31,21 +38,30 @@ void PrintCases() {
 	std::lock_guard lkg{ impl::g_mutex };
 
 	const auto& records = impl::g_records;
+	const bool hasCounters = std::any_of(records.begin(), records.end(), [](const auto& v) { return !v.counters.Empty(); });
 
-	std::vector<std::string_view> names;
-	std::vector<std::string> latencies;
-	std::vector<std::string> throughputs;
-	std::transform(records.begin(), records.end(), std::back_inserter(names), [](const auto& v) { return std::string_view(v.name); });
-	std::transform(records.begin(), records.end(), std::back_inserter(latencies), [](const auto& v) { return std::to_string(v.latency); });
-	std::transform(records.begin(), records.end(), std::back_inserter(throughputs), [](const auto& v) { return std::to_string(v.throughput); });
-
-	auto sizeFun = [](const auto& v) { return std::size(v); };
-	auto maxFun = [](const auto& a, const auto& b) { return std::max(a, b); };
-	std::array colSizes = {
-		std::transform_reduce(names.begin(), names.end(), std::size(headerName), maxFun, sizeFun),
-		std::transform_reduce(latencies.begin(), latencies.end(), std::size(headerLatency), maxFun, sizeFun),
-		std::transform_reduce(throughputs.begin(), throughputs.end(), std::size(headerThroughput), maxFun, sizeFun),
-	};
+	std::vector<std::string> headers = { std::string(headerName), std::string(headerLatency), std::string(headerThroughput) };
+	if (hasCounters) {
+		for (const auto& counterName : PerfRecord::names) {
+			headers.push_back(std::string(counterName) + "/op");
+		}
+	}
+
+	std::vector<std::vector<std::string>> rows;
+	std::transform(records.begin(), records.end(), std::back_inserter(rows), [hasCounters](const auto& v) {
+		std::vector<std::string> row = { v.name, std::to_string(v.latency), std::to_string(v.throughput) };
+		if (hasCounters) {
+			const auto counters = v.counters.Values();
+			std::transform(counters.begin(), counters.end(), std::back_inserter(row), FormatCounter);
+		}
+		return row;
+	});
+
+	std::vector<size_t> colSizes;
+	std::transform(headers.begin(), headers.end(), std::back_inserter(colSizes), [](const auto& v) { return std::size(v); });
+	for (const auto& row : rows) {
+		std::transform(row.begin(), row.end(), colSizes.begin(), colSizes.begin(), [](const auto& v, size_t size) { return std::max(size, std::size(v)); });
+	}
 
 	auto makeLine = [&](char fill, char column) {
 		auto lineLength = std::reduce(colSizes.begin(), colSizes.end()) + 3 * colSizes.size() + 1;
@@ -64,23 +80,24 @@ void PrintCases() {
 		std::cout << makeLine('-', '+') << std::endl;
 	};
 
-	auto printRecord = [&](std::string_view name, std::string_view latency, std::string_view throughput) {
+	// The name is aligned left, the numbers to the right.
+	auto printRecord = [&](const std::vector<std::string>& row) {
 		auto line = makeLine(' ', '|');
-		auto columnBegin = std::find(line.rbegin(), line.rend(), '|');
-		std::copy(throughput.begin(), throughput.end(), columnBegin.base() - throughput.size() - 2);
-		columnBegin = std::find(columnBegin + 1, line.rend(), '|');
-		std::copy(latency.begin(), latency.end(), columnBegin.base() - latency.size() - 2);
-		columnBegin = std::find(columnBegin + 1, line.rend(), '|');
-		columnBegin = std::find(columnBegin + 1, line.rend(), '|');
-		std::copy(name.begin(), name.end(), columnBegin.base() + 1);
+		size_t offset = 0;
+		for (size_t col = 0; col < row.size(); ++col) {
+			const auto& value = row[col];
+			const auto columnBegin = offset + 2;
+			offset += colSizes[col] + 3;
+			std::copy(value.begin(), value.end(), line.begin() + (col == 0 ? columnBegin : offset - 1 - value.size()));
+		}
 		std::cout << line << std::endl;
 	};
 
 	printSeparator();
-	printRecord(headerName, headerLatency, headerThroughput);
+	printRecord(headers);
 	printSeparator();
-	for (size_t i = 0; i < records.size(); ++i) {
-		printRecord(names[i], latencies[i], throughputs[i]);
+	for (const auto& row : rows) {
+		printRecord(row);
 	}
 	printSeparator();
 }
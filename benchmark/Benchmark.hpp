@@ -1,5 +1,7 @@
 #pragma once
 
+#include "PerfCounters.hpp"
+
 #include <Mathter/Common/OptimizationUtil.hpp>
 
 #include <algorithm>
@@ -27,6 +29,7 @@ struct BenchmarkRecord {
 	std::string name;
 	double latency;
 	double throughput;
+	PerfRecord counters;
 };
 
 
@@ -84,7 +87,10 @@ double LatencySample(int64_t repeat, Fixture&& fixture, FirstArg&& arg, Args&&..
 
 
 template <class Fixture, class FirstArg, class... Args>
-double ThroughputSample(int64_t repeat, Fixture&& fixture, FirstArg&& arg, Args&&... args) {
+double ThroughputSample(int64_t repeat, PerfCounters* counters, Fixture&& fixture, FirstArg&& arg, Args&&... args) {
+	if (counters) {
+		counters->Start();
+	}
 	const auto startTime = ReadTSC();
 
 	auto [lanes, count] = fixture.Throughput(std::forward<FirstArg>(arg), args...);
@@ -97,6 +103,9 @@ double ThroughputSample(int64_t repeat, Fixture&& fixture, FirstArg&& arg, Args&
 	DoNotOptimizeAway(lanes);
 
 	const auto endTime = ReadTSC();
+	if (counters) {
+		counters->Stop(double(count));
+	}
 	return (endTime - startTime) / double(count);
 }
 
@@ -109,7 +118,7 @@ double Latency(int64_t samples, int64_t repeat, Fixture&& fixture, FirstArg&& ar
 
 template <class Fixture, class FirstArg, class... Args>
 double Throughput(int64_t samples, int64_t repeat, Fixture&& fixture, FirstArg&& arg, Args&&... args) {
-	return BestSample([&]() { return ThroughputSample(repeat, fixture, arg, args...); }, samples);
+	return BestSample([&]() { return ThroughputSample(repeat, nullptr, fixture, arg, args...); }, samples);
 }
 
 
@@ -117,8 +126,14 @@ template <class Fixture, class ArgLatency, class ArgThroughput, class... Args>
 MATHTER_NOINLINE void BenchmarkCase(std::string_view name, int64_t samples, int64_t repeat, Fixture&& fixture, ArgLatency&& argLatency, ArgThroughput&& argThroutput, Args&&... args) {
 	const auto latency = Latency(samples, repeat, fixture, argLatency, args...);
 	const auto throughput = Throughput(samples, repeat, fixture, argThroutput, args...);
+	PerfRecord counters;
+	if (const auto perfCounters = ThreadPerfCounters()) {
+		// Counted separately so that reading the counters does not distort the timings.
+		ThroughputSample(repeat, perfCounters, fixture, argThroutput, args...);
+		counters = perfCounters->Record();
+	}
 	std::lock_guard lk{ g_mutex };
-	g_records.push_back(BenchmarkRecord{ std::string(name), latency, throughput });
+	g_records.push_back(BenchmarkRecord{ std::string(name), latency, throughput, counters });
 }
 
 
@@ -0,0 +1,155 @@
+#include "Benchmark.hpp"
+
+#include <Mathter/CharConv.hpp>
+#include <Mathter/IoStream.hpp>
+#include <Mathter/Matrix.hpp>
+#include <Mathter/Vector.hpp>
+
+#include <random>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+
+using namespace mathter;
+
+namespace {
+
+
+template <class Value>
+std::vector<Value> MakeRandomValues(size_t count, uint64_t seed) {
+	using Scalar = scalar_type_t<Value>;
+
+	std::mt19937_64 rne(seed);
+	std::uniform_real_distribution<Scalar> rng(-1000, 1000);
+
+	std::vector<Value> values(count);
+	for (auto& value : values) {
+		if constexpr (is_vector_v<Value>) {
+			for (int i = 0; i < dimension_v<Value>; ++i) {
+				value[i] = rng(rne);
+			}
+		}
+		else {
+			for (int i = 0; i < row_count_v<Value>; ++i) {
+				for (int j = 0; j < column_count_v<Value>; ++j) {
+					value(i, j) = rng(rne);
+				}
+			}
+		}
+	}
+	return values;
+}
+
+
+/// <summary> A scene file like text: one value per line. </summary>
+template <class Value>
+std::string MakeText(const std::vector<Value>& values) {
+	std::stringstream ss;
+	ss.precision(9);
+	for (const auto& value : values) {
+		ss << value << '\n';
+	}
+	return ss.str();
+}
+
+
+/// <summary> Parses all values of the text, and counts each value as one operation. </summary>
+template <class Value>
+struct FromCharsFixture {
+	MATHTER_FORCEINLINE auto Latency(const Value& previous, const std::string& text) const {
+		Value value = previous;
+		size_t count = 0;
+		const char* first = text.data();
+		const char* const last = text.data() + text.size();
+		for (auto result = FromChars(first, last, value); result.ec == std::errc{}; result = FromChars(result.ptr, last, value)) {
+			++count;
+		}
+		return std::tuple(value, count);
+	}
+
+	MATHTER_FORCEINLINE auto Throughput(const Value& previous, const std::string& text) const {
+		return Latency(previous, text);
+	}
+};
+
+
+template <class Value>
+struct IoStreamParseFixture {
+	MATHTER_FORCEINLINE auto Latency(const Value& previous, const std::string& text) const {
+		Value value = previous;
+		size_t count = 0;
+		std::istringstream is(text);
+		while (is >> std::ws && is.peek() != std::istringstream::traits_type::eof()) {
+			is >> value;
+			++count;
+		}
+		return std::tuple(value, count);
+	}
+
+	MATHTER_FORCEINLINE auto Throughput(const Value& previous, const std::string& text) const {
+		return Latency(previous, text);
+	}
+};
+
+
+/// <summary> Formats all values into a stack buffer, and counts each value as one operation. </summary>
+template <class Value>
+struct ToCharsFixture {
+	MATHTER_FORCEINLINE auto Latency(size_t previous, const std::vector<Value>& values) const {
+		char buffer[1024];
+		size_t length = previous;
+		for (const auto& value : values) {
+			const auto result = ToChars(buffer, buffer + sizeof(buffer), value);
+			length += result.ptr - buffer;
+		}
+		return std::tuple(length, values.size());
+	}
+
+	MATHTER_FORCEINLINE auto Throughput(size_t previous, const std::vector<Value>& values) const {
+		return Latency(previous, values);
+	}
+};
+
+
+template <class Value>
+struct IoStreamFormatFixture {
+	MATHTER_FORCEINLINE auto Latency(size_t previous, const std::vector<Value>& values) const {
+		std::ostringstream os;
+		for (const auto& value : values) {
+			os << value;
+		}
+		return std::tuple(previous + os.str().size(), values.size());
+	}
+
+	MATHTER_FORCEINLINE auto Throughput(size_t previous, const std::vector<Value>& values) const {
+		return Latency(previous, values);
+	}
+};
+
+
+#define CHARCONV_BENCHMARK_CASE(TYPE, TEXT)                             \
+	BENCHMARK_CASE(TEXT ": FromChars", "[CharConv]", 20, 4,             \
+				   FromCharsFixture<TYPE>{}, TYPE{}, TYPE{},            \
+				   MakeText(MakeRandomValues<TYPE>(1024, 1)));          \
+	BENCHMARK_CASE(TEXT ": operator>>", "[CharConv]", 20, 4,            \
+				   IoStreamParseFixture<TYPE>{}, TYPE{}, TYPE{},        \
+				   MakeText(MakeRandomValues<TYPE>(1024, 1)));          \
+	BENCHMARK_CASE(TEXT ": ToChars", "[CharConv]", 20, 4,               \
+				   ToCharsFixture<TYPE>{}, size_t(0), size_t(0),        \
+				   MakeRandomValues<TYPE>(1024, 1));                    \
+	BENCHMARK_CASE(TEXT ": operator<<", "[CharConv]", 20, 4,            \
+				   IoStreamFormatFixture<TYPE>{}, size_t(0), size_t(0), \
+				   MakeRandomValues<TYPE>(1024, 1));
+
+
+using Vec3f = Vector<float, 3>;
+using Mat44f = Matrix<float, 4, 4>;
+using Vec3d = Vector<double, 3>;
+
+CHARCONV_BENCHMARK_CASE(Vec3f, "Vector<float, 3>");
+CHARCONV_BENCHMARK_CASE(Vec3d, "Vector<double, 3>");
+CHARCONV_BENCHMARK_CASE(Mat44f, "Matrix<float, 4, 4>");
+
+} // namespace
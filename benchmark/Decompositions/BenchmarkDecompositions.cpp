@@ -5,6 +5,7 @@
 #include <Mathter/Decompositions/DecomposeLU.hpp>
 #include <Mathter/Decompositions/DecomposeQR.hpp>
 #include <Mathter/Decompositions/DecomposeSVD.hpp>
+#include <Mathter/Decompositions/IterativeRefinement.hpp>
 #include <Mathter/Matrix.hpp>
 
 
@@ -73,6 +74,66 @@ struct SVD2Op {
 };
 
 
+struct QRSolveOp {
+	template <class T, int Rows, int Columns, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+	auto operator()(const Matrix<T, Rows, Columns, Order, Layout, Packed>& salt, const Matrix<T, Rows, Columns, Order, Layout, Packed>& input) const {
+		const auto salted = remove_complex_t<T>(0.00001) * salt + input;
+		const auto x = DecomposeQR(salted).Solve(input.Column(0));
+		auto copy = salted;
+		copy(0, 0) = x[0];
+		return copy;
+	}
+};
+
+
+struct QRCompactSolveOp {
+	template <class T, int Rows, int Columns, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+	auto operator()(const Matrix<T, Rows, Columns, Order, Layout, Packed>& salt, const Matrix<T, Rows, Columns, Order, Layout, Packed>& input) const {
+		const auto salted = remove_complex_t<T>(0.00001) * salt + input;
+		const auto x = DecomposeQRCompact(salted).Solve(input.Column(0));
+		auto copy = salted;
+		copy(0, 0) = x[0];
+		return copy;
+	}
+};
+
+
+struct LUPSolveOp {
+	template <class T, int Rows, int Columns, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+	auto operator()(const Matrix<T, Rows, Columns, Order, Layout, Packed>& salt, const Matrix<T, Rows, Columns, Order, Layout, Packed>& input) const {
+		const auto salted = remove_complex_t<T>(0.00001) * salt + input;
+		const auto x = DecomposeLUP(salted).Solve(input.Column(0));
+		auto copy = salted;
+		copy(0, 0) = x[0];
+		return copy;
+	}
+};
+
+
+struct LUPCompactSolveOp {
+	template <class T, int Rows, int Columns, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+	auto operator()(const Matrix<T, Rows, Columns, Order, Layout, Packed>& salt, const Matrix<T, Rows, Columns, Order, Layout, Packed>& input) const {
+		const auto salted = remove_complex_t<T>(0.00001) * salt + input;
+		const auto x = DecomposeLUPCompact(salted).Solve(input.Column(0));
+		auto copy = salted;
+		copy(0, 0) = x[0];
+		return copy;
+	}
+};
+
+
+struct RefinedSolveOp {
+	template <class T, int Rows, int Columns, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+	auto operator()(const Matrix<T, Rows, Columns, Order, Layout, Packed>& salt, const Matrix<T, Rows, Columns, Order, Layout, Packed>& input) const {
+		const auto salted = remove_complex_t<T>(0.00001) * salt + input;
+		const auto x = SolveRefined(salted, input.Column(0)).x;
+		auto copy = salted;
+		copy(0, 0) = x[0];
+		return copy;
+	}
+};
+
+
 static constexpr auto benchmarkCaseLayout_r = eMatrixLayout::ROW_MAJOR;
 static constexpr auto benchmarkCaseLayout_c = eMatrixLayout::COLUMN_MAJOR;
 
@@ -87,6 +148,17 @@ static constexpr auto benchmarkCaseLayout_c = eMatrixLayout::COLUMN_MAJOR;
 				   MakeRandomInput<Matrix<TYPE, ROWS, COLS, eMatrixOrder::FOLLOW_VECTOR, benchmarkCaseLayout_##LAYOUT, PACKED>, 4>(),    \
 				   MakeRandomInput<Matrix<TYPE, ROWS, COLS, eMatrixOrder::FOLLOW_VECTOR, benchmarkCaseLayout_##LAYOUT, PACKED>, 64>());
 
+// Least squares problems precede the vector, and have fewer inputs to keep the large matrices off the limits of the stack.
+#define DECOMP_SOLVE_BENCHMARK_CASE(TYPE, ROWS, COLS, LAYOUT, PACKED, OP, OPTEXT)                                                         \
+	BENCHMARK_CASE(#TYPE "." #ROWS "x" #COLS #LAYOUT " " OPTEXT " (P=" #PACKED ")",                                                       \
+				   "[Matrix][Math]",                                                                                                      \
+				   20,                                                                                                                    \
+				   4,                                                                                                                     \
+				   GenericNAryFixture{ OP },                                                                                              \
+				   MakeRandomInput<Matrix<TYPE, ROWS, COLS, eMatrixOrder::PRECEDE_VECTOR, benchmarkCaseLayout_##LAYOUT, PACKED>, 1>()[0], \
+				   MakeRandomInput<Matrix<TYPE, ROWS, COLS, eMatrixOrder::PRECEDE_VECTOR, benchmarkCaseLayout_##LAYOUT, PACKED>, 2>(),    \
+				   MakeRandomInput<Matrix<TYPE, ROWS, COLS, eMatrixOrder::PRECEDE_VECTOR, benchmarkCaseLayout_##LAYOUT, PACKED>, 8>());
+
 DECOMP_BENCHMARK_CASE(float, 2, 2, r, false, LUOp{}, "LU decomp");
 DECOMP_BENCHMARK_CASE(float, 3, 3, r, false, LUOp{}, "LU decomp");
 DECOMP_BENCHMARK_CASE(float, 4, 4, r, false, LUOp{}, "LU decomp");
@@ -185,6 +257,36 @@ DECOMP_BENCHMARK_CASE(double, 2, 2, c, false, SVD2Op{}, "SVD (2-sided)");
 DECOMP_BENCHMARK_CASE(double, 3, 3, c, false, SVD2Op{}, "SVD (2-sided)");
 DECOMP_BENCHMARK_CASE(double, 4, 4, c, false, SVD2Op{}, "SVD (2-sided)");
 
-
-
-} // namespace
\ No newline at end of file
+DECOMP_SOLVE_BENCHMARK_CASE(float, 16, 8, r, false, QRSolveOp{}, "QR solve");
+DECOMP_SOLVE_BENCHMARK_CASE(float, 32, 16, r, false, QRSolveOp{}, "QR solve");
+DECOMP_SOLVE_BENCHMARK_CASE(float, 64, 32, r, false, QRSolveOp{}, "QR solve");
+DECOMP_SOLVE_BENCHMARK_CASE(float, 16, 8, r, false, QRCompactSolveOp{}, "QR compact solve");
+DECOMP_SOLVE_BENCHMARK_CASE(float, 32, 16, r, false, QRCompactSolveOp{}, "QR compact solve");
+DECOMP_SOLVE_BENCHMARK_CASE(float, 64, 32, r, false, QRCompactSolveOp{}, "QR compact solve");
+
+DECOMP_SOLVE_BENCHMARK_CASE(double, 16, 8, c, false, QRSolveOp{}, "QR solve");
+DECOMP_SOLVE_BENCHMARK_CASE(double, 32, 16, c, false, QRSolveOp{}, "QR solve");
+DECOMP_SOLVE_BENCHMARK_CASE(double, 64, 32, c, false, QRSolveOp{}, "QR solve");
+DECOMP_SOLVE_BENCHMARK_CASE(double, 16, 8, c, false, QRCompactSolveOp{}, "QR compact solve");
+DECOMP_SOLVE_BENCHMARK_CASE(double, 32, 16, c, false, QRCompactSolveOp{}, "QR compact solve");
+DECOMP_SOLVE_BENCHMARK_CASE(double, 64, 32, c, false, QRCompactSolveOp{}, "QR compact solve");
+
+} // namespace
+
+DECOMP_SOLVE_BENCHMARK_CASE(float, 6, 6, r, false, LUPSolveOp{}, "LUP solve");
+DECOMP_SOLVE_BENCHMARK_CASE(float, 16, 16, r, false, LUPSolveOp{}, "LUP solve");
+DECOMP_SOLVE_BENCHMARK_CASE(float, 32, 32, r, false, LUPSolveOp{}, "LUP solve");
+DECOMP_SOLVE_BENCHMARK_CASE(float, 6, 6, r, false, LUPCompactSolveOp{}, "LUP compact solve");
+DECOMP_SOLVE_BENCHMARK_CASE(float, 16, 16, r, false, LUPCompactSolveOp{}, "LUP compact solve");
+DECOMP_SOLVE_BENCHMARK_CASE(float, 32, 32, r, false, LUPCompactSolveOp{}, "LUP compact solve");
+
+DECOMP_SOLVE_BENCHMARK_CASE(double, 6, 6, c, false, LUPSolveOp{}, "LUP solve");
+DECOMP_SOLVE_BENCHMARK_CASE(double, 16, 16, c, false, LUPSolveOp{}, "LUP solve");
+DECOMP_SOLVE_BENCHMARK_CASE(double, 32, 32, c, false, LUPSolveOp{}, "LUP solve");
+DECOMP_SOLVE_BENCHMARK_CASE(double, 6, 6, c, false, LUPCompactSolveOp{}, "LUP compact solve");
+DECOMP_SOLVE_BENCHMARK_CASE(double, 16, 16, c, false, LUPCompactSolveOp{}, "LUP compact solve");
+DECOMP_SOLVE_BENCHMARK_CASE(double, 32, 32, c, false, LUPCompactSolveOp{}, "LUP compact solve");
+
+DECOMP_SOLVE_BENCHMARK_CASE(double, 6, 6, c, false, RefinedSolveOp{}, "refined solve");
+DECOMP_SOLVE_BENCHMARK_CASE(double, 16, 16, c, false, RefinedSolveOp{}, "refined solve");
+DECOMP_SOLVE_BENCHMARK_CASE(double, 32, 32, c, false, RefinedSolveOp{}, "refined solve");
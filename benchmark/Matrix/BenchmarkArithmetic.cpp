@@ -53,6 +53,27 @@ struct OuterProductOp {
 				   MakeRandomInput<Matrix<TYPE, MATCH, COLS, eMatrixOrder::FOLLOW_VECTOR, benchmarkCaseLayout_##LAYOUT_R, PACKED>, 64>());
 
 
+/// <summary> The row or column combination product that small matrices use, to compare the blocked product against. </summary>
+struct MultiplyStripesOp {
+	template <class MatLhs, class MatRhs>
+	auto operator()(const MatLhs& lhs, const MatRhs& rhs) const {
+		return mathter::impl::MultiplyStripes(lhs, rhs);
+	}
+};
+
+
+// Fewer inputs than for small matrices to keep the arrays of 64x64 matrices off the limits of the stack.
+#define MATRIX_LARGE_MUL_BENCHMARK_CASE(TYPE, DIM, LAYOUT, OP, OPTEXT)                                                                \
+	BENCHMARK_CASE(#TYPE "." #DIM "x" #DIM #LAYOUT " " OPTEXT " " #TYPE "." #DIM "x" #DIM #LAYOUT,                                    \
+				   "[Matrix][Arithmetic]",                                                                                            \
+				   20,                                                                                                                \
+				   4,                                                                                                                 \
+				   GenericNAryFixture{ OP{} },                                                                                        \
+				   MakeRandomInput<Matrix<TYPE, DIM, DIM, eMatrixOrder::FOLLOW_VECTOR, benchmarkCaseLayout_##LAYOUT, false>, 1>()[0], \
+				   MakeRandomInput<Matrix<TYPE, DIM, DIM, eMatrixOrder::FOLLOW_VECTOR, benchmarkCaseLayout_##LAYOUT, false>, 2>(),    \
+				   MakeRandomInput<Matrix<TYPE, DIM, DIM, eMatrixOrder::FOLLOW_VECTOR, benchmarkCaseLayout_##LAYOUT, false>, 8>());
+
+
 #define MATRIX_BINOP_VEC_CASE(TYPE, ROWS, COLS, ORDER, LAYOUT, PACKED, DIM, OP, OPTEXT)                   \
 	BENCHMARK_CASE(#TYPE "." #ROWS #COLS #ORDER #LAYOUT " " OPTEXT " " #TYPE "." #DIM " (P=" #PACKED ")", \
 				   "[Matrix][Arithmetic]",                                                                \
@@ -149,6 +170,32 @@ MATRIX_BINOP_BENCHMARK_CASE(double, 3, 3, 3, c, c, true, std::divides<>, "/");
 MATRIX_BINOP_BENCHMARK_CASE(double, 4, 4, 4, c, c, true, std::divides<>, "/");
 
 
+MATRIX_LARGE_MUL_BENCHMARK_CASE(float, 8, r, std::multiplies<>, "*");
+MATRIX_LARGE_MUL_BENCHMARK_CASE(float, 12, r, std::multiplies<>, "*");
+MATRIX_LARGE_MUL_BENCHMARK_CASE(float, 16, r, std::multiplies<>, "*");
+MATRIX_LARGE_MUL_BENCHMARK_CASE(float, 32, r, std::multiplies<>, "*");
+MATRIX_LARGE_MUL_BENCHMARK_CASE(float, 64, r, std::multiplies<>, "*");
+MATRIX_LARGE_MUL_BENCHMARK_CASE(float, 8, r, MultiplyStripesOp, "* (stripes)");
+MATRIX_LARGE_MUL_BENCHMARK_CASE(float, 12, r, MultiplyStripesOp, "* (stripes)");
+MATRIX_LARGE_MUL_BENCHMARK_CASE(float, 16, r, MultiplyStripesOp, "* (stripes)");
+MATRIX_LARGE_MUL_BENCHMARK_CASE(float, 32, r, MultiplyStripesOp, "* (stripes)");
+MATRIX_LARGE_MUL_BENCHMARK_CASE(float, 64, r, MultiplyStripesOp, "* (stripes)");
+
+MATRIX_LARGE_MUL_BENCHMARK_CASE(float, 12, c, std::multiplies<>, "*");
+MATRIX_LARGE_MUL_BENCHMARK_CASE(float, 12, c, MultiplyStripesOp, "* (stripes)");
+
+MATRIX_LARGE_MUL_BENCHMARK_CASE(double, 8, r, std::multiplies<>, "*");
+MATRIX_LARGE_MUL_BENCHMARK_CASE(double, 12, r, std::multiplies<>, "*");
+MATRIX_LARGE_MUL_BENCHMARK_CASE(double, 16, r, std::multiplies<>, "*");
+MATRIX_LARGE_MUL_BENCHMARK_CASE(double, 32, r, std::multiplies<>, "*");
+MATRIX_LARGE_MUL_BENCHMARK_CASE(double, 64, r, std::multiplies<>, "*");
+MATRIX_LARGE_MUL_BENCHMARK_CASE(double, 8, r, MultiplyStripesOp, "* (stripes)");
+MATRIX_LARGE_MUL_BENCHMARK_CASE(double, 12, r, MultiplyStripesOp, "* (stripes)");
+MATRIX_LARGE_MUL_BENCHMARK_CASE(double, 16, r, MultiplyStripesOp, "* (stripes)");
+MATRIX_LARGE_MUL_BENCHMARK_CASE(double, 32, r, MultiplyStripesOp, "* (stripes)");
+MATRIX_LARGE_MUL_BENCHMARK_CASE(double, 64, r, MultiplyStripesOp, "* (stripes)");
+
+
 MATRIX_BINOP_VEC_CASE(float, 2, 2, f, r, false, 2, MulVecOp, "*");
 MATRIX_BINOP_VEC_CASE(float, 3, 3, f, r, false, 3, MulVecOp, "*");
 MATRIX_BINOP_VEC_CASE(float, 4, 4, f, r, false, 4, MulVecOp, "*");
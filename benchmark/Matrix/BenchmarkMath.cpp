@@ -53,6 +53,18 @@ struct TransposeOp {
 };
 
 
+struct FlipLayoutOp {
+	template <class T, int Rows, int Columns, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+	auto operator()(const Matrix<T, Rows, Columns, Order, Layout, Packed>& mat) const {
+		// Reinterpret the stripes in the original layout so that the result can be fed back.
+		const auto flipped = FlipLayout(mat);
+		Matrix<T, Rows, Columns, Order, Layout, Packed> copy;
+		copy.stripes = flipped.stripes;
+		return copy;
+	}
+};
+
+
 struct DeterminantOp {
 	template <class T, int Rows, int Columns, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
 	auto operator()(const Matrix<T, Rows, Columns, Order, Layout, Packed>& mat) const {
@@ -128,6 +140,11 @@ MATRIX_UNARY_MATH_BENCHMARK_CASE(float, 4, 4, r, false, TraceOp{}, "Trace");
 MATRIX_UNARY_MATH_BENCHMARK_CASE(float, 2, 2, r, false, TransposeOp{}, "Tranpose");
 MATRIX_UNARY_MATH_BENCHMARK_CASE(float, 3, 3, r, false, TransposeOp{}, "Tranpose");
 MATRIX_UNARY_MATH_BENCHMARK_CASE(float, 4, 4, r, false, TransposeOp{}, "Tranpose");
+MATRIX_UNARY_MATH_BENCHMARK_CASE(float, 8, 8, r, false, TransposeOp{}, "Tranpose");
+
+MATRIX_UNARY_MATH_BENCHMARK_CASE(float, 3, 3, r, false, FlipLayoutOp{}, "FlipLayout");
+MATRIX_UNARY_MATH_BENCHMARK_CASE(float, 4, 4, r, false, FlipLayoutOp{}, "FlipLayout");
+MATRIX_UNARY_MATH_BENCHMARK_CASE(float, 8, 8, r, false, FlipLayoutOp{}, "FlipLayout");
 
 MATRIX_UNARY_MATH_BENCHMARK_CASE(float, 2, 2, r, false, DeterminantOp{}, "Determinant");
 MATRIX_UNARY_MATH_BENCHMARK_CASE(float, 3, 3, r, false, DeterminantOp{}, "Determinant");
@@ -172,6 +189,8 @@ MATRIX_UNARY_MATH_BENCHMARK_CASE(double, 2, 2, r, false, TransposeOp{}, "Tranpos
 MATRIX_UNARY_MATH_BENCHMARK_CASE(double, 3, 3, r, false, TransposeOp{}, "Tranpose");
 MATRIX_UNARY_MATH_BENCHMARK_CASE(double, 4, 4, r, false, TransposeOp{}, "Tranpose");
 
+MATRIX_UNARY_MATH_BENCHMARK_CASE(double, 4, 4, r, false, FlipLayoutOp{}, "FlipLayout");
+
 MATRIX_UNARY_MATH_BENCHMARK_CASE(double, 2, 2, r, false, DeterminantOp{}, "Determinant");
 MATRIX_UNARY_MATH_BENCHMARK_CASE(double, 3, 3, r, false, DeterminantOp{}, "Determinant");
 MATRIX_UNARY_MATH_BENCHMARK_CASE(double, 4, 4, r, false, DeterminantOp{}, "Determinant");
@@ -0,0 +1,154 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#include "PerfCounters.hpp"
+
+#include <atomic>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstring>
+#define MATHTER_PERF_EVENT_OPEN
+#endif
+
+
+namespace {
+
+std::atomic_bool g_perfCountersEnabled = false;
+
+
+#ifdef MATHTER_PERF_EVENT_OPEN
+
+struct EventConfig {
+	uint32_t type;
+	uint64_t config;
+};
+
+
+constexpr std::array<EventConfig, PerfRecord::size> eventConfigs = {
+	EventConfig{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+	EventConfig{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+	EventConfig{ PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+	EventConfig{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+	EventConfig{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+};
+
+
+int OpenEvent(const EventConfig& event) {
+	perf_event_attr attr;
+	std::memset(&attr, 0, sizeof(attr));
+	attr.size = sizeof(attr);
+	attr.type = event.type;
+	attr.config = event.config;
+	attr.disabled = 1;
+	// Counting user space only works with perf_event_paranoid up to 2, the default on most distributions.
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	// The events are not grouped, so they may be multiplexed. The timings let us scale the counts.
+	attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+	return int(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+
+std::optional<double> ReadEvent(int fd) {
+	uint64_t values[3] = {};
+	if (read(fd, values, sizeof(values)) != ssize_t(sizeof(values)) || values[2] == 0) {
+		return std::nullopt;
+	}
+	const auto [count, enabled, running] = values;
+	return double(count) * double(enabled) / double(running);
+}
+
+#endif
+
+} // namespace
+
+
+PerfCounters::PerfCounters() {
+	m_fds.fill(-1);
+#ifdef MATHTER_PERF_EVENT_OPEN
+	for (size_t i = 0; i < m_fds.size(); ++i) {
+		m_fds[i] = OpenEvent(eventConfigs[i]);
+	}
+#endif
+}
+
+
+PerfCounters::~PerfCounters() {
+#ifdef MATHTER_PERF_EVENT_OPEN
+	for (const auto fd : m_fds) {
+		if (fd >= 0) {
+			close(fd);
+		}
+	}
+#endif
+}
+
+
+bool PerfCounters::Available() const {
+	for (const auto fd : m_fds) {
+		if (fd >= 0) {
+			return true;
+		}
+	}
+	return false;
+}
+
+
+void PerfCounters::Start() {
+#ifdef MATHTER_PERF_EVENT_OPEN
+	for (const auto fd : m_fds) {
+		if (fd >= 0) {
+			ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+			ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+		}
+	}
+#endif
+}
+
+
+void PerfCounters::Stop(double operationCount) {
+	std::array<std::optional<double>, PerfRecord::size> counts;
+#ifdef MATHTER_PERF_EVENT_OPEN
+	for (const auto fd : m_fds) {
+		if (fd >= 0) {
+			ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+		}
+	}
+	for (size_t i = 0; i < m_fds.size(); ++i) {
+		if (m_fds[i] >= 0) {
+			if (const auto count = ReadEvent(m_fds[i])) {
+				counts[i] = *count / operationCount;
+			}
+		}
+	}
+#endif
+	const auto& [cycles, instructions, l1dMisses, llcMisses, branchMisses] = counts;
+	m_record = PerfRecord{ cycles, instructions, l1dMisses, llcMisses, branchMisses };
+}
+
+
+const PerfRecord& PerfCounters::Record() const {
+	return m_record;
+}
+
+
+void SetPerfCountersEnabled(bool enabled) {
+	g_perfCountersEnabled = enabled;
+}
+
+
+PerfCounters* ThreadPerfCounters() {
+	if (!g_perfCountersEnabled) {
+		return nullptr;
+	}
+	// The events are opened for the calling thread, so each benchmarking thread needs its own.
+	thread_local PerfCounters counters;
+	return counters.Available() ? &counters : nullptr;
+}
@@ -0,0 +1,81 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+
+/// <summary> Hardware event counts per operation of a benchmark case. </summary>
+/// <remarks> Events that the CPU, the OS, or the permissions don't allow to count are left empty. </remarks>
+struct PerfRecord {
+	std::optional<double> cycles;
+	std::optional<double> instructions;
+	std::optional<double> l1dMisses;
+	std::optional<double> llcMisses;
+	std::optional<double> branchMisses;
+
+	/// <summary> The number of events. </summary>
+	static constexpr size_t size = 5;
+
+	/// <summary> The short names of the events, in the order of the members. </summary>
+	static constexpr std::array<std::string_view, size> names = { "cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses" };
+
+	/// <summary> Returns the event counts in the order of the members. </summary>
+	std::array<std::optional<double>, size> Values() const {
+		return { cycles, instructions, l1dMisses, llcMisses, branchMisses };
+	}
+
+	/// <summary> True if none of the events was counted. </summary>
+	bool Empty() const {
+		const auto values = Values();
+		for (const auto& value : values) {
+			if (value) {
+				return false;
+			}
+		}
+		return true;
+	}
+};
+
+
+/// <summary> Counts hardware events of the calling thread using Linux perf_event_open. </summary>
+/// <remarks> On other systems, or when the kernel refuses to open the counters
+///		(e.g. because of perf_event_paranoid or in virtual machines), the counters
+///		are unavailable and <see cref="Record"/> returns an empty record. </remarks>
+class PerfCounters {
+public:
+	PerfCounters();
+	~PerfCounters();
+	PerfCounters(const PerfCounters&) = delete;
+	PerfCounters& operator=(const PerfCounters&) = delete;
+
+	/// <summary> True if at least one of the events can be counted. </summary>
+	bool Available() const;
+
+	/// <summary> Resets and starts the counters. </summary>
+	void Start();
+
+	/// <summary> Stops the counters, and divides the counts by the number of measured operations. </summary>
+	void Stop(double operationCount);
+
+	/// <summary> Returns the counts per operation of the last Start-Stop interval. </summary>
+	const PerfRecord& Record() const;
+
+private:
+	std::array<int, PerfRecord::size> m_fds;
+	PerfRecord m_record;
+};
+
+
+/// <summary> Enables or disables collecting counters for the benchmark cases. Disabled by default. </summary>
+void SetPerfCountersEnabled(bool enabled);
+
+/// <summary> Returns the counters of the calling thread. </summary>
+/// <returns> Null if collecting is disabled or no event can be counted on this system. </returns>
+PerfCounters* ThreadPerfCounters();
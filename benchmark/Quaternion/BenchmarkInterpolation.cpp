@@ -0,0 +1,167 @@
+#include "../Benchmark.hpp"
+#include "../Fixtures.hpp"
+
+#include <Mathter/Quaternion.hpp>
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+
+using namespace mathter;
+
+namespace {
+
+
+template <class Quat, size_t Count>
+std::array<Quat, Count> MakeRandomRotations(uint64_t seed) {
+	using Scalar = scalar_type_t<Quat>;
+
+	std::mt19937_64 rne(seed);
+	std::normal_distribution<Scalar> rng;
+
+	std::array<Quat, Count> r;
+	for (auto& q : r) {
+		q = Normalize(Quat(rng(rne), rng(rne), rng(rne), rng(rne)));
+	}
+	return r;
+}
+
+
+template <class T>
+struct NlerpOp {
+	template <class Quat>
+	auto operator()(const Quat& from, const Quat& to) const {
+		return Nlerp(from, to, T(0.3));
+	}
+};
+
+
+template <class T>
+struct SlerpOp {
+	template <class Quat>
+	auto operator()(const Quat& from, const Quat& to) const {
+		return Slerp(from, to, T(0.3));
+	}
+};
+
+
+template <class T>
+struct NlerpArrayOp {
+	template <class Quat, size_t Count>
+	void operator()(const std::array<Quat, Count>& from, const std::array<Quat, Count>& to, std::array<Quat, Count>& out) const {
+		Nlerp(from, to, T(0.3), out);
+	}
+};
+
+
+template <class T>
+struct SlerpArrayOp {
+	template <class Quat, size_t Count>
+	void operator()(const std::array<Quat, Count>& from, const std::array<Quat, Count>& to, std::array<Quat, Count>& out) const {
+		Slerp(from, to, T(0.3), out);
+	}
+};
+
+
+template <class T>
+struct AverageArrayOp {
+	template <class Quat, size_t Count>
+	void operator()(const std::array<Quat, Count>& from, const std::array<Quat, Count>& to, std::array<Quat, Count>& out) const {
+		const Quat* const arrays[] = { from.data(), to.data(), from.data(), to.data() };
+		const T weights[] = { T(0.4), T(0.3), T(0.2), T(0.1) };
+		Average(arrays, weights, 4, Count, out.data());
+	}
+};
+
+
+/// <summary> Runs the array operation on all elements at once, and counts each element as one operation. </summary>
+template <class Op>
+struct ArrayFixture {
+	template <class Quat, size_t Count>
+	MATHTER_FORCEINLINE auto Latency(const std::array<Quat, Count>& from, const std::array<Quat, Count>& to) const {
+		std::array<Quat, Count> out;
+		op(from, to, out);
+		return std::tuple(out, Count);
+	}
+
+	template <class Quat, size_t Count>
+	MATHTER_FORCEINLINE auto Throughput(const std::array<Quat, Count>& from, const std::array<Quat, Count>& to) const {
+		return Latency(from, to);
+	}
+
+	Op op;
+};
+
+template <class Op>
+ArrayFixture(const Op&) -> ArrayFixture<Op>;
+
+
+#define QUATERNION_INTERPOLATION_BENCHMARK_CASE(TYPE, OP, OPTEXT)        \
+	BENCHMARK_CASE(#TYPE ": " OPTEXT,                                    \
+				   "[Quaternion][Interpolation]",                        \
+				   50,                                                   \
+				   64,                                                   \
+				   GenericNAryFixture{ OP },                             \
+				   MakeRandomRotations<Quaternion<TYPE>, 1>(1)[0],       \
+				   MakeRandomRotations<Quaternion<TYPE>, 4>(2),          \
+				   MakeRandomRotations<Quaternion<TYPE>, 64>(3));
+
+
+#define QUATERNION_INTERPOLATION_ARRAY_BENCHMARK_CASE(TYPE, OP, OPTEXT)  \
+	BENCHMARK_CASE(#TYPE ": " OPTEXT " (array)",                         \
+				   "[Quaternion][Interpolation]",                        \
+				   50,                                                   \
+				   16,                                                   \
+				   ArrayFixture{ OP },                                   \
+				   MakeRandomRotations<Quaternion<TYPE>, 1024>(1),       \
+				   MakeRandomRotations<Quaternion<TYPE>, 1024>(1),       \
+				   MakeRandomRotations<Quaternion<TYPE>, 1024>(2));
+
+
+QUATERNION_INTERPOLATION_BENCHMARK_CASE(float, NlerpOp<float>{}, "Nlerp");
+QUATERNION_INTERPOLATION_BENCHMARK_CASE(float, SlerpOp<float>{}, "Slerp");
+QUATERNION_INTERPOLATION_ARRAY_BENCHMARK_CASE(float, NlerpArrayOp<float>{}, "Nlerp");
+QUATERNION_INTERPOLATION_ARRAY_BENCHMARK_CASE(float, SlerpArrayOp<float>{}, "Slerp");
+QUATERNION_INTERPOLATION_ARRAY_BENCHMARK_CASE(float, AverageArrayOp<float>{}, "Average x4");
+
+QUATERNION_INTERPOLATION_BENCHMARK_CASE(double, NlerpOp<double>{}, "Nlerp");
+QUATERNION_INTERPOLATION_BENCHMARK_CASE(double, SlerpOp<double>{}, "Slerp");
+QUATERNION_INTERPOLATION_ARRAY_BENCHMARK_CASE(double, NlerpArrayOp<double>{}, "Nlerp");
+QUATERNION_INTERPOLATION_ARRAY_BENCHMARK_CASE(double, SlerpArrayOp<double>{}, "Slerp");
+QUATERNION_INTERPOLATION_ARRAY_BENCHMARK_CASE(double, AverageArrayOp<double>{}, "Average x4");
+
+
+// Not timed: reports the worst angular error in radians compared to Slerp in double precision.
+TEST_CASE("float: Slerp & Nlerp accuracy", "[Quaternion][Interpolation]") {
+	constexpr size_t count = 1024;
+	const auto from = MakeRandomRotations<Quaternion<double>, count>(1);
+	const auto to = MakeRandomRotations<Quaternion<double>, count>(2);
+	const std::vector<Quaternion<float>> fromFloat(from.begin(), from.end());
+	const std::vector<Quaternion<float>> toFloat(to.begin(), to.end());
+
+	const auto angularError = [](const Quaternion<double>& reference, const Quaternion<float>& q) {
+		return 2.0 * std::acos(std::min(1.0, std::abs(Dot(reference, Normalize(Quaternion<double>(q))))));
+	};
+
+	double slerpError = 0.0;
+	double slerpArrayError = 0.0;
+	double nlerpError = 0.0;
+	std::vector<Quaternion<float>> slerpArray(count);
+	for (const float t : { 0.1f, 0.3f, 0.5f }) {
+		Slerp(fromFloat, toFloat, t, slerpArray);
+		for (size_t i = 0; i < count; ++i) {
+			const auto reference = Slerp(from[i], to[i], double(t));
+			slerpError = std::max(slerpError, angularError(reference, Slerp(fromFloat[i], toFloat[i], t)));
+			slerpArrayError = std::max(slerpArrayError, angularError(reference, slerpArray[i]));
+			nlerpError = std::max(nlerpError, angularError(reference, Nlerp(fromFloat[i], toFloat[i], t)));
+		}
+	}
+
+	WARN("Slerp: " << slerpError << ", Slerp (array): " << slerpArrayError << ", Nlerp: " << nlerpError);
+	CHECK(slerpError < 1e-3);
+	CHECK(slerpArrayError < 1e-3);
+}
+
+} // namespace
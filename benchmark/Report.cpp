@@ -0,0 +1,453 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#include "Report.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <istream>
+#include <ostream>
+#include <optional>
+#include <sstream>
+#include <unordered_map>
+
+#if MATHTER_ENABLE_SIMD
+#include <xsimd/xsimd.hpp>
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define MATHTER_CPUID_MSVC
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <cpuid.h>
+#define MATHTER_CPUID_GNU
+#endif
+
+
+namespace {
+
+std::string TrimWhitespace(std::string_view str) {
+	const auto first = str.find_first_not_of(" \t\r\n");
+	if (first == std::string_view::npos) {
+		return {};
+	}
+	const auto last = str.find_last_not_of(" \t\r\n");
+	return std::string(str.substr(first, last - first + 1));
+}
+
+
+std::string GetCpuName() {
+#if defined(MATHTER_CPUID_MSVC) || defined(MATHTER_CPUID_GNU)
+	std::array<unsigned, 12> brand = {};
+	for (unsigned leaf = 0; leaf < 3; ++leaf) {
+		unsigned* regs = brand.data() + 4 * leaf;
+#ifdef MATHTER_CPUID_MSVC
+		int info[4];
+		__cpuid(info, int(0x80000002u + leaf));
+		std::memcpy(regs, info, sizeof(info));
+#else
+		if (!__get_cpuid(0x80000002u + leaf, regs + 0, regs + 1, regs + 2, regs + 3)) {
+			break;
+		}
+#endif
+	}
+	char name[sizeof(brand) + 1] = {};
+	std::memcpy(name, brand.data(), sizeof(brand));
+	const auto trimmed = TrimWhitespace(name);
+	if (!trimmed.empty()) {
+		return trimmed;
+	}
+#endif
+	// Non-x86 Linux systems, such as ARM, don't have a brand string, but the kernel knows the model.
+	std::ifstream cpuinfo("/proc/cpuinfo");
+	std::string line;
+	while (std::getline(cpuinfo, line)) {
+		for (const auto& key : { "model name", "Hardware", "Model" }) {
+			if (line.rfind(key, 0) == 0 && line.find(':') != std::string::npos) {
+				return TrimWhitespace(std::string_view(line).substr(line.find(':') + 1));
+			}
+		}
+	}
+	return "unknown";
+}
+
+
+std::vector<std::pair<std::string, bool>> GetAvailableArchitectures() {
+#if MATHTER_ENABLE_SIMD
+	const auto architectures = xsimd::available_architectures();
+	return {
+		{ "sse2", architectures.sse2 },
+		{ "sse3", architectures.sse3 },
+		{ "ssse3", architectures.ssse3 },
+		{ "sse4_1", architectures.sse4_1 },
+		{ "sse4_2", architectures.sse4_2 },
+		{ "fma3_sse42", architectures.fma3_sse42 },
+		{ "fma4", architectures.fma4 },
+		{ "avx", architectures.avx },
+		{ "fma3_avx", architectures.fma3_avx },
+		{ "avx2", architectures.avx2 },
+		{ "avxvnni", architectures.avxvnni },
+		{ "fma3_avx2", architectures.fma3_avx2 },
+		{ "avx512f", architectures.avx512f },
+		{ "avx512cd", architectures.avx512cd },
+		{ "avx512dq", architectures.avx512dq },
+		{ "avx512bw", architectures.avx512bw },
+		{ "avx512er", architectures.avx512er },
+		{ "avx512pf", architectures.avx512pf },
+		{ "avx512ifma", architectures.avx512ifma },
+		{ "avx512vbmi", architectures.avx512vbmi },
+		{ "avx512vnni_bw", architectures.avx512vnni_bw },
+		{ "avx512vnni_vbmi", architectures.avx512vnni_vbmi },
+		{ "neon", architectures.neon },
+		{ "neon64", architectures.neon64 },
+		{ "i8mm_neon64", architectures.i8mm_neon64 },
+		{ "sve", architectures.sve },
+		{ "rvv", architectures.rvv },
+		{ "wasm", architectures.wasm },
+	};
+#else
+	return {};
+#endif
+}
+
+
+std::vector<std::string> GetEnabledArchitectures() {
+	std::vector<std::string> enabled;
+#if MATHTER_ENABLE_SIMD
+	xsimd::all_architectures::for_each([&enabled](const auto& arch) {
+		if (arch.supported()) {
+			enabled.push_back(arch.name());
+		}
+	});
+#endif
+	return enabled;
+}
+
+
+std::string GetCompiler() {
+#if defined(__clang__)
+	return "Clang " __clang_version__;
+#elif defined(__GNUC__)
+	return "GCC " __VERSION__;
+#elif defined(_MSC_VER)
+	return "MSVC " + std::to_string(_MSC_FULL_VER);
+#else
+	return "unknown";
+#endif
+}
+
+
+std::string GetBuildType() {
+#if defined(MATHTER_BENCHMARK_BUILD_TYPE)
+	if (std::strlen(MATHTER_BENCHMARK_BUILD_TYPE) != 0) {
+		return MATHTER_BENCHMARK_BUILD_TYPE;
+	}
+#endif
+#ifdef NDEBUG
+	return "Release";
+#else
+	return "Debug";
+#endif
+}
+
+
+std::string GetBuildFlags() {
+#ifdef MATHTER_BENCHMARK_CXX_FLAGS
+	return TrimWhitespace(MATHTER_BENCHMARK_CXX_FLAGS);
+#else
+	return {};
+#endif
+}
+
+
+std::string EscapeJson(std::string_view str) {
+	std::string escaped;
+	for (const char c : str) {
+		switch (c) {
+			case '"': escaped += "\\\""; break;
+			case '\\': escaped += "\\\\"; break;
+			case '\n': escaped += "\\n"; break;
+			case '\t': escaped += "\\t"; break;
+			default:
+				if (static_cast<unsigned char>(c) < 0x20) {
+					std::ostringstream code;
+					code << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int(c);
+					escaped += code.str();
+				}
+				else {
+					escaped += c;
+				}
+		}
+	}
+	return escaped;
+}
+
+
+std::string FormatPercent(double ratio) {
+	std::ostringstream ss;
+	ss << std::fixed << std::setprecision(1) << ratio * 100.0 << "%";
+	return ss.str();
+}
+
+
+std::string QuoteCsv(std::string_view str) {
+	std::string quoted = "\"";
+	for (const char c : str) {
+		quoted += c;
+		if (c == '"') {
+			quoted += '"';
+		}
+	}
+	quoted += '"';
+	return quoted;
+}
+
+
+std::vector<std::string> SplitCsvLine(std::string_view line) {
+	std::vector<std::string> fields(1);
+	bool quoted = false;
+	for (size_t i = 0; i < line.size(); ++i) {
+		const char c = line[i];
+		if (quoted) {
+			if (c == '"' && i + 1 < line.size() && line[i + 1] == '"') {
+				fields.back() += '"';
+				++i;
+			}
+			else if (c == '"') {
+				quoted = false;
+			}
+			else {
+				fields.back() += c;
+			}
+		}
+		else if (c == '"') {
+			quoted = true;
+		}
+		else if (c == ',') {
+			fields.emplace_back();
+		}
+		else if (c != '\r') {
+			fields.back() += c;
+		}
+	}
+	return fields;
+}
+
+} // namespace
+
+
+SystemInfo GetSystemInfo() {
+	SystemInfo system;
+	system.cpu = GetCpuName();
+	system.availableArchitectures = GetAvailableArchitectures();
+	system.enabledArchitectures = GetEnabledArchitectures();
+	system.compiler = GetCompiler();
+	system.buildType = GetBuildType();
+	system.buildFlags = GetBuildFlags();
+#if MATHTER_ENABLE_SIMD
+	system.simd = true;
+#else
+	system.simd = false;
+#endif
+#ifdef MATHTER_TSC_USES_CHRONO
+	system.timeUnit = "ns";
+#else
+	system.timeUnit = "cycles";
+#endif
+	return system;
+}
+
+
+void WriteJson(std::ostream& os, const SystemInfo& system, const std::vector<impl::BenchmarkRecord>& records) {
+	const auto joinStrings = [](const auto& strings) {
+		std::string joined;
+		for (const auto& str : strings) {
+			joined += (joined.empty() ? "\"" : ", \"") + EscapeJson(str) + "\"";
+		}
+		return joined;
+	};
+	std::vector<std::string> available;
+	for (const auto& [name, supported] : system.availableArchitectures) {
+		if (supported) {
+			available.push_back(name);
+		}
+	}
+
+	os << std::setprecision(10);
+	os << "{\n";
+	os << "  \"system\": {\n";
+	os << "    \"cpu\": \"" << EscapeJson(system.cpu) << "\",\n";
+	os << "    \"simd\": " << (system.simd ? "true" : "false") << ",\n";
+	os << "    \"availableArchitectures\": [" << joinStrings(available) << "],\n";
+	os << "    \"enabledArchitectures\": [" << joinStrings(system.enabledArchitectures) << "],\n";
+	os << "    \"compiler\": \"" << EscapeJson(system.compiler) << "\",\n";
+	os << "    \"buildType\": \"" << EscapeJson(system.buildType) << "\",\n";
+	os << "    \"buildFlags\": \"" << EscapeJson(system.buildFlags) << "\",\n";
+	os << "    \"timeUnit\": \"" << EscapeJson(system.timeUnit) << "\"\n";
+	os << "  },\n";
+	os << "  \"records\": [";
+	for (size_t i = 0; i < records.size(); ++i) {
+		os << (i == 0 ? "\n" : ",\n");
+		os << "    { \"name\": \"" << EscapeJson(records[i].name) << "\", "
+		   << "\"latency\": " << records[i].latency << ", "
+		   << "\"throughput\": " << records[i].throughput;
+		if (!records[i].counters.Empty()) {
+			const auto counters = records[i].counters.Values();
+			os << ", \"counters\": {";
+			for (size_t j = 0; j < counters.size(); ++j) {
+				os << (j == 0 ? " \"" : ", \"") << PerfRecord::names[j] << "\": ";
+				if (counters[j]) {
+					os << *counters[j];
+				}
+				else {
+					os << "null";
+				}
+			}
+			os << " }";
+		}
+		os << " }";
+	}
+	os << "\n  ]\n";
+	os << "}\n";
+}
+
+
+void WriteCsv(std::ostream& os, const SystemInfo& system, const std::vector<impl::BenchmarkRecord>& records) {
+	std::string available;
+	for (const auto& [name, supported] : system.availableArchitectures) {
+		if (supported) {
+			available += (available.empty() ? "" : " ") + name;
+		}
+	}
+	std::string enabled;
+	for (const auto& name : system.enabledArchitectures) {
+		enabled += (enabled.empty() ? "" : " ") + name;
+	}
+
+	os << std::setprecision(10);
+	os << "# cpu: " << system.cpu << "\n";
+	os << "# simd: " << (system.simd ? "ON" : "OFF") << "\n";
+	os << "# available architectures: " << available << "\n";
+	os << "# enabled architectures: " << enabled << "\n";
+	os << "# compiler: " << system.compiler << "\n";
+	os << "# build type: " << system.buildType << "\n";
+	os << "# build flags: " << system.buildFlags << "\n";
+	os << "# unit: " << system.timeUnit << "\n";
+	os << "name,latency,throughput";
+	for (const auto& counterName : PerfRecord::names) {
+		os << "," << counterName;
+	}
+	os << "\n";
+	for (const auto& record : records) {
+		os << QuoteCsv(record.name) << "," << record.latency << "," << record.throughput;
+		// Counters that were not collected are left empty.
+		for (const auto& counter : record.counters.Values()) {
+			os << ",";
+			if (counter) {
+				os << *counter;
+			}
+		}
+		os << "\n";
+	}
+}
+
+
+std::vector<impl::BenchmarkRecord> ReadCsv(std::istream& is, std::string& timeUnit) {
+	constexpr std::string_view unitPrefix = "# unit:";
+
+	std::vector<impl::BenchmarkRecord> records;
+	timeUnit.clear();
+	std::string line;
+	while (std::getline(is, line)) {
+		if (line.rfind(unitPrefix, 0) == 0) {
+			timeUnit = TrimWhitespace(std::string_view(line).substr(unitPrefix.size()));
+		}
+		if (line.empty() || line[0] == '#' || line.rfind("name,", 0) == 0) {
+			continue;
+		}
+		const auto fields = SplitCsvLine(line);
+		// Files written before the counters were added only have the timings.
+		if (fields.size() != 3 && fields.size() != 3 + PerfRecord::size) {
+			return {};
+		}
+		try {
+			impl::BenchmarkRecord record{ fields[0], std::stod(fields[1]), std::stod(fields[2]) };
+			std::array<std::optional<double>, PerfRecord::size> counters;
+			for (size_t i = 3; i < fields.size(); ++i) {
+				if (!fields[i].empty()) {
+					counters[i - 3] = std::stod(fields[i]);
+				}
+			}
+			const auto& [cycles, instructions, l1dMisses, llcMisses, branchMisses] = counters;
+			record.counters = PerfRecord{ cycles, instructions, l1dMisses, llcMisses, branchMisses };
+			records.push_back(std::move(record));
+		}
+		catch (const std::exception&) {
+			return {};
+		}
+	}
+	return records;
+}
+
+
+std::vector<Regression> CompareToBaseline(const std::vector<impl::BenchmarkRecord>& baseline,
+										  const std::vector<impl::BenchmarkRecord>& current,
+										  double threshold) {
+	std::unordered_map<std::string_view, const impl::BenchmarkRecord*> baselineByName;
+	for (const auto& record : baseline) {
+		baselineByName[record.name] = &record;
+	}
+
+	std::vector<Regression> regressions;
+	for (const auto& record : current) {
+		const auto it = baselineByName.find(record.name);
+		if (it == baselineByName.end()) {
+			continue;
+		}
+		const auto& reference = *it->second;
+		// Both metrics are time per operation, so larger is worse.
+		if (record.latency > reference.latency * (1.0 + threshold)) {
+			regressions.push_back({ record.name, "latency", reference.latency, record.latency });
+		}
+		if (record.throughput > reference.throughput * (1.0 + threshold)) {
+			regressions.push_back({ record.name, "throughput", reference.throughput, record.throughput });
+		}
+	}
+	return regressions;
+}
+
+
+void PrintRegressions(std::ostream& os, const std::vector<Regression>& regressions, double threshold) {
+	if (regressions.empty()) {
+		os << "No regressions beyond " << FormatPercent(threshold) << " compared to the baseline." << std::endl;
+		return;
+	}
+
+	size_t nameWidth = std::size(std::string_view("Name"));
+	for (const auto& regression : regressions) {
+		nameWidth = std::max(nameWidth, regression.name.size());
+	}
+
+	auto printRow = [&](std::string_view name, std::string_view metric, std::string_view baseline, std::string_view current, std::string_view change) {
+		os << std::left << std::setw(int(nameWidth)) << name
+		   << " | " << std::setw(10) << metric
+		   << " | " << std::setw(12) << baseline
+		   << " | " << std::setw(12) << current
+		   << " | " << change << std::right << std::endl;
+	};
+
+	os << regressions.size() << " regression(s) beyond " << FormatPercent(threshold) << " compared to the baseline:" << std::endl;
+	printRow("Name", "Metric", "Baseline", "Current", "Change");
+	for (const auto& regression : regressions) {
+		printRow(regression.name,
+				 regression.metric,
+				 std::to_string(regression.baseline),
+				 std::to_string(regression.current),
+				 "+" + FormatPercent(regression.current / regression.baseline - 1.0));
+	}
+}
@@ -0,0 +1,60 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#pragma once
+
+#include "Benchmark.hpp"
+
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+
+/// <summary> Describes the machine and the build the benchmarks ran on. </summary>
+struct SystemInfo {
+	std::string cpu;
+	std::vector<std::pair<std::string, bool>> availableArchitectures;
+	std::vector<std::string> enabledArchitectures;
+	std::string compiler;
+	std::string buildType;
+	std::string buildFlags;
+	bool simd;
+	std::string timeUnit;
+};
+
+
+/// <summary> A benchmark case that got slower than its baseline. </summary>
+struct Regression {
+	std::string name;
+	std::string metric;
+	double baseline;
+	double current;
+};
+
+
+/// <summary> Collects the CPU, SIMD and build information. </summary>
+SystemInfo GetSystemInfo();
+
+/// <summary> Writes the system information and the records as a JSON document. </summary>
+void WriteJson(std::ostream& os, const SystemInfo& system, const std::vector<impl::BenchmarkRecord>& records);
+
+/// <summary> Writes the records as CSV, preceded by the system information as # comment lines. </summary>
+void WriteCsv(std::ostream& os, const SystemInfo& system, const std::vector<impl::BenchmarkRecord>& records);
+
+/// <summary> Reads the records of a CSV file written by <see cref="WriteCsv"/>. </summary>
+/// <param name="timeUnit"> Receives the time unit of the records, or empty if the file does not specify it. </param>
+/// <returns> The records, or nothing if the file is malformed. </returns>
+std::vector<impl::BenchmarkRecord> ReadCsv(std::istream& is, std::string& timeUnit);
+
+/// <summary> Finds the cases whose latency or throughput is more than <paramref name="threshold"/> (relative) above the baseline. </summary>
+/// <remarks> Cases missing from either set are ignored. </remarks>
+std::vector<Regression> CompareToBaseline(const std::vector<impl::BenchmarkRecord>& baseline,
+										  const std::vector<impl::BenchmarkRecord>& current,
+										  double threshold);
+
+/// <summary> Prints a table of the regressions. </summary>
+void PrintRegressions(std::ostream& os, const std::vector<Regression>& regressions, double threshold);
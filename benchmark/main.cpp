@@ -5,14 +5,14 @@
 
 #pragma warning(disable : 4244)
 
+#include "Report.hpp"
+
+#include <Mathter/Common/Dispatch.hpp>
 #include <Mathter/Vector.hpp>
 
+#include <fstream>
 #include <iostream>
 
-#if MATHTER_ENABLE_SIMD
-#include <xsimd/xsimd.hpp>
-#endif
-
 #define CATCH_CONFIG_RUNNER
 #include <catch2/catch_session.hpp>
 
@@ -31,55 +31,70 @@ void PrintVectorType(std::string_view name) {
 }
 
 
-void DisplayArchitectureInfo() {
-#if MATHTER_ENABLE_SIMD
-	std::cout << "Available on CPU: " << std::endl;
-	const auto architectures = xsimd::available_architectures();
-
-	PrintArch("sse2", architectures.sse2);
-	PrintArch("sse3", architectures.sse3);
-	PrintArch("ssse3", architectures.ssse3);
-	PrintArch("sse4_1", architectures.sse4_1);
-	PrintArch("sse4_2", architectures.sse4_2);
-	PrintArch("fma3_sse42", architectures.fma3_sse42);
-	PrintArch("fma4", architectures.fma4);
-	PrintArch("avx", architectures.avx);
-	PrintArch("fma3_avx", architectures.fma3_avx);
-	PrintArch("avx2", architectures.avx2);
-	PrintArch("avxvnni", architectures.avxvnni);
-	PrintArch("fma3_avx2", architectures.fma3_avx2);
-	PrintArch("avx512f", architectures.avx512f);
-	PrintArch("avx512cd", architectures.avx512cd);
-	PrintArch("avx512dq", architectures.avx512dq);
-	PrintArch("avx512bw", architectures.avx512bw);
-	PrintArch("avx512er", architectures.avx512er);
-	PrintArch("avx512pf", architectures.avx512pf);
-	PrintArch("avx512ifma", architectures.avx512ifma);
-	PrintArch("avx512vbmi", architectures.avx512vbmi);
-	PrintArch("avx512vnni_bw", architectures.avx512vnni_bw);
-	PrintArch("avx512vnni_vbmi", architectures.avx512vnni_vbmi);
-	PrintArch("neon", architectures.neon);
-	PrintArch("neon64", architectures.neon64);
-	PrintArch("i8mm_neon64", architectures.i8mm_neon64);
-	PrintArch("sve", architectures.sve);
-	PrintArch("rvv", architectures.rvv);
-	PrintArch("wasm", architectures.wasm);
-
-	std::cout << "Enabled in build: " << std::endl;
-	xsimd::all_architectures::for_each([](const auto& arch) {
-		if (arch.supported()) {
-			std::cout << "  " << arch.name() << std::endl;
+void DisplayArchitectureInfo(const SystemInfo& system) {
+	std::cout << "CPU: " << system.cpu << std::endl;
+	if (system.simd) {
+		std::cout << "Available on CPU: " << std::endl;
+		for (const auto& [name, supported] : system.availableArchitectures) {
+			PrintArch(name, supported);
 		}
-	});
-	std::cout << std::endl;
-#else
-	std::cout << "SIMD disabled." << std::endl
-			  << std::endl;
+
+		std::cout << "Enabled in build: " << std::endl;
+		for (const auto& name : system.enabledArchitectures) {
+			std::cout << "  " << name << std::endl;
+		}
+#if MATHTER_ENABLE_DISPATCH
+		std::cout << "Dispatched kernels: " << DispatchedArchitecture() << std::endl;
 #endif
+		std::cout << std::endl;
+	}
+	else {
+		std::cout << "SIMD disabled." << std::endl
+				  << std::endl;
+	}
+}
+
+
+bool ExportRecords(const std::string& path, const SystemInfo& system, void (*write)(std::ostream&, const SystemInfo&, const std::vector<::impl::BenchmarkRecord>&)) {
+	std::ofstream file(path);
+	if (!file) {
+		std::cerr << "Could not open " << path << " for writing." << std::endl;
+		return false;
+	}
+	std::lock_guard lk{ ::impl::g_mutex };
+	write(file, system, ::impl::g_records);
+	return true;
+}
+
+
+bool CheckBaseline(const std::string& path, const SystemInfo& system, double threshold) {
+	std::ifstream file(path);
+	if (!file) {
+		std::cerr << "Could not open baseline " << path << "." << std::endl;
+		return false;
+	}
+	std::string timeUnit;
+	const auto baseline = ReadCsv(file, timeUnit);
+	if (baseline.empty()) {
+		std::cerr << "Baseline " << path << " is empty or malformed." << std::endl;
+		return false;
+	}
+	if (!timeUnit.empty() && timeUnit != system.timeUnit) {
+		std::cerr << "Baseline is measured in " << timeUnit << ", but this build measures in " << system.timeUnit << "." << std::endl;
+		return false;
+	}
+
+	std::lock_guard lk{ ::impl::g_mutex };
+	const auto regressions = CompareToBaseline(baseline, ::impl::g_records, threshold);
+	std::cout << std::endl;
+	PrintRegressions(std::cout, regressions, threshold);
+	std::cout << std::endl;
+	return regressions.empty();
 }
 
 int main(int argc, char* argv[]) {
-	DisplayArchitectureInfo();
+	const auto system = GetSystemInfo();
+	DisplayArchitectureInfo(system);
 
 	std::cout << "SIMD support:" << std::endl;
 	PrintVectorType<float, 2>("float2");
@@ -102,6 +117,44 @@ int main(int argc, char* argv[]) {
 	PrintVectorType<int64_t, 4>("i64_4");
 	std::cout << std::endl;
 
-	int ret = Catch::Session().run(argc, argv);
+	Catch::Session session;
+
+	std::string jsonPath;
+	std::string csvPath;
+	std::string baselinePath;
+	double thresholdPercent = 10.0;
+	bool perfCounters = false;
+
+	using namespace Catch::Clara;
+	const auto cli = session.cli()
+					 | Opt(jsonPath, "file")["--export-json"]("write the results and the system information as JSON")
+					 | Opt(csvPath, "file")["--export-csv"]("write the results and the system information as CSV")
+					 | Opt(baselinePath, "file")["--baseline"]("compare the results to a CSV written by --export-csv, fail on regressions")
+					 | Opt(thresholdPercent, "percent")["--regression-threshold"]("slowdown tolerated by --baseline, 10% by default")
+					 | Opt(perfCounters)["--perf-counters"]("count cycles, instructions, cache and branch misses per operation (Linux only)");
+	session.cli(cli);
+
+	int ret = session.applyCommandLine(argc, argv);
+	if (ret != 0) {
+		return ret;
+	}
+	if (perfCounters) {
+		SetPerfCountersEnabled(true);
+		if (!ThreadPerfCounters()) {
+			std::cerr << "Hardware performance counters are not available, only timings are reported." << std::endl
+					  << std::endl;
+		}
+	}
+	ret = session.run();
+
+	if (!jsonPath.empty() && !ExportRecords(jsonPath, system, WriteJson)) {
+		ret = ret != 0 ? ret : 1;
+	}
+	if (!csvPath.empty() && !ExportRecords(csvPath, system, WriteCsv)) {
+		ret = ret != 0 ? ret : 1;
+	}
+	if (!baselinePath.empty() && !CheckBaseline(baselinePath, system, thresholdPercent / 100.0)) {
+		ret = ret != 0 ? ret : 1;
+	}
 	return ret;
 }
\ No newline at end of file
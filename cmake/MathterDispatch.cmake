@@ -0,0 +1,79 @@
+# Compiles Mathter's bulk kernels, such as TransformPoints, for several SIMD architectures,
+# and makes the target select the best one the CPU supports at runtime.
+#
+#   mathter_target_dispatch(<target> ARCHITECTURES <arch>...)
+#
+# Supported architectures: avx512, avx2, avx, sse4_2, sse2, neon64. MSVC doesn't support sse4_2.
+# The order doesn't matter, the dispatcher always tries the best architecture first.
+# Include the oldest architecture of your fleet (e.g. sse2 for x86-64), and compile
+# the rest of the target for that architecture, so leave MATHTER_TARGET_ARCH empty.
+function(mathter_target_dispatch target)
+	cmake_parse_arguments(PARSE_ARGV 1 ARG "" "" "ARCHITECTURES")
+	if (NOT MATHTER_ENABLE_SIMD)
+		message(FATAL_ERROR "mathter_target_dispatch: runtime dispatch requires MATHTER_ENABLE_SIMD.")
+	endif()
+	if (NOT ARG_ARCHITECTURES)
+		message(FATAL_ERROR "mathter_target_dispatch: no ARCHITECTURES given for ${target}.")
+	endif()
+
+	# Ordered best first.
+	set(known_archs avx512 avx2 avx sse4_2 sse2 neon64)
+
+	set(xsimd_avx512 "xsimd::avx512bw")
+	set(xsimd_avx2 "xsimd::fma3<xsimd::avx2>")
+	set(xsimd_avx "xsimd::avx")
+	set(xsimd_sse4_2 "xsimd::sse4_2")
+	set(xsimd_sse2 "xsimd::sse2")
+	set(xsimd_neon64 "xsimd::neon64")
+
+	if (MSVC)
+		# Older MSVC versions have no /arch option for SSE4.2, so sse4_2 is rejected below.
+		set(flags_avx512 "/arch:AVX512")
+		set(flags_avx2 "/arch:AVX2")
+		set(flags_avx "/arch:AVX")
+		set(flags_sse2 "")
+		set(flags_neon64 "")
+	else()
+		set(flags_avx512 "-mavx512f;-mavx512cd;-mavx512dq;-mavx512bw;-mavx2;-mfma")
+		set(flags_avx2 "-mavx2;-mfma")
+		set(flags_avx "-mavx")
+		set(flags_sse4_2 "-msse4.2")
+		set(flags_sse2 "-msse2")
+		set(flags_neon64 "")
+	endif()
+
+	foreach(arch IN LISTS ARG_ARCHITECTURES)
+		if (NOT arch IN_LIST known_archs)
+			message(FATAL_ERROR "mathter_target_dispatch: unknown architecture ${arch}, expected one of ${known_archs}.")
+		endif()
+		if (NOT DEFINED flags_${arch})
+			message(FATAL_ERROR "mathter_target_dispatch: architecture ${arch} is not supported by ${CMAKE_CXX_COMPILER_ID}, it has no flags to compile for it.")
+		endif()
+	endforeach()
+
+	set(dispatch_archs "")
+	foreach(arch IN LISTS known_archs)
+		if (NOT arch IN_LIST ARG_ARCHITECTURES)
+			continue()
+		endif()
+		# Each architecture gets its own translation unit so that only the kernels are compiled with its flags.
+		# The translation unit includes only the kernel headers, which depend on nothing but xsimd, so
+		# Mathter's own types, whose layout depends on the architecture, are never compiled with these flags.
+		set(MATHTER_DISPATCH_ARCH "${xsimd_${arch}}")
+		set(source "${CMAKE_CURRENT_BINARY_DIR}/MathterDispatch/${target}_${arch}.cpp")
+		file(CONFIGURE OUTPUT "${source}" CONTENT [[
+// Generated by mathter_target_dispatch, do not edit.
+// Instantiates the dispatched Mathter kernels for @MATHTER_DISPATCH_ARCH@.
+
+#define MATHTER_DISPATCH_INSTANTIATE @MATHTER_DISPATCH_ARCH@
+
+#include <Mathter/Matrix/TransformLanes.hpp>
+]] @ONLY)
+		target_sources(${target} PRIVATE "${source}")
+		set_source_files_properties("${source}" TARGET_DIRECTORY ${target} PROPERTIES COMPILE_OPTIONS "${flags_${arch}}")
+		list(APPEND dispatch_archs "${xsimd_${arch}}")
+	endforeach()
+
+	list(JOIN dispatch_archs "," dispatch_archs)
+	target_compile_definitions(${target} PRIVATE MATHTER_ENABLE_DISPATCH=1 "MATHTER_DISPATCH_ARCHS=${dispatch_archs}")
+endfunction()
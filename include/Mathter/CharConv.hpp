@@ -0,0 +1,224 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#pragma once
+
+#include "Common/TypeTraits.hpp"
+#include "Matrix/Matrix.hpp"
+#include "Vector/Vector.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <complex>
+#include <cstddef>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+
+namespace mathter {
+
+
+namespace impl {
+
+	inline const char* SkipSpace(const char* first, const char* last) {
+		while (first != last && (*first == ' ' || *first == '\t' || *first == '\n' || *first == '\r' || *first == '\f' || *first == '\v')) {
+			++first;
+		}
+		return first;
+	}
+
+
+	inline std::from_chars_result FromCharsLiteral(const char* first, const char* last, char c) {
+		if (first == last || *first != c) {
+			return { first, std::errc::invalid_argument };
+		}
+		return { first + 1, std::errc{} };
+	}
+
+
+	inline std::to_chars_result ToCharsLiteral(char* first, char* last, std::string_view text) {
+		if (static_cast<size_t>(last - first) < text.size()) {
+			return { last, std::errc::value_too_large };
+		}
+		return { std::copy(text.begin(), text.end(), first), std::errc{} };
+	}
+
+
+	template <class Element>
+	std::from_chars_result FromCharsElement(const char* first, const char* last, Element& value) {
+		if constexpr (is_complex_v<Element>) {
+			// Same format as the stream operators: "re" or "re + imj".
+			using Real = remove_complex_t<Element>;
+			Real re(0);
+			Real im(0);
+			auto result = FromCharsElement(first, last, re);
+			if (result.ec != std::errc{}) {
+				return result;
+			}
+			const auto plus = SkipSpace(result.ptr, last);
+			if (plus != last && *plus == '+') {
+				result = FromCharsElement(SkipSpace(plus + 1, last), last, im);
+				if (result.ec != std::errc{}) {
+					return result;
+				}
+				result = FromCharsLiteral(result.ptr, last, 'j');
+				if (result.ec != std::errc{}) {
+					return result;
+				}
+			}
+			value = Element(re, im);
+			return result;
+		}
+		else {
+			// std::from_chars rejects the leading plus sign that the stream operators accept.
+			if (first != last && *first == '+') {
+				++first;
+			}
+			return std::from_chars(first, last, value);
+		}
+	}
+
+
+	template <class Element>
+	std::to_chars_result ToCharsElement(char* first, char* last, const Element& value) {
+		if constexpr (is_complex_v<Element>) {
+			auto result = ToCharsElement(first, last, std::real(value));
+			if (result.ec != std::errc{} || std::imag(value) == remove_complex_t<Element>(0)) {
+				return result;
+			}
+			result = ToCharsLiteral(result.ptr, last, " + ");
+			if (result.ec != std::errc{}) {
+				return result;
+			}
+			result = ToCharsElement(result.ptr, last, std::imag(value));
+			if (result.ec != std::errc{}) {
+				return result;
+			}
+			return ToCharsLiteral(result.ptr, last, "j");
+		}
+		else {
+			return std::to_chars(first, last, value);
+		}
+	}
+
+
+	/// <summary> Parses "[e0, e1, ...]" with exactly <paramref name="count"/> elements. </summary>
+	template <class Element, class ParseElement>
+	std::from_chars_result FromCharsArray(const char* first, const char* last, Element* elements, size_t count, ParseElement parseElement) {
+		auto result = FromCharsLiteral(SkipSpace(first, last), last, '[');
+		for (size_t i = 0; i < count && result.ec == std::errc{}; ++i) {
+			if (i != 0) {
+				result = FromCharsLiteral(SkipSpace(result.ptr, last), last, ',');
+			}
+			if (result.ec == std::errc{}) {
+				result = parseElement(SkipSpace(result.ptr, last), last, elements[i]);
+			}
+		}
+		if (result.ec != std::errc{}) {
+			return result;
+		}
+		return FromCharsLiteral(SkipSpace(result.ptr, last), last, ']');
+	}
+
+
+	/// <summary> Formats "[e0, e1, ...]". </summary>
+	template <class Element, class FormatElement>
+	std::to_chars_result ToCharsArray(char* first, char* last, const Element* elements, size_t count, FormatElement formatElement) {
+		auto result = ToCharsLiteral(first, last, "[");
+		for (size_t i = 0; i < count && result.ec == std::errc{}; ++i) {
+			if (i != 0) {
+				result = ToCharsLiteral(result.ptr, last, ", ");
+			}
+			if (result.ec == std::errc{}) {
+				result = formatElement(result.ptr, last, elements[i]);
+			}
+		}
+		if (result.ec != std::errc{}) {
+			return result;
+		}
+		return ToCharsLiteral(result.ptr, last, "]");
+	}
+
+} // namespace impl
+
+
+/// <summary> Parses a vector in the same format as the stream operators, such as "[1, 2, 3]". </summary>
+/// <remarks> Unlike the stream operators, this never throws or allocates memory.
+///		Leading whitespace is skipped, and parsing stops after the closing bracket.
+///		On error, <paramref name="value"/> is left unchanged and the result contains the position of the error. </remarks>
+/// <returns> The same as std::from_chars: the position after the parsed text and std::errc{},
+///		or std::errc::invalid_argument if the text is malformed, or std::errc::result_out_of_range if an element overflows. </returns>
+template <class T, int Dim, bool Packed>
+std::from_chars_result FromChars(const char* first, const char* last, Vector<T, Dim, Packed>& value) noexcept {
+	static_assert(Dim != DYNAMIC, "Dynamically sized vectors are not supported.");
+	Vector<T, Dim, true> packed;
+	const auto result = impl::FromCharsArray(first, last, packed.elements.array.data(), Dim, [](const char* begin, const char* end, T& element) {
+		return impl::FromCharsElement(begin, end, element);
+	});
+	if (result.ec == std::errc{}) {
+		value = Vector<T, Dim, Packed>(packed);
+	}
+	return result;
+}
+
+
+/// <summary> Parses a matrix in the same format as the stream operators, as an array of rows, such as "[[1, 2], [3, 4]]". </summary>
+/// <remarks> See the overload for vectors for details. </remarks>
+template <class T, int Rows, int Columns, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+std::from_chars_result FromChars(const char* first, const char* last, Matrix<T, Rows, Columns, Order, Layout, Packed>& value) noexcept {
+	static_assert(Rows != DYNAMIC && Columns != DYNAMIC, "Dynamically sized matrices are not supported.");
+	std::array<Vector<T, Columns, Packed>, Rows> rows;
+	const auto result = impl::FromCharsArray(first, last, rows.data(), Rows, [](const char* begin, const char* end, Vector<T, Columns, Packed>& row) {
+		return FromChars(begin, end, row);
+	});
+	if (result.ec == std::errc{}) {
+		for (int row = 0; row < Rows; ++row) {
+			value.Row(row, rows[row]);
+		}
+	}
+	return result;
+}
+
+
+/// <summary> Parses a vector or a matrix from a string. </summary>
+/// <remarks> See the overloads taking a character range for details. The text may continue after the parsed object. </remarks>
+template <class Value>
+auto FromChars(std::string_view text, Value& value) noexcept -> decltype(FromChars(text.data(), text.data(), value)) {
+	return FromChars(text.data(), text.data() + text.size(), value);
+}
+
+
+/// <summary> Formats a vector in the same format as the stream operators, such as "[1, 2, 3]". </summary>
+/// <remarks> Unlike the stream operators, this never throws or allocates memory, and does not add a null terminator.
+///		Floating point elements are formatted with the shortest representation that parses back to the same value. </remarks>
+/// <returns> The same as std::to_chars: the position after the formatted text and std::errc{},
+///		or <paramref name="last"/> and std::errc::value_too_large if the buffer is too small. </returns>
+template <class T, int Dim, bool Packed>
+std::to_chars_result ToChars(char* first, char* last, const Vector<T, Dim, Packed>& value) noexcept {
+	static_assert(Dim != DYNAMIC, "Dynamically sized vectors are not supported.");
+	const auto packed = Vector<T, Dim, true>(value);
+	return impl::ToCharsArray(first, last, packed.elements.array.data(), Dim, [](char* begin, char* end, const T& element) {
+		return impl::ToCharsElement(begin, end, element);
+	});
+}
+
+
+/// <summary> Formats a matrix in the same format as the stream operators, as an array of rows, such as "[[1, 2], [3, 4]]". </summary>
+/// <remarks> See the overload for vectors for details. </remarks>
+template <class T, int Rows, int Columns, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+std::to_chars_result ToChars(char* first, char* last, const Matrix<T, Rows, Columns, Order, Layout, Packed>& value) noexcept {
+	static_assert(Rows != DYNAMIC && Columns != DYNAMIC, "Dynamically sized matrices are not supported.");
+	std::array<Vector<T, Columns, Packed>, Rows> rows;
+	for (int row = 0; row < Rows; ++row) {
+		rows[row] = value.Row(row);
+	}
+	return impl::ToCharsArray(first, last, rows.data(), Rows, [](char* begin, char* end, const Vector<T, Columns, Packed>& row) {
+		return ToChars(begin, end, row);
+	});
+}
+
+} // namespace mathter
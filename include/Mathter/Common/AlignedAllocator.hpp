@@ -0,0 +1,67 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+
+namespace mathter {
+
+
+/// <summary> A standard allocator that returns memory with a guaranteed minimum alignment. </summary>
+/// <remarks> Use it for containers that are processed with aligned SIMD loads and stores. </remarks>
+template <class T, size_t Alignment = alignof(std::max_align_t)>
+class AlignedAllocator {
+	static_assert(Alignment > 0 && (Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two.");
+
+public:
+	using value_type = T;
+	using size_type = size_t;
+	using difference_type = std::ptrdiff_t;
+	using propagate_on_container_move_assignment = std::true_type;
+	using is_always_equal = std::true_type;
+
+	static constexpr size_t alignment = Alignment > alignof(T) ? Alignment : alignof(T);
+
+	template <class U>
+	struct rebind {
+		using other = AlignedAllocator<U, Alignment>;
+	};
+
+	AlignedAllocator() noexcept = default;
+
+	template <class U>
+	AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+	[[nodiscard]] T* allocate(size_t count) {
+		if (count > std::numeric_limits<size_t>::max() / sizeof(T)) {
+			throw std::bad_array_new_length();
+		}
+		return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t{ alignment }));
+	}
+
+	void deallocate(T* ptr, size_t) noexcept {
+		::operator delete(ptr, std::align_val_t{ alignment });
+	}
+};
+
+
+template <class T, class U, size_t Alignment>
+bool operator==(const AlignedAllocator<T, Alignment>&, const AlignedAllocator<U, Alignment>&) noexcept {
+	return true;
+}
+
+
+template <class T, class U, size_t Alignment>
+bool operator!=(const AlignedAllocator<T, Alignment>&, const AlignedAllocator<U, Alignment>&) noexcept {
+	return false;
+}
+
+
+} // namespace mathter
@@ -0,0 +1,80 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#pragma once
+
+#if MATHTER_ENABLE_DISPATCH
+#if !MATHTER_ENABLE_SIMD
+#error "Runtime dispatch requires MATHTER_ENABLE_SIMD."
+#endif
+#ifndef MATHTER_DISPATCH_ARCHS
+#error "Define MATHTER_DISPATCH_ARCHS as the list of xsimd architectures to dispatch to, best first. Use mathter_target_dispatch in CMake."
+#endif
+
+#include <xsimd/xsimd.hpp>
+
+#include <utility>
+#endif
+
+
+// Runtime dispatch
+//
+// The bulk kernels (e.g. TransformPoints) are declared as functors with a
+//		template <class Arch, class T> operator()(Arch, ...) const;
+// member, whose definition is only visible when MATHTER_DISPATCH_INSTANTIATE is defined.
+// Each architecture is instantiated in its own translation unit, compiled with the
+// architecture's compiler flags, by defining MATHTER_DISPATCH_INSTANTIATE as the
+// xsimd architecture and including the headers of the kernels. The CMake function
+// mathter_target_dispatch generates these translation units.
+//
+// The kernel headers (e.g. Matrix/TransformLanes.hpp) include nothing but xsimd, and
+// the kernels work on raw pointers. The storage of Mathter's vectors depends on the
+// architecture, so they must not be compiled with different flags in the same program.
+// Likewise, every template instantiated by a kernel is specialized for the architecture,
+// so the linker can't merge it with a copy compiled for an older CPU.
+//
+// All other translation units only see the declaration, so they can't accidentally
+// compile a kernel for an architecture with the wrong flags. At runtime, the calls are
+// forwarded to the best of MATHTER_DISPATCH_ARCHS that the CPU supports.
+
+
+namespace mathter {
+
+#if MATHTER_ENABLE_DISPATCH
+
+namespace impl {
+
+	/// <summary> The architectures the kernels are compiled for, best first. </summary>
+	using DispatchArchs = xsimd::arch_list<MATHTER_DISPATCH_ARCHS>;
+
+
+	/// <summary> Calls <paramref name="kernel"/> with the best architecture in <see cref="DispatchArchs"/> available on the CPU. </summary>
+	template <class Kernel, class... Args>
+	decltype(auto) Dispatch(const Kernel& kernel, Args&&... args) {
+		// The available architectures are detected once, when the first call initializes the dispatcher.
+		// The kernel is copied because the dispatcher would keep a reference to an lvalue.
+		static auto dispatcher = xsimd::dispatch<DispatchArchs>(Kernel(kernel));
+		return dispatcher(std::forward<Args>(args)...);
+	}
+
+
+	struct ArchitectureNameKernel {
+		template <class Arch>
+		const char* operator()(Arch) const {
+			return Arch::name();
+		}
+	};
+
+} // namespace impl
+
+
+/// <summary> Returns the name of the xsimd architecture the dispatched kernels use on this CPU. </summary>
+inline const char* DispatchedArchitecture() {
+	return impl::Dispatch(impl::ArchitectureNameKernel{});
+}
+
+#endif
+
+} // namespace mathter
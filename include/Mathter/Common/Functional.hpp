@@ -8,6 +8,7 @@
 #include "TypeTraits.hpp"
 
 #include <cmath>
+#include <cstdint>
 #include <type_traits>
 
 
@@ -332,4 +333,144 @@ struct sqrt<void> {
 	}
 };
 
+
+template <class T = void>
+struct sin {
+	constexpr auto operator()(const T& arg) const {
+		return std::sin(arg);
+	}
+};
+
+
+#ifdef MATHTER_ENABLE_SIMD
+template <class T, class A>
+struct sin<xsimd::batch<T, A>> {
+	xsimd::batch<T, A> operator()(const xsimd::batch<T, A>& arg) const {
+		return xsimd::sin(arg);
+	}
+};
+#endif
+
+
+template <>
+struct sin<void> {
+	template <class T>
+	constexpr auto operator()(T&& arg) const {
+		return sin<std::decay_t<T>>{}(std::forward<T>(arg));
+	}
+};
+
+
+template <class T = void>
+struct atan2 {
+	constexpr auto operator()(const T& y, const T& x) const {
+		return std::atan2(y, x);
+	}
+};
+
+
+#ifdef MATHTER_ENABLE_SIMD
+template <class T, class A>
+struct atan2<xsimd::batch<T, A>> {
+	xsimd::batch<T, A> operator()(const xsimd::batch<T, A>& y, const xsimd::batch<T, A>& x) const {
+		return xsimd::atan2(y, x);
+	}
+};
+#endif
+
+
+template <>
+struct atan2<void> {
+	template <class T>
+	constexpr auto operator()(const T& y, const T& x) const {
+		return atan2<T>{}(y, x);
+	}
+};
+
+
+/// <summary> Chooses <paramref name="lhs"/> where the condition is true, and <paramref name="rhs"/> elsewhere. </summary>
+/// <remarks> For SIMD batches, the choice is made separately for each lane. </remarks>
+template <class T = void>
+struct select {
+	constexpr T operator()(bool condition, const T& lhs, const T& rhs) const {
+		return condition ? lhs : rhs;
+	}
+};
+
+
+#ifdef MATHTER_ENABLE_SIMD
+template <class T, class A>
+struct select<xsimd::batch<T, A>> {
+	xsimd::batch<T, A> operator()(const xsimd::batch_bool<T, A>& condition, const xsimd::batch<T, A>& lhs, const xsimd::batch<T, A>& rhs) const {
+		return xsimd::select(condition, lhs, rhs);
+	}
+};
+#endif
+
+
+template <>
+struct select<void> {
+	template <class Condition, class T>
+	constexpr auto operator()(const Condition& condition, const T& lhs, const T& rhs) const {
+		return select<T>{}(condition, lhs, rhs);
+	}
+};
+
+
+/// <summary> Tells if the condition is true for any lane of a SIMD batch, or if the condition is true for scalars. </summary>
+template <class T = void>
+struct any_true {
+	constexpr bool operator()(bool condition) const {
+		return condition;
+	}
+};
+
+
+#ifdef MATHTER_ENABLE_SIMD
+template <class T, class A>
+struct any_true<xsimd::batch_bool<T, A>> {
+	bool operator()(const xsimd::batch_bool<T, A>& condition) const {
+		return xsimd::any(condition);
+	}
+};
+#endif
+
+
+template <>
+struct any_true<void> {
+	template <class Condition>
+	constexpr bool operator()(const Condition& condition) const {
+		return any_true<Condition>{}(condition);
+	}
+};
+
+
+/// <summary> Packs the lanes of a SIMD condition into the bits of an integer, the first lane being the least significant bit.
+///		For scalars, returns 1 if the condition is true and 0 otherwise. </summary>
+template <class T = void>
+struct mask_bits {
+	constexpr uint64_t operator()(bool condition) const {
+		return condition ? 1u : 0u;
+	}
+};
+
+
+#ifdef MATHTER_ENABLE_SIMD
+template <class T, class A>
+struct mask_bits<xsimd::batch_bool<T, A>> {
+	uint64_t operator()(const xsimd::batch_bool<T, A>& condition) const {
+		return condition.mask();
+	}
+};
+#endif
+
+
+template <>
+struct mask_bits<void> {
+	template <class Condition>
+	constexpr uint64_t operator()(const Condition& condition) const {
+		return mask_bits<Condition>{}(condition);
+	}
+};
+
 } // namespace mathter
\ No newline at end of file
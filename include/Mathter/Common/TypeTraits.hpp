@@ -54,6 +54,19 @@ template <class T>
 constexpr auto is_matrix_v = is_matrix<T>::value;
 
 
+template <class>
+struct is_dynamic : std::false_type {};
+
+template <class T, bool Packed>
+struct is_dynamic<Vector<T, DYNAMIC, Packed>> : std::true_type {};
+
+template <class T, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+struct is_dynamic<Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed>> : std::true_type {};
+
+template <class T>
+constexpr auto is_dynamic_v = is_dynamic<T>::value;
+
+
 template <class>
 struct is_quaternion : std::false_type {};
 
@@ -64,9 +77,19 @@ template <class T>
 constexpr auto is_quaternion_v = is_quaternion<T>::value;
 
 
+template <class T, class = void>
+struct is_expression : std::false_type {};
+
+template <class T>
+struct is_expression<T, std::void_t<typename T::ExpressionResult>> : std::true_type {};
+
+template <class T>
+constexpr auto is_expression_v = is_expression<T>::value;
+
+
 template <class T>
 struct is_scalar {
-	static constexpr auto value = !(is_vector_v<T> || is_swizzle_v<T> || is_matrix_v<T> || is_quaternion_v<T>);
+	static constexpr auto value = !(is_vector_v<T> || is_swizzle_v<T> || is_matrix_v<T> || is_quaternion_v<T> || is_expression_v<T>);
 };
 
 template <class T>
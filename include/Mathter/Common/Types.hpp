@@ -52,8 +52,8 @@ enum class eQuaternionLayout {
 // Constants
 //------------------------------------------------------------------------------
 
-/// <summary> Specify this as Vector or Matrix dimension template parameter to set size at runtime.
-/// PLEASE NOTE THAT DYNAMICALLY SIZED VECTORS AND MATRICES ARE NOT SUPPORTED YET. </summary>
+/// <summary> Specify this as Vector or Matrix dimension template parameter to set size at runtime. </summary>
+/// <remarks> Matrices must have both their rows and columns set to DYNAMIC. </remarks>
 constexpr int DYNAMIC = -1;
 
 
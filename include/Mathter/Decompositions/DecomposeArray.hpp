@@ -0,0 +1,494 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#pragma once
+
+#include "../Common/Functional.hpp"
+#include "../Common/TypeTraits.hpp"
+#include "../Matrix/MatrixArray.hpp"
+#include "../Vector/VectorArray.hpp"
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+
+namespace mathter {
+
+
+/// <summary> The LUP decompositions of many matrices. </summary>
+/// <remarks> Equivalent to <see cref="DecompositionLUP"/> for each matrix of the array. </remarks>
+template <class T, int Dim>
+struct DecompositionLUPArray {
+	/// <summary> Unit lower triangular factors. </summary>
+	MatrixArray<T, Dim, Dim> L;
+	/// <summary> Upper triangular factors. </summary>
+	MatrixArray<T, Dim, Dim> U;
+	/// <summary> Row i of L * U is row P[i] of the original matrix. </summary>
+	/// <remarks> The row indices are stored as <typeparamref name="T"/> so that they can be processed in the same lanes as the factors. </remarks>
+	VectorArray<T, Dim> P;
+
+	/// <summary> Solves the linear system of equations A * x = b for each matrix and right-hand side. </summary>
+	VectorArray<T, Dim> Solve(const VectorArray<T, Dim>& b) const;
+};
+
+
+/// <summary> The thin QR decompositions of many matrices. </summary>
+/// <remarks> Equivalent to <see cref="DecompositionQR"/> for each matrix of the array. </remarks>
+template <class T, int Rows, int Columns>
+struct DecompositionQRArray {
+	static_assert(Rows >= Columns);
+
+	/// <summary> Factors with orthonormal columns. </summary>
+	MatrixArray<T, Rows, Columns> Q;
+	/// <summary> Upper triangular factors. </summary>
+	MatrixArray<T, Columns, Columns> R;
+
+	/// <summary> Solves the linear system of equations A * x = b for each matrix and right-hand side. </summary>
+	/// <remarks> For overdetermined systems, it returns the least squares solution. </remarks>
+	VectorArray<T, Columns> Solve(const VectorArray<T, Rows>& b) const;
+};
+
+
+/// <summary> The thin singular value decompositions of many matrices. </summary>
+/// <remarks> Equivalent to <see cref="DecompositionSVD"/> for each matrix of the array, that is, A = U * S * V.
+///		The singular values are sorted in decreasing order. </remarks>
+template <class T, int Rows, int Columns>
+struct DecompositionSVDArray {
+	static_assert(Rows >= Columns);
+
+	/// <summary> Factors with orthonormal columns. Columns that belong to zero singular values are zero. </summary>
+	MatrixArray<T, Rows, Columns> U;
+	/// <summary> The singular values. </summary>
+	VectorArray<T, Columns> S;
+	/// <summary> Orthonormal factors. </summary>
+	MatrixArray<T, Columns, Columns> V;
+
+	/// <summary> Solves the linear system of equations A * x = b for each matrix and right-hand side. </summary>
+	/// <remarks> For overdetermined systems, it returns the least squares solution. </remarks>
+	VectorArray<T, Columns> Solve(const VectorArray<T, Rows>& b) const;
+};
+
+
+//------------------------------------------------------------------------------
+// Lane utilities
+//------------------------------------------------------------------------------
+
+namespace impl {
+
+	/// <summary> The elements of a vector for as many vectors as a lane block holds. </summary>
+	template <class Block, int Dim>
+	using LaneVector = std::array<typename Block::Block, Dim>;
+
+
+	/// <summary> Loads the vectors starting at <paramref name="index"/>, one vector per SIMD lane. </summary>
+	template <class T, int Dim>
+	auto LoadLaneVector(const VectorArray<T, Dim>& array, size_t index) {
+		using Block = typename VectorArray<T, Dim>::Block;
+		LaneVector<Block, Dim> v;
+		for (int component = 0; component < Dim; ++component) {
+			v[component] = Block::Load(array.Lane(component) + index);
+		}
+		return v;
+	}
+
+
+	/// <summary> Stores the vectors of the SIMD lanes starting at <paramref name="index"/>. </summary>
+	template <class T, int Dim, class LaneVec>
+	void StoreLaneVector(VectorArray<T, Dim>& array, size_t index, const LaneVec& v) {
+		using Block = typename VectorArray<T, Dim>::Block;
+		for (int component = 0; component < Dim; ++component) {
+			Block::Store(array.Lane(component) + index, v[component]);
+		}
+	}
+
+
+	/// <summary> Exchanges <paramref name="a"/> and <paramref name="b"/> in the lanes where the condition holds. </summary>
+	template <class Condition, class B>
+	void SwapWhere(const Condition& condition, B& a, B& b) {
+		const auto newA = select{}(condition, b, a);
+		b = select{}(condition, a, b);
+		a = newA;
+	}
+
+
+	/// <summary> Returns the identity matrix for each lane. </summary>
+	template <class Block, int Dim>
+	auto LaneIdentity() {
+		LaneMatrix<Block, Dim, Dim> m;
+		for (int row = 0; row < Dim; ++row) {
+			for (int column = 0; column < Dim; ++column) {
+				m[row][column] = Block::Broadcast(row == column ? 1 : 0);
+			}
+		}
+		return m;
+	}
+
+} // namespace impl
+
+
+//------------------------------------------------------------------------------
+// LUP
+//------------------------------------------------------------------------------
+
+/// <summary> Calculates the LUP decomposition of each matrix in the array. </summary>
+/// <remarks> The matrices are processed one per SIMD lane. Each lane chooses its
+///		own pivots, the row exchanges are done by blending, not branching. </remarks>
+template <class T, int Dim>
+auto DecomposeLUP(const MatrixArray<T, Dim, Dim>& m) {
+	static_assert(std::is_floating_point_v<T>, "Batched decompositions are only implemented for real numbers.");
+	using Block = typename MatrixArray<T, Dim, Dim>::Block;
+
+	const auto zero = Block::Broadcast(T(0));
+	const auto one = Block::Broadcast(T(1));
+
+	DecompositionLUPArray<T, Dim> result{ MatrixArray<T, Dim, Dim>(m.Size()), MatrixArray<T, Dim, Dim>(m.Size()), VectorArray<T, Dim>(m.Size()) };
+	for (size_t index = 0; index < m.PaddedSize(); index += Block::size) {
+		auto U = impl::LoadLaneMatrix(m, index);
+		auto L = impl::LaneIdentity<Block, Dim>();
+		impl::LaneVector<Block, Dim> P;
+		for (int row = 0; row < Dim; ++row) {
+			P[row] = Block::Broadcast(T(row));
+		}
+
+		for (int col = 0; col < Dim - 1; ++col) {
+			auto pivotAbs = abs{}(U[col][col]);
+			auto pivotRow = Block::Broadcast(T(col));
+			for (int row = col + 1; row < Dim; ++row) {
+				const auto rowAbs = abs{}(U[row][col]);
+				const auto larger = rowAbs > pivotAbs;
+				pivotAbs = select{}(larger, rowAbs, pivotAbs);
+				pivotRow = select{}(larger, Block::Broadcast(T(row)), pivotRow);
+			}
+
+			for (int row = col + 1; row < Dim; ++row) {
+				const auto swap = pivotRow == Block::Broadcast(T(row));
+				for (int k = 0; k < Dim; ++k) {
+					impl::SwapWhere(swap, U[col][k], U[row][k]);
+				}
+				for (int k = 0; k < col; ++k) {
+					impl::SwapWhere(swap, L[col][k], L[row][k]);
+				}
+				impl::SwapWhere(swap, P[col], P[row]);
+			}
+
+			// Lanes with a zero pivot skip the elimination, like the single matrix version.
+			const auto rcpPivot = select{}(pivotAbs != zero, one / U[col][col], zero);
+			for (int row = col + 1; row < Dim; ++row) {
+				const auto scale = U[row][col] * rcpPivot;
+				for (int k = col + 1; k < Dim; ++k) {
+					U[row][k] = madd{}(-scale, U[col][k], U[row][k]);
+				}
+				U[row][col] = zero;
+				L[row][col] = scale;
+			}
+		}
+
+		impl::StoreLaneMatrix(result.L, index, L);
+		impl::StoreLaneMatrix(result.U, index, U);
+		impl::StoreLaneVector(result.P, index, P);
+	}
+	return result;
+}
+
+
+template <class T, int Dim>
+VectorArray<T, Dim> DecompositionLUPArray<T, Dim>::Solve(const VectorArray<T, Dim>& b) const {
+	assert(b.Size() == L.Size());
+	using Block = typename MatrixArray<T, Dim, Dim>::Block;
+
+	VectorArray<T, Dim> result(b.Size());
+	for (size_t index = 0; index < result.PaddedSize(); index += Block::size) {
+		const auto lanesL = impl::LoadLaneMatrix(L, index);
+		const auto lanesU = impl::LoadLaneMatrix(U, index);
+		const auto lanesP = impl::LoadLaneVector(P, index);
+		const auto lanesB = impl::LoadLaneVector(b, index);
+
+		// Forward substitution with the permuted right-hand side.
+		impl::LaneVector<Block, Dim> x;
+		for (int row = 0; row < Dim; ++row) {
+			auto permuted = lanesB[0];
+			for (int source = 1; source < Dim; ++source) {
+				permuted = select{}(lanesP[row] == Block::Broadcast(T(source)), lanesB[source], permuted);
+			}
+			for (int k = 0; k < row; ++k) {
+				permuted = madd{}(-lanesL[row][k], x[k], permuted);
+			}
+			x[row] = permuted;
+		}
+
+		// Backward substitution.
+		for (int row = Dim - 1; row >= 0; --row) {
+			for (int k = row + 1; k < Dim; ++k) {
+				x[row] = madd{}(-lanesU[row][k], x[k], x[row]);
+			}
+			x[row] = x[row] / lanesU[row][row];
+		}
+
+		impl::StoreLaneVector(result, index, x);
+	}
+	return result;
+}
+
+
+//------------------------------------------------------------------------------
+// QR
+//------------------------------------------------------------------------------
+
+/// <summary> Calculates the thin QR decomposition of each matrix in the array. </summary>
+/// <remarks> The matrices are processed one per SIMD lane using Householder reflections.
+///		Only applies to square or tall matrices. </remarks>
+template <class T, int Rows, int Columns>
+auto DecomposeQR(const MatrixArray<T, Rows, Columns>& m) {
+	static_assert(std::is_floating_point_v<T>, "Batched decompositions are only implemented for real numbers.");
+	static_assert(Rows >= Columns);
+	using Block = typename MatrixArray<T, Rows, Columns>::Block;
+
+	const auto zero = Block::Broadcast(T(0));
+	const auto two = Block::Broadcast(T(2));
+
+	DecompositionQRArray<T, Rows, Columns> result{ MatrixArray<T, Rows, Columns>(m.Size()), MatrixArray<T, Columns, Columns>(m.Size()) };
+	for (size_t index = 0; index < m.PaddedSize(); index += Block::size) {
+		auto R = impl::LoadLaneMatrix(m, index);
+		auto QT = impl::LaneIdentity<Block, Rows>();
+
+		for (int col = 0; col < Columns; ++col) {
+			// The reflection I - 2vv^T / (v^T v) maps the column to [..., alpha, 0, ...].
+			auto normSq = R[col][col] * R[col][col];
+			for (int row = col + 1; row < Rows; ++row) {
+				normSq = madd{}(R[row][col], R[row][col], normSq);
+			}
+			const auto norm = sqrt{}(normSq);
+			const auto alpha = select{}(R[col][col] >= zero, -norm, norm);
+			impl::LaneVector<Block, Rows> v;
+			v[col] = R[col][col] - alpha;
+			auto vNormSq = v[col] * v[col];
+			for (int row = col + 1; row < Rows; ++row) {
+				v[row] = R[row][col];
+				vNormSq = madd{}(v[row], v[row], vNormSq);
+			}
+			const auto scale = select{}(vNormSq != zero, two / vNormSq, zero);
+
+			const auto reflect = [&](auto& target, int firstColumn, int lastColumn) {
+				for (int k = firstColumn; k < lastColumn; ++k) {
+					auto dot = v[col] * target[col][k];
+					for (int row = col + 1; row < Rows; ++row) {
+						dot = madd{}(v[row], target[row][k], dot);
+					}
+					const auto weight = dot * scale;
+					for (int row = col; row < Rows; ++row) {
+						target[row][k] = madd{}(-weight, v[row], target[row][k]);
+					}
+				}
+			};
+			reflect(R, col, Columns);
+			reflect(QT, 0, Rows);
+		}
+
+		impl::LaneMatrix<Block, Rows, Columns> Q;
+		impl::LaneMatrix<Block, Columns, Columns> thinR;
+		for (int row = 0; row < Rows; ++row) {
+			for (int col = 0; col < Columns; ++col) {
+				Q[row][col] = QT[col][row];
+			}
+		}
+		for (int row = 0; row < Columns; ++row) {
+			for (int col = 0; col < Columns; ++col) {
+				thinR[row][col] = row <= col ? R[row][col] : zero;
+			}
+		}
+
+		impl::StoreLaneMatrix(result.Q, index, Q);
+		impl::StoreLaneMatrix(result.R, index, thinR);
+	}
+	return result;
+}
+
+
+template <class T, int Rows, int Columns>
+VectorArray<T, Columns> DecompositionQRArray<T, Rows, Columns>::Solve(const VectorArray<T, Rows>& b) const {
+	assert(b.Size() == Q.Size());
+	using Block = typename MatrixArray<T, Rows, Columns>::Block;
+
+	VectorArray<T, Columns> result(b.Size());
+	for (size_t index = 0; index < result.PaddedSize(); index += Block::size) {
+		const auto lanesQ = impl::LoadLaneMatrix(Q, index);
+		const auto lanesR = impl::LoadLaneMatrix(R, index);
+		const auto lanesB = impl::LoadLaneVector(b, index);
+
+		// Solve R * x = Q^T * b.
+		impl::LaneVector<Block, Columns> x;
+		for (int row = 0; row < Columns; ++row) {
+			x[row] = lanesQ[0][row] * lanesB[0];
+			for (int k = 1; k < Rows; ++k) {
+				x[row] = madd{}(lanesQ[k][row], lanesB[k], x[row]);
+			}
+		}
+		for (int row = Columns - 1; row >= 0; --row) {
+			for (int k = row + 1; k < Columns; ++k) {
+				x[row] = madd{}(-lanesR[row][k], x[k], x[row]);
+			}
+			x[row] = x[row] / lanesR[row][row];
+		}
+
+		impl::StoreLaneVector(result, index, x);
+	}
+	return result;
+}
+
+
+//------------------------------------------------------------------------------
+// SVD
+//------------------------------------------------------------------------------
+
+namespace impl {
+
+	/// <summary> Safety limit for the Jacobi sweeps of the batched SVD, they normally converge in far fewer. </summary>
+	constexpr int batchedJacobiSweepLimit = 32;
+
+} // namespace impl
+
+
+/// <summary> Calculates the thin SVD of each matrix in the array. </summary>
+/// <remarks> The matrices are processed one per SIMD lane using the 1-sided Jacobi algorithm.
+///		The sweeps continue until the columns are orthogonal in all lanes, converged lanes
+///		use identity rotations meanwhile. Only applies to square or tall matrices. </remarks>
+template <class T, int Rows, int Columns>
+auto DecomposeSVD(const MatrixArray<T, Rows, Columns>& m) {
+	static_assert(std::is_floating_point_v<T>, "Batched decompositions are only implemented for real numbers.");
+	static_assert(Rows >= Columns);
+	using Block = typename MatrixArray<T, Rows, Columns>::Block;
+
+	const auto zero = Block::Broadcast(T(0));
+	const auto one = Block::Broadcast(T(1));
+	const auto two = Block::Broadcast(T(2));
+	const auto tolerance = Block::Broadcast(std::numeric_limits<T>::epsilon());
+
+	DecompositionSVDArray<T, Rows, Columns> result{ MatrixArray<T, Rows, Columns>(m.Size()), VectorArray<T, Columns>(m.Size()), MatrixArray<T, Columns, Columns>(m.Size()) };
+	for (size_t index = 0; index < m.PaddedSize(); index += Block::size) {
+		auto X = impl::LoadLaneMatrix(m, index);
+		auto W = impl::LaneIdentity<Block, Columns>();
+
+		bool rotated = true;
+		for (int sweep = 0; sweep < impl::batchedJacobiSweepLimit && rotated; ++sweep) {
+			rotated = false;
+			for (int p = 0; p < Columns; ++p) {
+				for (int q = p + 1; q < Columns; ++q) {
+					auto alpha = X[0][p] * X[0][p];
+					auto beta = X[0][q] * X[0][q];
+					auto gamma = X[0][p] * X[0][q];
+					for (int row = 1; row < Rows; ++row) {
+						alpha = madd{}(X[row][p], X[row][p], alpha);
+						beta = madd{}(X[row][q], X[row][q], beta);
+						gamma = madd{}(X[row][p], X[row][q], gamma);
+					}
+					const auto rotate = abs{}(gamma) > tolerance * sqrt{}(alpha * beta);
+					if (!any_true{}(rotate)) {
+						continue;
+					}
+					rotated = true;
+
+					// Minimal angle rotation that makes columns p and q orthogonal.
+					const auto zeta = (beta - alpha) / (two * select{}(rotate, gamma, one));
+					const auto t = select{}(zeta >= zero, one, -one) / (abs{}(zeta) + sqrt{}(madd{}(zeta, zeta, one)));
+					const auto c0 = one / sqrt{}(madd{}(t, t, one));
+					const auto c = select{}(rotate, c0, one);
+					const auto s = select{}(rotate, c0 * t, zero);
+
+					const auto rotateColumns = [&c, &s, p, q](auto& target, int rows) {
+						for (int row = 0; row < rows; ++row) {
+							const auto xp = target[row][p];
+							const auto xq = target[row][q];
+							target[row][p] = c * xp - s * xq;
+							target[row][q] = s * xp + c * xq;
+						}
+					};
+					rotateColumns(X, Rows);
+					rotateColumns(W, Columns);
+				}
+			}
+		}
+
+		// The singular values are the norms of the orthogonal columns.
+		impl::LaneVector<Block, Columns> S;
+		for (int col = 0; col < Columns; ++col) {
+			auto normSq = X[0][col] * X[0][col];
+			for (int row = 1; row < Rows; ++row) {
+				normSq = madd{}(X[row][col], X[row][col], normSq);
+			}
+			S[col] = sqrt{}(normSq);
+		}
+
+		// Exchange sort in each lane, the columns are swapped along with the singular values.
+		for (int i = 0; i < Columns; ++i) {
+			for (int j = i + 1; j < Columns; ++j) {
+				const auto swap = S[j] > S[i];
+				impl::SwapWhere(swap, S[i], S[j]);
+				for (int row = 0; row < Rows; ++row) {
+					impl::SwapWhere(swap, X[row][i], X[row][j]);
+				}
+				for (int row = 0; row < Columns; ++row) {
+					impl::SwapWhere(swap, W[row][i], W[row][j]);
+				}
+			}
+		}
+
+		impl::LaneMatrix<Block, Columns, Columns> V;
+		for (int col = 0; col < Columns; ++col) {
+			const auto rcpS = select{}(S[col] != zero, one / S[col], zero);
+			for (int row = 0; row < Rows; ++row) {
+				X[row][col] = X[row][col] * rcpS;
+			}
+			for (int row = 0; row < Columns; ++row) {
+				V[col][row] = W[row][col];
+			}
+		}
+
+		impl::StoreLaneMatrix(result.U, index, X);
+		impl::StoreLaneVector(result.S, index, S);
+		impl::StoreLaneMatrix(result.V, index, V);
+	}
+	return result;
+}
+
+
+template <class T, int Rows, int Columns>
+VectorArray<T, Columns> DecompositionSVDArray<T, Rows, Columns>::Solve(const VectorArray<T, Rows>& b) const {
+	assert(b.Size() == U.Size());
+	using Block = typename MatrixArray<T, Rows, Columns>::Block;
+
+	VectorArray<T, Columns> result(b.Size());
+	for (size_t index = 0; index < result.PaddedSize(); index += Block::size) {
+		const auto lanesU = impl::LoadLaneMatrix(U, index);
+		const auto lanesS = impl::LoadLaneVector(S, index);
+		const auto lanesV = impl::LoadLaneMatrix(V, index);
+		const auto lanesB = impl::LoadLaneVector(b, index);
+
+		// x = V^T * S^-1 * U^T * b
+		impl::LaneVector<Block, Columns> y;
+		for (int row = 0; row < Columns; ++row) {
+			y[row] = lanesU[0][row] * lanesB[0];
+			for (int k = 1; k < Rows; ++k) {
+				y[row] = madd{}(lanesU[k][row], lanesB[k], y[row]);
+			}
+			y[row] = y[row] / lanesS[row];
+		}
+		impl::LaneVector<Block, Columns> x;
+		for (int row = 0; row < Columns; ++row) {
+			x[row] = lanesV[0][row] * y[0];
+			for (int k = 1; k < Columns; ++k) {
+				x[row] = madd{}(lanesV[k][row], y[k], x[row]);
+			}
+		}
+
+		impl::StoreLaneVector(result, index, x);
+	}
+	return result;
+}
+
+
+} // namespace mathter
@@ -0,0 +1,330 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#pragma once
+
+#include "../Common/Functional.hpp"
+#include "../Common/OptimizationUtil.hpp"
+#include "../Common/TypeTraits.hpp"
+#include "../Common/Types.hpp"
+#include "../Matrix/Algorithm.hpp"
+#include "../Matrix/Arithmetic.hpp"
+#include "../Matrix/Math.hpp"
+#include "../Matrix/Matrix.hpp"
+#include "../Matrix/MatrixDynamic.hpp"
+#include "../Transforms/IdentityBuilder.hpp"
+#include "../Transforms/ZeroBuilder.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+
+
+namespace mathter {
+
+
+/// <summary> The Cholesky decomposition A = L * L^H of a Hermitian positive-definite matrix. </summary>
+template <class T, int Dim, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+struct DecompositionCholesky {
+	using Mat = Matrix<T, Dim, Dim, Order, Layout, Packed>;
+
+	/// <summary> Lower triangular factor with positive real diagonal. </summary>
+	Mat L;
+
+	/// <summary> Solve multiple linear systems of equations at the same time. </summary>
+	template <class T2, int Rows2, int Columns2, eMatrixLayout Layout2, bool Packed2>
+	auto Solve(const Matrix<T2, Rows2, Columns2, Order, Layout2, Packed2>& b) const;
+
+	/// <summary> Solve a linear systems of equations. </summary>
+	template <class T2, bool Packed2>
+	auto Solve(const Vector<T2, Dim, Packed2>& b) const;
+
+	/// <summary> Compute the inverse of the matrix. </summary>
+	auto Inverse() const -> Matrix<T, Dim, Dim, Order, Layout, Packed>;
+};
+
+
+template <class T, int Dim, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+DecompositionCholesky(const Matrix<T, Dim, Dim, Order, Layout, Packed>&) -> DecompositionCholesky<T, Dim, Order, Layout, Packed>;
+
+
+/// <summary> The decomposition A = L * D * L^H of a Hermitian matrix. </summary>
+/// <remarks> Unlike the Cholesky decomposition, this does not need square roots,
+///		and it also works for indefinite matrices as long as no leading minor is singular. </remarks>
+template <class T, int Dim, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+struct DecompositionLDLT {
+	using Mat = Matrix<T, Dim, Dim, Order, Layout, Packed>;
+	using Vec = Vector<T, Dim, Packed>;
+
+	/// <summary> Unit lower triangular factor. </summary>
+	Mat L;
+	/// <summary> The elements of the diagonal factor. </summary>
+	Vec D;
+
+	/// <summary> Solve multiple linear systems of equations at the same time. </summary>
+	template <class T2, int Rows2, int Columns2, eMatrixLayout Layout2, bool Packed2>
+	auto Solve(const Matrix<T2, Rows2, Columns2, Order, Layout2, Packed2>& b) const;
+
+	/// <summary> Solve a linear systems of equations. </summary>
+	template <class T2, bool Packed2>
+	auto Solve(const Vector<T2, Dim, Packed2>& b) const;
+
+	/// <summary> Compute the inverse of the matrix. </summary>
+	auto Inverse() const -> Matrix<T, Dim, Dim, Order, Layout, Packed>;
+};
+
+
+template <class T, int Dim, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+DecompositionLDLT(const Matrix<T, Dim, Dim, Order, Layout, Packed>&,
+				  const Vector<T, Dim, Packed>&) -> DecompositionLDLT<T, Dim, Order, Layout, Packed>;
+
+
+//------------------------------------------------------------------------------
+// Solve
+//------------------------------------------------------------------------------
+
+template <class T, int Dim, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+template <class T2, int Rows2, int Columns2, eMatrixLayout Layout2, bool Packed2>
+auto DecompositionCholesky<T, Dim, Order, Layout, Packed>::Solve(const Matrix<T2, Rows2, Columns2, Order, Layout2, Packed2>& b) const {
+	const auto LH = ConjTranspose(L);
+	if constexpr (Order == eMatrixOrder::PRECEDE_VECTOR) {
+		static_assert(Rows2 == Dim, "Incorrect shape for system of equations right-hand side.");
+		const auto y = SolveLowerTriangular(L, b);
+		return SolveUpperTriangular(LH, y);
+	}
+	else {
+		static_assert(Columns2 == Dim, "Incorrect shape for system of equations right-hand side.");
+		const auto y = SolveUpperTriangular(LH, b);
+		return SolveLowerTriangular(L, y);
+	}
+}
+
+
+template <class T, int Dim, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+template <class T2, bool Packed2>
+auto DecompositionCholesky<T, Dim, Order, Layout, Packed>::Solve(const Vector<T2, Dim, Packed2>& b) const {
+	if constexpr (Dim == DYNAMIC) {
+		return impl::MatrixToVector(Solve(impl::VectorToMatrix<Order, Layout>(b)));
+	}
+	else {
+		using Vec = Vector<T2, Dim, Packed2>;
+		constexpr auto vecMatRows = Order == eMatrixOrder::PRECEDE_VECTOR ? Dim : 1;
+		constexpr auto vecMatCols = Order == eMatrixOrder::PRECEDE_VECTOR ? 1 : Dim;
+		using VecMat = Matrix<T2, vecMatRows, vecMatCols, Order, Layout, Packed2>;
+		return Vec(Solve(VecMat(b)));
+	}
+}
+
+
+template <class T, int Dim, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+auto DecompositionCholesky<T, Dim, Order, Layout, Packed>::Inverse() const -> Matrix<T, Dim, Dim, Order, Layout, Packed> {
+	return Solve(impl::MakeIdentity<Mat>(L.RowCount(), L.ColumnCount()));
+}
+
+
+template <class T, int Dim, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+template <class T2, int Rows2, int Columns2, eMatrixLayout Layout2, bool Packed2>
+auto DecompositionLDLT<T, Dim, Order, Layout, Packed>::Solve(const Matrix<T2, Rows2, Columns2, Order, Layout2, Packed2>& b) const {
+	const auto LH = ConjTranspose(L);
+	if constexpr (Order == eMatrixOrder::PRECEDE_VECTOR) {
+		static_assert(Rows2 == Dim, "Incorrect shape for system of equations right-hand side.");
+		auto y = SolveLowerTriangular(L, b);
+		for (size_t row = 0; row < size_t(D.Dimension()); ++row) {
+			y.Row(row, y.Row(row) / D(row));
+		}
+		return SolveUpperTriangular(LH, y);
+	}
+	else {
+		static_assert(Columns2 == Dim, "Incorrect shape for system of equations right-hand side.");
+		auto y = SolveUpperTriangular(LH, b);
+		for (size_t col = 0; col < size_t(D.Dimension()); ++col) {
+			y.Column(col, y.Column(col) / D(col));
+		}
+		return SolveLowerTriangular(L, y);
+	}
+}
+
+
+template <class T, int Dim, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+template <class T2, bool Packed2>
+auto DecompositionLDLT<T, Dim, Order, Layout, Packed>::Solve(const Vector<T2, Dim, Packed2>& b) const {
+	if constexpr (Dim == DYNAMIC) {
+		return impl::MatrixToVector(Solve(impl::VectorToMatrix<Order, Layout>(b)));
+	}
+	else {
+		using Vec = Vector<T2, Dim, Packed2>;
+		constexpr auto vecMatRows = Order == eMatrixOrder::PRECEDE_VECTOR ? Dim : 1;
+		constexpr auto vecMatCols = Order == eMatrixOrder::PRECEDE_VECTOR ? 1 : Dim;
+		using VecMat = Matrix<T2, vecMatRows, vecMatCols, Order, Layout, Packed2>;
+		return Vec(Solve(VecMat(b)));
+	}
+}
+
+
+template <class T, int Dim, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+auto DecompositionLDLT<T, Dim, Order, Layout, Packed>::Inverse() const -> Matrix<T, Dim, Dim, Order, Layout, Packed> {
+	return Solve(impl::MakeIdentity<Mat>(L.RowCount(), L.ColumnCount()));
+}
+
+
+//------------------------------------------------------------------------------
+// Factorization
+//------------------------------------------------------------------------------
+
+namespace impl {
+
+	/// <summary> Matrices up to this size are factorized by fully unrolled code. </summary>
+	constexpr int symmetricFactorizationUnrollLimit = 6;
+
+
+	/// <summary> Calculates the diagonal element of the factor from the Schur complement.
+	///		This is also the divisor of the elements below the diagonal. </summary>
+	template <bool WithDiagonal, class T>
+	MATHTER_FORCEINLINE T SymmetricFactorizationPivot(const T& complement) {
+		if constexpr (WithDiagonal) {
+			return complement;
+		}
+		else {
+			return static_cast<T>(std::sqrt(std::real(complement)));
+		}
+	}
+
+
+	/// <summary> Factorizes the lower triangle of <paramref name="W"/> in place by fully unrolled loops. </summary>
+	/// <remarks> For Cholesky, the result is L, for LDLT, the strict lower triangle is L and the diagonal is D.
+	///		The upper triangle is left untouched. </remarks>
+	template <bool WithDiagonal, int Dim, class Mat>
+	void FactorizeSymmetricUnrolled(Mat& W) {
+		ForUnrolled<0, Dim, 1, Dim>([&W](ptrdiff_t j) {
+			auto complement = W(j, j);
+			ForUnrolled<0, Dim, 1, Dim>([&](ptrdiff_t k) {
+				if (k < j) {
+					const auto weight = WithDiagonal ? W(k, k) : scalar_type_t<Mat>(1);
+					complement -= W(j, k) * conj{}(W(j, k)) * weight;
+				}
+			});
+			const auto pivot = SymmetricFactorizationPivot<WithDiagonal>(complement);
+			W(j, j) = pivot;
+
+			ForUnrolled<0, Dim, 1, Dim>([&](ptrdiff_t i) {
+				if (i > j) {
+					auto element = W(i, j);
+					ForUnrolled<0, Dim, 1, Dim>([&](ptrdiff_t k) {
+						if (k < j) {
+							const auto weight = WithDiagonal ? W(k, k) : scalar_type_t<Mat>(1);
+							element -= W(i, k) * conj{}(W(j, k)) * weight;
+						}
+					});
+					W(i, j) = element / pivot;
+				}
+			});
+		});
+	}
+
+
+	/// <summary> Factorizes the lower triangle of the row-major <paramref name="W"/> in place. </summary>
+	/// <remarks> Same as the unrolled version, but for larger and dynamically sized matrices.
+	///		The update of each column is expressed as dot products between contiguous rows. </remarks>
+	template <bool WithDiagonal, class T, int Dim, eMatrixOrder Order, bool Packed>
+	void FactorizeSymmetricInPlace(Matrix<T, Dim, Dim, Order, eMatrixLayout::ROW_MAJOR, Packed>& W) {
+		using Mat = Matrix<T, Dim, Dim, Order, eMatrixLayout::ROW_MAJOR, Packed>;
+
+		const size_t dim = W.RowCount();
+		auto weightedRow = MakeZero<Vector<T, Dim, Packed>>(dim);
+
+		const auto rowDot = [&W, &weightedRow](size_t i, size_t count) {
+			if constexpr (is_dynamic_v<Mat> && !is_complex_v<T>) {
+				return DotElements(W.StripeData(i), weightedRow.data(), count);
+			}
+			else {
+				T sum = static_cast<T>(0);
+				for (size_t k = 0; k < count; ++k) {
+					sum += W(i, k) * weightedRow[k];
+				}
+				return sum;
+			}
+		};
+
+		for (size_t j = 0; j < dim; ++j) {
+			for (size_t k = 0; k < j; ++k) {
+				weightedRow[k] = conj{}(W(j, k));
+				if constexpr (WithDiagonal) {
+					weightedRow[k] *= W(k, k);
+				}
+			}
+
+			const auto pivot = SymmetricFactorizationPivot<WithDiagonal>(W(j, j) - rowDot(j, j));
+			W(j, j) = pivot;
+			for (size_t i = j + 1; i < dim; ++i) {
+				W(i, j) = (W(i, j) - rowDot(i, j)) / pivot;
+			}
+		}
+	}
+
+
+	template <bool WithDiagonal, class T, int Dim, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+	auto FactorizeSymmetric(const Matrix<T, Dim, Dim, Order, Layout, Packed>& m) {
+		assert(m.RowCount() == m.ColumnCount());
+		using MatWorking = Matrix<T, Dim, Dim, Order, eMatrixLayout::ROW_MAJOR, Packed>;
+
+		MatWorking W = m;
+		if constexpr (Dim != DYNAMIC && Dim <= symmetricFactorizationUnrollLimit) {
+			FactorizeSymmetricUnrolled<WithDiagonal, Dim>(W);
+		}
+		else {
+			FactorizeSymmetricInPlace<WithDiagonal>(W);
+		}
+		return W;
+	}
+
+} // namespace impl
+
+
+/// <summary> Calculates the Cholesky decomposition of a Hermitian positive-definite matrix. </summary>
+/// <remarks> Only the lower triangle of <paramref name="m"/> is read, the upper triangle is assumed to be its conjugate.
+///		If the matrix is not positive-definite, the factor contains NaNs.
+///		Matrices up to 6x6 are factorized by fully unrolled code. </remarks>
+template <class T, int Dim, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+auto DecomposeCholesky(const Matrix<T, Dim, Dim, Order, Layout, Packed>& m) {
+	using Mat = Matrix<T, Dim, Dim, Order, Layout, Packed>;
+
+	const auto W = impl::FactorizeSymmetric<false>(m);
+	const size_t dim = W.RowCount();
+
+	Mat L = impl::MakeZero<Mat>(dim, dim);
+	for (size_t i = 0; i < dim; ++i) {
+		for (size_t j = 0; j <= i; ++j) {
+			L(i, j) = W(i, j);
+		}
+	}
+	return DecompositionCholesky{ L };
+}
+
+
+/// <summary> Calculates the L * D * L^H decomposition of a Hermitian matrix. </summary>
+/// <remarks> Only the lower triangle of <paramref name="m"/> is read, the upper triangle is assumed to be its conjugate.
+///		No pivoting is performed, so all leading principal minors of the matrix must be non-singular.
+///		Matrices up to 6x6 are factorized by fully unrolled code. </remarks>
+template <class T, int Dim, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+auto DecomposeLDLT(const Matrix<T, Dim, Dim, Order, Layout, Packed>& m) {
+	using Mat = Matrix<T, Dim, Dim, Order, Layout, Packed>;
+	using Vec = Vector<T, Dim, Packed>;
+
+	const auto W = impl::FactorizeSymmetric<true>(m);
+	const size_t dim = W.RowCount();
+
+	Mat L = impl::MakeIdentity<Mat>(dim, dim);
+	Vec D = impl::MakeZero<Vec>(dim);
+	for (size_t i = 0; i < dim; ++i) {
+		for (size_t j = 0; j < i; ++j) {
+			L(i, j) = W(i, j);
+		}
+		D(i) = W(i, i);
+	}
+	return DecompositionLDLT{ L, D };
+}
+
+} // namespace mathter
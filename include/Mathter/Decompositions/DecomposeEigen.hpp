@@ -0,0 +1,346 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#pragma once
+
+#include "../Common/Functional.hpp"
+#include "../Common/TypeTraits.hpp"
+#include "../Matrix/Arithmetic.hpp"
+#include "../Matrix/Math.hpp"
+#include "../Matrix/Matrix.hpp"
+#include "../Matrix/MatrixDynamic.hpp"
+#include "../Transforms/IdentityBuilder.hpp"
+#include "../Vector/Math.hpp"
+#include "DecomposeSVD.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+
+
+namespace mathter {
+
+
+/// <summary> The eigendecomposition A = V * diag(D) * V^H of a Hermitian (symmetric) matrix. </summary>
+/// <remarks> The eigenvalues are sorted in decreasing order, and the columns of V
+///		are the corresponding orthonormal eigenvectors. </remarks>
+template <class T, int Dim, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+struct DecompositionEigenHermitian {
+	using Real = remove_complex_t<T>;
+	using Mat = Matrix<T, Dim, Dim, Order, Layout, Packed>;
+	using Vec = Vector<Real, Dim, Packed>;
+
+	/// <summary> Unitary matrix with the eigenvectors in its columns. </summary>
+	Mat V;
+	/// <summary> The eigenvalues, which are always real. </summary>
+	Vec D;
+
+	/// <summary> Solve multiple linear systems of equations at the same time. </summary>
+	template <class T2, int Rows2, int Columns2, eMatrixLayout Layout2, bool Packed2>
+	auto Solve(const Matrix<T2, Rows2, Columns2, Order, Layout2, Packed2>& b) const;
+
+	/// <summary> Solve a linear systems of equations. </summary>
+	template <class T2, bool Packed2>
+	auto Solve(const Vector<T2, Dim, Packed2>& b) const;
+
+	/// <summary> Compute the inverse of the matrix. </summary>
+	auto Inverse() const -> Matrix<T, Dim, Dim, Order, Layout, Packed>;
+};
+
+
+template <class T, int Dim, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+DecompositionEigenHermitian(const Matrix<T, Dim, Dim, Order, Layout, Packed>&,
+							const Vector<remove_complex_t<T>, Dim, Packed>&) -> DecompositionEigenHermitian<T, Dim, Order, Layout, Packed>;
+
+
+//------------------------------------------------------------------------------
+// Solve
+//------------------------------------------------------------------------------
+
+template <class T, int Dim, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+template <class T2, int Rows2, int Columns2, eMatrixLayout Layout2, bool Packed2>
+auto DecompositionEigenHermitian<T, Dim, Order, Layout, Packed>::Solve(const Matrix<T2, Rows2, Columns2, Order, Layout2, Packed2>& b) const {
+	const auto VH = ConjTranspose(V);
+	if constexpr (Order == eMatrixOrder::PRECEDE_VECTOR) {
+		static_assert(Rows2 == Dim, "Incorrect shape for system of equations right-hand side.");
+		auto y = VH * b;
+		for (size_t row = 0; row < size_t(D.Dimension()); ++row) {
+			y.Row(row, y.Row(row) / D(row));
+		}
+		return V * y;
+	}
+	else {
+		static_assert(Columns2 == Dim, "Incorrect shape for system of equations right-hand side.");
+		auto y = b * V;
+		for (size_t col = 0; col < size_t(D.Dimension()); ++col) {
+			y.Column(col, y.Column(col) / D(col));
+		}
+		return y * VH;
+	}
+}
+
+
+template <class T, int Dim, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+template <class T2, bool Packed2>
+auto DecompositionEigenHermitian<T, Dim, Order, Layout, Packed>::Solve(const Vector<T2, Dim, Packed2>& b) const {
+	if constexpr (Dim == DYNAMIC) {
+		return impl::MatrixToVector(Solve(impl::VectorToMatrix<Order, Layout>(b)));
+	}
+	else {
+		using Vec = Vector<T2, Dim, Packed2>;
+		constexpr auto vecMatRows = Order == eMatrixOrder::PRECEDE_VECTOR ? Dim : 1;
+		constexpr auto vecMatCols = Order == eMatrixOrder::PRECEDE_VECTOR ? 1 : Dim;
+		using VecMat = Matrix<T2, vecMatRows, vecMatCols, Order, Layout, Packed2>;
+		return Vec(Solve(VecMat(b)));
+	}
+}
+
+
+template <class T, int Dim, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+auto DecompositionEigenHermitian<T, Dim, Order, Layout, Packed>::Inverse() const -> Matrix<T, Dim, Dim, Order, Layout, Packed> {
+	return Solve(impl::MakeIdentity<Mat>(V.RowCount(), V.ColumnCount()));
+}
+
+
+//------------------------------------------------------------------------------
+// Decomposition
+//------------------------------------------------------------------------------
+
+namespace impl {
+
+	/// <summary> Sorts the eigenvalues in decreasing order, and permutes the eigenvectors to match. </summary>
+	/// <remarks> Selection sort: it makes the fewest column swaps, and the matrices are small anyway. </remarks>
+	template <class Vec, class Mat>
+	void SortEigenpairs(Vec& D, Mat& V) {
+		const size_t dim = D.Dimension();
+		for (size_t i = 0; i < dim; ++i) {
+			size_t largest = i;
+			for (size_t j = i + 1; j < dim; ++j) {
+				largest = D(j) > D(largest) ? j : largest;
+			}
+			if (largest != i) {
+				std::swap(D(i), D(largest));
+				const auto column = V.Column(i);
+				V.Column(i, V.Column(largest));
+				V.Column(largest, column);
+			}
+		}
+	}
+
+
+	/// <summary> Diagonalizes a Hermitian matrix by the cyclic Jacobi eigenvalue algorithm. </summary>
+	/// <remarks> Each step annihilates one off-diagonal pair using the same minimal angle rotation
+	///		as the 1-sided Jacobi SVD, but applies it directly to A instead of A^H * A. This does about half
+	///		the work of the SVD, and the eigenvalues of small magnitude are computed to high relative accuracy. </remarks>
+	template <class T, int Dim, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+	auto DecomposeEigenHermitianJacobi(const Matrix<T, Dim, Dim, Order, Layout, Packed>& A) {
+		assert(A.RowCount() == A.ColumnCount());
+
+		using Real = remove_complex_t<T>;
+		using Mat = Matrix<T, Dim, Dim, Order, Layout, Packed>;
+		using MatWorkingV = Matrix<T, Dim, Dim, Order, eMatrixLayout::COLUMN_MAJOR, Packed>;
+		constexpr auto tolerance = Real(1e-1f) * std::numeric_limits<Real>::epsilon();
+
+		const size_t dim = A.RowCount();
+
+		// Only the lower triangle is read, the upper is mirrored from it.
+		const auto scaler = ScaleElements(A);
+		Mat X = A / (scaler != Real(0) ? scaler : Real(1));
+		for (size_t row = 0; row < dim; ++row) {
+			X(row, row) = std::real(X(row, row));
+			for (size_t col = row + 1; col < dim; ++col) {
+				X(row, col) = conj{}(X(col, row));
+			}
+		}
+		auto V = MakeIdentity<MatWorkingV>(dim, dim);
+
+		auto maxErrorPrev = std::numeric_limits<Real>::max();
+		auto maxError = std::nextafter(maxErrorPrev, Real(0));
+		while (maxError < maxErrorPrev) {
+			maxErrorPrev = maxError;
+			maxError = Real(0);
+			for (int p = 0; p < int(dim); ++p) {
+				for (int q = p + 1; q < int(dim); ++q) {
+					const auto xpq = X(p, q);
+					const auto error = std::abs(xpq);
+					if (error > tolerance) {
+						maxError = std::max(maxError, error);
+						const auto [cv0, sv0] = DiagonalizeHermitian2x2(std::real(X(p, p)), xpq, std::real(X(q, q)));
+						const auto [cv, sv] = MinimizeDiagonalizingRotation(cv0, sv0);
+
+						GivensRotateRight(X, p, q, cv, sv);
+						GivensRotateLeft(X, p, q, cv, -sv);
+						GivensRotateRight(V, p, q, cv, sv);
+					}
+				}
+			}
+		}
+
+		auto D = MakeZero<Vector<Real, Dim, Packed>>(dim);
+		for (size_t i = 0; i < dim; ++i) {
+			D(i) = std::real(X(i, i)) * scaler;
+		}
+		SortEigenpairs(D, V);
+
+		return DecompositionEigenHermitian{ Mat(V), D };
+	}
+
+
+	/// <summary> Multiplies the vector by the 3x3 symmetric matrix given by its packed lower triangle. </summary>
+	template <class Real>
+	Vector<Real, 3, false> MultiplySymmetric3x3(const std::array<Real, 6>& a, const Vector<Real, 3, false>& v) {
+		return {
+			a[0] * v[0] + a[1] * v[1] + a[2] * v[2],
+			a[1] * v[0] + a[3] * v[1] + a[4] * v[2],
+			a[2] * v[0] + a[4] * v[1] + a[5] * v[2],
+		};
+	}
+
+
+	/// <summary> Returns the unit eigenvector of the 3x3 symmetric matrix A for the eigenvalue. </summary>
+	/// <remarks> The eigenvalue must be simple. The rows of A - eigenvalue * I span the orthogonal complement
+	///		of the eigenvector, so the longest cross product of two rows gives the most accurate direction. </remarks>
+	template <class Real>
+	Vector<Real, 3, false> EigenvectorSymmetric3x3(const std::array<Real, 6>& a, Real eigenvalue) {
+		using Vec = Vector<Real, 3, false>;
+
+		const Vec row0 = { a[0] - eigenvalue, a[1], a[2] };
+		const Vec row1 = { a[1], a[3] - eigenvalue, a[4] };
+		const Vec row2 = { a[2], a[4], a[5] - eigenvalue };
+		const std::array<Vec, 3> candidates = { Cross(row0, row1), Cross(row0, row2), Cross(row1, row2) };
+		const std::array<Real, 3> lengthsSq = { Dot(candidates[0], candidates[0]),
+												Dot(candidates[1], candidates[1]),
+												Dot(candidates[2], candidates[2]) };
+		const auto longest = size_t(std::max_element(lengthsSq.begin(), lengthsSq.end()) - lengthsSq.begin());
+		return candidates[longest] / std::sqrt(lengthsSq[longest]);
+	}
+
+
+	/// <summary> Returns the unit eigenvector of the 3x3 symmetric matrix A for the eigenvalue
+	///		that is perpendicular to an already known eigenvector. </summary>
+	/// <remarks> The eigenvalue may be repeated. The problem is restricted to the plane perpendicular to the
+	///		known eigenvector, where it reduces to finding the null vector of a 2x2 symmetric matrix. </remarks>
+	template <class Real>
+	Vector<Real, 3, false> EigenvectorSymmetric3x3(const std::array<Real, 6>& a, Real eigenvalue, const Vector<Real, 3, false>& known) {
+		using Vec = Vector<Real, 3, false>;
+
+		// Orthonormal basis {u, v} of the plane perpendicular to the known eigenvector.
+		const auto u = std::abs(known[0]) > std::abs(known[1])
+						   ? Vec{ -known[2], Real(0), known[0] } / std::hypot(known[0], known[2])
+						   : Vec{ Real(0), known[2], -known[1] } / std::hypot(known[1], known[2]);
+		const auto v = Cross(known, u);
+
+		const auto Au = MultiplySymmetric3x3(a, u);
+		const auto Av = MultiplySymmetric3x3(a, v);
+		const auto m00 = Dot(u, Au) - eigenvalue;
+		const auto m01 = Dot(u, Av);
+		const auto m11 = Dot(v, Av) - eigenvalue;
+
+		// The null vector (c, s) of [m00, m01; m01, m11] is perpendicular to the larger row.
+		const bool useFirstRow = std::abs(m00) >= std::abs(m11);
+		const auto diagonal = useFirstRow ? m00 : m11;
+		const auto norm = std::hypot(diagonal, m01);
+		if (norm == Real(0)) {
+			return u;
+		}
+		const auto [c, s] = useFirstRow ? std::tuple(m01 / norm, -m00 / norm) : std::tuple(m11 / norm, -m01 / norm);
+		return c * u + s * v;
+	}
+
+
+	/// <summary> Computes the eigendecomposition of a real symmetric 3x3 matrix by closed form formulas. </summary>
+	/// <remarks> The eigenvalues are the roots of the characteristic polynomial, computed by the trigonometric
+	///		solution of the depressed cubic. The eigenvector of the most separated eigenvalue is computed first
+	///		so that the remaining ones are still accurate when the other two eigenvalues are close.
+	///		This is much faster than the iterative algorithm, but the accuracy is relative to the largest
+	///		eigenvalue instead of each eigenvalue. </remarks>
+	template <class T, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+	auto DecomposeEigenHermitianAnalytic(const Matrix<T, 3, 3, Order, Layout, Packed>& A) {
+		static_assert(!is_complex_v<T>, "The closed form solution is only for real matrices.");
+
+		using Mat = Matrix<T, 3, 3, Order, Layout, Packed>;
+		using Vec = Vector<T, 3, false>;
+		constexpr auto pi = T(3.1415926535897932384626433832795L);
+
+		// Lower triangle, packed as a00, a10, a20, a11, a21, a22.
+		const std::array<T, 6> unscaled = { A(0, 0), A(1, 0), A(2, 0), A(1, 1), A(2, 1), A(2, 2) };
+		const auto scaler = ScaleElements(A);
+		if (scaler == T(0)) {
+			return DecompositionEigenHermitian{ Mat(Identity()), Vector<T, 3, Packed>(T(0)) };
+		}
+		std::array<T, 6> a;
+		std::transform(unscaled.begin(), unscaled.end(), a.begin(), [scaler](T element) { return element / scaler; });
+
+		const auto offDiagonalSq = a[1] * a[1] + a[2] * a[2] + a[4] * a[4];
+		if (offDiagonalSq == T(0)) {
+			Mat V = Identity();
+			Vector<T, 3, Packed> D = { a[0], a[3], a[5] };
+			SortEigenpairs(D, V);
+			return DecompositionEigenHermitian{ V, D * scaler };
+		}
+
+		// Eigenvalues of B = (A - q * I) / p, whose characteristic polynomial is x^3 - 3x - det(B) = 0.
+		const auto q = (a[0] + a[3] + a[5]) / T(3);
+		const auto b00 = a[0] - q;
+		const auto b11 = a[3] - q;
+		const auto b22 = a[5] - q;
+		const auto p = std::sqrt((b00 * b00 + b11 * b11 + b22 * b22 + T(2) * offDiagonalSq) / T(6));
+		const auto c00 = b11 * b22 - a[4] * a[4];
+		const auto c01 = a[1] * b22 - a[4] * a[2];
+		const auto c02 = a[1] * a[4] - b11 * a[2];
+		const auto halfDet = std::clamp((b00 * c00 - a[1] * c01 + a[2] * c02) / (T(2) * p * p * p), T(-1), T(1));
+		const auto angle = std::acos(halfDet) / T(3);
+		const auto beta0 = T(2) * std::cos(angle);
+		const auto beta2 = T(2) * std::cos(angle + T(2) * pi / T(3));
+		const auto beta1 = -(beta0 + beta2);
+		const std::array<T, 3> eigenvalues = { q + p * beta0, q + p * beta1, q + p * beta2 };
+
+		// halfDet >= 0 means the largest eigenvalue is the most separated one.
+		std::array<Vec, 3> eigenvectors;
+		if (halfDet >= T(0)) {
+			eigenvectors[0] = EigenvectorSymmetric3x3(a, eigenvalues[0]);
+			eigenvectors[1] = EigenvectorSymmetric3x3(a, eigenvalues[1], eigenvectors[0]);
+			eigenvectors[2] = Cross(eigenvectors[0], eigenvectors[1]);
+		}
+		else {
+			eigenvectors[2] = EigenvectorSymmetric3x3(a, eigenvalues[2]);
+			eigenvectors[1] = EigenvectorSymmetric3x3(a, eigenvalues[1], eigenvectors[2]);
+			eigenvectors[0] = Cross(eigenvectors[1], eigenvectors[2]);
+		}
+
+		// The roots of the cubic lose half the digits for repeated eigenvalues, but the
+		// eigenvectors are still accurate, so the Rayleigh quotients give better eigenvalues.
+		Mat V;
+		Vector<T, 3, Packed> D;
+		for (size_t i = 0; i < 3; ++i) {
+			V.Column(i, Vector<T, 3, Packed>(eigenvectors[i]));
+			D(i) = Dot(eigenvectors[i], MultiplySymmetric3x3(a, eigenvectors[i])) * scaler;
+		}
+		SortEigenpairs(D, V);
+		return DecompositionEigenHermitian{ V, D };
+	}
+
+} // namespace impl
+
+
+/// <summary> Calculates the eigendecomposition of a Hermitian (or real symmetric) matrix. </summary>
+/// <remarks> Only the lower triangle of the matrix is read.
+///		Real 3x3 matrices, such as covariance matrices of point clouds, use a closed form solution,
+///		the rest use the cyclic Jacobi eigenvalue algorithm. </remarks>
+template <class T, int Dim, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+auto DecomposeEigenHermitian(const Matrix<T, Dim, Dim, Order, Layout, Packed>& m) {
+	if constexpr (Dim == 3 && !is_complex_v<T>) {
+		return impl::DecomposeEigenHermitianAnalytic(m);
+	}
+	else {
+		return impl::DecomposeEigenHermitianJacobi(m);
+	}
+}
+
+} // namespace mathter
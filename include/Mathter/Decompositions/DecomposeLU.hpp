@@ -5,12 +5,18 @@
 
 #pragma once
 
+#include "../Common/Functional.hpp"
 #include "../Common/Types.hpp"
 #include "../Matrix/Algorithm.hpp"
 #include "../Matrix/Matrix.hpp"
+#include "../Matrix/MatrixDynamic.hpp"
 #include "../Transforms/IdentityBuilder.hpp"
 #include "../Transforms/ZeroBuilder.hpp"
+#include "../Vector/SIMDUtil.hpp"
 
+#include <algorithm>
+#include <cassert>
+#include <cmath>
 #include <numeric>
 
 
@@ -64,17 +70,22 @@ auto DecompositionLU<T, Dim, Order, Layout, Packed>::Solve(const Matrix<T2, Rows
 template <class T, int Dim, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
 template <class T2, bool Packed2>
 auto DecompositionLU<T, Dim, Order, Layout, Packed>::Solve(const Vector<T2, Dim, Packed2>& b) const {
-	using Vec = Vector<T2, Dim, Packed2>;
-	constexpr auto vecMatRows = Order == eMatrixOrder::PRECEDE_VECTOR ? Dim : 1;
-	constexpr auto vecMatCols = Order == eMatrixOrder::PRECEDE_VECTOR ? 1 : Dim;
-	using VecMat = Matrix<T2, vecMatRows, vecMatCols, Order, Layout, Packed2>;
-	return Vec(Solve(VecMat(b)));
+	if constexpr (Dim == DYNAMIC) {
+		return impl::MatrixToVector(Solve(impl::VectorToMatrix<Order, Layout>(b)));
+	}
+	else {
+		using Vec = Vector<T2, Dim, Packed2>;
+		constexpr auto vecMatRows = Order == eMatrixOrder::PRECEDE_VECTOR ? Dim : 1;
+		constexpr auto vecMatCols = Order == eMatrixOrder::PRECEDE_VECTOR ? 1 : Dim;
+		using VecMat = Matrix<T2, vecMatRows, vecMatCols, Order, Layout, Packed2>;
+		return Vec(Solve(VecMat(b)));
+	}
 }
 
 
 template <class T, int Dim, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
 auto mathter::DecompositionLU<T, Dim, Order, Layout, Packed>::Inverse() const -> Matrix<T, Dim, Dim, Order, Layout, Packed> {
-	return Solve(Mat(Identity()));
+	return Solve(impl::MakeIdentity<Mat>(L.RowCount(), L.ColumnCount()));
 }
 
 
@@ -137,17 +148,22 @@ auto DecompositionLUP<T, Dim, Order, Layout, Packed>::Solve(const Matrix<T2, Row
 template <class T, int Dim, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
 template <class T2, bool Packed2>
 auto mathter::DecompositionLUP<T, Dim, Order, Layout, Packed>::Solve(const Vector<T2, Dim, Packed2>& b) const {
-	using Vec = Vector<T2, Dim, Packed2>;
-	constexpr auto vecMatRows = Order == eMatrixOrder::PRECEDE_VECTOR ? Dim : 1;
-	constexpr auto vecMatCols = Order == eMatrixOrder::PRECEDE_VECTOR ? 1 : Dim;
-	using VecMat = Matrix<T2, vecMatRows, vecMatCols, Order, Layout, Packed2>;
-	return Vec(Solve(VecMat(b)));
+	if constexpr (Dim == DYNAMIC) {
+		return impl::MatrixToVector(Solve(impl::VectorToMatrix<Order, Layout>(b)));
+	}
+	else {
+		using Vec = Vector<T2, Dim, Packed2>;
+		constexpr auto vecMatRows = Order == eMatrixOrder::PRECEDE_VECTOR ? Dim : 1;
+		constexpr auto vecMatCols = Order == eMatrixOrder::PRECEDE_VECTOR ? 1 : Dim;
+		using VecMat = Matrix<T2, vecMatRows, vecMatCols, Order, Layout, Packed2>;
+		return Vec(Solve(VecMat(b)));
+	}
 }
 
 
 template <class T, int Dim, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
 auto mathter::DecompositionLUP<T, Dim, Order, Layout, Packed>::Inverse() const -> Matrix<T, Dim, Dim, Order, Layout, Packed> {
-	return Solve(Mat(Identity()));
+	return Solve(impl::MakeIdentity<Mat>(L.RowCount(), L.ColumnCount()));
 }
 
 
@@ -159,8 +175,8 @@ auto DecompositionLUP<T, Dim, Order, Layout, Packed>::ExpandPermutation() const
 
 template <class T, int Dim, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
 auto DecompositionLUP<T, Dim, Order, Layout, Packed>::ExpandPermutation(Perm P) -> Mat {
-	Mat PM = Zero();
-	for (size_t i = 0; i < Dim; ++i) {
+	Mat PM = impl::MakeZero<Mat>(P.Dimension(), P.Dimension());
+	for (size_t i = 0; i < size_t(P.Dimension()); ++i) {
 		PM(i, P[i]) = static_cast<T>(1);
 	}
 	return PM;
@@ -170,8 +186,8 @@ auto DecompositionLUP<T, Dim, Order, Layout, Packed>::ExpandPermutation(Perm P)
 template <class T, int Dim, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
 template <class T2, int Rows2, int Columns2, eMatrixLayout Layout2, bool Packed2>
 auto DecompositionLUP<T, Dim, Order, Layout, Packed>::InversePermute(const Matrix<T2, Rows2, Columns2, Order, Layout2, Packed2>& b) const {
-	std::decay_t<decltype(b)> PinvB;
-	for (size_t i = 0; i < Dim; ++i) {
+	auto PinvB = b;
+	for (size_t i = 0; i < size_t(P.Dimension()); ++i) {
 		if constexpr (Order == eMatrixOrder::PRECEDE_VECTOR) {
 			static_assert(Rows2 == Dim, "Incorrect shape for matrix to permute.");
 			PinvB.Row(P[i], b.Row(i));
@@ -188,8 +204,8 @@ auto DecompositionLUP<T, Dim, Order, Layout, Packed>::InversePermute(const Matri
 template <class T, int Dim, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
 template <class T2, int Rows2, int Columns2, eMatrixLayout Layout2, bool Packed2>
 auto DecompositionLUP<T, Dim, Order, Layout, Packed>::Permute(const Matrix<T2, Rows2, Columns2, Order, Layout2, Packed2>& b) const {
-	std::decay_t<decltype(b)> PinvB;
-	for (size_t i = 0; i < Dim; ++i) {
+	auto PinvB = b;
+	for (size_t i = 0; i < size_t(P.Dimension()); ++i) {
 		if constexpr (Order == eMatrixOrder::PRECEDE_VECTOR) {
 			static_assert(Rows2 == Dim, "Incorrect shape for matrix to permute.");
 			PinvB.Row(i, b.Row(P[i]));
@@ -203,6 +219,207 @@ auto DecompositionLUP<T, Dim, Order, Layout, Packed>::Permute(const Matrix<T2, R
 }
 
 
+/// <summary> The LUP decomposition of a matrix, with L and U packed into a single matrix. </summary>
+/// <remarks> L is stored below the diagonal with an implicit unit diagonal, and U is stored on and above the diagonal.
+///		The permutation is stored as the sequence of row swaps made during pivoting, the same way as LAPACK does:
+///		row k was swapped with row pivots[k] at step k. This takes half the memory of <see cref="DecompositionLUP"/>,
+///		and the substitutions of Solve read the packed matrix directly. </remarks>
+template <class T, int Dim, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+struct DecompositionLUPCompact {
+	static_assert(Dim != DYNAMIC, "Use DecomposeLUP for dynamically sized matrices.");
+
+	using Mat = Matrix<T, Dim, Dim, Order, Layout, Packed>;
+	using MatLU = Matrix<T, Dim, Dim, Order, eMatrixLayout::ROW_MAJOR, Packed>;
+	using Pivots = Vector<uint32_t, Dim, Packed>;
+
+	/// <summary> L below the diagonal, U on and above the diagonal. </summary>
+	MatLU LU;
+	/// <summary> The row that was swapped with row k at step k of the elimination. </summary>
+	Pivots pivots;
+
+	/// <summary> Solve multiple linear systems of equations at the same time. </summary>
+	template <class T2, int Rows2, int Columns2, eMatrixLayout Layout2, bool Packed2>
+	auto Solve(const Matrix<T2, Rows2, Columns2, Order, Layout2, Packed2>& b) const;
+
+	/// <summary> Solve a linear systems of equations. </summary>
+	template <class T2, bool Packed2>
+	auto Solve(const Vector<T2, Dim, Packed2>& b) const;
+
+	/// <summary> Compute the inverse or the pseudoinverse of the matrix. </summary>
+	auto Inverse() const -> Matrix<T, Dim, Dim, Order, Layout, Packed>;
+
+	/// <summary> Returns the unit lower triangular factor L. </summary>
+	Mat ExtractL() const;
+
+	/// <summary> Returns the upper triangular factor U. </summary>
+	Mat ExtractU() const;
+
+	/// <summary> Converts the row swaps into a permutation vector, as in <see cref="DecompositionLUP"/>. </summary>
+	auto Permutation() const -> Vector<uint32_t, Dim, Packed>;
+
+	/// <summary> Expand the permutation to an orthonormal matrix P such that P*A = L*U. </summary>
+	Mat ExpandPermutation() const;
+};
+
+
+template <class T, int Dim, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+template <class T2, int Rows2, int Columns2, eMatrixLayout Layout2, bool Packed2>
+auto DecompositionLUPCompact<T, Dim, Order, Layout, Packed>::Solve(const Matrix<T2, Rows2, Columns2, Order, Layout2, Packed2>& b) const {
+	using TR = common_arithmetic_type_t<T, T2>;
+	const auto& lu = LU.stripes;
+
+	if constexpr (Order == eMatrixOrder::PRECEDE_VECTOR) {
+		// L*U*x = P*b, processing whole rows of the right-hand side.
+		static_assert(Rows2 == Dim, "Incorrect shape for system of equations right-hand side.");
+		Matrix<TR, Dim, Columns2, Order, eMatrixLayout::ROW_MAJOR, Packed2> x(b);
+		auto& rows = x.stripes;
+
+		for (int k = 0; k < Dim; ++k) {
+			if (pivots[k] != uint32_t(k)) {
+				std::swap(rows[k], rows[pivots[k]]);
+			}
+		}
+		for (int i = 1; i < Dim; ++i) {
+			for (int k = 0; k < i; ++k) {
+				rows[i] -= static_cast<TR>(lu[i][k]) * rows[k];
+			}
+		}
+		for (int i = Dim - 1; i >= 0; --i) {
+			for (int k = i + 1; k < Dim; ++k) {
+				rows[i] -= static_cast<TR>(lu[i][k]) * rows[k];
+			}
+			rows[i] /= static_cast<TR>(lu[i][i]);
+		}
+		return Matrix<TR, Rows2, Columns2, Order, Layout2, Packed2>(x);
+	}
+	else {
+		// x*P^-1*L*U = b, processing whole columns of the right-hand side.
+		// Going through the rows of U and L in order keeps reading the packed matrix contiguously.
+		static_assert(Columns2 == Dim, "Incorrect shape for system of equations right-hand side.");
+		Matrix<TR, Rows2, Dim, Order, eMatrixLayout::COLUMN_MAJOR, Packed2> x(b);
+		auto& columns = x.stripes;
+
+		for (int i = 0; i < Dim; ++i) {
+			columns[i] /= static_cast<TR>(lu[i][i]);
+			for (int k = i + 1; k < Dim; ++k) {
+				columns[k] -= static_cast<TR>(lu[i][k]) * columns[i];
+			}
+		}
+		for (int i = Dim - 1; i >= 1; --i) {
+			for (int k = 0; k < i; ++k) {
+				columns[k] -= static_cast<TR>(lu[i][k]) * columns[i];
+			}
+		}
+		for (int k = Dim - 1; k >= 0; --k) {
+			if (pivots[k] != uint32_t(k)) {
+				std::swap(columns[k], columns[pivots[k]]);
+			}
+		}
+		return Matrix<TR, Rows2, Columns2, Order, Layout2, Packed2>(x);
+	}
+}
+
+
+template <class T, int Dim, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+template <class T2, bool Packed2>
+auto DecompositionLUPCompact<T, Dim, Order, Layout, Packed>::Solve(const Vector<T2, Dim, Packed2>& b) const {
+	using TR = common_arithmetic_type_t<T, T2>;
+	const auto& lu = LU.stripes;
+	Vector<TR, Dim, Packed2> x(b);
+
+	// Same as the matrix version, but the substitutions accumulate in scalars instead of one-element stripes.
+	if constexpr (Order == eMatrixOrder::PRECEDE_VECTOR) {
+		for (int k = 0; k < Dim; ++k) {
+			std::swap(x[k], x[pivots[k]]);
+		}
+		for (int i = 1; i < Dim; ++i) {
+			const T* const row = lu[i].data();
+			TR sum = x[i];
+			for (int k = 0; k < i; ++k) {
+				sum -= static_cast<TR>(row[k]) * x[k];
+			}
+			x[i] = sum;
+		}
+		for (int i = Dim - 1; i >= 0; --i) {
+			const T* const row = lu[i].data();
+			TR sum = x[i];
+			for (int k = i + 1; k < Dim; ++k) {
+				sum -= static_cast<TR>(row[k]) * x[k];
+			}
+			x[i] = sum / static_cast<TR>(row[i]);
+		}
+	}
+	else {
+		for (int i = 0; i < Dim; ++i) {
+			const T* const row = lu[i].data();
+			const TR xi = x[i] / static_cast<TR>(row[i]);
+			x[i] = xi;
+			for (int k = i + 1; k < Dim; ++k) {
+				x[k] -= static_cast<TR>(row[k]) * xi;
+			}
+		}
+		for (int i = Dim - 1; i >= 1; --i) {
+			const T* const row = lu[i].data();
+			const TR xi = x[i];
+			for (int k = 0; k < i; ++k) {
+				x[k] -= static_cast<TR>(row[k]) * xi;
+			}
+		}
+		for (int k = Dim - 1; k >= 0; --k) {
+			std::swap(x[k], x[pivots[k]]);
+		}
+	}
+	return x;
+}
+
+
+template <class T, int Dim, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+auto DecompositionLUPCompact<T, Dim, Order, Layout, Packed>::Inverse() const -> Matrix<T, Dim, Dim, Order, Layout, Packed> {
+	return Solve(Mat(Identity()));
+}
+
+
+template <class T, int Dim, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+auto DecompositionLUPCompact<T, Dim, Order, Layout, Packed>::ExtractL() const -> Mat {
+	Mat L;
+	for (int i = 0; i < Dim; ++i) {
+		for (int j = 0; j < Dim; ++j) {
+			L(i, j) = i > j ? LU(i, j) : (i == j ? T(1) : T(0));
+		}
+	}
+	return L;
+}
+
+
+template <class T, int Dim, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+auto DecompositionLUPCompact<T, Dim, Order, Layout, Packed>::ExtractU() const -> Mat {
+	Mat U;
+	for (int i = 0; i < Dim; ++i) {
+		for (int j = 0; j < Dim; ++j) {
+			U(i, j) = i <= j ? LU(i, j) : T(0);
+		}
+	}
+	return U;
+}
+
+
+template <class T, int Dim, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+auto DecompositionLUPCompact<T, Dim, Order, Layout, Packed>::Permutation() const -> Vector<uint32_t, Dim, Packed> {
+	Vector<uint32_t, Dim, Packed> P;
+	std::iota(P.begin(), P.end(), uint32_t(0));
+	for (int k = 0; k < Dim; ++k) {
+		std::swap(P[k], P[pivots[k]]);
+	}
+	return P;
+}
+
+
+template <class T, int Dim, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+auto DecompositionLUPCompact<T, Dim, Order, Layout, Packed>::ExpandPermutation() const -> Mat {
+	return DecompositionLUP<T, Dim, Order, Layout, Packed>::ExpandPermutation(Permutation());
+}
+
+
 template <class T, int Dim, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
 auto DecomposeLU(const Matrix<T, Dim, Dim, Order, Layout, Packed>& m) {
 	using Mat = std::decay_t<decltype(m)>;
@@ -227,39 +444,138 @@ auto DecomposeLU(const Matrix<T, Dim, Dim, Order, Layout, Packed>& m) {
 }
 
 
+/// <summary> Calculates the LUP decomposition of the matrix, with L and U packed into a single matrix. </summary>
+/// <remarks> The elimination is done in place on the packed matrix: the pivot rows are swapped as a whole,
+///		which permutes the already computed part of L together with U. </remarks>
+template <class T, int Dim, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+auto DecomposeLUPCompact(const Matrix<T, Dim, Dim, Order, Layout, Packed>& m) {
+	using Decomposition = DecompositionLUPCompact<T, Dim, Order, Layout, Packed>;
+	using MatLU = typename Decomposition::MatLU;
+	using Real = remove_complex_t<T>;
+
+	Decomposition result{ MatLU(m), {} };
+	auto& a = result.LU.stripes;
+
+	for (int k = 0; k < Dim; ++k) {
+		int pivotRowIdx = k;
+		for (int i = k + 1; i < Dim; ++i) {
+			if (std::abs(a[i][k]) > std::abs(a[pivotRowIdx][k])) {
+				pivotRowIdx = i;
+			}
+		}
+		const auto pivot = a[pivotRowIdx][k];
+
+		if (pivot == static_cast<Real>(0)) {
+			// The column is zero, there is nothing to eliminate.
+			result.pivots[k] = uint32_t(k);
+			continue;
+		}
+		result.pivots[k] = uint32_t(pivotRowIdx);
+		if (pivotRowIdx != k) {
+			std::swap(a[pivotRowIdx], a[k]);
+		}
+
+		// The updated part of the rows starts at k + 1, so it's generally not aligned to the SIMD registers.
+		using Lanes = impl::LaneBlock<T>;
+		constexpr int width = static_cast<int>(Lanes::size);
+		const T* const pivotRow = a[k].data();
+		for (int i = k + 1; i < Dim; ++i) {
+			T* const row = a[i].data();
+			const T scale = row[k] / pivot;
+			row[k] = scale;
+			int j = k + 1;
+			if constexpr (width > 1) {
+				const auto negScale = Lanes::Broadcast(-scale);
+				for (; j + width <= Dim; j += width) {
+					Lanes::StoreUnaligned(row + j, madd{}(negScale, Lanes::LoadUnaligned(pivotRow + j), Lanes::LoadUnaligned(row + j)));
+				}
+			}
+			for (; j < Dim; ++j) {
+				row[j] -= scale * pivotRow[j];
+			}
+		}
+	}
+
+	return result;
+}
+
+
 template <class T, int Dim, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
 auto DecomposeLUP(const Matrix<T, Dim, Dim, Order, Layout, Packed>& m) {
-	using MatResult = Matrix<T, Dim, Dim, Order, Layout, Packed>;
-	using MatWorking = Matrix<T, Dim, Dim, Order, eMatrixLayout::ROW_MAJOR, Packed>;
-	using Perm = Vector<uint32_t, Dim, Packed>;
+	const auto compact = DecomposeLUPCompact(m);
+	return DecompositionLUP{ compact.ExtractL(), compact.ExtractU(), compact.Permutation() };
+}
+
+
+template <class T, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+auto DecomposeLU(const Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed>& m) {
+	using MatResult = Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed>;
+	using MatWorking = Matrix<T, DYNAMIC, DYNAMIC, Order, eMatrixLayout::ROW_MAJOR, Packed>;
+	using Block = typename MatWorking::Block;
+
+	assert(m.RowCount() == m.ColumnCount());
+	const size_t dim = m.RowCount();
+	MatResult L = impl::MakeIdentity<MatResult>(dim, dim);
+	MatWorking U = m;
+
+	for (size_t zeroedColIdx = 0; zeroedColIdx + 1 < dim; ++zeroedColIdx) {
+		const T* const pivotRow = U.StripeData(zeroedColIdx);
+		const auto pivot = pivotRow[zeroedColIdx];
+		// Elements left of the pivot are already zero, so the update starts at the pivot's SIMD block.
+		const size_t firstColIdx = zeroedColIdx / Block::size * Block::size;
+
+		for (size_t zeroedRowIdx = zeroedColIdx + 1; zeroedRowIdx < dim; ++zeroedRowIdx) {
+			const auto target = U(zeroedRowIdx, zeroedColIdx);
+			const auto scale = target / pivot;
+			impl::SubtractScaledElements(U.StripeData(zeroedRowIdx) + firstColIdx, pivotRow + firstColIdx, scale, dim - firstColIdx);
+			U(zeroedRowIdx, zeroedColIdx) = static_cast<T>(0); // Just to be sure that it is exactly zero.
+			L(zeroedRowIdx, zeroedColIdx) = scale;
+		}
+	}
+
+	return DecompositionLU{ L, MatResult(U) };
+}
+
+
+template <class T, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+auto DecomposeLUP(const Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed>& m) {
+	using MatResult = Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed>;
+	using MatWorking = Matrix<T, DYNAMIC, DYNAMIC, Order, eMatrixLayout::ROW_MAJOR, Packed>;
+	using Block = typename MatWorking::Block;
+	using Perm = Vector<uint32_t, DYNAMIC, Packed>;
 	using Real = remove_complex_t<T>;
 
-	MatResult L = Identity();
+	assert(m.RowCount() == m.ColumnCount());
+	const size_t dim = m.RowCount();
+	MatResult L = impl::MakeIdentity<MatResult>(dim, dim);
 	MatWorking U = m;
-	Perm P;
+	Perm P(dim);
 	std::iota(P.begin(), P.end(), uint32_t(0));
 
-	for (size_t zeroedColIdx = 0; zeroedColIdx < Dim - 1; ++zeroedColIdx) {
-		const auto zeroedColAbs = Abs(U.Column(zeroedColIdx));
-		const auto pivotRowIt = std::max_element(zeroedColAbs.begin() + zeroedColIdx, zeroedColAbs.end());
-		const auto pivotRowIdx = pivotRowIt - zeroedColAbs.begin();
-		const auto pivotRow = U.Row(pivotRowIdx);
-		const auto pivot = pivotRow(zeroedColIdx);
+	for (size_t zeroedColIdx = 0; zeroedColIdx + 1 < dim; ++zeroedColIdx) {
+		size_t pivotRowIdx = zeroedColIdx;
+		for (size_t rowIdx = zeroedColIdx + 1; rowIdx < dim; ++rowIdx) {
+			if (std::abs(U(rowIdx, zeroedColIdx)) > std::abs(U(pivotRowIdx, zeroedColIdx))) {
+				pivotRowIdx = rowIdx;
+			}
+		}
+		const auto pivot = U(pivotRowIdx, zeroedColIdx);
 
 		if (pivot != static_cast<Real>(0)) {
 			// Swap pivot row and the current row.
-			U.Row(pivotRowIdx, U.Row(zeroedColIdx));
-			U.Row(zeroedColIdx, pivotRow);
+			std::swap_ranges(U.StripeData(pivotRowIdx), U.StripeData(pivotRowIdx) + dim, U.StripeData(zeroedColIdx));
 			std::swap(P[pivotRowIdx], P[zeroedColIdx]);
 			for (size_t i = 0; i < zeroedColIdx; ++i) {
 				std::swap(L(pivotRowIdx, i), L(zeroedColIdx, i));
 			}
 
 			// Zero out column as usual business.
-			for (size_t zeroedRowIdx = zeroedColIdx + 1; zeroedRowIdx < Dim; ++zeroedRowIdx) {
+			const T* const pivotRow = U.StripeData(zeroedColIdx);
+			const size_t firstColIdx = zeroedColIdx / Block::size * Block::size;
+			for (size_t zeroedRowIdx = zeroedColIdx + 1; zeroedRowIdx < dim; ++zeroedRowIdx) {
 				const auto target = U(zeroedRowIdx, zeroedColIdx);
 				const auto scale = target / pivot;
-				U.Row(zeroedRowIdx, U.Row(zeroedRowIdx) - pivotRow * scale);
+				impl::SubtractScaledElements(U.StripeData(zeroedRowIdx) + firstColIdx, pivotRow + firstColIdx, scale, dim - firstColIdx);
 				U(zeroedRowIdx, zeroedColIdx) = static_cast<T>(0); // Just to be sure that it is exactly zero.
 				L(zeroedRowIdx, zeroedColIdx) = scale;
 			}
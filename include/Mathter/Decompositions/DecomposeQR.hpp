@@ -11,9 +11,14 @@
 #include "../Matrix/Cast.hpp"
 #include "../Matrix/Math.hpp"
 #include "../Matrix/Matrix.hpp"
+#include "../Matrix/MatrixDynamic.hpp"
 #include "../Transforms/IdentityBuilder.hpp"
 #include "../Transforms/RandomBuilder.hpp"
+#include "../Transforms/ZeroBuilder.hpp"
 
+#include <algorithm>
+#include <cassert>
+#include <limits>
 #include <random>
 
 
@@ -84,14 +89,19 @@ template <class T, int Rows, int Columns, eMatrixOrder Order, eMatrixLayout Layo
 template <class T2, bool Packed2>
 auto DecompositionQR<T, Rows, Columns, Order, Layout, Packed>::Solve(const Vector<T2, Rows, Packed2>& b) const {
 	static_assert(Order == eMatrixOrder::PRECEDE_VECTOR, MATHTER_QR_SOLVE_ORDER_ERROR);
-	return Vector(SolveUnordered(Matrix<T2, Rows, 1, Order, Layout, Packed>(b)));
+	if constexpr (Rows == DYNAMIC) {
+		return impl::MatrixToVector(SolveUnordered(impl::VectorToMatrix<Order, Layout>(b)));
+	}
+	else {
+		return Vector(SolveUnordered(Matrix<T2, Rows, 1, Order, Layout, Packed>(b)));
+	}
 }
 
 
 template <class T, int Rows, int Columns, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
 auto DecompositionQR<T, Rows, Columns, Order, Layout, Packed>::Inverse() const -> Matrix<T, Columns, Rows, Order, Layout, Packed> {
 	const auto ordR = SetOrder<eMatrixOrder::PRECEDE_VECTOR>(R, std::false_type{});
-	const auto ordI = SetOrder<eMatrixOrder::PRECEDE_VECTOR>(MatR(Identity()), std::false_type{});
+	const auto ordI = SetOrder<eMatrixOrder::PRECEDE_VECTOR>(impl::MakeIdentity<MatR>(R.RowCount(), R.ColumnCount()), std::false_type{});
 	const auto Rinv = SetOrder<Order>(SolveUpperTriangular(ordR, ordI), std::false_type{});
 	const auto Qinv = ConjTranspose(Q);
 	return Rinv * Qinv;
@@ -174,6 +184,228 @@ auto DecompositionLQ<T, Rows, Columns, Order, Layout, Packed>::Inverse() const -
 }
 
 
+/// <summary> The QR decomposition of a matrix, stored as Householder reflectors in compact WY form. </summary>
+/// <remarks> Unlike <see cref="DecompositionQR"/>, Q is never formed unless you ask for it with ExtractQ:
+///		Solve applies the reflectors to the right-hand side directly. The reflectors are grouped into
+///		blocks of <see cref="blockSize"/>, and each block is applied to a column as a whole,
+///		in the form I - V T V*, where V holds the reflectors of the block and T is upper triangular. </remarks>
+template <class T, int Rows, int Columns, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+struct DecompositionQRCompact {
+	static_assert(Rows >= Columns);
+	static_assert(Rows != DYNAMIC && Columns != DYNAMIC, "Use DecomposeQR for dynamically sized matrices.");
+
+	/// <summary> The number of reflectors applied together as one block reflector. </summary>
+	static constexpr int blockSize = std::min(Columns, 8);
+
+	using MatQ = Matrix<T, Rows, Columns, Order, Layout, Packed>;
+	using MatR = Matrix<T, Columns, Columns, Order, Layout, Packed>;
+	using MatReflectors = Matrix<T, Rows, Columns, Order, eMatrixLayout::COLUMN_MAJOR, Packed>;
+	using MatFactors = Matrix<T, blockSize, Columns, Order, eMatrixLayout::COLUMN_MAJOR, Packed>;
+	using Real = remove_complex_t<T>;
+
+	/// <summary> R on and above the diagonal, the Householder vectors below the diagonal. </summary>
+	/// <remarks> The Householder vectors have an implicit 1 on the diagonal. </remarks>
+	MatReflectors reflectors;
+	/// <summary> The triangular factors T of the blocks, side by side. </summary>
+	MatFactors factors;
+
+	/// <summary> Solve multiple linear systems of equations at the same time. </summary>
+	/// <remarks> For overdetermined systems, it returns the least squares solution.
+	///		Only applies to matrices that pre-multiply vectors, see <see cref="DecompositionQR"/>. </remarks>
+	template <class T2, int Columns2, eMatrixLayout Layout2, bool Packed2>
+	auto Solve(const Matrix<T2, Rows, Columns2, Order, Layout2, Packed2>& b) const;
+
+	/// <summary> Solve a linear systems of equations. </summary>
+	/// <remarks> For overdetermined systems, it returns the least squares solution.
+	///		Only applies to matrices that pre-multiply vectors, see <see cref="DecompositionQR"/>. </remarks>
+	template <class T2, bool Packed2>
+	auto Solve(const Vector<T2, Rows, Packed2>& b) const;
+
+	/// <summary> Compute the inverse or the pseudoinverse of the matrix. </summary>
+	/// <remarks> For non-square matrices, the pseudoinverse is computed instead. </remarks>
+	auto Inverse() const -> Matrix<T, Columns, Rows, Order, Layout, Packed>;
+
+	/// <summary> Forms the thin Q factor explicitly. </summary>
+	MatQ ExtractQ() const;
+
+	/// <summary> Returns the R factor. </summary>
+	MatR ExtractR() const;
+
+private:
+	/// <summary> Solve multiple linear systems of equations at the same time. </summary>
+	/// <remarks> This is a general routine that ignores matrix ordering.
+	///		For internal use only. </remarks>
+	template <class T2, int Columns2, eMatrixOrder Order2, eMatrixLayout Layout2, bool Packed2>
+	auto SolveUnordered(const Matrix<T2, Rows, Columns2, Order2, Layout2, Packed2>& b) const;
+};
+
+
+namespace impl {
+
+	/// <summary> Applies the block of reflectors starting at column <paramref name="first"/> to the column vector <paramref name="c"/>. </summary>
+	/// <typeparam name="Adjoint"> Applies I - V T* V* if true, I - V T V* otherwise. </typeparam>
+	template <bool Adjoint, class MatReflectors, class MatFactors, class T2>
+	void ApplyBlockReflector(const MatReflectors& reflectors, const MatFactors& factors, int first, T2* c) {
+		constexpr int rows = row_count_v<MatReflectors>;
+		constexpr int blockSize = row_count_v<MatFactors>;
+		const int width = std::min(blockSize, column_count_v<MatReflectors> - first);
+
+		// w = V* c
+		T2 w[blockSize];
+		for (int i = 0; i < width; ++i) {
+			const int k = first + i;
+			const auto& v = reflectors.stripes[k];
+			T2 sum = c[k];
+			for (int r = k + 1; r < rows; ++r) {
+				sum += static_cast<T2>(conj<>{}(v[r])) * c[r];
+			}
+			w[i] = sum;
+		}
+
+		// w = T* w or w = T w, in place.
+		const auto& t = factors.stripes;
+		if constexpr (Adjoint) {
+			for (int i = width - 1; i >= 0; --i) {
+				T2 sum(0);
+				for (int l = 0; l <= i; ++l) {
+					sum += static_cast<T2>(conj<>{}(t[first + i][l])) * w[l];
+				}
+				w[i] = sum;
+			}
+		}
+		else {
+			for (int i = 0; i < width; ++i) {
+				T2 sum(0);
+				for (int l = i; l < width; ++l) {
+					sum += static_cast<T2>(t[first + l][i]) * w[l];
+				}
+				w[i] = sum;
+			}
+		}
+
+		// c = c - V w
+		for (int i = 0; i < width; ++i) {
+			const int k = first + i;
+			const auto& v = reflectors.stripes[k];
+			c[k] -= w[i];
+			for (int r = k + 1; r < rows; ++r) {
+				c[r] -= static_cast<T2>(v[r]) * w[i];
+			}
+		}
+	}
+
+
+	/// <summary> Turns <paramref name="x"/> into the Householder vector that reflects it onto its first axis. </summary>
+	/// <remarks> On return, x[0] holds the reflected value, and x[1..count) holds the Householder vector,
+	///		whose first element is an implicit 1. </remarks>
+	/// <returns> The real scale factor tau of the reflection I - tau v v*, which is zero if x is zero. </returns>
+	template <class T>
+	remove_complex_t<T> MakeHouseholderVector(T* x, int count) {
+		using Real = remove_complex_t<T>;
+
+		Real tail(0);
+		for (int r = 1; r < count; ++r) {
+			tail += std::norm(x[r]);
+		}
+		const auto pivot = x[0];
+		const auto mag = std::abs(pivot);
+		const auto normX = std::sqrt(mag * mag + tail);
+		if (normX == Real(0)) {
+			return Real(0);
+		}
+
+		// The sign is opposite to the pivot's to avoid cancellation.
+		const auto sign = mag != Real(0) ? -(pivot / mag) : T(1);
+		const auto alpha = sign * normX;
+		const auto head = pivot - alpha;
+		for (int r = 1; r < count; ++r) {
+			x[r] /= head;
+		}
+		x[0] = alpha;
+		return Real(2) / (Real(1) + tail / std::norm(head));
+	}
+
+} // namespace impl
+
+
+template <class T, int Rows, int Columns, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+template <class T2, int Columns2, eMatrixLayout Layout2, bool Packed2>
+auto DecompositionQRCompact<T, Rows, Columns, Order, Layout, Packed>::Solve(const Matrix<T2, Rows, Columns2, Order, Layout2, Packed2>& b) const {
+	static_assert(Order == eMatrixOrder::PRECEDE_VECTOR, MATHTER_QR_SOLVE_ORDER_ERROR);
+	return SolveUnordered(b);
+}
+
+
+template <class T, int Rows, int Columns, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+template <class T2, bool Packed2>
+auto DecompositionQRCompact<T, Rows, Columns, Order, Layout, Packed>::Solve(const Vector<T2, Rows, Packed2>& b) const {
+	static_assert(Order == eMatrixOrder::PRECEDE_VECTOR, MATHTER_QR_SOLVE_ORDER_ERROR);
+	return Vector(SolveUnordered(Matrix<T2, Rows, 1, Order, Layout, Packed>(b)));
+}
+
+
+template <class T, int Rows, int Columns, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+auto DecompositionQRCompact<T, Rows, Columns, Order, Layout, Packed>::Inverse() const -> Matrix<T, Columns, Rows, Order, Layout, Packed> {
+	return Matrix<T, Columns, Rows, Order, Layout, Packed>(SolveUnordered(Matrix<T, Rows, Rows, Order, Layout, Packed>(Identity())));
+}
+
+
+template <class T, int Rows, int Columns, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+auto DecompositionQRCompact<T, Rows, Columns, Order, Layout, Packed>::ExtractQ() const -> MatQ {
+	Matrix<T, Rows, Columns, Order, eMatrixLayout::COLUMN_MAJOR, Packed> q = Identity();
+	constexpr int lastBlock = (Columns - 1) / blockSize * blockSize;
+	for (int first = lastBlock; first >= 0; first -= blockSize) {
+		// The block doesn't touch the columns of the identity before it.
+		for (int j = first; j < Columns; ++j) {
+			impl::ApplyBlockReflector<false>(reflectors, factors, first, q.stripes[j].data());
+		}
+	}
+	return MatQ(q);
+}
+
+
+template <class T, int Rows, int Columns, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+auto DecompositionQRCompact<T, Rows, Columns, Order, Layout, Packed>::ExtractR() const -> MatR {
+	MatR r;
+	for (int i = 0; i < Columns; ++i) {
+		for (int j = 0; j < Columns; ++j) {
+			r(i, j) = i <= j ? reflectors(i, j) : T(0);
+		}
+	}
+	return r;
+}
+
+
+template <class T, int Rows, int Columns, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+template <class T2, int Columns2, eMatrixOrder Order2, eMatrixLayout Layout2, bool Packed2>
+auto DecompositionQRCompact<T, Rows, Columns, Order, Layout, Packed>::SolveUnordered(const Matrix<T2, Rows, Columns2, Order2, Layout2, Packed2>& b) const {
+	using TR = common_arithmetic_type_t<T, T2>;
+
+	// Q* b, one column at a time.
+	Matrix<TR, Rows, Columns2, Order2, eMatrixLayout::COLUMN_MAJOR, Packed2> y(b);
+	for (int j = 0; j < Columns2; ++j) {
+		for (int first = 0; first < Columns; first += blockSize) {
+			impl::ApplyBlockReflector<true>(reflectors, factors, first, y.stripes[j].data());
+		}
+	}
+
+	// Back substitution with R, going through its columns.
+	Matrix<TR, Columns, Columns2, Order2, eMatrixLayout::COLUMN_MAJOR, Packed2> x;
+	for (int j = 0; j < Columns2; ++j) {
+		TR* const yj = y.stripes[j].data();
+		for (int i = Columns - 1; i >= 0; --i) {
+			const auto& r = reflectors.stripes[i];
+			const TR xi = yj[i] / static_cast<TR>(r[i]);
+			for (int l = 0; l < i; ++l) {
+				yj[l] -= static_cast<TR>(r[l]) * xi;
+			}
+			x.stripes[j][i] = xi;
+		}
+	}
+	return Matrix<TR, Columns, Columns2, Order2, Layout2, Packed2>(x);
+}
+
+
 namespace impl {
 
 	template <class T, int Rows, int Columns, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
@@ -205,44 +437,159 @@ namespace impl {
 } // namespace impl
 
 
+/// <summary> Calculates the QR decomposition of the matrix, but keeps Q as Householder reflectors. </summary>
+/// <remarks> This is cheaper than <see cref="DecomposeQR"/> when you only need to solve equations,
+///		because Q is never formed. You can still get Q via ExtractQ.
+///		Applicable to square or tall matrices (i.e. Rows >= Columns). </remarks>
+template <class T, int Rows, int Columns, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+auto DecomposeQRCompact(const Matrix<T, Rows, Columns, Order, Layout, Packed>& m) {
+	static_assert(Rows >= Columns);
+
+	using Decomposition = DecompositionQRCompact<T, Rows, Columns, Order, Layout, Packed>;
+	using MatReflectors = typename Decomposition::MatReflectors;
+	using MatFactors = typename Decomposition::MatFactors;
+	using Real = remove_complex_t<T>;
+	constexpr int blockSize = Decomposition::blockSize;
+
+	const auto scaler = std::max(std::numeric_limits<Real>::min(), ScaleElements(m));
+	Decomposition result{ MatReflectors(m / scaler), MatFactors(Zero()) };
+	auto& a = result.reflectors.stripes;
+	auto& t = result.factors.stripes;
+
+	for (int first = 0; first < Columns; first += blockSize) {
+		const int width = std::min(blockSize, Columns - first);
+
+		// Factor the panel one column at a time, and build its factor T along the way.
+		for (int i = 0; i < width; ++i) {
+			const int k = first + i;
+			T* const v = a[k].data();
+			const Real tau = impl::MakeHouseholderVector(v + k, Rows - k);
+
+			for (int j = k + 1; j < first + width; ++j) {
+				T* const c = a[j].data();
+				T w = c[k];
+				for (int r = k + 1; r < Rows; ++r) {
+					w += conj<>{}(v[r]) * c[r];
+				}
+				w *= tau;
+				c[k] -= w;
+				for (int r = k + 1; r < Rows; ++r) {
+					c[r] -= v[r] * w;
+				}
+			}
+
+			// T(0:i, i) = -tau T(0:i, 0:i) V(:, 0:i)* v
+			T z[blockSize];
+			for (int l = 0; l < i; ++l) {
+				const auto& u = a[first + l];
+				T sum = conj<>{}(u[k]);
+				for (int r = k + 1; r < Rows; ++r) {
+					sum += conj<>{}(u[r]) * v[r];
+				}
+				z[l] = sum;
+			}
+			for (int l = 0; l < i; ++l) {
+				T sum(0);
+				for (int p = l; p < i; ++p) {
+					sum += t[first + p][l] * z[p];
+				}
+				t[k][l] = -tau * sum;
+			}
+			t[k][i] = T(tau);
+		}
+
+		for (int j = first + width; j < Columns; ++j) {
+			impl::ApplyBlockReflector<true>(result.reflectors, result.factors, first, a[j].data());
+		}
+	}
+
+	for (int j = 0; j < Columns; ++j) {
+		for (int i = 0; i <= j; ++i) {
+			a[j][i] *= scaler;
+		}
+	}
+
+	return result;
+}
+
+
 /// <summary> Calculates the QR decomposition of the matrix. </summary>
 /// <remarks> The QR decomposition is applicable to square or tall matrices (i.e. Rows >= Columns).
-///		For wide matrices, use the LQ or QRorLQ decompositions. </remarks>
+///		For wide matrices, use the LQ or QRorLQ decompositions.
+///		If you don't need Q itself, <see cref="DecomposeQRCompact"/> is faster. </remarks>
 template <class T, int Rows, int Columns, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
 auto DecomposeQR(const Matrix<T, Rows, Columns, Order, Layout, Packed>& m) {
 	static_assert(Rows >= Columns);
 
-	using ColumnMat = Matrix<T, Rows, 1, Order, Layout, Packed>;
-	using RowMat = Matrix<T, 1, Rows, Order, Layout, Packed>;
-	using MatQ = Matrix<T, Rows, Rows, Order, Layout, Packed>;
-	using MatR = Matrix<T, Rows, Columns, Order, Layout, Packed>;
+	const auto compact = DecomposeQRCompact(m);
+	return DecompositionQR{ compact.ExtractQ(), compact.ExtractR() };
+}
+
+
+namespace impl {
+
+	/// <summary> Applies the Householder reflection I - 2vv* to <paramref name="m"/> from the left. </summary>
+	/// <remarks> The first <paramref name="k"/> elements of <paramref name="v"/> must be zero. </remarks>
+	template <class T, eMatrixOrder Order, bool Packed>
+	void ReflectRows(Matrix<T, DYNAMIC, DYNAMIC, Order, eMatrixLayout::ROW_MAJOR, Packed>& m, const Vector<T, DYNAMIC, Packed>& v, size_t k) {
+		using Real = remove_complex_t<T>;
+
+		const size_t rows = m.RowCount();
+		const size_t columns = m.ColumnCount();
+		if (k >= rows || columns == 0) {
+			return;
+		}
+
+		const auto vConj = DoUnaryOp(v, conj<>{});
+		Vector<T, DYNAMIC, Packed> w(columns);
+		AccumulateStripes(w.data(), size_t(0), size_t(1),
+						  m.StripeData(k), m.StripeStride(), rows - k,
+						  columns,
+						  vConj.data() + k, size_t(0), size_t(1));
+		for (size_t rowIdx = k; rowIdx < rows; ++rowIdx) {
+			SubtractScaledElements(m.StripeData(rowIdx), w.data(), Real(2) * v[rowIdx], columns);
+		}
+	}
+
+} // namespace impl
+
+
+/// <summary> Calculates the QR decomposition of the matrix. </summary>
+/// <remarks> The QR decomposition is applicable to square or tall matrices (i.e. Rows >= Columns).
+///		For wide matrices, use the LQ or QRorLQ decompositions. </remarks>
+template <class T, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+auto DecomposeQR(const Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed>& m) {
+	assert(m.RowCount() >= m.ColumnCount());
+
+	using Mat = Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed>;
+	using MatWorking = Matrix<T, DYNAMIC, DYNAMIC, Order, eMatrixLayout::ROW_MAJOR, Packed>;
 	using Real = remove_complex_t<T>;
 
+	const size_t rows = m.RowCount();
+	const size_t columns = m.ColumnCount();
+
 	const auto scaler = std::max(std::numeric_limits<Real>::min(), ScaleElements(m));
-	MatQ QT = Identity();
-	MatR R = m / scaler;
+	MatWorking QT = impl::MakeIdentity<MatWorking>(rows, rows);
+	MatWorking R = m / scaler;
 
-	// Using Householder reflections.
-	// Algorithm from Wikipedia's page: https://en.wikipedia.org/wiki/QR_decomposition#Using_Householder_reflections
-	// and Higham's book "Accuracy and Stability of Numerical Algorithms"
-	for (size_t k = 0; k < m.ColumnCount(); ++k) {
+	// Same as for fixed size matrices, but the reflections are applied as
+	// a row vector accumulation and rank-1 updates on the rows instead of matrix products.
+	for (size_t k = 0; k < columns; ++k) {
 		const auto v = impl::HouseholderReflection(R, k);
-		const auto vm = ColumnMat(v);
-		const auto vmT = RowMat(Conj(v));
-		R = R - Real(2) * vm * (vmT * R);
-		QT = QT - Real(2) * vm * (vmT * QT);
+		impl::ReflectRows(R, v, k);
+		impl::ReflectRows(QT, v, k);
 	}
 
 	// Completely zero out lower triangle. These elements are near zero after householder transforms.
-	for (size_t columnIdx = 0; columnIdx < Columns; ++columnIdx) {
-		for (size_t rowIdx = columnIdx + 1; rowIdx < Columns; ++rowIdx) {
+	for (size_t columnIdx = 0; columnIdx < columns; ++columnIdx) {
+		for (size_t rowIdx = columnIdx + 1; rowIdx < columns; ++rowIdx) {
 			R(rowIdx, columnIdx) = static_cast<T>(0);
 		}
 	}
 
 	return DecompositionQR{
-		ConjTranspose(QT.template Extract<Columns, Rows>(0, 0)),
-		scaler * R.template Extract<Columns, Columns>(0, 0)
+		Mat(ConjTranspose(QT.Extract(0, 0, columns, rows))),
+		Mat(scaler * R.Extract(0, 0, columns, columns))
 	};
 }
 
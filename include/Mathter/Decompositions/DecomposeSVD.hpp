@@ -6,11 +6,14 @@
 #pragma once
 
 #include "../Matrix/Matrix.hpp"
+#include "../Matrix/MatrixDynamic.hpp"
 #include "../Transforms/IdentityBuilder.hpp"
 #include "DecomposeQR.hpp"
 
 #include <algorithm>
 #include <array>
+#include <cassert>
+#include <vector>
 
 
 namespace mathter {
@@ -61,7 +64,7 @@ auto DecompositionSVD<T, Rows, Columns, Order, Layout, Packed>::Solve(const Matr
 	if constexpr (Order == eMatrixOrder::PRECEDE_VECTOR) {
 		static_assert(Rows == Rows2);
 		auto X = ConjTranspose(U) * b;
-		for (size_t row = 0; row < Columns; ++row) {
+		for (size_t row = 0; row < size_t(S.Dimension()); ++row) {
 			X.Row(row, X.Row(row) / S(row));
 		}
 		return ConjTranspose(V) * X;
@@ -69,7 +72,7 @@ auto DecompositionSVD<T, Rows, Columns, Order, Layout, Packed>::Solve(const Matr
 	else {
 		static_assert(Columns == Columns2);
 		auto X = b * ConjTranspose(V);
-		for (size_t col = 0; col < Rows; ++col) {
+		for (size_t col = 0; col < size_t(S.Dimension()); ++col) {
 			X.Column(col, X.Column(col) / S(col));
 		}
 		return X * ConjTranspose(U);
@@ -80,7 +83,10 @@ auto DecompositionSVD<T, Rows, Columns, Order, Layout, Packed>::Solve(const Matr
 template <class T, int Rows, int Columns, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
 template <class T2, bool Packed2>
 auto DecompositionSVD<T, Rows, Columns, Order, Layout, Packed>::Solve(const Vector<T2, std::max(Rows, Columns), Packed2>& b) const {
-	if constexpr (Order == eMatrixOrder::PRECEDE_VECTOR) {
+	if constexpr (Rows == DYNAMIC) {
+		return impl::MatrixToVector(Solve(impl::VectorToMatrix<Order, Layout>(b)));
+	}
+	else if constexpr (Order == eMatrixOrder::PRECEDE_VECTOR) {
 		return Vector(Solve(Matrix<T2, Rows, 1, Order, Layout, Packed>(b)));
 	}
 	else {
@@ -92,7 +98,7 @@ auto DecompositionSVD<T, Rows, Columns, Order, Layout, Packed>::Solve(const Vect
 template <class T, int Rows, int Columns, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
 auto DecompositionSVD<T, Rows, Columns, Order, Layout, Packed>::Inverse() const -> Matrix<T, Columns, Rows, Order, Layout, Packed> {
 	auto Xi = ConjTranspose(V);
-	for (size_t i = 0; i < S.Dimension(); ++i) {
+	for (size_t i = 0; i < size_t(S.Dimension()); ++i) {
 		Xi.Column(i, Xi.Column(i) / S(i));
 	}
 	const auto Ui = ConjTranspose(U);
@@ -425,6 +431,60 @@ namespace impl {
 	}
 
 
+	template <class T, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+	auto DecomposeSVDJacobiTwoSided(const Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed>& A) {
+		assert(A.RowCount() >= A.ColumnCount());
+
+		using Real = remove_complex_t<T>;
+		using Mat = Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed>;
+		using MatWorkingU = Matrix<T, DYNAMIC, DYNAMIC, Order, eMatrixLayout::COLUMN_MAJOR, Packed>;
+		using MatWorkingV = Matrix<T, DYNAMIC, DYNAMIC, Order, eMatrixLayout::ROW_MAJOR, Packed>;
+		constexpr auto tolerance = Real(1e-1f) * std::numeric_limits<Real>::epsilon();
+
+		const size_t rows = A.RowCount();
+		const size_t columns = A.ColumnCount();
+
+		const auto scaler = ScaleElements(A);
+		auto U = MakeIdentity<MatWorkingU>(rows, rows);
+		Mat X(rows, rows);
+		auto V = MakeIdentity<MatWorkingV>(rows, rows);
+		X.Insert(0, 0, A / scaler);
+
+		auto maxErrorPrev = std::numeric_limits<Real>::max();
+		auto maxError = std::nextafter(maxErrorPrev, Real(0));
+		while (maxError < maxErrorPrev) {
+			maxErrorPrev = maxError;
+			maxError = Real(0);
+			for (int p = 0; p < int(rows); ++p) {
+				for (int q = p + 1; q < int(rows); ++q) {
+					const auto [xpp, xpq, xqp, xqq] = std::tuple(X(p, p), X(p, q), X(q, p), X(q, q));
+					const auto error = ScaleElements(xpq, xqp);
+					if (error > tolerance) {
+						maxError = std::max(maxError, error);
+						const auto svd2x2 = DecomposeSVD2x2(Matrix<T, 2, 2>{ xpp, xpq, xqp, xqq });
+
+						GivensRotateRight(U, p, q, svd2x2.cu, svd2x2.su, svd2x2.det);
+						GivensRotateLeft(X, p, q, conj()(svd2x2.cu), -conj()(svd2x2.det) * svd2x2.su, conj()(svd2x2.det));
+						GivensRotateRight(X, p, q, conj()(svd2x2.cv), -svd2x2.sv);
+						GivensRotateLeft(V, p, q, svd2x2.cv, svd2x2.sv);
+					}
+				}
+			}
+		}
+
+		Vector<Real, DYNAMIC, Packed> S(columns);
+		for (size_t i = 0; i < columns; ++i) {
+			S(i) = std::real(X(i, i));
+		}
+
+		return DecompositionSVD{
+			Mat(U.Extract(0, 0, rows, columns)),
+			S * scaler,
+			Mat(V.Extract(0, 0, columns, columns)),
+		};
+	}
+
+
 	template <class T, int Rows, int Columns, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
 	auto DecomposeSVDJacobiOneSided(const Matrix<T, Rows, Columns, Order, Layout, Packed>& A) {
 		static_assert(Rows >= Columns);
@@ -512,6 +572,92 @@ namespace impl {
 		}
 	}
 
+
+	template <class T, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+	auto DecomposeSVDJacobiOneSided(const Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed>& A) {
+		assert(A.RowCount() >= A.ColumnCount());
+
+		using Real = remove_complex_t<T>;
+
+		using Mat = Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed>;
+		using MatWorkingX = Matrix<T, DYNAMIC, DYNAMIC, Order, eMatrixLayout::COLUMN_MAJOR, Packed>;
+		using MatWorkingV = Matrix<T, DYNAMIC, DYNAMIC, Order, eMatrixLayout::ROW_MAJOR, Packed>;
+
+		const size_t rows = A.RowCount();
+		const size_t columns = A.ColumnCount();
+
+		const auto scaler = ScaleElements(A);
+		MatWorkingX X = A / scaler;
+		MatWorkingV V = MakeIdentity<MatWorkingV>(columns, columns);
+
+		auto maxErrorPrev = std::numeric_limits<Real>::max();
+		auto maxError = std::nextafter(maxErrorPrev, Real(0));
+		while (maxError < maxErrorPrev) {
+			maxErrorPrev = maxError;
+			maxError = Real(0);
+			for (int p = 0; p < int(columns); ++p) {
+				for (int q = p + 1; q < int(columns); ++q) {
+					const auto [ata11, ataoff, ata22] = TransposeMultiplyPartial(X, p, q);
+					const auto error = std::abs(ataoff);
+					if (error != T(0)) {
+						maxError = std::max(maxError, error);
+						const auto [cv0, sv0] = DiagonalizeHermitian2x2(ata11, ataoff, ata22);
+						const auto [cv, sv] = MinimizeDiagonalizingRotation(cv0, sv0);
+
+						GivensRotateRight(X, p, q, cv, sv);
+						GivensRotateLeft(V, p, q, cv, -sv);
+					}
+				}
+			}
+		}
+
+		// Sort the singular values in decreasing order.
+		std::vector<std::pair<Real, size_t>> sortedS(columns);
+		for (size_t i = 0; i < columns; ++i) {
+			sortedS[i] = { Length(X.Column(i)), i };
+		}
+		std::sort(sortedS.begin(), sortedS.end(), [](const auto& lhs, const auto& rhs) { return lhs.first > rhs.first; });
+
+		Vector<Real, DYNAMIC, Packed> S(columns);
+		for (size_t i = 0; i < columns; ++i) {
+			S(i) = sortedS[i].first;
+		}
+
+		/// Sort the rows/columns of X and V to match that of the sorted singular values.
+		MatWorkingX sortedX(rows, columns);
+		MatWorkingV sortedV(columns, columns);
+		for (size_t i = 0; i < columns; ++i) {
+			const auto from = sortedS[i].second;
+			sortedX.Column(i, X.Column(from));
+			sortedV.Row(i, V.Row(from));
+		}
+		X = std::move(sortedX);
+		V = std::move(sortedV);
+
+		// Normalize the columns of X using the singular values.
+		const auto normalizationThreshold = columns > 0 ? S(0) * std::sqrt(std::numeric_limits<Real>::epsilon()) : Real(0);
+		size_t numOverThreshold = 0;
+		for (size_t i = 0; i < columns; ++i) {
+			const auto scale = S(i);
+			if (scale != Real(0)) {
+				X.Column(i, X.Column(i) / scale);
+			}
+			numOverThreshold += static_cast<size_t>(scale >= normalizationThreshold);
+		}
+
+		// Orthogonalize the columns of the smallest singular values, see the fixed size version.
+		if (numOverThreshold != columns) {
+			const auto [Q, R] = DecomposeQR(X);
+			for (size_t i = 0; i < columns; ++i) {
+				S(i) = std::copysign(S(i), std::real(R(i, i)));
+			}
+			return DecompositionSVD{ Mat(Q), S * scaler, Mat(V) };
+		}
+		else {
+			return DecompositionSVD{ Mat(X), S * scaler, Mat(V) };
+		}
+	}
+
 } // namespace impl
 
 
@@ -545,4 +691,28 @@ auto DecomposeSVD(Matrix<T, Rows, Columns, Order, Layout, Packed> m,
 	}
 }
 
+
+/// <summary> Calculates the thin SVD of the matrix. </summary>
+/// <remarks> For wide matrices, V is wide while U and S square.
+///		For tall matrices, U is tall while S and V square. </remarks>
+template <class T, eMatrixOrder Order, eMatrixLayout Layout, bool Packed, eSVDAlgorithm Algorithm = eSVDAlgorithm::JACOBI_TWO_SIDED>
+auto DecomposeSVD(Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed> m,
+				  std::integral_constant<eSVDAlgorithm, Algorithm> algorithm = {}) {
+	const auto decompose = [](const auto& tall) {
+		if constexpr (Algorithm == eSVDAlgorithm::JACOBI_ONE_SIDED) {
+			return impl::DecomposeSVDJacobiOneSided(tall);
+		}
+		else {
+			return impl::DecomposeSVDJacobiTwoSided(tall);
+		}
+	};
+	if (m.RowCount() >= m.ColumnCount()) {
+		return decompose(m);
+	}
+	else {
+		const auto [VT, S, UT] = decompose(FlipLayoutAndOrder(m));
+		return DecompositionSVD{ FlipLayoutAndOrder(UT), S, FlipLayoutAndOrder(VT) };
+	}
+}
+
 } // namespace mathter
\ No newline at end of file
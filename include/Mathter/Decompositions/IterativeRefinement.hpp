@@ -0,0 +1,163 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#pragma once
+
+#include "../Common/TypeTraits.hpp"
+#include "../Matrix/Arithmetic.hpp"
+#include "../Matrix/Math.hpp"
+#include "../Matrix/Matrix.hpp"
+#include "../Vector/Math.hpp"
+#include "DecomposeLU.hpp"
+#include "DecomposeQR.hpp"
+
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <type_traits>
+
+
+namespace mathter {
+
+
+/// <summary> The solution of a linear system of equations found by <see cref="SolveRefined"/>. </summary>
+template <class Solution>
+struct RefinedSolution {
+	/// <summary> The solution of the system. </summary>
+	Solution x;
+	/// <summary> The number of refinement steps done on top of the low precision solution. </summary>
+	int iterations;
+	/// <summary> False if the refinement did not converge and the system was solved again in full precision. </summary>
+	bool converged;
+};
+
+
+enum class eRefinedDecomposition {
+	LUP,
+	QR,
+};
+
+
+inline constexpr auto RefinedDecompositionLUP = std::integral_constant<eRefinedDecomposition, eRefinedDecomposition::LUP>{};
+inline constexpr auto RefinedDecompositionQR = std::integral_constant<eRefinedDecomposition, eRefinedDecomposition::QR>{};
+
+
+namespace impl {
+
+	template <class T>
+	struct lower_precision {
+		using type = void;
+	};
+
+	template <>
+	struct lower_precision<double> {
+		using type = float;
+	};
+
+	template <>
+	struct lower_precision<long double> {
+		using type = double;
+	};
+
+	template <class T>
+	struct lower_precision<std::complex<T>> {
+		using type = std::complex<typename lower_precision<T>::type>;
+	};
+
+	template <class T>
+	using lower_precision_t = typename lower_precision<T>::type;
+
+
+	template <class U, class T, int Dim, bool Packed>
+	auto ConvertScalars(const Vector<T, Dim, Packed>& v) {
+		return Vector<U, Dim, Packed>(v);
+	}
+
+
+	template <class U, class T, int Rows, int Columns, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+	auto ConvertScalars(const Matrix<T, Rows, Columns, Order, Layout, Packed>& m) {
+		return Matrix<U, Rows, Columns, Order, Layout, Packed>(m);
+	}
+
+
+	template <eRefinedDecomposition Decomposition, class Mat>
+	auto DecomposeForRefinement(const Mat& m) {
+		if constexpr (Decomposition == eRefinedDecomposition::LUP) {
+			return DecomposeLUPCompact(m);
+		}
+		else {
+			return DecomposeQRCompact(m);
+		}
+	}
+
+} // namespace impl
+
+
+/// <summary> Solves a linear system of equations with a low precision decomposition,
+///		then refines the solution in full precision. </summary>
+/// <remarks> The matrix is decomposed in the next lower precision, such as float for double matrices.
+///		It is not faster than solving in full precision: for fixed-size matrices, the residuals cost more than
+///		the lower precision saves on the decomposition. With AVX2, it measured about 1.5 times slower than
+///		<see cref="DecomposeLUPCompact"/> in double for 16x16 and 32x32 matrices. In exchange, the residual of the solution is checked.
+///		The residual b - A*x is then computed in full precision, and the correction for it is found with the low precision decomposition.
+///		The refinement stops when the largest element of the residual is below <paramref name="tolerance"/> times the largest
+///		element of A times the largest element of x. When the residual stops shrinking, or the refinement takes
+///		more than <paramref name="maxIterations"/> steps, the matrix is decomposed and the system is solved again in full precision.
+///		This happens when the matrix is too ill-conditioned for the lower precision.
+///		<para> The QR decomposition can only be used for matrices that pre-multiply vectors. </para></remarks>
+/// <param name="A"> The square matrix of the system. </param>
+/// <param name="b"> The right-hand side, either a vector or a matrix for solving multiple systems at the same time. </param>
+/// <param name="decomposition"> <see cref="RefinedDecompositionLUP"/> or <see cref="RefinedDecompositionQR"/>. </param>
+template <class T, int Dim, eMatrixOrder Order, eMatrixLayout Layout, bool Packed, class Rhs,
+		  eRefinedDecomposition Decomposition = eRefinedDecomposition::LUP>
+auto SolveRefined(const Matrix<T, Dim, Dim, Order, Layout, Packed>& A,
+				  const Rhs& b,
+				  [[maybe_unused]] std::integral_constant<eRefinedDecomposition, Decomposition> decomposition = {},
+				  remove_complex_t<T> tolerance = remove_complex_t<T>(Dim) * std::numeric_limits<remove_complex_t<T>>::epsilon(),
+				  int maxIterations = 30) {
+	using TLow = impl::lower_precision_t<T>;
+	using Real = remove_complex_t<T>;
+	static_assert(!std::is_void_v<TLow>, "Iterative refinement needs double or long double scalars.");
+	static_assert(std::is_same_v<scalar_type_t<Rhs>, T>, "The right-hand side must have the same scalar type as the matrix.");
+
+	const auto residual = [&A, &b](const Rhs& x) {
+		if constexpr (Order == eMatrixOrder::PRECEDE_VECTOR) {
+			return Rhs(b - A * x);
+		}
+		else {
+			return Rhs(b - x * A);
+		}
+	};
+
+	const auto lowDecomposition = impl::DecomposeForRefinement<Decomposition>(impl::ConvertScalars<TLow>(A));
+	auto x = Rhs(lowDecomposition.Solve(impl::ConvertScalars<TLow>(b)));
+	const Real scaleA = ScaleElements(A);
+	Real previousScaleR = std::numeric_limits<Real>::infinity();
+
+	int iterations = 0;
+	while (true) {
+		const Rhs r = residual(x);
+		const Real scaleR = ScaleElements(r);
+		if (std::isfinite(scaleR) && scaleR <= tolerance * scaleA * ScaleElements(x)) {
+			return RefinedSolution<Rhs>{ x, iterations, true };
+		}
+		if (!(scaleR <= previousScaleR / Real(2))) {
+			break; // Not shrinking fast enough, or not finite.
+		}
+		if (iterations == maxIterations) {
+			break;
+		}
+		// Normalizing the residual keeps small residuals out of the subnormal range of the low precision.
+		const auto correction = Rhs(lowDecomposition.Solve(impl::ConvertScalars<TLow>(r / scaleR)));
+		x += correction * scaleR;
+		previousScaleR = scaleR;
+		++iterations;
+	}
+
+	const auto fullDecomposition = impl::DecomposeForRefinement<Decomposition>(A);
+	return RefinedSolution<Rhs>{ Rhs(fullDecomposition.Solve(b)), iterations, false };
+}
+
+} // namespace mathter
@@ -5,10 +5,16 @@
 
 #pragma once
 
+#include "Geometry/AABB.hpp"
 #include "Geometry/BezierCurve.hpp"
+#include "Geometry/Bvh.hpp"
+#include "Geometry/Frustum.hpp"
 #include "Geometry/Hyperplane.hpp"
 #include "Geometry/Intersection.hpp"
 #include "Geometry/Line.hpp"
 #include "Geometry/LineSegment.hpp"
+#include "Geometry/Overlap.hpp"
+#include "Geometry/Packet.hpp"
 #include "Geometry/Ray.hpp"
+#include "Geometry/Sphere.hpp"
 #include "Geometry/Triangle.hpp"
\ No newline at end of file
@@ -0,0 +1,95 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#pragma once
+
+#include "../Vector/Math.hpp"
+#include "../Vector/Vector.hpp"
+
+#include <limits>
+
+
+namespace mathter {
+
+/// <summary> An axis-aligned bounding box. </summary>
+/// <remarks> The box is closed, so points on its faces are inside. </remarks>
+template <class T, int Dim>
+class AABB {
+	using Vec = Vector<T, Dim>;
+
+public:
+	/// <summary> Does not initialize the object. </summary>
+	AABB() = default;
+
+	/// <summary> Construct a box from its minimum and maximum corners. </summary>
+	AABB(const Vec& minimum, const Vec& maximum)
+		: minimum(minimum), maximum(maximum) {}
+
+	/// <summary> Convert from a box with different scalar type. </summary>
+	template <class TOther>
+	AABB(const AABB<TOther, Dim>& other)
+		: minimum(other.minimum), maximum(other.maximum) {}
+
+	/// <summary> Returns a box that contains nothing, not even a single point. </summary>
+	/// <remarks> Expanding the empty box by a point results in a box that contains only that point. </remarks>
+	static AABB Empty() {
+		return AABB(Vec(std::numeric_limits<T>::infinity()), Vec(-std::numeric_limits<T>::infinity()));
+	}
+
+	/// <summary> Returns true if the box contains no points. </summary>
+	bool IsEmpty() const {
+		for (int i = 0; i < Dim; ++i) {
+			if (!(minimum[i] <= maximum[i])) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/// <summary> Returns the point in the middle of the box. </summary>
+	Vec Center() const {
+		return (minimum + maximum) / T(2);
+	}
+
+	/// <summary> Returns the length of the box's edges along each axis. </summary>
+	Vec Size() const {
+		return maximum - minimum;
+	}
+
+	/// <summary> Grows the box just enough to contain <paramref name="point"/>. </summary>
+	void Expand(const Vec& point) {
+		minimum = Min(minimum, point);
+		maximum = Max(maximum, point);
+	}
+
+	/// <summary> Grows the box just enough to contain <paramref name="other"/>. </summary>
+	void Expand(const AABB& other) {
+		minimum = Min(minimum, other.minimum);
+		maximum = Max(maximum, other.maximum);
+	}
+
+	/// <summary> Returns true if <paramref name="point"/> is inside the box or on its boundary. </summary>
+	bool Contains(const Vec& point) const {
+		for (int i = 0; i < Dim; ++i) {
+			if (point[i] < minimum[i] || maximum[i] < point[i]) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+public:
+	Vec minimum;
+	Vec maximum;
+};
+
+
+/// <summary> Returns the smallest box that contains both boxes. </summary>
+template <class T, int Dim>
+AABB<T, Dim> Union(const AABB<T, Dim>& lhs, const AABB<T, Dim>& rhs) {
+	return AABB<T, Dim>(Min(lhs.minimum, rhs.minimum), Max(lhs.maximum, rhs.maximum));
+}
+
+} // namespace mathter
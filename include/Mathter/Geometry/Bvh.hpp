@@ -0,0 +1,435 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#pragma once
+
+#include "../Vector/Math.hpp"
+#include "../Vector/Vector.hpp"
+#include "Intersection.hpp"
+#include "Ray.hpp"
+#include "Triangle.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <thread>
+#include <vector>
+
+
+namespace mathter {
+
+
+/// <summary> A bounding volume hierarchy over triangles to accelerate ray queries. </summary>
+/// <remarks> The hierarchy is built with the binned surface area heuristic, and is stored
+///		as a flat array of nodes in depth-first order. The triangles are copied into the hierarchy
+///		and reordered so that the triangles of a leaf are contiguous in memory. </remarks>
+/// <typeparam name="T"> The scalar type of the triangles and the rays. Must be a real number. </typeparam>
+template <class T>
+class Bvh {
+	static_assert(std::is_floating_point_v<T>, "Must use real numbers for the BVH.");
+
+public:
+	using Vec = Vector<T, 3, false>;
+
+	/// <summary> Describes where a ray hit the triangles. </summary>
+	struct Hit {
+		/// <summary> The index of the triangle in the array the hierarchy was built from. </summary>
+		size_t triangle;
+		/// <summary> The distance of the hit point from the base of the ray. </summary>
+		T distance;
+		/// <summary> The point where the ray hit the triangle. </summary>
+		Vec point;
+	};
+
+	/// <summary> A node of the flattened hierarchy. </summary>
+	/// <remarks> The left child of an inner node immediately follows its parent. </remarks>
+	struct Node {
+		Vector<T, 3, true> boundsMin;
+		Vector<T, 3, true> boundsMax;
+		/// <summary> The index of the first triangle for leaves, the index of the right child for inner nodes. </summary>
+		uint32_t offset;
+		/// <summary> The number of triangles for leaves, zero for inner nodes. </summary>
+		uint32_t count;
+
+		bool IsLeaf() const { return count != 0; }
+	};
+
+public:
+	/// <summary> Creates an empty hierarchy. </summary>
+	Bvh() = default;
+
+	/// <summary> Builds the hierarchy over <paramref name="count"/> triangles. </summary>
+	/// <param name="threads"> The number of threads to build with. Zero uses all hardware threads. </param>
+	Bvh(const Triangle<T, 3>* triangles, size_t count, unsigned threads = 1);
+
+	/// <summary> Builds the hierarchy over a contiguous range of triangles, such as an std::vector. </summary>
+	/// <param name="threads"> The number of threads to build with. Zero uses all hardware threads. </param>
+	template <class Range, class = decltype(std::data(std::declval<const Range&>()))>
+	explicit Bvh(const Range& triangles, unsigned threads = 1)
+		: Bvh(std::data(triangles), std::size(triangles), threads) {}
+
+	/// <summary> Returns the number of triangles in the hierarchy. </summary>
+	size_t Size() const { return m_triangles.size(); }
+
+	/// <summary> Returns true if the hierarchy has no triangles. </summary>
+	bool Empty() const { return m_triangles.empty(); }
+
+	/// <summary> Returns the nodes of the hierarchy. The first node is the root. </summary>
+	const std::vector<Node>& Nodes() const { return m_nodes; }
+
+	/// <summary> Finds the triangle that <paramref name="ray"/> hits first. </summary>
+	/// <param name="maxDistance"> Hits farther than this from the base of the ray are ignored. </param>
+	/// <returns> The closest hit, or nullopt if the ray does not hit any of the triangles. </returns>
+	std::optional<Hit> ClosestHit(const Ray<T, 3>& ray, T maxDistance = std::numeric_limits<T>::infinity()) const;
+
+	/// <summary> Tells if <paramref name="ray"/> hits any of the triangles. </summary>
+	/// <remarks> Returns on the first hit found, which is faster than <see cref="ClosestHit"/> for occlusion queries. </remarks>
+	/// <param name="maxDistance"> Hits farther than this from the base of the ray are ignored. </param>
+	bool AnyHit(const Ray<T, 3>& ray, T maxDistance = std::numeric_limits<T>::infinity()) const;
+
+private:
+	struct Primitive {
+		Vector<T, 3, true> boundsMin;
+		Vector<T, 3, true> boundsMax;
+		Vector<T, 3, true> centroid;
+		uint32_t index;
+	};
+
+	struct Bin {
+		Vector<T, 3, true> boundsMin = Vector<T, 3, true>(std::numeric_limits<T>::infinity());
+		Vector<T, 3, true> boundsMax = Vector<T, 3, true>(-std::numeric_limits<T>::infinity());
+		size_t count = 0;
+	};
+
+	/// <summary> The number of bins the centroids are sorted into along each axis when searching for a split. </summary>
+	static constexpr int binCount = 16;
+	/// <summary> Leaves with this many triangles or less are not split. </summary>
+	static constexpr size_t minSplitSize = 2;
+	/// <summary> Leaves with more triangles than this are split even if the heuristic says otherwise. </summary>
+	static constexpr size_t maxLeafSize = 16;
+	/// <summary> The heuristic is abandoned for median splits below this depth, which bounds the traversal stack. </summary>
+	static constexpr int maxHeuristicDepth = 32;
+	/// <summary> The depth of the tree is limited by the median splits of 32-bit triangle indices. </summary>
+	static constexpr int maxDepth = maxHeuristicDepth + 32;
+	/// <summary> Subtrees with fewer triangles are built on the current thread. </summary>
+	static constexpr size_t minParallelSize = 4096;
+
+	static T HalfArea(const Vector<T, 3, true>& boundsMin, const Vector<T, 3, true>& boundsMax);
+	static void Build(std::vector<Node>& nodes, Primitive* primitives, Primitive* first, Primitive* last, int depth, unsigned threads);
+	static Primitive* Split(Primitive* first, Primitive* last, const Node& node, int depth);
+
+	/// <summary> Returns the distance where the ray enters the node's bounds, or infinity if it misses them. </summary>
+	static T IntersectBounds(const Node& node, const Vec& base, const Vec& inverseDirection, T maxDistance);
+
+	/// <summary> Intersects the ray with a triangle, and returns the distance of the hit point. </summary>
+	static std::optional<std::pair<T, Vec>> IntersectTriangle(const Ray<T, 3>& ray, const Triangle<T, 3>& triangle);
+
+private:
+	std::vector<Node> m_nodes;
+	std::vector<Triangle<T, 3>> m_triangles;
+	std::vector<size_t> m_indices;
+};
+
+
+template <class T>
+Bvh<T>::Bvh(const Triangle<T, 3>* triangles, size_t count, unsigned threads) {
+	assert(count <= std::numeric_limits<uint32_t>::max());
+	if (count == 0) {
+		return;
+	}
+	if (threads == 0) {
+		threads = std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	std::vector<Primitive> primitives(count);
+	for (size_t i = 0; i < count; ++i) {
+		const auto& corners = triangles[i].corners;
+		auto& primitive = primitives[i];
+		primitive.boundsMin = Min(Min(corners[0], corners[1]), corners[2]);
+		primitive.boundsMax = Max(Max(corners[0], corners[1]), corners[2]);
+		primitive.centroid = (primitive.boundsMin + primitive.boundsMax) * T(0.5);
+		primitive.index = static_cast<uint32_t>(i);
+	}
+
+	// A binary tree with at least one triangle per leaf has at most 2n - 1 nodes.
+	m_nodes.reserve(2 * count - 1);
+	Build(m_nodes, primitives.data(), primitives.data(), primitives.data() + count, 0, threads);
+
+	m_triangles.reserve(count);
+	m_indices.reserve(count);
+	for (const auto& primitive : primitives) {
+		m_triangles.push_back(triangles[primitive.index]);
+		m_indices.push_back(primitive.index);
+	}
+}
+
+
+template <class T>
+T Bvh<T>::HalfArea(const Vector<T, 3, true>& boundsMin, const Vector<T, 3, true>& boundsMax) {
+	const auto extent = Max(boundsMax - boundsMin, Vector<T, 3, true>(T(0)));
+	return extent[0] * extent[1] + extent[1] * extent[2] + extent[2] * extent[0];
+}
+
+
+template <class T>
+void Bvh<T>::Build(std::vector<Node>& nodes, Primitive* primitives, Primitive* first, Primitive* last, int depth, unsigned threads) {
+	const size_t nodeIndex = nodes.size();
+	Node node;
+	node.boundsMin = first->boundsMin;
+	node.boundsMax = first->boundsMax;
+	for (auto it = first + 1; it != last; ++it) {
+		node.boundsMin = Min(node.boundsMin, it->boundsMin);
+		node.boundsMax = Max(node.boundsMax, it->boundsMax);
+	}
+	node.offset = 0;
+	node.count = 0;
+	nodes.push_back(node);
+
+	Primitive* const middle = Split(first, last, node, depth);
+	if (middle == first) {
+		// All threads partition the same array, so leaves of any subtree can refer to their triangles by global index.
+		nodes[nodeIndex].offset = static_cast<uint32_t>(first - primitives);
+		nodes[nodeIndex].count = static_cast<uint32_t>(last - first);
+		return;
+	}
+
+	const size_t count = last - first;
+	if (threads > 1 && count >= minParallelSize) {
+		std::vector<Node> rightNodes;
+		rightNodes.reserve(2 * (last - middle) - 1);
+		auto right = std::async(std::launch::async, [&rightNodes, primitives, middle, last, depth, threads] {
+			Build(rightNodes, primitives, middle, last, depth + 1, threads / 2);
+		});
+		Build(nodes, primitives, first, middle, depth + 1, threads - threads / 2);
+		right.get();
+
+		const auto rightIndex = static_cast<uint32_t>(nodes.size());
+		for (auto rightNode : rightNodes) {
+			if (!rightNode.IsLeaf()) {
+				rightNode.offset += rightIndex;
+			}
+			nodes.push_back(rightNode);
+		}
+		nodes[nodeIndex].offset = rightIndex;
+	}
+	else {
+		Build(nodes, primitives, first, middle, depth + 1, 1);
+		nodes[nodeIndex].offset = static_cast<uint32_t>(nodes.size());
+		Build(nodes, primitives, middle, last, depth + 1, 1);
+	}
+}
+
+
+template <class T>
+auto Bvh<T>::Split(Primitive* first, Primitive* last, const Node& node, int depth) -> Primitive* {
+	const size_t count = last - first;
+	if (count <= minSplitSize) {
+		return first;
+	}
+
+	Vector<T, 3, true> centroidMin = first->centroid;
+	Vector<T, 3, true> centroidMax = first->centroid;
+	for (auto it = first + 1; it != last; ++it) {
+		centroidMin = Min(centroidMin, it->centroid);
+		centroidMax = Max(centroidMax, it->centroid);
+	}
+	const auto centroidExtent = centroidMax - centroidMin;
+	const int longestAxis = int(std::max_element(centroidExtent.begin(), centroidExtent.end()) - centroidExtent.begin());
+
+	if (centroidExtent[longestAxis] <= T(0)) {
+		// All centroids coincide, the only way to make leaves smaller is an arbitrary split.
+		return count > maxLeafSize ? first + count / 2 : first;
+	}
+
+	if (depth >= maxHeuristicDepth) {
+		Primitive* const middle = first + count / 2;
+		std::nth_element(first, middle, last, [longestAxis](const Primitive& lhs, const Primitive& rhs) {
+			return lhs.centroid[longestAxis] < rhs.centroid[longestAxis];
+		});
+		return middle;
+	}
+
+	// Evaluate the surface area heuristic at the boundaries of the bins along each axis.
+	// Traversing a node is assumed to cost as much as intersecting a triangle.
+	T bestCost = std::numeric_limits<T>::infinity();
+	int bestAxis = -1;
+	int bestSplit = 0;
+	for (int axis = 0; axis < 3; ++axis) {
+		if (centroidExtent[axis] <= T(0)) {
+			continue;
+		}
+		const T scale = T(binCount) / centroidExtent[axis];
+		std::array<Bin, binCount> bins;
+		for (auto it = first; it != last; ++it) {
+			const int binIndex = std::min(binCount - 1, int((it->centroid[axis] - centroidMin[axis]) * scale));
+			auto& bin = bins[binIndex];
+			bin.boundsMin = Min(bin.boundsMin, it->boundsMin);
+			bin.boundsMax = Max(bin.boundsMax, it->boundsMax);
+			++bin.count;
+		}
+
+		std::array<T, binCount - 1> leftCosts;
+		Bin accumulated;
+		for (int split = 1; split < binCount; ++split) {
+			const auto& bin = bins[split - 1];
+			accumulated.boundsMin = Min(accumulated.boundsMin, bin.boundsMin);
+			accumulated.boundsMax = Max(accumulated.boundsMax, bin.boundsMax);
+			accumulated.count += bin.count;
+			leftCosts[split - 1] = HalfArea(accumulated.boundsMin, accumulated.boundsMax) * T(accumulated.count);
+		}
+		accumulated = Bin{};
+		for (int split = binCount - 1; split >= 1; --split) {
+			const auto& bin = bins[split];
+			accumulated.boundsMin = Min(accumulated.boundsMin, bin.boundsMin);
+			accumulated.boundsMax = Max(accumulated.boundsMax, bin.boundsMax);
+			accumulated.count += bin.count;
+			const T cost = leftCosts[split - 1] + HalfArea(accumulated.boundsMin, accumulated.boundsMax) * T(accumulated.count);
+			if (accumulated.count != 0 && accumulated.count != count && cost < bestCost) {
+				bestCost = cost;
+				bestAxis = axis;
+				bestSplit = split;
+			}
+		}
+	}
+
+	const T leafCost = HalfArea(node.boundsMin, node.boundsMax) * T(count);
+	const T splitCost = HalfArea(node.boundsMin, node.boundsMax) + bestCost;
+	if (bestAxis < 0 || (splitCost >= leafCost && count <= maxLeafSize)) {
+		return count > maxLeafSize ? first + count / 2 : first;
+	}
+
+	const T scale = T(binCount) / centroidExtent[bestAxis];
+	return std::partition(first, last, [&](const Primitive& primitive) {
+		return std::min(binCount - 1, int((primitive.centroid[bestAxis] - centroidMin[bestAxis]) * scale)) < bestSplit;
+	});
+}
+
+
+template <class T>
+T Bvh<T>::IntersectBounds(const Node& node, const Vec& base, const Vec& inverseDirection, T maxDistance) {
+	// Slab test. When the ray is parallel to a slab and starts on its boundary, 0 * inf produces NaN,
+	// which std::min and std::max ignore since it's their second argument.
+	T entry = T(0);
+	T exit = maxDistance;
+	for (int axis = 0; axis < 3; ++axis) {
+		const T t1 = (node.boundsMin[axis] - base[axis]) * inverseDirection[axis];
+		const T t2 = (node.boundsMax[axis] - base[axis]) * inverseDirection[axis];
+		entry = std::max(entry, std::min(t1, t2));
+		exit = std::min(exit, std::max(t1, t2));
+	}
+	return entry <= exit ? entry : std::numeric_limits<T>::infinity();
+}
+
+
+template <class T>
+auto Bvh<T>::IntersectTriangle(const Ray<T, 3>& ray, const Triangle<T, 3>& triangle) -> std::optional<std::pair<T, Vec>> {
+	const auto point = Intersect(ray, triangle);
+	if (!point) {
+		return std::nullopt;
+	}
+	// The direction of the ray is normalized, so the projection is the distance.
+	return std::pair{ Dot(*point - ray.Base(), ray.Direction()), *point };
+}
+
+
+template <class T>
+auto Bvh<T>::ClosestHit(const Ray<T, 3>& ray, T maxDistance) const -> std::optional<Hit> {
+	if (m_nodes.empty()) {
+		return std::nullopt;
+	}
+
+	const Vec base = ray.Base();
+	const Vec inverseDirection = T(1) / ray.Direction();
+	if (IntersectBounds(m_nodes[0], base, inverseDirection, maxDistance) == std::numeric_limits<T>::infinity()) {
+		return std::nullopt;
+	}
+
+	std::optional<Hit> closest;
+	std::array<uint32_t, maxDepth> stack;
+	int stackSize = 0;
+	uint32_t nodeIndex = 0;
+	while (true) {
+		const Node& node = m_nodes[nodeIndex];
+		if (node.IsLeaf()) {
+			for (uint32_t i = node.offset; i < node.offset + node.count; ++i) {
+				const auto hit = IntersectTriangle(ray, m_triangles[i]);
+				if (hit && hit->first <= maxDistance) {
+					maxDistance = hit->first;
+					closest = Hit{ m_indices[i], hit->first, hit->second };
+				}
+			}
+		}
+		else {
+			// Visit the nearer child first so that the hits found there cull the farther one.
+			uint32_t nearIndex = nodeIndex + 1;
+			uint32_t farIndex = node.offset;
+			T nearEntry = IntersectBounds(m_nodes[nearIndex], base, inverseDirection, maxDistance);
+			T farEntry = IntersectBounds(m_nodes[farIndex], base, inverseDirection, maxDistance);
+			if (farEntry < nearEntry) {
+				std::swap(nearIndex, farIndex);
+				std::swap(nearEntry, farEntry);
+			}
+			if (nearEntry != std::numeric_limits<T>::infinity()) {
+				if (farEntry != std::numeric_limits<T>::infinity()) {
+					stack[stackSize++] = farIndex;
+				}
+				nodeIndex = nearIndex;
+				continue;
+			}
+		}
+
+		// Nodes on the stack may have been culled by hits found since they were pushed.
+		do {
+			if (stackSize == 0) {
+				return closest;
+			}
+			nodeIndex = stack[--stackSize];
+		} while (IntersectBounds(m_nodes[nodeIndex], base, inverseDirection, maxDistance) == std::numeric_limits<T>::infinity());
+	}
+}
+
+
+template <class T>
+bool Bvh<T>::AnyHit(const Ray<T, 3>& ray, T maxDistance) const {
+	if (m_nodes.empty()) {
+		return false;
+	}
+
+	const Vec base = ray.Base();
+	const Vec inverseDirection = T(1) / ray.Direction();
+
+	std::array<uint32_t, maxDepth + 1> stack;
+	int stackSize = 0;
+	stack[stackSize++] = 0;
+	while (stackSize > 0) {
+		const uint32_t nodeIndex = stack[--stackSize];
+		const Node& node = m_nodes[nodeIndex];
+		if (IntersectBounds(node, base, inverseDirection, maxDistance) == std::numeric_limits<T>::infinity()) {
+			continue;
+		}
+		if (node.IsLeaf()) {
+			for (uint32_t i = node.offset; i < node.offset + node.count; ++i) {
+				const auto hit = IntersectTriangle(ray, m_triangles[i]);
+				if (hit && hit->first <= maxDistance) {
+					return true;
+				}
+			}
+		}
+		else {
+			stack[stackSize++] = node.offset;
+			stack[stackSize++] = nodeIndex + 1;
+		}
+	}
+	return false;
+}
+
+
+} // namespace mathter
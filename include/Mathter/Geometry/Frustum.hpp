@@ -0,0 +1,328 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#pragma once
+
+#include "../Common/Functional.hpp"
+#include "../Common/Types.hpp"
+#include "../Matrix/Matrix.hpp"
+#include "../Vector/Math.hpp"
+#include "../Vector/SIMDUtil.hpp"
+#include "../Vector/Vector.hpp"
+#include "../Vector/VectorArray.hpp"
+#include "AABB.hpp"
+#include "Hyperplane.hpp"
+#include "Overlap.hpp"
+#include "Sphere.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+
+namespace mathter {
+
+/// <summary> Tells where an object is relative to a volume. </summary>
+enum class eClassification : uint8_t {
+	OUTSIDE,
+	INTERSECTING,
+	INSIDE,
+};
+
+
+namespace impl {
+
+	/// <summary> Returns the signed distance of a box's center from a plane, and the box's half-extent along the plane's normal. </summary>
+	template <class R>
+	std::pair<R, R> BoxPlaneDistance(const std::array<R, 3>& center, const std::array<R, 3>& extent, const std::array<R, 3>& normal, const R& scalar) {
+		const R distance = madd{}(normal[0], center[0], madd{}(normal[1], center[1], normal[2] * center[2])) - scalar;
+		const R radius = madd{}(abs{}(normal[0]), extent[0], madd{}(abs{}(normal[1]), extent[1], abs{}(normal[2]) * extent[2]));
+		return { distance, radius };
+	}
+
+
+	/// <summary> Returns the signed distance of a sphere's center from a plane, and the sphere's radius. </summary>
+	template <class R>
+	std::pair<R, R> SpherePlaneDistance(const std::array<R, 3>& center, const R& radius, const std::array<R, 3>& normal, const R& scalar) {
+		const R distance = madd{}(normal[0], center[0], madd{}(normal[1], center[1], normal[2] * center[2])) - scalar;
+		return { distance, radius };
+	}
+
+} // namespace impl
+
+
+/// <summary> The volume a camera sees, bounded by six planes. </summary>
+/// <remarks> The normals of the planes point into the frustum, so points inside have positive distance from all planes.
+///		When extracted from a matrix, the planes are stored in the order of left, right, bottom, top, near, and far. </remarks>
+template <class T>
+class Frustum {
+	using Vec = Vector<T, 3>;
+
+public:
+	/// <summary> Does not initialize the object. </summary>
+	Frustum() = default;
+
+	/// <summary> Construct a frustum from its bounding planes. </summary>
+	/// <remarks> The normals must point into the frustum. </remarks>
+	explicit Frustum(const std::array<Hyperplane<T, 3>, 6>& planes) : planes(planes) {}
+
+	/// <summary> Extract the frustum from a view-projection matrix. </summary>
+	/// <param name="viewProjection"> Transforms world space to clip space, such as a projection matrix from
+	///		<see cref="Perspective"/> or <see cref="Orthographic"/> combined with a view matrix from <see cref="LookAt"/>. </param>
+	/// <param name="projNearPlane"> Where the near plane is taken after projection, same as for <see cref="Perspective"/>. </param>
+	/// <param name="projFarPlane"> Where the far plane is taken after projection, same as for <see cref="Perspective"/>. </param>
+	/// <remarks> The planes are in world space. Clip space X and Y are bounded by -1 and 1 after the perspective division. </remarks>
+	template <class U, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+	explicit Frustum(const Matrix<U, 4, 4, Order, Layout, Packed>& viewProjection, T projNearPlane = T(0), T projFarPlane = T(1));
+
+	/// <summary> Returns true if <paramref name="point"/> is inside the frustum or on its boundary. </summary>
+	bool Contains(const Vec& point) const;
+
+	/// <summary> Tells if the box is inside the frustum, outside of it, or intersects its boundary. </summary>
+	/// <remarks> The test is conservative: boxes near the frustum's edges may be classified as intersecting
+	///		even if they are outside, but objects classified as outside are never visible. </remarks>
+	eClassification Classify(const AABB<T, 3>& box) const;
+
+	/// <summary> Tells if the sphere is inside the frustum, outside of it, or intersects its boundary. </summary>
+	/// <remarks> The test is conservative, see the overload for boxes. </remarks>
+	eClassification Classify(const Sphere<T, 3>& sphere) const;
+
+	/// <summary> Classifies each box of the array, given by their minimum and maximum corners. </summary>
+	/// <remarks> As many boxes are tested at once as fit into a SIMD register. </remarks>
+	std::vector<eClassification> Classify(const VectorArray<T, 3>& minima, const VectorArray<T, 3>& maxima) const;
+
+	/// <summary> Classifies each box of the array, first testing the plane that rejected it last time. </summary>
+	/// <param name="lastPlanes"> The coherency cache: the index of the plane that last rejected each box.
+	///		Reuse the same vector over frames for the same array of boxes. It's reset when its size doesn't match the array. </param>
+	/// <remarks> Boxes outside the frustum tend to stay outside of the same plane as the camera moves, so the rest
+	///		of the planes don't have to be tested. The cached planes are tested for a whole SIMD register of boxes at once,
+	///		so sorting the boxes spatially makes the cache more effective. </remarks>
+	std::vector<eClassification> Classify(const VectorArray<T, 3>& minima, const VectorArray<T, 3>& maxima, std::vector<uint8_t>& lastPlanes) const;
+
+	/// <summary> Classifies each sphere of the array, given by their centers and radii. </summary>
+	/// <remarks> As many spheres are tested at once as fit into a SIMD register. </remarks>
+	std::vector<eClassification> Classify(const VectorArray<T, 3>& centers, const VectorArray<T, 1>& radii) const;
+
+	/// <summary> Classifies each sphere of the array, first testing the plane that rejected it last time. </summary>
+	/// <remarks> See the overload for boxes. </remarks>
+	std::vector<eClassification> Classify(const VectorArray<T, 3>& centers, const VectorArray<T, 1>& radii, std::vector<uint8_t>& lastPlanes) const;
+
+private:
+	template <class LoadObjects>
+	std::vector<eClassification> ClassifyArray(size_t count, const LoadObjects& loadObjects, std::vector<uint8_t>* lastPlanes) const;
+
+	auto LoadBoxes(const VectorArray<T, 3>& minima, const VectorArray<T, 3>& maxima) const;
+	auto LoadSpheres(const VectorArray<T, 3>& centers, const VectorArray<T, 1>& radii) const;
+
+public:
+	std::array<Hyperplane<T, 3>, 6> planes;
+};
+
+
+template <class T>
+template <class U, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+Frustum<T>::Frustum(const Matrix<U, 4, 4, Order, Layout, Packed>& viewProjection, T projNearPlane, T projFarPlane) {
+	// The rows of the matrix in PRECEDE_VECTOR order give the clip space coordinates as the dot product with (p, 1).
+	// A point is inside if -w <= x <= w, -w <= y <= w, and z is between near * w and far * w.
+	std::array<Vector<T, 4>, 4> rows;
+	for (int i = 0; i < 4; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			rows[i][j] = static_cast<T>(Order == eMatrixOrder::PRECEDE_VECTOR ? viewProjection(i, j) : viewProjection(j, i));
+		}
+	}
+	const T sign = projNearPlane < projFarPlane ? T(1) : T(-1);
+	const std::array<Vector<T, 4>, 6> equations = {
+		rows[3] + rows[0],
+		rows[3] - rows[0],
+		rows[3] + rows[1],
+		rows[3] - rows[1],
+		sign * (rows[2] - projNearPlane * rows[3]),
+		sign * (projFarPlane * rows[3] - rows[2]),
+	};
+	for (int i = 0; i < 6; ++i) {
+		const Vec normal = equations[i].xyz;
+		const T length = Length(normal);
+		planes[i] = Hyperplane<T, 3>(normal / length, -equations[i][3] / length);
+	}
+}
+
+
+template <class T>
+bool Frustum<T>::Contains(const Vec& point) const {
+	return std::all_of(planes.begin(), planes.end(), [&point](const auto& plane) { return plane.Distance(point) >= T(0); });
+}
+
+
+template <class T>
+eClassification Frustum<T>::Classify(const AABB<T, 3>& box) const {
+	const auto center = impl::ToArray(Vec(box.Center()));
+	const auto extent = impl::ToArray(Vec(box.Size() / T(2)));
+	bool inside = true;
+	for (const auto& plane : planes) {
+		const auto [distance, radius] = impl::BoxPlaneDistance(center, extent, impl::ToArray(plane.normal), plane.scalar);
+		if (distance < -radius) {
+			return eClassification::OUTSIDE;
+		}
+		inside = inside && distance >= radius;
+	}
+	return inside ? eClassification::INSIDE : eClassification::INTERSECTING;
+}
+
+
+template <class T>
+eClassification Frustum<T>::Classify(const Sphere<T, 3>& sphere) const {
+	const auto center = impl::ToArray(sphere.center);
+	bool inside = true;
+	for (const auto& plane : planes) {
+		const auto [distance, radius] = impl::SpherePlaneDistance(center, sphere.radius, impl::ToArray(plane.normal), plane.scalar);
+		if (distance < -radius) {
+			return eClassification::OUTSIDE;
+		}
+		inside = inside && distance >= radius;
+	}
+	return inside ? eClassification::INSIDE : eClassification::INTERSECTING;
+}
+
+
+template <class T>
+auto Frustum<T>::LoadBoxes(const VectorArray<T, 3>& minima, const VectorArray<T, 3>& maxima) const {
+	return [&minima, &maxima](auto block, size_t index) {
+		using Block = decltype(block);
+		using R = typename Block::Block;
+		const auto minimum = impl::LoadArray<Block>(minima, index);
+		const auto maximum = impl::LoadArray<Block>(maxima, index);
+		const R half = Block::Broadcast(T(0.5));
+		std::array<R, 3> center;
+		std::array<R, 3> extent;
+		for (int i = 0; i < 3; ++i) {
+			center[i] = (minimum[i] + maximum[i]) * half;
+			extent[i] = (maximum[i] - minimum[i]) * half;
+		}
+		return [center, extent](const std::array<R, 3>& normal, const R& scalar) {
+			return impl::BoxPlaneDistance(center, extent, normal, scalar);
+		};
+	};
+}
+
+
+template <class T>
+auto Frustum<T>::LoadSpheres(const VectorArray<T, 3>& centers, const VectorArray<T, 1>& radii) const {
+	return [&centers, &radii](auto block, size_t index) {
+		using Block = decltype(block);
+		using R = typename Block::Block;
+		const auto center = impl::LoadArray<Block>(centers, index);
+		const R radius = Block::Load(radii.Lane(0) + index);
+		return [center, radius](const std::array<R, 3>& normal, const R& scalar) {
+			return impl::SpherePlaneDistance(center, radius, normal, scalar);
+		};
+	};
+}
+
+
+template <class T>
+std::vector<eClassification> Frustum<T>::Classify(const VectorArray<T, 3>& minima, const VectorArray<T, 3>& maxima) const {
+	assert(minima.Size() == maxima.Size());
+	return ClassifyArray(minima.Size(), LoadBoxes(minima, maxima), nullptr);
+}
+
+
+template <class T>
+std::vector<eClassification> Frustum<T>::Classify(const VectorArray<T, 3>& minima, const VectorArray<T, 3>& maxima, std::vector<uint8_t>& lastPlanes) const {
+	assert(minima.Size() == maxima.Size());
+	return ClassifyArray(minima.Size(), LoadBoxes(minima, maxima), &lastPlanes);
+}
+
+
+template <class T>
+std::vector<eClassification> Frustum<T>::Classify(const VectorArray<T, 3>& centers, const VectorArray<T, 1>& radii) const {
+	assert(centers.Size() == radii.Size());
+	return ClassifyArray(centers.Size(), LoadSpheres(centers, radii), nullptr);
+}
+
+
+template <class T>
+std::vector<eClassification> Frustum<T>::Classify(const VectorArray<T, 3>& centers, const VectorArray<T, 1>& radii, std::vector<uint8_t>& lastPlanes) const {
+	assert(centers.Size() == radii.Size());
+	return ClassifyArray(centers.Size(), LoadSpheres(centers, radii), &lastPlanes);
+}
+
+
+template <class T>
+template <class LoadObjects>
+std::vector<eClassification> Frustum<T>::ClassifyArray(size_t count, const LoadObjects& loadObjects, std::vector<uint8_t>* lastPlanes) const {
+	using Block = impl::LaneBlock<T>;
+	using R = typename Block::Block;
+
+	std::array<std::array<R, 3>, 6> normals;
+	std::array<R, 6> scalars;
+	for (int p = 0; p < 6; ++p) {
+		normals[p] = impl::BroadcastArray<Block>(planes[p].normal);
+		scalars[p] = Block::Broadcast(planes[p].scalar);
+	}
+
+	if (lastPlanes && lastPlanes->size() != count) {
+		lastPlanes->assign(count, uint8_t(0));
+	}
+
+	std::vector<eClassification> result(count);
+	for (size_t index = 0; index < count; index += Block::size) {
+		const size_t lanes = std::min(Block::size, count - index);
+		const uint64_t valid = lanes == 64 ? ~uint64_t(0) : (uint64_t(1) << lanes) - 1;
+		const auto objects = loadObjects(Block{}, index);
+
+		if (lastPlanes) {
+			// Each lane has its own cached plane, so the planes' coefficients are gathered into registers.
+			alignas(impl::laneAlignment) std::array<std::array<T, Block::size>, 4> cached;
+			for (size_t j = 0; j < Block::size; ++j) {
+				const auto& plane = planes[j < lanes ? (*lastPlanes)[index + j] : 0];
+				cached[0][j] = plane.normal[0];
+				cached[1][j] = plane.normal[1];
+				cached[2][j] = plane.normal[2];
+				cached[3][j] = plane.scalar;
+			}
+			const std::array<R, 3> normal = { Block::Load(cached[0].data()), Block::Load(cached[1].data()), Block::Load(cached[2].data()) };
+			const auto [distance, radius] = objects(normal, Block::Load(cached[3].data()));
+			if ((mask_bits{}(distance < -radius) & valid) == valid) {
+				std::fill_n(result.begin() + index, lanes, eClassification::OUTSIDE);
+				continue;
+			}
+		}
+
+		const auto [distance, radius] = objects(normals[0], scalars[0]);
+		auto outside = distance < -radius;
+		auto inside = distance >= radius;
+		R rejectingPlane = Block::Broadcast(T(0));
+		for (int p = 1; p < 6; ++p) {
+			const auto [distance, radius] = objects(normals[p], scalars[p]);
+			const auto rejected = distance < -radius;
+			outside = outside | rejected;
+			inside = inside & (distance >= radius);
+			rejectingPlane = select{}(rejected, Block::Broadcast(T(p)), rejectingPlane);
+		}
+
+		const uint64_t outsideBits = mask_bits{}(outside);
+		const uint64_t insideBits = mask_bits{}(inside);
+		for (size_t j = 0; j < lanes; ++j) {
+			const bool isOutside = (outsideBits >> j) & 1u;
+			const bool isInside = (insideBits >> j) & 1u;
+			result[index + j] = isOutside ? eClassification::OUTSIDE : isInside ? eClassification::INSIDE : eClassification::INTERSECTING;
+		}
+		if (lastPlanes && outsideBits != 0) {
+			alignas(impl::laneAlignment) std::array<T, Block::size> rejecting;
+			Block::Store(rejecting.data(), rejectingPlane);
+			for (size_t j = 0; j < lanes; ++j) {
+				if ((outsideBits >> j) & 1u) {
+					(*lastPlanes)[index + j] = static_cast<uint8_t>(rejecting[j]);
+				}
+			}
+		}
+	}
+	return result;
+}
+
+} // namespace mathter
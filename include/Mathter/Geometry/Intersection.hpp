@@ -7,13 +7,17 @@
 
 #include "../Decompositions/DecomposeQR.hpp"
 #include "../Transforms/IdentityBuilder.hpp"
+#include "AABB.hpp"
 #include "Hyperplane.hpp"
 #include "Line.hpp"
 #include "LineSegment.hpp"
+#include "Overlap.hpp"
 #include "Ray.hpp"
+#include "Sphere.hpp"
 #include "Triangle.hpp"
 
 #include <cmath>
+#include <limits>
 #include <optional>
 
 
@@ -260,4 +264,69 @@ auto Intersect(const Triangle<T1, 3>& triangle, const Ray<T2, 3>& ray)
 	return Intersect(ray, triangle);
 }
 
+
+/// <summary> Find where the ray enters the box. </summary>
+/// <returns> The point where the ray enters the box, the base of the ray if it starts inside the box, or nullopt if the ray misses the box. </returns>
+template <class T1, class T2, int Dim>
+auto Intersect(const Ray<T1, Dim>& ray, const AABB<T2, Dim>& box)
+	-> std::optional<Vector<common_arithmetic_type_t<T1, T2>, Dim, false>> {
+	using T = common_arithmetic_type_t<T1, T2>;
+	using Vec = Vector<T, Dim, false>;
+
+	T entry = T(0);
+	T exit = std::numeric_limits<T>::infinity();
+	const Vec base = ray.Base();
+	const Vec inverseDirection = T(1) / Vec(ray.Direction());
+	if (!impl::IntersectSlabs<T>(impl::ToArray(base), impl::ToArray(inverseDirection), impl::ToArray(Vec(box.minimum)), impl::ToArray(Vec(box.maximum)), entry, exit)) {
+		return std::nullopt;
+	}
+	return Ray<T, Dim>(ray).PointAt(entry);
+}
+
+
+/// <summary> Find where the ray enters the box. </summary>
+/// <returns> The point where the ray enters the box, the base of the ray if it starts inside the box, or nullopt if the ray misses the box. </returns>
+template <class T1, class T2, int Dim>
+auto Intersect(const AABB<T1, Dim>& box, const Ray<T2, Dim>& ray)
+	-> std::optional<Vector<common_arithmetic_type_t<T1, T2>, Dim, false>> {
+	return Intersect(ray, box);
+}
+
+
+/// <summary> Find where the ray enters the sphere. </summary>
+/// <returns> The point where the ray enters the sphere, the base of the ray if it starts inside the sphere, or nullopt if the ray misses the sphere. </returns>
+template <class T1, class T2, int Dim>
+auto Intersect(const Ray<T1, Dim>& ray, const Sphere<T2, Dim>& sphere)
+	-> std::optional<Vector<common_arithmetic_type_t<T1, T2>, Dim, false>> {
+	using T = common_arithmetic_type_t<T1, T2>;
+	using Vec = Vector<T, Dim, false>;
+
+	if (sphere.IsEmpty()) {
+		return std::nullopt;
+	}
+
+	// Solves |base + t * direction - center|^2 = radius^2 for t, where direction is a unit vector.
+	const Vec offset = Vec(ray.Base()) - Vec(sphere.center);
+	const T b = Dot(offset, Vec(ray.Direction()));
+	const T c = LengthSquared(offset) - T(sphere.radius) * T(sphere.radius);
+	if (c <= T(0)) {
+		return Vec(ray.Base());
+	}
+	const T discriminant = b * b - c;
+	if (b > T(0) || discriminant < T(0)) {
+		return std::nullopt;
+	}
+	const T t = -b - std::sqrt(discriminant);
+	return Ray<T, Dim>(ray).PointAt(t);
+}
+
+
+/// <summary> Find where the ray enters the sphere. </summary>
+/// <returns> The point where the ray enters the sphere, the base of the ray if it starts inside the sphere, or nullopt if the ray misses the sphere. </returns>
+template <class T1, class T2, int Dim>
+auto Intersect(const Sphere<T1, Dim>& sphere, const Ray<T2, Dim>& ray)
+	-> std::optional<Vector<common_arithmetic_type_t<T1, T2>, Dim, false>> {
+	return Intersect(ray, sphere);
+}
+
 } // namespace mathter
\ No newline at end of file
@@ -0,0 +1,284 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#pragma once
+
+#include "../Common/Functional.hpp"
+#include "../Vector/Math.hpp"
+#include "../Vector/SIMDUtil.hpp"
+#include "../Vector/Vector.hpp"
+#include "../Vector/VectorArray.hpp"
+#include "AABB.hpp"
+#include "Ray.hpp"
+#include "Sphere.hpp"
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+
+namespace mathter {
+
+namespace impl {
+
+	/// <summary> Clips the interval [entry, exit] of each lane's ray to the slabs of each lane's box. </summary>
+	/// <remarks> When a ray is parallel to a slab and starts on its boundary, 0 * inf produces NaN.
+	///		The ray is inside the closed slab, so the NaNs are replaced such that they don't clip the interval.
+	///		This makes the result the same for scalars and SIMD registers, whose min and max treat NaNs differently. </remarks>
+	/// <returns> The condition that is true for the lanes where the ray hits the box. </returns>
+	template <class T, class R, size_t Dim>
+	auto IntersectSlabs(const std::array<R, Dim>& base,
+						const std::array<R, Dim>& inverseDirection,
+						const std::array<R, Dim>& minimum,
+						const std::array<R, Dim>& maximum,
+						R& entry,
+						R& exit) {
+		const R inf = R(std::numeric_limits<T>::infinity());
+		for (size_t i = 0; i < Dim; ++i) {
+			const R t1 = (minimum[i] - base[i]) * inverseDirection[i];
+			const R t2 = (maximum[i] - base[i]) * inverseDirection[i];
+			const R entering = min<R>{}(select{}(t1 == t1, t1, -inf), select{}(t2 == t2, t2, -inf));
+			const R exiting = max<R>{}(select{}(t1 == t1, t1, inf), select{}(t2 == t2, t2, inf));
+			entry = max<R>{}(entry, entering);
+			exit = min<R>{}(exit, exiting);
+		}
+		return entry <= exit;
+	}
+
+
+	/// <summary> Returns the squared distance of each lane's sphere center from each lane's box. </summary>
+	template <class T, class R, size_t Dim>
+	R DistanceSquaredToBox(const std::array<R, Dim>& point, const std::array<R, Dim>& minimum, const std::array<R, Dim>& maximum) {
+		R distanceSq = R(T(0));
+		for (size_t i = 0; i < Dim; ++i) {
+			const R offset = point[i] - min<R>{}(max<R>{}(point[i], minimum[i]), maximum[i]);
+			distanceSq = madd{}(offset, offset, distanceSq);
+		}
+		return distanceSq;
+	}
+
+
+	template <class T, int Dim>
+	std::array<T, Dim> ToArray(const Vector<T, Dim>& vector) {
+		std::array<T, Dim> elements;
+		for (int i = 0; i < Dim; ++i) {
+			elements[i] = vector[i];
+		}
+		return elements;
+	}
+
+
+	template <class Block, class T, int Dim>
+	std::array<typename Block::Block, Dim> BroadcastArray(const Vector<T, Dim>& vector) {
+		std::array<typename Block::Block, Dim> elements;
+		for (int i = 0; i < Dim; ++i) {
+			elements[i] = Block::Broadcast(vector[i]);
+		}
+		return elements;
+	}
+
+
+	template <class Block, class T, int Dim>
+	std::array<typename Block::Block, Dim> LoadArray(const VectorArray<T, Dim>& array, size_t index) {
+		std::array<typename Block::Block, Dim> elements;
+		for (int i = 0; i < Dim; ++i) {
+			elements[i] = Block::Load(array.Lane(i) + index);
+		}
+		return elements;
+	}
+
+
+	/// <summary> Evaluates <paramref name="test"/> for each block of <paramref name="count"/> elements, and packs the results into bits. </summary>
+	/// <remarks> The test is called as test(Block{}, index) and must return a condition for the block of elements starting at index.
+	///		The bits of the padding elements are cleared. </remarks>
+	template <class T, class Test>
+	std::vector<uint64_t> TestLanes(size_t count, const Test& test) {
+		using Block = LaneBlock<T>;
+		static_assert(64 % Block::size == 0, "The bits of a block must not straddle two words.");
+
+		std::vector<uint64_t> bits((count + 63) / 64, 0);
+		for (size_t index = 0; index < count; index += Block::size) {
+			bits[index / 64] |= mask_bits{}(test(Block{}, index)) << (index % 64);
+		}
+		if (count % 64 != 0) {
+			bits.back() &= (uint64_t(1) << (count % 64)) - 1;
+		}
+		return bits;
+	}
+
+} // namespace impl
+
+
+//------------------------------------------------------------------------------
+// Single objects
+//------------------------------------------------------------------------------
+
+/// <summary> Returns true if the two boxes have at least one point in common. </summary>
+template <class T, int Dim>
+bool Overlaps(const AABB<T, Dim>& lhs, const AABB<T, Dim>& rhs) {
+	for (int i = 0; i < Dim; ++i) {
+		if (!(lhs.minimum[i] <= rhs.maximum[i] && rhs.minimum[i] <= lhs.maximum[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+
+/// <summary> Returns true if the two spheres have at least one point in common. </summary>
+template <class T, int Dim>
+bool Overlaps(const Sphere<T, Dim>& lhs, const Sphere<T, Dim>& rhs) {
+	const T radius = lhs.radius + rhs.radius;
+	return !lhs.IsEmpty() && !rhs.IsEmpty() && LengthSquared(lhs.center - rhs.center) <= radius * radius;
+}
+
+
+/// <summary> Returns true if the sphere and the box have at least one point in common. </summary>
+template <class T, int Dim>
+bool Overlaps(const Sphere<T, Dim>& sphere, const AABB<T, Dim>& box) {
+	const T distanceSq = impl::DistanceSquaredToBox<T>(impl::ToArray(sphere.center), impl::ToArray(box.minimum), impl::ToArray(box.maximum));
+	return !sphere.IsEmpty() && !box.IsEmpty() && distanceSq <= sphere.radius * sphere.radius;
+}
+
+
+/// <summary> Returns true if the sphere and the box have at least one point in common. </summary>
+template <class T, int Dim>
+bool Overlaps(const AABB<T, Dim>& box, const Sphere<T, Dim>& sphere) {
+	return Overlaps(sphere, box);
+}
+
+
+/// <summary> Returns true if the ray hits the box within <paramref name="maxDistance"/> of its base. </summary>
+/// <remarks> Rays that start inside the box always hit it. </remarks>
+template <class T, int Dim>
+bool Overlaps(const Ray<T, Dim>& ray, const AABB<T, Dim>& box, T maxDistance = std::numeric_limits<T>::infinity()) {
+	T entry = T(0);
+	return impl::IntersectSlabs<T>(impl::ToArray(ray.Base()), impl::ToArray(T(1) / ray.Direction()), impl::ToArray(box.minimum), impl::ToArray(box.maximum), entry, maxDistance);
+}
+
+
+//------------------------------------------------------------------------------
+// Arrays of objects
+//
+// The arrays of boxes are given by the vector arrays of their minimum and maximum corners,
+// and the arrays of spheres by the vector arrays of their centers and radii. The tests
+// are done for as many objects at once as fit into a SIMD register.
+//
+// The results are bit sets, where the result for object i is bit i % 64 of word i / 64.
+//------------------------------------------------------------------------------
+
+/// <summary> Tests which boxes of the array overlap <paramref name="box"/>. </summary>
+template <class T, int Dim>
+std::vector<uint64_t> Overlaps(const AABB<T, Dim>& box, const VectorArray<T, Dim>& minima, const VectorArray<T, Dim>& maxima) {
+	assert(minima.Size() == maxima.Size());
+	return impl::TestLanes<T>(minima.Size(), [&](auto block, size_t index) {
+		using Block = decltype(block);
+		auto result = (Block::Load(minima.Lane(0) + index) <= Block::Broadcast(box.maximum[0]))
+					  & (Block::Broadcast(box.minimum[0]) <= Block::Load(maxima.Lane(0) + index));
+		for (int i = 1; i < Dim; ++i) {
+			result = result & (Block::Load(minima.Lane(i) + index) <= Block::Broadcast(box.maximum[i]))
+					 & (Block::Broadcast(box.minimum[i]) <= Block::Load(maxima.Lane(i) + index));
+		}
+		return result;
+	});
+}
+
+
+/// <summary> Tests which boxes of the array overlap <paramref name="sphere"/>. </summary>
+template <class T, int Dim>
+std::vector<uint64_t> Overlaps(const Sphere<T, Dim>& sphere, const VectorArray<T, Dim>& minima, const VectorArray<T, Dim>& maxima) {
+	assert(minima.Size() == maxima.Size());
+	if (sphere.IsEmpty()) {
+		return std::vector<uint64_t>((minima.Size() + 63) / 64, 0);
+	}
+	return impl::TestLanes<T>(minima.Size(), [&](auto block, size_t index) {
+		using Block = decltype(block);
+		const auto center = impl::BroadcastArray<Block>(sphere.center);
+		const auto distanceSq = impl::DistanceSquaredToBox<T>(center, impl::LoadArray<Block>(minima, index), impl::LoadArray<Block>(maxima, index));
+		auto nonEmpty = Block::Load(minima.Lane(0) + index) <= Block::Load(maxima.Lane(0) + index);
+		for (int i = 1; i < Dim; ++i) {
+			nonEmpty = nonEmpty & (Block::Load(minima.Lane(i) + index) <= Block::Load(maxima.Lane(i) + index));
+		}
+		return nonEmpty & (distanceSq <= Block::Broadcast(sphere.radius * sphere.radius));
+	});
+}
+
+
+/// <summary> Tests which spheres of the array overlap <paramref name="sphere"/>. </summary>
+template <class T, int Dim>
+std::vector<uint64_t> Overlaps(const Sphere<T, Dim>& sphere, const VectorArray<T, Dim>& centers, const VectorArray<T, 1>& radii) {
+	assert(centers.Size() == radii.Size());
+	if (sphere.IsEmpty()) {
+		return std::vector<uint64_t>((centers.Size() + 63) / 64, 0);
+	}
+	return impl::TestLanes<T>(centers.Size(), [&](auto block, size_t index) {
+		using Block = decltype(block);
+		auto distanceSq = Block::Broadcast(T(0));
+		for (int i = 0; i < Dim; ++i) {
+			const auto offset = Block::Load(centers.Lane(i) + index) - Block::Broadcast(sphere.center[i]);
+			distanceSq = madd{}(offset, offset, distanceSq);
+		}
+		const auto radius = Block::Load(radii.Lane(0) + index);
+		const auto sum = radius + Block::Broadcast(sphere.radius);
+		return (radius >= Block::Broadcast(T(0))) & (distanceSq <= sum * sum);
+	});
+}
+
+
+/// <summary> Tests which boxes of the array the ray hits within <paramref name="maxDistance"/> of its base. </summary>
+template <class T, int Dim>
+std::vector<uint64_t> Overlaps(const Ray<T, Dim>& ray, const VectorArray<T, Dim>& minima, const VectorArray<T, Dim>& maxima, T maxDistance = std::numeric_limits<T>::infinity()) {
+	assert(minima.Size() == maxima.Size());
+	const Vector<T, Dim> inverseDirection = T(1) / ray.Direction();
+	return impl::TestLanes<T>(minima.Size(), [&](auto block, size_t index) {
+		using Block = decltype(block);
+		auto entry = Block::Broadcast(T(0));
+		auto exit = Block::Broadcast(maxDistance);
+		return impl::IntersectSlabs<T>(impl::BroadcastArray<Block>(ray.Base()),
+									impl::BroadcastArray<Block>(inverseDirection),
+									impl::LoadArray<Block>(minima, index),
+									impl::LoadArray<Block>(maxima, index),
+									entry,
+									exit);
+	});
+}
+
+
+/// <summary> Tests which points of the array are inside <paramref name="box"/> or on its boundary. </summary>
+template <class T, int Dim>
+std::vector<uint64_t> Contains(const AABB<T, Dim>& box, const VectorArray<T, Dim>& points) {
+	return impl::TestLanes<T>(points.Size(), [&](auto block, size_t index) {
+		using Block = decltype(block);
+		auto result = (Block::Broadcast(box.minimum[0]) <= Block::Load(points.Lane(0) + index))
+					  & (Block::Load(points.Lane(0) + index) <= Block::Broadcast(box.maximum[0]));
+		for (int i = 1; i < Dim; ++i) {
+			result = result & (Block::Broadcast(box.minimum[i]) <= Block::Load(points.Lane(i) + index))
+					 & (Block::Load(points.Lane(i) + index) <= Block::Broadcast(box.maximum[i]));
+		}
+		return result;
+	});
+}
+
+
+/// <summary> Tests which points of the array are inside <paramref name="sphere"/> or on its surface. </summary>
+template <class T, int Dim>
+std::vector<uint64_t> Contains(const Sphere<T, Dim>& sphere, const VectorArray<T, Dim>& points) {
+	if (sphere.IsEmpty()) {
+		return std::vector<uint64_t>((points.Size() + 63) / 64, 0);
+	}
+	return impl::TestLanes<T>(points.Size(), [&](auto block, size_t index) {
+		using Block = decltype(block);
+		auto distanceSq = Block::Broadcast(T(0));
+		for (int i = 0; i < Dim; ++i) {
+			const auto offset = Block::Load(points.Lane(i) + index) - Block::Broadcast(sphere.center[i]);
+			distanceSq = madd{}(offset, offset, distanceSq);
+		}
+		return distanceSq <= Block::Broadcast(sphere.radius * sphere.radius);
+	});
+}
+
+} // namespace mathter
@@ -0,0 +1,283 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#pragma once
+
+#include "../Common/Functional.hpp"
+#include "../Vector/SIMDUtil.hpp"
+#include "Ray.hpp"
+#include "Triangle.hpp"
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+
+namespace mathter {
+
+namespace impl {
+
+	/// <summary> The number of lanes a packet of <paramref name="size"/> elements stores, so that it can be processed in whole blocks. </summary>
+	template <class T>
+	constexpr size_t PacketLanes(int size) {
+		return PadLaneSize(size_t(size), LaneBlock<T>::size);
+	}
+
+
+	/// <summary> Three lanes of coordinates for the x, y, and z of a packet of vectors. </summary>
+	template <class T, int Size>
+	using PacketLanes3 = std::array<std::array<T, PacketLanes<T>(Size)>, 3>;
+
+
+	template <class T, int Size>
+	void SetPacketVector(PacketLanes3<T, Size>& lanes, int index, const Vector<T, 3>& value) {
+		for (int i = 0; i < 3; ++i) {
+			lanes[i][index] = value[i];
+		}
+	}
+
+
+	template <class T, int Size>
+	Vector<T, 3> GetPacketVector(const PacketLanes3<T, Size>& lanes, int index) {
+		return { lanes[0][index], lanes[1][index], lanes[2][index] };
+	}
+
+
+	template <class R>
+	std::array<R, 3> CrossLanes(const std::array<R, 3>& lhs, const std::array<R, 3>& rhs) {
+		return {
+			lhs[1] * rhs[2] - lhs[2] * rhs[1],
+			lhs[2] * rhs[0] - lhs[0] * rhs[2],
+			lhs[0] * rhs[1] - lhs[1] * rhs[0],
+		};
+	}
+
+
+	template <class R>
+	R DotLanes(const std::array<R, 3>& lhs, const std::array<R, 3>& rhs) {
+		return lhs[0] * rhs[0] + lhs[1] * rhs[1] + lhs[2] * rhs[2];
+	}
+
+
+	/// <summary> Möller-Trumbore ray-triangle intersection of each lane without branches. </summary>
+	/// <remarks> The tests are the same as the scalar <see cref="Intersect"/>, so the two give the same hits.
+	///		Where the ray misses, <paramref name="t"/> is set to infinity and the barycentrics to zero. </remarks>
+	/// <returns> The condition that is true for the lanes where the ray hits the triangle. </returns>
+	template <class T, class R>
+	auto IntersectLanes(const std::array<R, 3>& base,
+						const std::array<R, 3>& direction,
+						const std::array<R, 3>& corner,
+						const std::array<R, 3>& edge1,
+						const std::array<R, 3>& edge2,
+						R& t,
+						R& u,
+						R& v) {
+		const R epsilon = R(std::numeric_limits<T>::epsilon());
+		const R zero = R(T(0));
+		const R one = R(T(1));
+
+		const auto h = CrossLanes(direction, edge2);
+		const R a = DotLanes(edge1, h);
+		const R f = one / a;
+		const std::array<R, 3> s = { base[0] - corner[0], base[1] - corner[1], base[2] - corner[2] };
+		const auto q = CrossLanes(s, edge1);
+
+		u = f * DotLanes(s, h);
+		v = f * DotLanes(direction, q);
+		t = f * DotLanes(edge2, q);
+
+		const auto hit = (abs{}(a) >= epsilon) & (u >= zero) & (u <= one) & (v >= zero) & (u + v <= one) & (t >= epsilon);
+		t = select{}(hit, t, R(std::numeric_limits<T>::infinity()));
+		u = select{}(hit, u, zero);
+		v = select{}(hit, v, zero);
+		return hit;
+	}
+
+} // namespace impl
+
+
+/// <summary> The result of intersecting a packet of rays with a triangle, or a ray with a packet of triangles. </summary>
+template <class T, int Size>
+struct PacketHits {
+	/// <summary> Bit i is set if the i-th ray or triangle of the packet is hit. </summary>
+	uint64_t mask;
+	/// <summary> The distances along the rays to the hit points, infinity where there is no hit. </summary>
+	alignas(impl::laneAlignment) std::array<T, impl::PacketLanes<T>(Size)> distance;
+	/// <summary> The barycentric coordinate of the hit point for the triangles' second corner, zero where there is no hit. </summary>
+	alignas(impl::laneAlignment) std::array<T, impl::PacketLanes<T>(Size)> u;
+	/// <summary> The barycentric coordinate of the hit point for the triangles' third corner, zero where there is no hit. </summary>
+	/// <remarks> The barycentric coordinate for the first corner is 1 - u - v. </remarks>
+	alignas(impl::laneAlignment) std::array<T, impl::PacketLanes<T>(Size)> v;
+
+	/// <summary> Tells if the i-th ray or triangle is hit. </summary>
+	bool Hit(int index) const {
+		return (mask >> index) & 1u;
+	}
+};
+
+
+/// <summary> A fixed number of rays stored as a structure of arrays, so that they can be intersected together using SIMD. </summary>
+/// <remarks> Packets work best with coherent rays, such as primary rays of nearby pixels, or shadow rays towards the same light. </remarks>
+template <class T, int Size>
+class RayPacket {
+	static_assert(1 <= Size && Size <= 64, "The hit mask of a packet can hold at most 64 rays.");
+	using Vec = Vector<T, 3>;
+
+public:
+	/// <summary> Creates a packet of degenerate rays that don't hit anything. </summary>
+	RayPacket() {
+		for (auto& lane : bases) {
+			lane.fill(T(0));
+		}
+		for (auto& lane : directions) {
+			lane.fill(T(0));
+		}
+	}
+
+	/// <summary> Creates a packet from the first <typeparamref name="Size"/> rays of the array. </summary>
+	explicit RayPacket(const Ray<T, 3>* rays) : RayPacket() {
+		for (int i = 0; i < Size; ++i) {
+			Set(i, rays[i]);
+		}
+	}
+
+	/// <summary> The number of rays in the packet. </summary>
+	static constexpr int size = Size;
+
+	/// <summary> Replaces the i-th ray of the packet. </summary>
+	void Set(int index, const Ray<T, 3>& ray) {
+		impl::SetPacketVector<T, Size>(bases, index, ray.Base());
+		impl::SetPacketVector<T, Size>(directions, index, ray.Direction());
+	}
+
+	/// <summary> Returns the i-th ray of the packet. </summary>
+	Ray<T, 3> Get(int index) const {
+		return Ray<T, 3>(impl::GetPacketVector<T, Size>(bases, index), impl::GetPacketVector<T, Size>(directions, index));
+	}
+
+public:
+	/// <summary> The x, y, and z coordinates of the rays' bases. </summary>
+	/// <remarks> The lanes are padded to a multiple of the SIMD register, the padding holds rays that don't hit anything. </remarks>
+	alignas(impl::laneAlignment) impl::PacketLanes3<T, Size> bases;
+	/// <summary> The x, y, and z coordinates of the rays' directions. </summary>
+	alignas(impl::laneAlignment) impl::PacketLanes3<T, Size> directions;
+};
+
+
+/// <summary> A fixed number of triangles stored as a structure of arrays, so that they can be intersected together using SIMD. </summary>
+/// <remarks> The triangles are stored as their first corner and two edges, which is what the intersection needs. </remarks>
+template <class T, int Size>
+class TrianglePacket {
+	static_assert(1 <= Size && Size <= 64, "The hit mask of a packet can hold at most 64 triangles.");
+	using Vec = Vector<T, 3>;
+
+public:
+	/// <summary> Creates a packet of degenerate triangles that don't get hit. </summary>
+	TrianglePacket() {
+		for (auto* lanes : { &corners, &edges1, &edges2 }) {
+			for (auto& lane : *lanes) {
+				lane.fill(T(0));
+			}
+		}
+	}
+
+	/// <summary> Creates a packet from the first <typeparamref name="Size"/> triangles of the array. </summary>
+	explicit TrianglePacket(const Triangle<T, 3>* triangles) : TrianglePacket() {
+		for (int i = 0; i < Size; ++i) {
+			Set(i, triangles[i]);
+		}
+	}
+
+	/// <summary> The number of triangles in the packet. </summary>
+	static constexpr int size = Size;
+
+	/// <summary> Replaces the i-th triangle of the packet. </summary>
+	void Set(int index, const Triangle<T, 3>& triangle) {
+		const Vec corner = triangle.corners[0];
+		impl::SetPacketVector<T, Size>(corners, index, corner);
+		impl::SetPacketVector<T, Size>(edges1, index, triangle.corners[1] - corner);
+		impl::SetPacketVector<T, Size>(edges2, index, triangle.corners[2] - corner);
+	}
+
+	/// <summary> Returns the i-th triangle of the packet. </summary>
+	Triangle<T, 3> Get(int index) const {
+		const Vec corner = impl::GetPacketVector<T, Size>(corners, index);
+		return Triangle<T, 3>(corner,
+							  corner + impl::GetPacketVector<T, Size>(edges1, index),
+							  corner + impl::GetPacketVector<T, Size>(edges2, index));
+	}
+
+public:
+	/// <summary> The x, y, and z coordinates of the triangles' first corners. </summary>
+	/// <remarks> The lanes are padded to a multiple of the SIMD register, the padding holds degenerate triangles. </remarks>
+	alignas(impl::laneAlignment) impl::PacketLanes3<T, Size> corners;
+	/// <summary> The x, y, and z coordinates of the edges from the first to the second corners. </summary>
+	alignas(impl::laneAlignment) impl::PacketLanes3<T, Size> edges1;
+	/// <summary> The x, y, and z coordinates of the edges from the first to the third corners. </summary>
+	alignas(impl::laneAlignment) impl::PacketLanes3<T, Size> edges2;
+};
+
+
+/// <summary> Intersects each ray of the packet with the triangle. </summary>
+/// <remarks> Gives the same hits as intersecting the rays one by one, but without branches. </remarks>
+template <class T, int Size>
+PacketHits<T, Size> Intersect(const RayPacket<T, Size>& rays, const Triangle<T, 3>& triangle) {
+	using Block = impl::LaneBlock<T>;
+	using R = typename Block::Block;
+	using Vec = Vector<T, 3>;
+
+	const Vec corner = triangle.corners[0];
+	const Vec edge1 = triangle.corners[1] - corner;
+	const Vec edge2 = triangle.corners[2] - corner;
+	const auto broadcast = [](const Vec& vector) {
+		return std::array<R, 3>{ Block::Broadcast(vector[0]), Block::Broadcast(vector[1]), Block::Broadcast(vector[2]) };
+	};
+	const auto corners = broadcast(corner);
+	const auto edges1 = broadcast(edge1);
+	const auto edges2 = broadcast(edge2);
+
+	PacketHits<T, Size> hits;
+	hits.mask = 0;
+	for (size_t i = 0; i < impl::PacketLanes<T>(Size); i += Block::size) {
+		const std::array<R, 3> base = { Block::Load(&rays.bases[0][i]), Block::Load(&rays.bases[1][i]), Block::Load(&rays.bases[2][i]) };
+		const std::array<R, 3> direction = { Block::Load(&rays.directions[0][i]), Block::Load(&rays.directions[1][i]), Block::Load(&rays.directions[2][i]) };
+		R t, u, v;
+		const auto hit = impl::IntersectLanes<T>(base, direction, corners, edges1, edges2, t, u, v);
+		Block::Store(&hits.distance[i], t);
+		Block::Store(&hits.u[i], u);
+		Block::Store(&hits.v[i], v);
+		hits.mask |= mask_bits{}(hit) << i;
+	}
+	return hits;
+}
+
+
+/// <summary> Intersects the ray with each triangle of the packet. </summary>
+/// <remarks> Gives the same hits as intersecting the triangles one by one, but without branches. </remarks>
+template <class T, int Size>
+PacketHits<T, Size> Intersect(const Ray<T, 3>& ray, const TrianglePacket<T, Size>& triangles) {
+	using Block = impl::LaneBlock<T>;
+	using R = typename Block::Block;
+
+	const std::array<R, 3> base = { Block::Broadcast(ray.Base()[0]), Block::Broadcast(ray.Base()[1]), Block::Broadcast(ray.Base()[2]) };
+	const std::array<R, 3> direction = { Block::Broadcast(ray.Direction()[0]), Block::Broadcast(ray.Direction()[1]), Block::Broadcast(ray.Direction()[2]) };
+
+	PacketHits<T, Size> hits;
+	hits.mask = 0;
+	for (size_t i = 0; i < impl::PacketLanes<T>(Size); i += Block::size) {
+		const std::array<R, 3> corner = { Block::Load(&triangles.corners[0][i]), Block::Load(&triangles.corners[1][i]), Block::Load(&triangles.corners[2][i]) };
+		const std::array<R, 3> edge1 = { Block::Load(&triangles.edges1[0][i]), Block::Load(&triangles.edges1[1][i]), Block::Load(&triangles.edges1[2][i]) };
+		const std::array<R, 3> edge2 = { Block::Load(&triangles.edges2[0][i]), Block::Load(&triangles.edges2[1][i]), Block::Load(&triangles.edges2[2][i]) };
+		R t, u, v;
+		const auto hit = impl::IntersectLanes<T>(base, direction, corner, edge1, edge2, t, u, v);
+		Block::Store(&hits.distance[i], t);
+		Block::Store(&hits.u[i], u);
+		Block::Store(&hits.v[i], v);
+		hits.mask |= mask_bits{}(hit) << i;
+	}
+	return hits;
+}
+
+} // namespace mathter
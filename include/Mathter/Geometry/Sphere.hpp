@@ -0,0 +1,100 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#pragma once
+
+#include "../Vector/Math.hpp"
+#include "../Vector/Vector.hpp"
+#include "AABB.hpp"
+
+#include <cmath>
+
+
+namespace mathter {
+
+/// <summary> A ball in any dimensions, a circle in 2D or a sphere in 3D. </summary>
+/// <remarks> The sphere is closed, so points on its surface are inside. </remarks>
+template <class T, int Dim>
+class Sphere {
+	using Vec = Vector<T, Dim>;
+
+public:
+	/// <summary> Does not initialize the object. </summary>
+	Sphere() = default;
+
+	/// <summary> Construct a sphere from its center and radius. </summary>
+	Sphere(const Vec& center, const T& radius)
+		: center(center), radius(radius) {}
+
+	/// <summary> Convert from a sphere with different scalar type. </summary>
+	template <class TOther>
+	Sphere(const Sphere<TOther, Dim>& other)
+		: center(other.center), radius(static_cast<T>(other.radius)) {}
+
+	/// <summary> Returns a sphere that contains nothing, not even a single point. </summary>
+	/// <remarks> Expanding the empty sphere by a point results in a sphere of zero radius around that point. </remarks>
+	static Sphere Empty() {
+		return Sphere(Vec(T(0)), T(-1));
+	}
+
+	/// <summary> Returns true if the sphere contains no points. </summary>
+	bool IsEmpty() const {
+		return radius < T(0);
+	}
+
+	/// <summary> Returns the smallest axis-aligned box that contains the sphere. </summary>
+	AABB<T, Dim> Bounds() const {
+		return AABB<T, Dim>(center - radius, center + radius);
+	}
+
+	/// <summary> Grows the sphere just enough to contain <paramref name="point"/>. </summary>
+	/// <remarks> The center moves towards the point, so the result is the smallest sphere containing the original sphere and the point. </remarks>
+	void Expand(const Vec& point) {
+		Expand(Sphere(point, T(0)));
+	}
+
+	/// <summary> Grows the sphere just enough to contain <paramref name="other"/>. </summary>
+	void Expand(const Sphere& other) {
+		if (other.IsEmpty()) {
+			return;
+		}
+		if (IsEmpty()) {
+			*this = other;
+			return;
+		}
+		const auto offset = other.center - center;
+		const T distance = Length(offset);
+		if (distance + other.radius <= radius) {
+			return;
+		}
+		if (distance + radius <= other.radius) {
+			*this = other;
+			return;
+		}
+		const T newRadius = (distance + radius + other.radius) / T(2);
+		center += offset * ((newRadius - radius) / distance);
+		radius = newRadius;
+	}
+
+	/// <summary> Returns true if <paramref name="point"/> is inside the sphere or on its surface. </summary>
+	bool Contains(const Vec& point) const {
+		return LengthSquared(point - center) <= radius * radius && !IsEmpty();
+	}
+
+public:
+	Vec center;
+	T radius;
+};
+
+
+/// <summary> Returns the smallest sphere that contains both spheres. </summary>
+template <class T, int Dim>
+Sphere<T, Dim> Union(const Sphere<T, Dim>& lhs, const Sphere<T, Dim>& rhs) {
+	auto result = lhs;
+	result.Expand(rhs);
+	return result;
+}
+
+} // namespace mathter
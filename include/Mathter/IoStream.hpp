@@ -7,13 +7,16 @@
 
 #include "Common/TypeTraits.hpp"
 #include "Matrix/Matrix.hpp"
+#include "Matrix/MatrixDynamic.hpp"
 #include "Quaternion/Math.hpp"
 #include "Quaternion/Quaternion.hpp"
 #include "Utility.hpp"
 #include "Vector/Vector.hpp"
+#include "Vector/VectorDynamic.hpp"
 
 #include <iostream>
 #include <type_traits>
+#include <vector>
 
 namespace mathter {
 
@@ -138,6 +141,18 @@ namespace impl {
 	}
 
 
+	template <class Char, class CharTraits,
+			  class Iterator>
+	void PrintRange(std::basic_ostream<Char, CharTraits>& os, Iterator first, Iterator last) {
+		os << "[";
+		for (auto it = first; it != last; ++it) {
+			it != first ? static_cast<void>(os << ", ") : void();
+			PrintElement(os, *it);
+		}
+		os << "]";
+	}
+
+
 	template <class Char, class CharTraits,
 			  class Element, size_t Size>
 	void ParseArray(std::basic_istream<Char, CharTraits>& is, std::array<Element, Size>& array) {
@@ -183,6 +198,26 @@ auto operator<<(std::basic_ostream<Char, CharTraits>& os, const Matrix<T, Rows,
 }
 
 
+template <class Char, class CharTraits,
+		  class T, bool Packed>
+auto operator<<(std::basic_ostream<Char, CharTraits>& os, const Vector<T, DYNAMIC, Packed>& v) -> std::basic_ostream<Char, CharTraits>& {
+	impl::PrintRange(os, v.begin(), v.end());
+	return os;
+}
+
+
+template <class Char, class CharTraits,
+		  class T, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+auto operator<<(std::basic_ostream<Char, CharTraits>& os, const Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed>& m) -> std::basic_ostream<Char, CharTraits>& {
+	std::vector<Vector<T, DYNAMIC, Packed>> rows;
+	for (size_t row = 0; row < m.RowCount(); ++row) {
+		rows.push_back(m.Row(row));
+	}
+	impl::PrintRange(os, rows.begin(), rows.end());
+	return os;
+}
+
+
 template <class Char, class CharTraits,
 		  class T, eQuaternionLayout Layout, bool Packed>
 auto operator<<(std::basic_ostream<Char, CharTraits>& os, const Quaternion<T, Layout, Packed>& q) -> std::basic_ostream<Char, CharTraits>& {
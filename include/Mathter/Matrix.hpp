@@ -5,8 +5,12 @@
 
 #pragma once
 
+#include "Matrix/Affine.hpp"
 #include "Matrix/Arithmetic.hpp"
 #include "Matrix/Cast.hpp"
 #include "Matrix/Comparison.hpp"
 #include "Matrix/Math.hpp"
 #include "Matrix/Matrix.hpp"
+#include "Matrix/MatrixArray.hpp"
+#include "Matrix/MatrixDynamic.hpp"
+#include "Matrix/TransformPoints.hpp"
@@ -0,0 +1,294 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#pragma once
+
+#include "../Common/TypeTraits.hpp"
+#include "../Vector/Vector.hpp"
+#include "../Vector/VectorArray.hpp"
+#include "Arithmetic.hpp"
+#include "Comparison.hpp"
+#include "Math.hpp"
+#include "Matrix.hpp"
+#include "TransformPoints.hpp"
+
+#include <cstddef>
+#include <type_traits>
+
+
+namespace mathter {
+
+
+/// <summary> An affine transform, that is, a linear transform followed by a translation. </summary>
+/// <typeparam name="T"> The scalar type of the elements. </typeparam>
+/// <typeparam name="Dim"> The dimension of the space the transform operates on. </typeparam>
+/// <typeparam name="Packed"> If true, tightly packs the rows of the matrix and disables SIMD optimization. </typeparam>
+/// <remarks>
+/// Only the top Dim x (Dim + 1) part of the homogeneous transform matrix is stored, as the last row is always (0, ..., 0, 1).
+/// For 3D, that's 12 scalars instead of 16. The matrix is stored in precede-vector order and row-major layout,
+/// with the linear transform in the first Dim columns and the translation in the last column.
+/// Like precede-vector matrices, transforms are combined right-to-left, so `a * b` applies `b` first.
+/// </remarks>
+template <class T, int Dim, bool Packed = false>
+class Affine {
+public:
+	using MatrixType = Matrix<T, Dim, Dim + 1, eMatrixOrder::PRECEDE_VECTOR, eMatrixLayout::ROW_MAJOR, Packed>;
+	using LinearType = Matrix<T, Dim, Dim, eMatrixOrder::PRECEDE_VECTOR, eMatrixLayout::ROW_MAJOR, Packed>;
+
+	/// <summary> The top Dim rows of the homogeneous transform matrix. </summary>
+	MatrixType matrix;
+
+	//-----------------------------------------------
+	// Constructors
+	//-----------------------------------------------
+
+	/// <summary> Does NOT zero-initialize values. </summary>
+	Affine() = default;
+
+	/// <summary> Sets the top Dim rows of the homogeneous transform matrix. </summary>
+	explicit Affine(const MatrixType& matrix) : matrix(matrix) {}
+
+	/// <summary> Creates the transform that first applies <paramref name="linear"/>, then translates. </summary>
+	Affine(const LinearType& linear, const Vector<T, Dim, Packed>& translation);
+
+	/// <summary> Converts a transform builder, like <see cref="Translation"/> or <see cref="RotationAxisAngle"/>. </summary>
+	/// <remarks> Any object that converts to a Dim x (Dim + 1) precede-vector matrix is accepted. </remarks>
+	template <class Transform, std::enable_if_t<!is_matrix_v<Transform> && std::is_convertible_v<const Transform&, MatrixType>, int> = 0>
+	Affine(const Transform& transform) : matrix(transform) {}
+
+	/// <summary> Converts an affine transform matrix. </summary>
+	/// <remarks> The matrix must be square with one more row than <typeparamref name="Dim"/>,
+	///		(Dim + 1) x Dim with follow-vector order, or Dim x (Dim + 1) with precede-vector order.
+	///		For square matrices, the last row (or column for follow-vector order) is ignored. </remarks>
+	template <class TOther, int RowsOther, int ColumnsOther, eMatrixOrder OrderOther, eMatrixLayout LayoutOther, bool PackedOther>
+	explicit Affine(const Matrix<TOther, RowsOther, ColumnsOther, OrderOther, LayoutOther, PackedOther>& matrix);
+
+	//-----------------------------------------------
+	// Conversion operators
+	//-----------------------------------------------
+
+	/// <summary> Converts to a homogeneous transform matrix. </summary>
+	/// <remarks> The shape of the matrix must be one that the converting constructor accepts. </remarks>
+	template <class TOther, int RowsOther, int ColumnsOther, eMatrixOrder OrderOther, eMatrixLayout LayoutOther, bool PackedOther>
+	explicit operator Matrix<TOther, RowsOther, ColumnsOther, OrderOther, LayoutOther, PackedOther>() const;
+
+	//-----------------------------------------------
+	// Parts
+	//-----------------------------------------------
+
+	/// <summary> Returns the linear part of the transform, without the translation. </summary>
+	LinearType Linear() const;
+
+	/// <summary> Returns the translation part of the transform. </summary>
+	Vector<T, Dim, Packed> Translation() const;
+};
+
+
+//------------------------------------------------------------------------------
+// Helpers
+//------------------------------------------------------------------------------
+
+namespace impl {
+
+	template <int Dim, eMatrixOrder Order, int Rows, int Columns>
+	constexpr bool IsAffineTransformShape() {
+		return (Rows == Dim + 1 && Columns == Dim + 1)
+			   || (Order == eMatrixOrder::FOLLOW_VECTOR && Rows == Dim + 1 && Columns == Dim)
+			   || (Order == eMatrixOrder::PRECEDE_VECTOR && Rows == Dim && Columns == Dim + 1);
+	}
+
+} // namespace impl
+
+
+//------------------------------------------------------------------------------
+// Constructors
+//------------------------------------------------------------------------------
+
+template <class T, int Dim, bool Packed>
+Affine<T, Dim, Packed>::Affine(const LinearType& linear, const Vector<T, Dim, Packed>& translation) {
+	for (int i = 0; i < Dim; ++i) {
+		matrix.stripes[i] = Vector<T, Dim + 1, Packed>(linear.stripes[i], translation[i]);
+	}
+}
+
+
+template <class T, int Dim, bool Packed>
+template <class TOther, int RowsOther, int ColumnsOther, eMatrixOrder OrderOther, eMatrixLayout LayoutOther, bool PackedOther>
+Affine<T, Dim, Packed>::Affine(const Matrix<TOther, RowsOther, ColumnsOther, OrderOther, LayoutOther, PackedOther>& matrix) {
+	static_assert(impl::IsAffineTransformShape<Dim, OrderOther, RowsOther, ColumnsOther>(), "Matrix does not represent an affine transform.");
+	for (int i = 0; i < Dim; ++i) {
+		for (int j = 0; j < Dim + 1; ++j) {
+			if constexpr (OrderOther == eMatrixOrder::PRECEDE_VECTOR) {
+				this->matrix(i, j) = static_cast<T>(matrix(i, j));
+			}
+			else {
+				this->matrix(i, j) = static_cast<T>(matrix(j, i));
+			}
+		}
+	}
+}
+
+
+template <class T, int Dim, bool Packed>
+template <class TOther, int RowsOther, int ColumnsOther, eMatrixOrder OrderOther, eMatrixLayout LayoutOther, bool PackedOther>
+Affine<T, Dim, Packed>::operator Matrix<TOther, RowsOther, ColumnsOther, OrderOther, LayoutOther, PackedOther>() const {
+	static_assert(impl::IsAffineTransformShape<Dim, OrderOther, RowsOther, ColumnsOther>(), "Matrix cannot represent an affine transform.");
+	Matrix<TOther, RowsOther, ColumnsOther, OrderOther, LayoutOther, PackedOther> result;
+	constexpr int rows = OrderOther == eMatrixOrder::PRECEDE_VECTOR ? RowsOther : ColumnsOther;
+	for (int i = 0; i < rows; ++i) {
+		for (int j = 0; j < Dim + 1; ++j) {
+			const auto value = i < Dim ? static_cast<TOther>(matrix(i, j)) : static_cast<TOther>(j == Dim);
+			if constexpr (OrderOther == eMatrixOrder::PRECEDE_VECTOR) {
+				result(i, j) = value;
+			}
+			else {
+				result(j, i) = value;
+			}
+		}
+	}
+	return result;
+}
+
+
+template <class T, int Dim, bool Packed>
+auto Affine<T, Dim, Packed>::Linear() const -> LinearType {
+	return matrix.template Extract<Dim, Dim>(0, 0);
+}
+
+
+template <class T, int Dim, bool Packed>
+Vector<T, Dim, Packed> Affine<T, Dim, Packed>::Translation() const {
+	return matrix.Column(Dim);
+}
+
+
+//------------------------------------------------------------------------------
+// Arithmetic
+//------------------------------------------------------------------------------
+
+/// <summary> Combines two transforms, <paramref name="rhs"/> is applied first. </summary>
+/// <remarks> Cheaper than multiplying full homogeneous matrices because the constant last row is skipped. </remarks>
+template <class T, int Dim, bool Packed>
+Affine<T, Dim, Packed> operator*(const Affine<T, Dim, Packed>& lhs, const Affine<T, Dim, Packed>& rhs) {
+	// Each row of the result is a combination of the rows of rhs, plus the translation of lhs.
+	Affine<T, Dim, Packed> result;
+	for (int i = 0; i < Dim; ++i) {
+		auto row = lhs.matrix(i, 0) * rhs.matrix.stripes[0];
+		for (int k = 1; k < Dim; ++k) {
+			row += lhs.matrix(i, k) * rhs.matrix.stripes[k];
+		}
+		row[Dim] += lhs.matrix(i, Dim);
+		result.matrix.stripes[i] = row;
+	}
+	return result;
+}
+
+
+template <class T, int Dim, bool Packed>
+Affine<T, Dim, Packed>& operator*=(Affine<T, Dim, Packed>& lhs, const Affine<T, Dim, Packed>& rhs) {
+	return lhs = lhs * rhs;
+}
+
+
+template <class T1, class T2, int Dim, bool Packed1, bool Packed2>
+bool operator==(const Affine<T1, Dim, Packed1>& lhs, const Affine<T2, Dim, Packed2>& rhs) {
+	return lhs.matrix == rhs.matrix;
+}
+
+
+template <class T1, class T2, int Dim, bool Packed1, bool Packed2>
+bool operator!=(const Affine<T1, Dim, Packed1>& lhs, const Affine<T2, Dim, Packed2>& rhs) {
+	return !(lhs == rhs);
+}
+
+
+/// <summary> Applies the transform to a point, including the translation. </summary>
+template <class T, int Dim, bool Packed, class TOther, bool PackedOther>
+Vector<T, Dim, Packed> TransformPoint(const Affine<T, Dim, Packed>& transform, const Vector<TOther, Dim, PackedOther>& point) {
+	const Vector<T, Dim + 1, Packed> homogeneous(Vector<T, Dim, Packed>(point), T(1));
+	Vector<T, Dim, Packed> result;
+	for (int i = 0; i < Dim; ++i) {
+		result[i] = Dot(transform.matrix.stripes[i], homogeneous);
+	}
+	return result;
+}
+
+
+/// <summary> Applies the transform to a direction, ignoring the translation. </summary>
+template <class T, int Dim, bool Packed, class TOther, bool PackedOther>
+Vector<T, Dim, Packed> TransformDirection(const Affine<T, Dim, Packed>& transform, const Vector<TOther, Dim, PackedOther>& direction) {
+	const Vector<T, Dim + 1, Packed> homogeneous(Vector<T, Dim, Packed>(direction), T(0));
+	Vector<T, Dim, Packed> result;
+	for (int i = 0; i < Dim; ++i) {
+		result[i] = Dot(transform.matrix.stripes[i], homogeneous);
+	}
+	return result;
+}
+
+
+//------------------------------------------------------------------------------
+// Inverse
+//------------------------------------------------------------------------------
+
+/// <summary> Returns the inverse of an affine transform. </summary>
+/// <remarks> Only the linear part is inverted as a matrix, the translation is simply transformed by it,
+///		which is much cheaper than inverting the full homogeneous matrix. The linear part must be invertible. </remarks>
+template <class T, int Dim, bool Packed>
+Affine<T, Dim, Packed> Inverse(const Affine<T, Dim, Packed>& transform) {
+	const auto linear = typename Affine<T, Dim, Packed>::LinearType(Inverse(transform.Linear()));
+	return { linear, -(linear * transform.Translation()) };
+}
+
+
+/// <summary> Returns the inverse of a rigid transform, that is, a rotation followed by a translation. </summary>
+/// <remarks> The inverse of a rotation is its transpose, so this doesn't need a matrix inverse at all.
+///		The result is wrong if the linear part is not a rotation, for example, if it has scaling. </remarks>
+template <class T, int Dim, bool Packed>
+Affine<T, Dim, Packed> InverseRigid(const Affine<T, Dim, Packed>& transform) {
+	const auto linear = typename Affine<T, Dim, Packed>::LinearType(Transpose(transform.Linear()));
+	return { linear, -(linear * transform.Translation()) };
+}
+
+
+//------------------------------------------------------------------------------
+// Arrays
+//------------------------------------------------------------------------------
+
+/// <summary> Transforms an array of points by an affine transform. </summary>
+/// <remarks> See the overload for matrices for details. </remarks>
+template <class T, bool PackedIn, bool PackedOut, class TA, bool PackedA>
+void TransformPoints(const Vector<T, 3, PackedIn>* points,
+					 size_t count,
+					 const Affine<TA, 3, PackedA>& transform,
+					 Vector<T, 3, PackedOut>* out) {
+	TransformPoints(points, count, transform.matrix, out);
+}
+
+
+/// <summary> Transforms an array of points by an affine transform. </summary>
+template <class T, class TA, bool PackedA>
+VectorArray<T, 3> TransformPoints(const VectorArray<T, 3>& points, const Affine<TA, 3, PackedA>& transform) {
+	return TransformPoints(points, transform.matrix);
+}
+
+
+/// <summary> Transforms an array of directions by an affine transform, ignoring the translation. </summary>
+/// <remarks> See the overload for matrices for details. </remarks>
+template <class T, bool PackedIn, bool PackedOut, class TA, bool PackedA>
+void TransformDirections(const Vector<T, 3, PackedIn>* directions,
+						 size_t count,
+						 const Affine<TA, 3, PackedA>& transform,
+						 Vector<T, 3, PackedOut>* out) {
+	TransformDirections(directions, count, transform.matrix, out);
+}
+
+
+/// <summary> Transforms an array of directions by an affine transform, ignoring the translation. </summary>
+template <class T, class TA, bool PackedA>
+VectorArray<T, 3> TransformDirections(const VectorArray<T, 3>& directions, const Affine<TA, 3, PackedA>& transform) {
+	return TransformDirections(directions, transform.matrix);
+}
+
+} // namespace mathter
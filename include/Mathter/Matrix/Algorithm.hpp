@@ -7,6 +7,11 @@
 
 #include "Cast.hpp"
 #include "Matrix.hpp"
+#include "MatrixDynamic.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
 
 
 namespace mathter {
@@ -82,4 +87,59 @@ auto SolveLowerTriangular(const Matrix<T1, Dim, Dim, eMatrixOrder::FOLLOW_VECTOR
 	return FlipLayoutAndOrder(SolveUpperTriangular(FlipLayoutAndOrder(A), FlipLayoutAndOrder(b)));
 }
 
+
+namespace impl {
+
+	/// <summary> Divides the first <paramref name="count"/> elements of <paramref name="row"/> by <paramref name="divisor"/>. </summary>
+	template <class T>
+	void DivideElements(T* row, size_t count, const T& divisor) {
+		TransformElements(row, count, std::divides<>{}, ElementSource<T>{ row }, BroadcastElementSource<T>{ divisor });
+	}
+
+} // namespace impl
+
+
+template <class T1, eMatrixLayout Layout1, bool Packed1,
+		  class T2, eMatrixLayout Layout2, bool Packed2>
+auto SolveUpperTriangular(const Matrix<T1, DYNAMIC, DYNAMIC, eMatrixOrder::PRECEDE_VECTOR, Layout1, Packed1>& A,
+						  const Matrix<T2, DYNAMIC, DYNAMIC, eMatrixOrder::PRECEDE_VECTOR, Layout2, Packed2>& b) {
+	assert(A.RowCount() == A.ColumnCount() && A.RowCount() == b.RowCount());
+	const auto& AWorking = impl::ConvertDynamic<T1, eMatrixLayout::ROW_MAJOR>(A);
+	Matrix<T2, DYNAMIC, DYNAMIC, eMatrixOrder::PRECEDE_VECTOR, eMatrixLayout::ROW_MAJOR, Packed2> bWorking(b);
+	const size_t dim = A.RowCount();
+	const size_t columns = b.ColumnCount();
+
+	for (ptrdiff_t rowIdx = ptrdiff_t(dim) - 1; rowIdx >= 0; --rowIdx) {
+		impl::DivideElements(bWorking.StripeData(rowIdx), columns, static_cast<T2>(AWorking(rowIdx, rowIdx)));
+		for (ptrdiff_t targetIdx = rowIdx - 1; targetIdx >= 0; --targetIdx) {
+			const auto multiplier = static_cast<T2>(AWorking(targetIdx, rowIdx));
+			impl::SubtractScaledElements(bWorking.StripeData(targetIdx), bWorking.StripeData(rowIdx), multiplier, columns);
+		}
+	}
+
+	return std::decay_t<decltype(b)>(bWorking);
+}
+
+
+template <class T1, eMatrixLayout Layout1, bool Packed1,
+		  class T2, eMatrixLayout Layout2, bool Packed2>
+auto SolveLowerTriangular(const Matrix<T1, DYNAMIC, DYNAMIC, eMatrixOrder::PRECEDE_VECTOR, Layout1, Packed1>& A,
+						  const Matrix<T2, DYNAMIC, DYNAMIC, eMatrixOrder::PRECEDE_VECTOR, Layout2, Packed2>& b) {
+	assert(A.RowCount() == A.ColumnCount() && A.RowCount() == b.RowCount());
+	const auto& AWorking = impl::ConvertDynamic<T1, eMatrixLayout::ROW_MAJOR>(A);
+	Matrix<T2, DYNAMIC, DYNAMIC, eMatrixOrder::PRECEDE_VECTOR, eMatrixLayout::ROW_MAJOR, Packed2> bWorking(b);
+	const size_t dim = A.RowCount();
+	const size_t columns = b.ColumnCount();
+
+	for (size_t rowIdx = 0; rowIdx < dim; ++rowIdx) {
+		impl::DivideElements(bWorking.StripeData(rowIdx), columns, static_cast<T2>(AWorking(rowIdx, rowIdx)));
+		for (size_t targetIdx = rowIdx + 1; targetIdx < dim; ++targetIdx) {
+			const auto multiplier = static_cast<T2>(AWorking(targetIdx, rowIdx));
+			impl::SubtractScaledElements(bWorking.StripeData(targetIdx), bWorking.StripeData(rowIdx), multiplier, columns);
+		}
+	}
+
+	return std::decay_t<decltype(b)>(bWorking);
+}
+
 } // namespace mathter
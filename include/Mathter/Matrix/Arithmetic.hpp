@@ -7,6 +7,7 @@
 
 #include "../Vector/Arithmetic.hpp"
 #include "../Vector/Math.hpp"
+#include "BlockedMultiply.hpp"
 #include "Cast.hpp"
 #include "Matrix.hpp"
 
@@ -14,11 +15,18 @@ namespace mathter {
 
 namespace impl {
 
+	template <class Mat>
+	constexpr size_t StripeStride() {
+		return sizeof(typename Mat::Stripe) / sizeof(scalar_type_t<Mat>);
+	}
+
+
+	/// <summary> Multiplies the matrices by combining whole rows of <paramref name="rhs"/>. </summary>
 	template <class T1, bool Packed1,
 			  class T2, bool Packed2,
 			  int Rows1, int Match, int Columns2, eMatrixOrder Order>
-	auto Multiply(const Matrix<T1, Rows1, Match, Order, eMatrixLayout::ROW_MAJOR, Packed1>& lhs,
-				  const Matrix<T2, Match, Columns2, Order, eMatrixLayout::ROW_MAJOR, Packed2>& rhs) {
+	auto MultiplyStripes(const Matrix<T1, Rows1, Match, Order, eMatrixLayout::ROW_MAJOR, Packed1>& lhs,
+						 const Matrix<T2, Match, Columns2, Order, eMatrixLayout::ROW_MAJOR, Packed2>& rhs) {
 		using T = common_arithmetic_type_t<T1, T2>;
 		constexpr auto Packed = Packed1 && Packed2;
 		using Mat = Matrix<T, Rows1, Columns2, Order, eMatrixLayout::ROW_MAJOR, Packed>;
@@ -36,6 +44,28 @@ namespace impl {
 	}
 
 
+	template <class T1, bool Packed1,
+			  class T2, bool Packed2,
+			  int Rows1, int Match, int Columns2, eMatrixOrder Order>
+	auto Multiply(const Matrix<T1, Rows1, Match, Order, eMatrixLayout::ROW_MAJOR, Packed1>& lhs,
+				  const Matrix<T2, Match, Columns2, Order, eMatrixLayout::ROW_MAJOR, Packed2>& rhs) {
+		using T = common_arithmetic_type_t<T1, T2>;
+		constexpr auto Packed = Packed1 && Packed2;
+		using Mat = Matrix<T, Rows1, Columns2, Order, eMatrixLayout::ROW_MAJOR, Packed>;
+
+		if constexpr (std::is_same_v<T1, T2> && IsBlockedMultiplyPreferred<T, Rows1, Match, Columns2, Packed>()) {
+			Mat m;
+			BlockedMultiply<Rows1, Match, Columns2>(lhs.stripes[0].data(), StripeStride<std::decay_t<decltype(lhs)>>(),
+													rhs.stripes[0].data(), StripeStride<std::decay_t<decltype(rhs)>>(),
+													m.stripes[0].data(), StripeStride<Mat>());
+			return m;
+		}
+		else {
+			return MultiplyStripes(lhs, rhs);
+		}
+	}
+
+
 	template <class T1, bool Packed1,
 			  class T2, bool Packed2,
 			  int Rows1, int Match, int Columns2, eMatrixOrder Order>
@@ -54,11 +84,12 @@ namespace impl {
 	}
 
 
+	/// <summary> Multiplies the matrices by combining whole columns of <paramref name="lhs"/>. </summary>
 	template <class T1, bool Packed1,
 			  class T2, eMatrixLayout Layout2, bool Packed2,
 			  int Rows1, int Match, int Columns2, eMatrixOrder Order>
-	auto Multiply(const Matrix<T1, Rows1, Match, Order, eMatrixLayout::COLUMN_MAJOR, Packed1>& lhs,
-				  const Matrix<T2, Match, Columns2, Order, Layout2, Packed2>& rhs) {
+	auto MultiplyStripes(const Matrix<T1, Rows1, Match, Order, eMatrixLayout::COLUMN_MAJOR, Packed1>& lhs,
+						 const Matrix<T2, Match, Columns2, Order, Layout2, Packed2>& rhs) {
 		using T = common_arithmetic_type_t<T1, T2>;
 		constexpr auto Packed = Packed1 && Packed2;
 		using Mat = Matrix<T, Rows1, Columns2, Order, eMatrixLayout::COLUMN_MAJOR, Packed>;
@@ -75,6 +106,30 @@ namespace impl {
 	}
 
 
+	template <class T1, bool Packed1,
+			  class T2, eMatrixLayout Layout2, bool Packed2,
+			  int Rows1, int Match, int Columns2, eMatrixOrder Order>
+	auto Multiply(const Matrix<T1, Rows1, Match, Order, eMatrixLayout::COLUMN_MAJOR, Packed1>& lhs,
+				  const Matrix<T2, Match, Columns2, Order, Layout2, Packed2>& rhs) {
+		using T = common_arithmetic_type_t<T1, T2>;
+		constexpr auto Packed = Packed1 && Packed2;
+		using Mat = Matrix<T, Rows1, Columns2, Order, eMatrixLayout::COLUMN_MAJOR, Packed>;
+
+		// The columns of column-major matrices are the rows of their transposes, so this computes rhs^T * lhs^T.
+		if constexpr (std::is_same_v<T1, T2> && Layout2 == eMatrixLayout::COLUMN_MAJOR
+					  && IsBlockedMultiplyPreferred<T, Columns2, Match, Rows1, Packed>()) {
+			Mat m;
+			BlockedMultiply<Columns2, Match, Rows1>(rhs.stripes[0].data(), StripeStride<std::decay_t<decltype(rhs)>>(),
+													lhs.stripes[0].data(), StripeStride<std::decay_t<decltype(lhs)>>(),
+													m.stripes[0].data(), StripeStride<Mat>());
+			return m;
+		}
+		else {
+			return MultiplyStripes(lhs, rhs);
+		}
+	}
+
+
 	template <class T1, eMatrixLayout Layout1, bool Packed1,
 			  class T2, eMatrixLayout Layout2, bool Packed2,
 			  int Rows, int Columns, eMatrixOrder Order,
@@ -313,7 +368,8 @@ auto operator*(const Matrix<T1, Rows1, Match, eMatrixOrder::PRECEDE_VECTOR, Layo
 /// </remarks>
 template <class T1, bool Packed1,
 		  class T2, eMatrixLayout Layout2, bool Packed2,
-		  int Match>
+		  int Match,
+		  class = std::enable_if_t<(Match > 1)>>
 auto operator*(const Vector<T1, Match - 1, Packed1>& lhs,
 			   const Matrix<T2, Match, Match, eMatrixOrder::FOLLOW_VECTOR, Layout2, Packed2>& rhs) {
 	const auto homogeneous = impl::Multiply(Vector(lhs, static_cast<T1>(1)), rhs);
@@ -331,7 +387,8 @@ auto operator*(const Vector<T1, Match - 1, Packed1>& lhs,
 /// </remarks>
 template <class T1, eMatrixLayout Layout1, bool Packed1,
 		  class T2, bool Packed2,
-		  int Match>
+		  int Match,
+		  class = std::enable_if_t<(Match > 1)>>
 auto operator*(const Matrix<T1, Match, Match, eMatrixOrder::PRECEDE_VECTOR, Layout1, Packed1>& lhs,
 			   const Vector<T2, Match - 1, Packed2>& rhs) {
 	const auto homogeneous = impl::Multiply(lhs, Vector(rhs, static_cast<T1>(1)));
@@ -345,7 +402,8 @@ auto operator*(const Matrix<T1, Match, Match, eMatrixOrder::PRECEDE_VECTOR, Layo
 /// <remarks> The vector is augmented by appending a 1, and then multiplied by the matrix. </remarks>
 template <class T1, bool Packed1,
 		  class T2, eMatrixLayout Layout2, bool Packed2,
-		  int Match>
+		  int Match,
+		  class = std::enable_if_t<(Match > 1)>>
 auto operator*(const Vector<T1, Match - 1, Packed1>& lhs,
 			   const Matrix<T2, Match, Match - 1, eMatrixOrder::FOLLOW_VECTOR, Layout2, Packed2>& rhs) {
 	return impl::Multiply(Vector(lhs, static_cast<T1>(1)), rhs);
@@ -356,7 +414,8 @@ auto operator*(const Vector<T1, Match - 1, Packed1>& lhs,
 /// <remarks> The vector is augmented by appending a 1, and then multiplied by the matrix. </remarks>
 template <class T1, eMatrixLayout Layout1, bool Packed1,
 		  class T2, bool Packed2,
-		  int Match>
+		  int Match,
+		  class = std::enable_if_t<(Match > 1)>>
 auto operator*(const Matrix<T1, Match - 1, Match, eMatrixOrder::PRECEDE_VECTOR, Layout1, Packed1>& lhs,
 			   const Vector<T2, Match - 1, Packed2>& rhs) {
 	return impl::Multiply(lhs, Vector(rhs, static_cast<T1>(1)));
@@ -374,7 +433,8 @@ auto& operator*=(Vector<T1, Match, Packed1>& lhs,
 
 template <class T1, bool Packed1,
 		  class T2, eMatrixLayout Layout2, bool Packed2,
-		  int Match>
+		  int Match,
+		  class = std::enable_if_t<(Match > 1)>>
 auto& operator*=(Vector<T1, Match - 1, Packed1>& lhs,
 				 const Matrix<T2, Match, Match, eMatrixOrder::FOLLOW_VECTOR, Layout2, Packed2>& rhs) {
 	return lhs = lhs * rhs;
@@ -383,7 +443,8 @@ auto& operator*=(Vector<T1, Match - 1, Packed1>& lhs,
 
 template <class T1, bool Packed1,
 		  class T2, eMatrixLayout Layout2, bool Packed2,
-		  int Match>
+		  int Match,
+		  class = std::enable_if_t<(Match > 1)>>
 auto& operator*=(Vector<T1, Match - 1, Packed1>& lhs,
 				 const Matrix<T2, Match, Match - 1, eMatrixOrder::FOLLOW_VECTOR, Layout2, Packed2>& rhs) {
 	return lhs = lhs * rhs;
@@ -0,0 +1,143 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#pragma once
+
+#include "../Common/Functional.hpp"
+#include "../Common/OptimizationUtil.hpp"
+#include "../Vector/SIMDUtil.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+
+
+namespace mathter {
+
+namespace impl {
+
+	/// <summary> Tile sizes of the register-blocked matrix product. </summary>
+	/// <remarks> With SIMD, a tile of the result is 4 rows by 2 SIMD registers. Its 8 accumulators, the 2 rows of the right-hand side,
+	///		and the broadcast element of the left-hand side fit into the 16 registers of SSE, AVX, and NEON.
+	///		Without SIMD, a tile row is a cache line of scalars, which the compiler can auto-vectorize. </remarks>
+	template <class T>
+	struct BlockedMultiplyTile {
+		static constexpr int rows = 4;
+		static constexpr int blocks = LaneBlock<T>::size == 1 ? static_cast<int>(laneAlignment / sizeof(T)) : 2;
+		static constexpr int width = static_cast<int>(LaneBlock<T>::size);
+		static constexpr int columns = blocks * width;
+	};
+
+
+	/// <summary> Computes one tile of the result from a packed panel of the right-hand side. </summary>
+	/// <typeparam name="TileRows"> The number of rows of the result to compute, at most BlockedMultiplyTile::rows. </typeparam>
+	/// <typeparam name="Blocks"> The number of SIMD registers that the panel is wide. </typeparam>
+	/// <typeparam name="Columns"> The number of columns of the result to store, at most Blocks * register width. </typeparam>
+	template <int TileRows, int Blocks, int Columns, int Match, class T>
+	MATHTER_FORCEINLINE void MultiplyTile(const T* lhs, size_t lhsStride, const T* panel, T* out, size_t outStride) {
+		using Lanes = LaneBlock<T>;
+		using Block = typename Lanes::Block;
+		constexpr int width = static_cast<int>(Lanes::size);
+		constexpr int panelWidth = Blocks * width;
+
+		Block acc[TileRows][Blocks];
+		for (int i = 0; i < TileRows; ++i) {
+			for (int b = 0; b < Blocks; ++b) {
+				acc[i][b] = Lanes::Broadcast(T(0));
+			}
+		}
+		for (int k = 0; k < Match; ++k) {
+			Block rhs[Blocks];
+			for (int b = 0; b < Blocks; ++b) {
+				rhs[b] = Lanes::Load(panel + k * panelWidth + b * width);
+			}
+			for (int i = 0; i < TileRows; ++i) {
+				const Block element = Lanes::Broadcast(lhs[i * lhsStride + k]);
+				for (int b = 0; b < Blocks; ++b) {
+					acc[i][b] = madd{}(element, rhs[b], acc[i][b]);
+				}
+			}
+		}
+
+		for (int i = 0; i < TileRows; ++i) {
+			if constexpr (Columns == panelWidth) {
+				for (int b = 0; b < Blocks; ++b) {
+					Lanes::StoreUnaligned(out + i * outStride + b * width, acc[i][b]);
+				}
+			}
+			else {
+				alignas(laneAlignment) T row[panelWidth];
+				for (int b = 0; b < Blocks; ++b) {
+					Lanes::Store(row + b * width, acc[i][b]);
+				}
+				std::copy(row, row + Columns, out + i * outStride);
+			}
+		}
+	}
+
+
+	/// <summary> Computes a vertical strip of the result that is <typeparamref name="Columns"/> wide. </summary>
+	/// <remarks> The corresponding strip of the right-hand side is first packed into a contiguous, aligned panel
+	///		padded with zeros to full registers. The panel is small enough to stay in L1 cache while it's reused
+	///		for every tile in the strip. </remarks>
+	template <int Rows, int Match, int Columns, class T>
+	MATHTER_FORCEINLINE void MultiplyPanel(const T* lhs, size_t lhsStride, const T* rhs, size_t rhsStride, T* out, size_t outStride) {
+		using Tile = BlockedMultiplyTile<T>;
+		constexpr int blocks = (Columns + Tile::width - 1) / Tile::width;
+		constexpr int panelWidth = blocks * Tile::width;
+
+		alignas(laneAlignment) T panel[Match * panelWidth];
+		for (int k = 0; k < Match; ++k) {
+			std::copy(rhs + k * rhsStride, rhs + k * rhsStride + Columns, panel + k * panelWidth);
+			std::fill(panel + k * panelWidth + Columns, panel + (k + 1) * panelWidth, T(0));
+		}
+
+		constexpr int fullRows = Rows / Tile::rows * Tile::rows;
+		for (int i = 0; i < fullRows; i += Tile::rows) {
+			MultiplyTile<Tile::rows, blocks, Columns, Match>(lhs + i * lhsStride, lhsStride, panel, out + i * outStride, outStride);
+		}
+		if constexpr (fullRows < Rows) {
+			MultiplyTile<Rows - fullRows, blocks, Columns, Match>(lhs + fullRows * lhsStride, lhsStride, panel, out + fullRows * outStride, outStride);
+		}
+	}
+
+
+	/// <summary> Multiplies two row-major matrices given as raw arrays: out = lhs * rhs. </summary>
+	/// <remarks> The strides are the distances between consecutive rows in elements. </remarks>
+	template <int Rows, int Match, int Columns, class T>
+	void BlockedMultiply(const T* lhs, size_t lhsStride, const T* rhs, size_t rhsStride, T* out, size_t outStride) {
+		using Tile = BlockedMultiplyTile<T>;
+		constexpr int fullColumns = Columns / Tile::columns * Tile::columns;
+		for (int j = 0; j < fullColumns; j += Tile::columns) {
+			MultiplyPanel<Rows, Match, Tile::columns>(lhs, lhsStride, rhs + j, rhsStride, out + j, outStride);
+		}
+		if constexpr (fullColumns < Columns) {
+			MultiplyPanel<Rows, Match, Columns - fullColumns>(lhs, lhsStride, rhs + fullColumns, rhsStride, out + fullColumns, outStride);
+		}
+	}
+
+
+	/// <summary> Tells if the matrix product of these dimensions should use <see cref="BlockedMultiply"/>. </summary>
+	/// <remarks> The stripe-by-stripe product is faster for small matrices, and for rows that are padded for SIMD,
+	///		because the blocked kernel doesn't fill the padding. Without SIMD, the auto-vectorized stripe-by-stripe product
+	///		is only slower for single precision matrices with more than 8 but at most 32 columns. </remarks>
+	template <class T, int Rows, int Match, int Columns, bool Packed>
+	constexpr bool IsBlockedMultiplyPreferred() {
+		if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>) {
+			const bool isMedium = Rows >= 8 && Match >= 8 && Columns >= 8 && Rows <= 64 && Match <= 64 && Columns <= 64;
+			const bool isUnpadded = GetStorageSize<T, Columns, Packed>() == Columns;
+			if constexpr (LaneBlock<T>::size > 1) {
+				return isMedium && isUnpadded;
+			}
+			else {
+				return isMedium && isUnpadded && sizeof(T) <= 4 && Columns > 8 && Rows <= 32 && Match <= 32 && Columns <= 32;
+			}
+		}
+		return false;
+	}
+
+} // namespace impl
+
+} // namespace mathter
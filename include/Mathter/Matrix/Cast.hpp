@@ -34,6 +34,26 @@ auto FlipLayoutAndOrder(const Matrix<T, Rows, Columns, Order, Layout, Packed>& m
 }
 
 
+/// <summary> Converts the matrix to the opposite layout. The elements stay the same. </summary>
+/// <remarks> This rearranges the stripes in memory, using SIMD shuffles if the stripes are batched. </remarks>
+template <class T, int Rows, int Columns, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+auto FlipLayout(const Matrix<T, Rows, Columns, Order, Layout, Packed>& m) {
+	return Matrix<T, Rows, Columns, Order, opposite_layout_v<Layout>, Packed>(m);
+}
+
+
+/// <summary> Converts each matrix in the range [first, last) to the opposite layout and writes them to <paramref name="out"/>. </summary>
+/// <remarks> Use this to prepare arrays of matrices for APIs that expect the other layout, such as graphics APIs. </remarks>
+/// <returns> The end of the output range. </returns>
+template <class InputIter, class OutputIter>
+OutputIter FlipLayout(InputIter first, InputIter last, OutputIter out) {
+	for (; first != last; ++first, ++out) {
+		*out = FlipLayout(*first);
+	}
+	return out;
+}
+
+
 /// <summary> Flip  the order of the matrix. </summary>
 /// <typeparam name="PreserveTransform"> If true, transposes the matrix to preserve transform,
 ///		if false, preserves stripes and is essentially a noop. </typeparam>
@@ -0,0 +1,467 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#pragma once
+
+#include "../Common/TypeTraits.hpp"
+#include "../Vector/Arithmetic.hpp"
+#include "../Vector/Vector.hpp"
+#include "Arithmetic.hpp"
+#include "Matrix.hpp"
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+
+namespace mathter {
+
+//------------------------------------------------------------------------------
+// Expression templates
+//------------------------------------------------------------------------------
+//
+// Lazy(x) wraps a vector or a matrix into an expression. Arithmetic on
+// expressions builds a tree instead of computing temporaries, and the tree is
+// evaluated in one pass when it's converted to a vector or a matrix:
+//	- elementwise operations are evaluated stripe by stripe, without
+//	  materializing the intermediate vectors and matrices,
+//	- a * b + c patterns are fused into MultiplyAdd,
+//	- chains of matrix products are multiplied in the order that takes the
+//	  fewest scalar multiplications.
+// The result is always the same type the eager operators would return.
+//
+// Expressions store lvalue operands by reference. Either evaluate them within
+// the full expression, or make sure the operands outlive the expression.
+//------------------------------------------------------------------------------
+
+
+template <class Expr, class = std::enable_if_t<is_expression_v<Expr>>>
+auto Evaluate(const Expr& expr);
+
+
+namespace impl {
+
+	template <class T>
+	using expression_result_t = typename std::decay_t<T>::ExpressionResult;
+
+
+	/// <summary> Provides the conversion to the eager result for all expression nodes. </summary>
+	template <class Derived, class Result>
+	class ExpressionBase {
+	public:
+		using ExpressionResult = Result;
+
+		/// <summary> Evaluates the expression. </summary>
+		operator Result() const {
+			return Evaluate(static_cast<const Derived&>(*this));
+		}
+	};
+
+
+	/// <summary> A vector or matrix operand. </summary>
+	/// <typeparam name="Value"> Either a const reference to or the value of the operand. </typeparam>
+	template <class Value>
+	class LeafExpression : public ExpressionBase<LeafExpression<Value>, std::decay_t<Value>> {
+	public:
+		explicit LeafExpression(Value value) : value(std::forward<Value>(value)) {}
+
+		template <eMatrixLayout Layout>
+		auto Stripe(size_t index) const {
+			if constexpr (is_matrix_v<std::decay_t<Value>>) {
+				if constexpr (Layout == eMatrixLayout::ROW_MAJOR) {
+					return value.Row(index);
+				}
+				else {
+					return value.Column(index);
+				}
+			}
+			else {
+				return value;
+			}
+		}
+
+		Value value;
+	};
+
+
+	/// <summary> A scalar operand, broadcast to all elements. </summary>
+	template <class T>
+	class ScalarExpression : public ExpressionBase<ScalarExpression<T>, T> {
+	public:
+		explicit ScalarExpression(const T& value) : value(value) {}
+
+		template <eMatrixLayout Layout>
+		const T& Stripe(size_t) const {
+			return value;
+		}
+
+		T value;
+	};
+
+
+	/// <summary> An elementwise binary operation. </summary>
+	template <class Op, class Lhs, class Rhs>
+	class BinaryExpression : public ExpressionBase<BinaryExpression<Op, Lhs, Rhs>,
+												   decltype(Op{}(std::declval<expression_result_t<Lhs>>(), std::declval<expression_result_t<Rhs>>()))> {
+	public:
+		BinaryExpression(Lhs lhs, Rhs rhs) : lhs(std::move(lhs)), rhs(std::move(rhs)) {}
+
+		template <eMatrixLayout Layout>
+		auto Stripe(size_t index) const;
+
+		Lhs lhs;
+		Rhs rhs;
+	};
+
+
+	/// <summary> Negates the operand elementwise. </summary>
+	template <class Arg>
+	class NegateExpression : public ExpressionBase<NegateExpression<Arg>, decltype(-std::declval<expression_result_t<Arg>>())> {
+	public:
+		explicit NegateExpression(Arg arg) : arg(std::move(arg)) {}
+
+		template <eMatrixLayout Layout>
+		auto Stripe(size_t index) const {
+			return -arg.template Stripe<Layout>(index);
+		}
+
+		Arg arg;
+	};
+
+
+	/// <summary> A matrix-matrix or matrix-vector product. </summary>
+	/// <remarks> Products are not evaluated stripe by stripe. Before evaluating the expression,
+	///		the chain of products is flattened and multiplied in the cheapest order. </remarks>
+	template <class Lhs, class Rhs>
+	class ProductExpression : public ExpressionBase<ProductExpression<Lhs, Rhs>,
+													decltype(Multiply(std::declval<expression_result_t<Lhs>>(), std::declval<expression_result_t<Rhs>>()))> {
+	public:
+		ProductExpression(Lhs lhs, Rhs rhs) : lhs(std::move(lhs)), rhs(std::move(rhs)) {}
+
+		Lhs lhs;
+		Rhs rhs;
+	};
+
+
+	template <class T>
+	struct is_multiplication : std::false_type {};
+
+	template <class Lhs, class Rhs>
+	struct is_multiplication<BinaryExpression<std::multiplies<>, Lhs, Rhs>> : std::true_type {};
+
+
+	/// <summary> Converts a scalar stripe to the vector type of the result stripe. </summary>
+	template <class StripeType, class T>
+	StripeType BroadcastStripe(const T& value) {
+		if constexpr (is_scalar_v<T>) {
+			return StripeType(static_cast<scalar_type_t<StripeType>>(value));
+		}
+		else {
+			return StripeType(value);
+		}
+	}
+
+
+	template <class Op, class Lhs, class Rhs>
+	template <eMatrixLayout Layout>
+	auto BinaryExpression<Op, Lhs, Rhs>::Stripe(size_t index) const {
+		using StripeType = decltype(Op{}(lhs.template Stripe<Layout>(index), rhs.template Stripe<Layout>(index)));
+		constexpr bool isAdditive = std::is_same_v<Op, std::plus<>> || std::is_same_v<Op, std::minus<>>;
+
+		if constexpr (isAdditive && is_vector_v<StripeType> && is_multiplication<Lhs>::value) {
+			// a * b + c and a * b - c
+			const auto a = BroadcastStripe<StripeType>(lhs.lhs.template Stripe<Layout>(index));
+			const auto b = BroadcastStripe<StripeType>(lhs.rhs.template Stripe<Layout>(index));
+			const auto c = BroadcastStripe<StripeType>(rhs.template Stripe<Layout>(index));
+			if constexpr (std::is_same_v<Op, std::plus<>>) {
+				return MultiplyAdd(a, b, c);
+			}
+			else {
+				return MultiplyAdd(a, b, -c);
+			}
+		}
+		else if constexpr (isAdditive && is_vector_v<StripeType> && is_multiplication<Rhs>::value) {
+			// c + a * b and c - a * b
+			const auto a = BroadcastStripe<StripeType>(rhs.lhs.template Stripe<Layout>(index));
+			const auto b = BroadcastStripe<StripeType>(rhs.rhs.template Stripe<Layout>(index));
+			const auto c = BroadcastStripe<StripeType>(lhs.template Stripe<Layout>(index));
+			if constexpr (std::is_same_v<Op, std::plus<>>) {
+				return MultiplyAdd(a, b, c);
+			}
+			else {
+				return MultiplyAdd(-a, b, c);
+			}
+		}
+		else {
+			return Op{}(lhs.template Stripe<Layout>(index), rhs.template Stripe<Layout>(index));
+		}
+	}
+
+
+	//--------------------------------------
+	// Building expressions
+	//--------------------------------------
+
+	/// <summary> Wraps vectors, matrices and scalars into expression nodes, passes expressions through. </summary>
+	template <class T>
+	auto AsExpression(T&& value) {
+		using Value = std::decay_t<T>;
+		if constexpr (is_expression_v<Value>) {
+			return Value(std::forward<T>(value));
+		}
+		else if constexpr (is_vector_v<Value> || is_matrix_v<Value>) {
+			static_assert(!is_dynamic_v<Value>, "Expressions only support fixed-size vectors and matrices.");
+			if constexpr (std::is_lvalue_reference_v<T>) {
+				return LeafExpression<const Value&>(value);
+			}
+			else {
+				return LeafExpression<Value>(std::move(value));
+			}
+		}
+		else {
+			return ScalarExpression<Value>(value);
+		}
+	}
+
+
+	template <class T>
+	constexpr bool is_expression_operand_v = is_expression_v<T> || is_vector_v<T> || is_matrix_v<T> || is_scalar_v<T>;
+
+
+	template <class Lhs, class Rhs>
+	constexpr bool is_expression_operation_v = (is_expression_v<std::decay_t<Lhs>> || is_expression_v<std::decay_t<Rhs>>)
+											   && is_expression_operand_v<std::decay_t<Lhs>>
+											   && is_expression_operand_v<std::decay_t<Rhs>>;
+
+
+	template <class Op, class Lhs, class Rhs>
+	auto MakeBinary(Lhs&& lhs, Rhs&& rhs) {
+		auto lhsExpr = AsExpression(std::forward<Lhs>(lhs));
+		auto rhsExpr = AsExpression(std::forward<Rhs>(rhs));
+		return BinaryExpression<Op, decltype(lhsExpr), decltype(rhsExpr)>(std::move(lhsExpr), std::move(rhsExpr));
+	}
+
+
+	template <class Lhs, class Rhs>
+	auto MakeProduct(Lhs&& lhs, Rhs&& rhs) {
+		auto lhsExpr = AsExpression(std::forward<Lhs>(lhs));
+		auto rhsExpr = AsExpression(std::forward<Rhs>(rhs));
+		return ProductExpression<decltype(lhsExpr), decltype(rhsExpr)>(std::move(lhsExpr), std::move(rhsExpr));
+	}
+
+
+	//--------------------------------------
+	// Matrix chain ordering
+	//--------------------------------------
+
+	/// <summary> The row and column count of the factor at <paramref name="Index"/> in a chain of products. </summary>
+	/// <remarks> Vectors can only appear at the ends of a chain: a row vector on the left, a column vector on the right. </remarks>
+	template <class Factor, size_t Index>
+	constexpr std::array<size_t, 2> FactorShape() {
+		if constexpr (is_matrix_v<Factor>) {
+			return { size_t(row_count_v<Factor>), size_t(column_count_v<Factor>) };
+		}
+		else if constexpr (Index == 0) {
+			return { 1, size_t(dimension_v<Factor>) };
+		}
+		else {
+			return { size_t(dimension_v<Factor>), 1 };
+		}
+	}
+
+
+	template <class Factors, size_t... Indices>
+	constexpr auto ChainDimensions(std::index_sequence<Indices...>) {
+		constexpr std::array<std::array<size_t, 2>, sizeof...(Indices)> shapes = {
+			FactorShape<std::decay_t<std::tuple_element_t<Indices, Factors>>, Indices>()...
+		};
+		std::array<size_t, sizeof...(Indices) + 1> dimensions = {};
+		for (size_t i = 0; i < shapes.size(); ++i) {
+			dimensions[i] = shapes[i][0];
+		}
+		dimensions[shapes.size()] = shapes[shapes.size() - 1][1];
+		return dimensions;
+	}
+
+
+	/// <summary> Solves the matrix chain ordering problem by dynamic programming. </summary>
+	/// <returns> The factors [i, j] are best multiplied as [i, split[i][j]] times [split[i][j] + 1, j]. </returns>
+	template <size_t Count>
+	constexpr auto ChainSplits(const std::array<size_t, Count + 1>& dimensions) {
+		std::array<std::array<size_t, Count>, Count> cost = {};
+		std::array<std::array<size_t, Count>, Count> split = {};
+		for (size_t length = 2; length <= Count; ++length) {
+			for (size_t first = 0; first + length <= Count; ++first) {
+				const size_t last = first + length - 1;
+				cost[first][last] = std::numeric_limits<size_t>::max();
+				for (size_t mid = first; mid < last; ++mid) {
+					const size_t candidate = cost[first][mid] + cost[mid + 1][last]
+											 + dimensions[first] * dimensions[mid + 1] * dimensions[last + 1];
+					if (candidate < cost[first][last]) {
+						cost[first][last] = candidate;
+						split[first][last] = mid;
+					}
+				}
+			}
+		}
+		return split;
+	}
+
+
+	template <size_t First, size_t Last, class Factors>
+	decltype(auto) MultiplyChain(const Factors& factors) {
+		if constexpr (First == Last) {
+			return std::get<First>(factors);
+		}
+		else {
+			constexpr size_t count = std::tuple_size_v<Factors>;
+			constexpr auto splits = ChainSplits<count>(ChainDimensions<Factors>(std::make_index_sequence<count>{}));
+			constexpr size_t mid = splits[First][Last];
+			return Multiply(MultiplyChain<First, mid>(factors), MultiplyChain<mid + 1, Last>(factors));
+		}
+	}
+
+
+	//--------------------------------------
+	// Preparing expressions for evaluation
+	//--------------------------------------
+
+	template <class Expr>
+	auto FlattenProduct(const Expr& expr) {
+		return std::make_tuple(Evaluate(expr));
+	}
+
+	template <class Value>
+	auto FlattenProduct(const LeafExpression<Value>& expr) {
+		return std::tuple<const std::decay_t<Value>&>(expr.value);
+	}
+
+	template <class Lhs, class Rhs>
+	auto FlattenProduct(const ProductExpression<Lhs, Rhs>& expr) {
+		return std::tuple_cat(FlattenProduct(expr.lhs), FlattenProduct(expr.rhs));
+	}
+
+
+	/// <summary> Replaces the products by their values so that the rest of the expression can be evaluated stripe by stripe. </summary>
+	template <class Value>
+	auto Prepare(const LeafExpression<Value>& expr) {
+		return LeafExpression<const std::decay_t<Value>&>(expr.value);
+	}
+
+	template <class T>
+	auto Prepare(const ScalarExpression<T>& expr) {
+		return expr;
+	}
+
+	template <class Op, class Lhs, class Rhs>
+	auto Prepare(const BinaryExpression<Op, Lhs, Rhs>& expr) {
+		auto lhs = Prepare(expr.lhs);
+		auto rhs = Prepare(expr.rhs);
+		return BinaryExpression<Op, decltype(lhs), decltype(rhs)>(std::move(lhs), std::move(rhs));
+	}
+
+	template <class Arg>
+	auto Prepare(const NegateExpression<Arg>& expr) {
+		auto arg = Prepare(expr.arg);
+		return NegateExpression<decltype(arg)>(std::move(arg));
+	}
+
+	template <class Lhs, class Rhs>
+	auto Prepare(const ProductExpression<Lhs, Rhs>& expr) {
+		using Result = expression_result_t<ProductExpression<Lhs, Rhs>>;
+		const auto factors = FlattenProduct(expr);
+		constexpr size_t count = std::tuple_size_v<std::decay_t<decltype(factors)>>;
+		return LeafExpression<Result>(Result(MultiplyChain<0, count - 1>(factors)));
+	}
+
+} // namespace impl
+
+
+//------------------------------------------------------------------------------
+// Creating and evaluating expressions
+//------------------------------------------------------------------------------
+
+/// <summary> Wraps a vector or a matrix into an expression to opt in to lazy evaluation. </summary>
+/// <remarks> Lvalues are referenced, rvalues are moved into the expression. </remarks>
+template <class T, class = std::enable_if_t<is_vector_v<std::decay_t<T>> || is_matrix_v<std::decay_t<T>>>>
+auto Lazy(T&& value) {
+	return impl::AsExpression(std::forward<T>(value));
+}
+
+
+/// <summary> Evaluates the expression into the vector or matrix the eager operators would return. </summary>
+template <class Expr, class>
+auto Evaluate(const Expr& expr) {
+	using Result = impl::expression_result_t<Expr>;
+	const auto prepared = impl::Prepare(expr);
+
+	if constexpr (is_matrix_v<Result>) {
+		Result m;
+		if constexpr (layout_v<Result> == eMatrixLayout::ROW_MAJOR) {
+			for (size_t rowIdx = 0; rowIdx < row_count_v<Result>; ++rowIdx) {
+				m.Row(rowIdx, prepared.template Stripe<eMatrixLayout::ROW_MAJOR>(rowIdx));
+			}
+		}
+		else {
+			for (size_t colIdx = 0; colIdx < column_count_v<Result>; ++colIdx) {
+				m.Column(colIdx, prepared.template Stripe<eMatrixLayout::COLUMN_MAJOR>(colIdx));
+			}
+		}
+		return m;
+	}
+	else {
+		return Result(prepared.template Stripe<eMatrixLayout::ROW_MAJOR>(0));
+	}
+}
+
+
+//------------------------------------------------------------------------------
+// Expression operators
+//------------------------------------------------------------------------------
+
+template <class Lhs, class Rhs, class = std::enable_if_t<impl::is_expression_operation_v<Lhs, Rhs>>>
+auto operator+(Lhs&& lhs, Rhs&& rhs) {
+	return impl::MakeBinary<std::plus<>>(std::forward<Lhs>(lhs), std::forward<Rhs>(rhs));
+}
+
+
+template <class Lhs, class Rhs, class = std::enable_if_t<impl::is_expression_operation_v<Lhs, Rhs>>>
+auto operator-(Lhs&& lhs, Rhs&& rhs) {
+	return impl::MakeBinary<std::minus<>>(std::forward<Lhs>(lhs), std::forward<Rhs>(rhs));
+}
+
+
+/// <summary> Matrix product if either side is a matrix, elementwise product otherwise. </summary>
+template <class Lhs, class Rhs, class = std::enable_if_t<impl::is_expression_operation_v<Lhs, Rhs>>>
+auto operator*(Lhs&& lhs, Rhs&& rhs) {
+	using LhsResult = impl::expression_result_t<decltype(impl::AsExpression(std::forward<Lhs>(lhs)))>;
+	using RhsResult = impl::expression_result_t<decltype(impl::AsExpression(std::forward<Rhs>(rhs)))>;
+	if constexpr ((is_matrix_v<LhsResult> && !is_scalar_v<RhsResult>) || (is_matrix_v<RhsResult> && !is_scalar_v<LhsResult>)) {
+		return impl::MakeProduct(std::forward<Lhs>(lhs), std::forward<Rhs>(rhs));
+	}
+	else {
+		return impl::MakeBinary<std::multiplies<>>(std::forward<Lhs>(lhs), std::forward<Rhs>(rhs));
+	}
+}
+
+
+template <class Lhs, class Rhs, class = std::enable_if_t<impl::is_expression_operation_v<Lhs, Rhs>>>
+auto operator/(Lhs&& lhs, Rhs&& rhs) {
+	return impl::MakeBinary<std::divides<>>(std::forward<Lhs>(lhs), std::forward<Rhs>(rhs));
+}
+
+
+template <class Arg, class = std::enable_if_t<is_expression_v<std::decay_t<Arg>>>>
+auto operator-(Arg&& arg) {
+	using Expr = std::decay_t<Arg>;
+	return impl::NegateExpression<Expr>(std::forward<Arg>(arg));
+}
+
+
+} // namespace mathter
@@ -277,11 +277,7 @@ T Determinant(const Matrix<T, Dim, Dim, Order, Layout, Packed>& m) {
 template <class T, int Rows, int Columns, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
 auto Transpose(const Matrix<T, Rows, Columns, Order, Layout, Packed>& m) {
 	Matrix<T, Columns, Rows, Order, Layout, Packed> result;
-	for (int i = 0; i < m.RowCount(); ++i) {
-		for (int j = 0; j < m.ColumnCount(); ++j) {
-			result(j, i) = m(i, j);
-		}
-	}
+	impl::TransposeStripes(result.stripes, m.stripes);
 	return result;
 }
 
@@ -446,7 +442,12 @@ template <class T, int Dim, eMatrixOrder Order, eMatrixLayout Layout, bool Packe
 Matrix<T, Dim, Dim, Order, Layout, Packed> Inverse(const Matrix<T, Dim, Dim, Order, Layout, Packed>& m) {
 	static_assert(!std::is_integral_v<T>, "Integer matrices cannot be inverted.");
 
-	return DecomposeLUP(m).Inverse();
+	if constexpr (Dim != DYNAMIC) {
+		return DecomposeLUPCompact(m).Inverse();
+	}
+	else {
+		return DecomposeLUP(m).Inverse();
+	}
 }
 
 } // namespace mathter
\ No newline at end of file
@@ -9,6 +9,7 @@
 #include "../Common/TypeTraits.hpp"
 #include "../Common/Types.hpp"
 #include "../Vector/Vector.hpp"
+#include "StripeTranspose.hpp"
 
 #include <array>
 #include <cassert>
@@ -174,11 +175,7 @@ Matrix<T, Rows, Columns, Order, Layout, Packed>::Matrix(const Matrix<TOther, Row
 		}
 	}
 	else {
-		for (size_t i = 0; i < RowCount(); ++i) {
-			for (size_t j = 0; j < ColumnCount(); ++j) {
-				(*this)(i, j) = rhs(i, j);
-			}
-		}
+		impl::TransposeStripes(stripes, rhs.stripes);
 	}
 }
 
@@ -192,11 +189,7 @@ Matrix<T, Rows, Columns, Order, Layout, Packed>::Matrix(const Matrix<T2, Columns
 		}
 	}
 	else {
-		for (size_t i = 0; i < RowCount(); ++i) {
-			for (size_t j = 0; j < ColumnCount(); ++j) {
-				(*this)(i, j) = rhs(j, i);
-			}
-		}
+		impl::TransposeStripes(stripes, rhs.stripes);
 	}
 }
 
@@ -0,0 +1,255 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#pragma once
+
+#include "../Common/AlignedAllocator.hpp"
+#include "../Common/TypeTraits.hpp"
+#include "../Vector/SIMDUtil.hpp"
+#include "Matrix.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+
+namespace mathter {
+
+
+/// <summary> Stores a sequence of small matrices in structure-of-arrays layout. </summary>
+/// <remarks> Each element of the matrices is stored in its own contiguous, aligned lane,
+///		the same way as <see cref="VectorArray"/> stores vector components. Functions
+///		on the array, such as the batched decompositions, process one matrix per SIMD lane,
+///		so they work on as many matrices at a time as the widest SIMD register fits.
+///		Use <see cref="Gather"/> and <see cref="Scatter"/> to exchange individual matrices
+///		with the regular <see cref="Matrix"/>. </remarks>
+/// <typeparam name="T"> The scalar type of the matrices. </typeparam>
+/// <typeparam name="Rows"> The number of rows of the matrices. </typeparam>
+/// <typeparam name="Columns"> The number of columns of the matrices. </typeparam>
+template <class T, int Rows, int Columns>
+class MatrixArray {
+	static_assert(Rows >= 1 && Columns >= 1, "Dimensions must be positive integers.");
+
+public:
+	/// <summary> Describes how many elements of a lane are processed at once, and how they are loaded. </summary>
+	using Block = impl::LaneBlock<T>;
+	using LaneStorage = std::vector<T, AlignedAllocator<T, impl::laneAlignment>>;
+
+public:
+	//--------------------------------------------
+	// Constructors
+	//--------------------------------------------
+
+	/// <summary> Creates an empty array. </summary>
+	MatrixArray() = default;
+
+	/// <summary> Creates an array of <paramref name="size"/> zero matrices. </summary>
+	explicit MatrixArray(size_t size);
+
+	/// <summary> Creates an array by gathering the matrices in the range [first, last). </summary>
+	template <class Iter, class = std::enable_if_t<is_matrix_v<typename std::iterator_traits<Iter>::value_type>>>
+	MatrixArray(Iter first, Iter last);
+
+	//--------------------------------------------
+	// Size
+	//--------------------------------------------
+
+	/// <summary> Returns the number of rows of the stored matrices. </summary>
+	constexpr int RowCount() const;
+
+	/// <summary> Returns the number of columns of the stored matrices. </summary>
+	constexpr int ColumnCount() const;
+
+	/// <summary> Returns the number of stored matrices. </summary>
+	size_t Size() const;
+
+	/// <summary> Returns true if the array stores no matrices. </summary>
+	bool Empty() const;
+
+	/// <summary> Changes the number of matrices. New matrices are zero matrices. </summary>
+	void Resize(size_t size);
+
+	/// <summary> Returns the number of elements allocated per lane. </summary>
+	/// <remarks> Always a multiple of <see cref="Block::size"/> and <see cref="impl::LanePadding"/>. The elements past
+	///		<see cref="Size"/> are padding, and kernels may overwrite them. </remarks>
+	size_t PaddedSize() const;
+
+	//--------------------------------------------
+	// Accessors
+	//--------------------------------------------
+
+	/// <summary> Returns the contiguous array holding the element (<paramref name="row"/>, <paramref name="column"/>) of each matrix. </summary>
+	const T* Lane(int row, int column) const;
+	/// <summary> Returns the contiguous array holding the element (<paramref name="row"/>, <paramref name="column"/>) of each matrix. </summary>
+	T* Lane(int row, int column);
+
+	/// <summary> Assembles the matrix at <paramref name="index"/> from the lanes. </summary>
+	template <eMatrixOrder Order = eMatrixOrder::FOLLOW_VECTOR, eMatrixLayout Layout = eMatrixLayout::ROW_MAJOR, bool Packed = false>
+	Matrix<T, Rows, Columns, Order, Layout, Packed> Gather(size_t index) const;
+
+	/// <summary> Distributes the elements of <paramref name="value"/> into the lanes at <paramref name="index"/>. </summary>
+	template <eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+	void Scatter(size_t index, const Matrix<T, Rows, Columns, Order, Layout, Packed>& value);
+
+	/// <summary> Distributes the matrices in the range [first, last) into the lanes starting at <paramref name="index"/>. </summary>
+	template <class Iter>
+	void Scatter(size_t index, Iter first, Iter last);
+
+private:
+	std::array<LaneStorage, Rows * Columns> m_lanes;
+	size_t m_size = 0;
+};
+
+
+template <class Iter, class Mat = typename std::iterator_traits<Iter>::value_type>
+MatrixArray(Iter first, Iter last) -> MatrixArray<scalar_type_t<Mat>, row_count_v<Mat>, column_count_v<Mat>>;
+
+
+template <class T, int Rows, int Columns>
+MatrixArray<T, Rows, Columns>::MatrixArray(size_t size) {
+	Resize(size);
+}
+
+
+template <class T, int Rows, int Columns>
+template <class Iter, class>
+MatrixArray<T, Rows, Columns>::MatrixArray(Iter first, Iter last) {
+	Resize(size_t(std::distance(first, last)));
+	Scatter(0, first, last);
+}
+
+
+template <class T, int Rows, int Columns>
+constexpr int MatrixArray<T, Rows, Columns>::RowCount() const {
+	return Rows;
+}
+
+
+template <class T, int Rows, int Columns>
+constexpr int MatrixArray<T, Rows, Columns>::ColumnCount() const {
+	return Columns;
+}
+
+
+template <class T, int Rows, int Columns>
+size_t MatrixArray<T, Rows, Columns>::Size() const {
+	return m_size;
+}
+
+
+template <class T, int Rows, int Columns>
+bool MatrixArray<T, Rows, Columns>::Empty() const {
+	return m_size == 0;
+}
+
+
+template <class T, int Rows, int Columns>
+void MatrixArray<T, Rows, Columns>::Resize(size_t size) {
+	const size_t padded = impl::PadLaneSize(size, impl::LanePadding<T>());
+	for (auto& lane : m_lanes) {
+		// Padding may contain garbage written by the kernels, it has to be cleared when exposed.
+		const size_t dirtyEnd = std::min(size, lane.size());
+		std::fill(lane.begin() + std::min(m_size, dirtyEnd), lane.begin() + dirtyEnd, static_cast<T>(0));
+		lane.resize(padded, static_cast<T>(0));
+	}
+	m_size = size;
+}
+
+
+template <class T, int Rows, int Columns>
+size_t MatrixArray<T, Rows, Columns>::PaddedSize() const {
+	return m_lanes[0].size();
+}
+
+
+template <class T, int Rows, int Columns>
+const T* MatrixArray<T, Rows, Columns>::Lane(int row, int column) const {
+	assert(0 <= row && row < Rows && 0 <= column && column < Columns);
+	return m_lanes[row * Columns + column].data();
+}
+
+
+template <class T, int Rows, int Columns>
+T* MatrixArray<T, Rows, Columns>::Lane(int row, int column) {
+	assert(0 <= row && row < Rows && 0 <= column && column < Columns);
+	return m_lanes[row * Columns + column].data();
+}
+
+
+template <class T, int Rows, int Columns>
+template <eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+Matrix<T, Rows, Columns, Order, Layout, Packed> MatrixArray<T, Rows, Columns>::Gather(size_t index) const {
+	assert(index < m_size);
+	Matrix<T, Rows, Columns, Order, Layout, Packed> value;
+	for (int row = 0; row < Rows; ++row) {
+		for (int column = 0; column < Columns; ++column) {
+			value(row, column) = m_lanes[row * Columns + column][index];
+		}
+	}
+	return value;
+}
+
+
+template <class T, int Rows, int Columns>
+template <eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+void MatrixArray<T, Rows, Columns>::Scatter(size_t index, const Matrix<T, Rows, Columns, Order, Layout, Packed>& value) {
+	assert(index < m_size);
+	for (int row = 0; row < Rows; ++row) {
+		for (int column = 0; column < Columns; ++column) {
+			m_lanes[row * Columns + column][index] = value(row, column);
+		}
+	}
+}
+
+
+template <class T, int Rows, int Columns>
+template <class Iter>
+void MatrixArray<T, Rows, Columns>::Scatter(size_t index, Iter first, Iter last) {
+	for (; first != last; ++first, ++index) {
+		Scatter(index, *first);
+	}
+}
+
+
+namespace impl {
+
+	/// <summary> The elements of a matrix for as many matrices as a lane block holds. </summary>
+	template <class Block, int Rows, int Columns>
+	using LaneMatrix = std::array<std::array<typename Block::Block, Columns>, Rows>;
+
+
+	/// <summary> Loads the matrices starting at <paramref name="index"/>, one matrix per SIMD lane. </summary>
+	template <class T, int Rows, int Columns>
+	auto LoadLaneMatrix(const MatrixArray<T, Rows, Columns>& array, size_t index) {
+		using Block = typename MatrixArray<T, Rows, Columns>::Block;
+		LaneMatrix<Block, Rows, Columns> m;
+		for (int row = 0; row < Rows; ++row) {
+			for (int column = 0; column < Columns; ++column) {
+				m[row][column] = Block::Load(array.Lane(row, column) + index);
+			}
+		}
+		return m;
+	}
+
+
+	/// <summary> Stores the matrices of the SIMD lanes starting at <paramref name="index"/>. </summary>
+	template <class T, int Rows, int Columns, class LaneMat>
+	void StoreLaneMatrix(MatrixArray<T, Rows, Columns>& array, size_t index, const LaneMat& m) {
+		using Block = typename MatrixArray<T, Rows, Columns>::Block;
+		for (int row = 0; row < Rows; ++row) {
+			for (int column = 0; column < Columns; ++column) {
+				Block::Store(array.Lane(row, column) + index, m[row][column]);
+			}
+		}
+	}
+
+} // namespace impl
+
+
+} // namespace mathter
@@ -0,0 +1,958 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#pragma once
+
+#include "../Common/AlignedAllocator.hpp"
+#include "../Common/Functional.hpp"
+#include "../Common/TypeTraits.hpp"
+#include "../Common/Types.hpp"
+#include "../Vector/SIMDUtil.hpp"
+#include "../Vector/VectorDynamic.hpp"
+#include "Matrix.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <complex>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+
+namespace mathter {
+
+
+/// <summary> Represents a matrix whose number of rows and columns is set at runtime. </summary>
+/// <remarks> Select it by passing <see cref="DYNAMIC"/> as both the row and column count.
+///		The elements are stored on the heap. Each stripe (row or column, depending on the layout)
+///		begins at an address aligned for SIMD, and stripes are padded to a multiple of the
+///		SIMD register width. Matrix products are computed by a register and cache blocked kernel.
+///		Dynamically sized matrices only take part in operations with other dynamically
+///		sized matrices and vectors. Fixed size matrices have to be converted explicitly. </remarks>
+template <class T, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+class Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed> {
+public:
+	using Block = impl::LaneBlock<T>;
+	using Storage = std::vector<T, AlignedAllocator<T, impl::laneAlignment>>;
+	using Stripe = Vector<T, DYNAMIC, Packed>;
+	static constexpr bool isVector = false;
+	static constexpr int vectorDim = 0;
+
+public:
+	//--------------------------------------------
+	// Constructors
+	//--------------------------------------------
+
+	/// <summary> Creates an empty matrix. </summary>
+	Matrix() = default;
+
+	/// <summary> Creates a matrix of <paramref name="rows"/> by <paramref name="columns"/> zeros. </summary>
+	Matrix(size_t rows, size_t columns);
+
+	/// <summary> Creates a matrix from its elements listed row by row. </summary>
+	Matrix(size_t rows, size_t columns, std::initializer_list<T> elements);
+
+	/// <summary> Copies and converts the elements of a fixed or dynamically sized matrix. </summary>
+	template <class T2, int Rows2, int Columns2, eMatrixLayout Layout2, bool Packed2>
+	Matrix(const Matrix<T2, Rows2, Columns2, Order, Layout2, Packed2>& rhs);
+
+	/// <summary> Converts the matrix to a fixed size matrix. </summary>
+	/// <remarks> The dimensions must match. </remarks>
+	template <class T2, int Rows2, int Columns2, eMatrixLayout Layout2, bool Packed2, class = std::enable_if_t<(Rows2 >= 1 && Columns2 >= 1)>>
+	explicit operator Matrix<T2, Rows2, Columns2, Order, Layout2, Packed2>() const;
+
+	//--------------------------------------------
+	// Properties
+	//--------------------------------------------
+
+	/// <summary> Returns the number of columns of the matrix. </summary>
+	size_t ColumnCount() const;
+
+	/// <summary> Returns the number of rows of the matrix. </summary>
+	size_t RowCount() const;
+
+	/// <summary> Returns the number of columns of the matrix. </summary>
+	size_t Width() const;
+
+	/// <summary> Returns the number of rows of the matrix. </summary>
+	size_t Height() const;
+
+	/// <summary> Changes the number of rows and columns of the matrix. </summary>
+	/// <remarks> Elements that are inside both the old and the new size are kept, new elements are set to zero. </remarks>
+	void Resize(size_t rows, size_t columns);
+
+	//--------------------------------------------
+	// Accessors
+	//--------------------------------------------
+
+	/// <summary> Returns the <paramref name="col"/>-th element of the <paramref name="row"/>-th row. </summary>
+	T& operator()(size_t row, size_t col);
+
+	/// <summary> Returns the <paramref name="col"/>-th element of the <paramref name="row"/>-th row. </summary>
+	const T& operator()(size_t row, size_t col) const;
+
+	/// <summary> Return the matrix's column as a vector. </summary>
+	Stripe Column(size_t colIdx) const;
+
+	/// <summary> Return the matrix's row as a vector. </summary>
+	Stripe Row(size_t rowIdx) const;
+
+	/// <summary> Set the matrix's column from a vector. </summary>
+	void Column(size_t colIdx, const Stripe& column);
+
+	/// <summary> Set the matrix's row from a vector. </summary>
+	void Row(size_t rowIdx, const Stripe& row);
+
+	/// <summary> Extract a submatrix. </summary>
+	/// <param name="whereRow"> First row to extract. </param>
+	/// <param name="whereCol"> First columns to extract. </param>
+	/// <param name="rows"> Number of rows of the submatrix. </param>
+	/// <param name="columns"> Number of columns of the submatrix. </param>
+	Matrix Extract(size_t whereRow, size_t whereCol, size_t rows, size_t columns) const;
+
+	/// <summary> Insert a submatrix. </summary>
+	/// <param name="whereRow"> First row to overwrite. </param>
+	/// <param name="whereCol"> First columns to overwrite. </param>
+	void Insert(size_t whereRow, size_t whereCol, const Matrix& submatrix);
+
+	//--------------------------------------------
+	// Stripes
+	//--------------------------------------------
+
+	/// <summary> Returns the number of rows for row-major, and the number of columns for column-major matrices. </summary>
+	size_t StripeCount() const;
+
+	/// <summary> Returns the number of elements in a row for row-major, and in a column for column-major matrices. </summary>
+	size_t StripeDimension() const;
+
+	/// <summary> Returns the distance in elements between the beginnings of two consecutive stripes. </summary>
+	size_t StripeStride() const;
+
+	/// <summary> Returns a pointer to the first element of the <paramref name="stripeIdx"/>-th stripe. </summary>
+	/// <remarks> The pointer is aligned for SIMD operations. </remarks>
+	T* StripeData(size_t stripeIdx);
+
+	/// <summary> Returns a pointer to the first element of the <paramref name="stripeIdx"/>-th stripe. </summary>
+	/// <remarks> The pointer is aligned for SIMD operations. </remarks>
+	const T* StripeData(size_t stripeIdx) const;
+
+private:
+	static size_t GetStride(size_t stripeDim);
+
+private:
+	size_t m_rows = 0;
+	size_t m_columns = 0;
+	size_t m_stride = 0;
+	Storage m_elements;
+};
+
+
+template <class T, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed>::Matrix(size_t rows, size_t columns)
+	: m_rows(rows),
+	  m_columns(columns),
+	  m_stride(GetStride(Layout == eMatrixLayout::ROW_MAJOR ? columns : rows)),
+	  m_elements(m_stride * (Layout == eMatrixLayout::ROW_MAJOR ? rows : columns), static_cast<T>(0)) {}
+
+
+template <class T, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed>::Matrix(size_t rows, size_t columns, std::initializer_list<T> elements)
+	: Matrix(rows, columns) {
+	assert(elements.size() == rows * columns);
+	auto it = elements.begin();
+	for (size_t i = 0; i < rows; ++i) {
+		for (size_t j = 0; j < columns; ++j) {
+			(*this)(i, j) = *it++;
+		}
+	}
+}
+
+
+template <class T, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+template <class T2, int Rows2, int Columns2, eMatrixLayout Layout2, bool Packed2>
+Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed>::Matrix(const Matrix<T2, Rows2, Columns2, Order, Layout2, Packed2>& rhs)
+	: Matrix(rhs.RowCount(), rhs.ColumnCount()) {
+	for (size_t i = 0; i < m_rows; ++i) {
+		for (size_t j = 0; j < m_columns; ++j) {
+			(*this)(i, j) = static_cast<T>(rhs(i, j));
+		}
+	}
+}
+
+
+template <class T, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+template <class T2, int Rows2, int Columns2, eMatrixLayout Layout2, bool Packed2, class>
+Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed>::operator Matrix<T2, Rows2, Columns2, Order, Layout2, Packed2>() const {
+	assert(m_rows == Rows2 && m_columns == Columns2);
+	Matrix<T2, Rows2, Columns2, Order, Layout2, Packed2> m;
+	for (size_t i = 0; i < Rows2; ++i) {
+		for (size_t j = 0; j < Columns2; ++j) {
+			m(i, j) = static_cast<T2>((*this)(i, j));
+		}
+	}
+	return m;
+}
+
+
+template <class T, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+size_t Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed>::ColumnCount() const {
+	return m_columns;
+}
+
+
+template <class T, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+size_t Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed>::RowCount() const {
+	return m_rows;
+}
+
+
+template <class T, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+size_t Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed>::Width() const {
+	return m_columns;
+}
+
+
+template <class T, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+size_t Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed>::Height() const {
+	return m_rows;
+}
+
+
+template <class T, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+void Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed>::Resize(size_t rows, size_t columns) {
+	Matrix resized(rows, columns);
+	for (size_t i = 0; i < std::min(rows, m_rows); ++i) {
+		for (size_t j = 0; j < std::min(columns, m_columns); ++j) {
+			resized(i, j) = (*this)(i, j);
+		}
+	}
+	*this = std::move(resized);
+}
+
+
+template <class T, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+T& Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed>::operator()(size_t row, size_t col) {
+	assert(row < RowCount());
+	assert(col < ColumnCount());
+	return Layout == eMatrixLayout::ROW_MAJOR ? m_elements[row * m_stride + col] : m_elements[col * m_stride + row];
+}
+
+
+template <class T, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+const T& Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed>::operator()(size_t row, size_t col) const {
+	assert(row < RowCount());
+	assert(col < ColumnCount());
+	return Layout == eMatrixLayout::ROW_MAJOR ? m_elements[row * m_stride + col] : m_elements[col * m_stride + row];
+}
+
+
+template <class T, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+auto Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed>::Column(size_t colIdx) const -> Stripe {
+	Stripe column(RowCount());
+	if constexpr (Layout == eMatrixLayout::COLUMN_MAJOR) {
+		std::copy_n(StripeData(colIdx), RowCount(), column.data());
+	}
+	else {
+		for (size_t i = 0; i < RowCount(); ++i) {
+			column(i) = (*this)(i, colIdx);
+		}
+	}
+	return column;
+}
+
+
+template <class T, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+auto Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed>::Row(size_t rowIdx) const -> Stripe {
+	Stripe row(ColumnCount());
+	if constexpr (Layout == eMatrixLayout::ROW_MAJOR) {
+		std::copy_n(StripeData(rowIdx), ColumnCount(), row.data());
+	}
+	else {
+		for (size_t i = 0; i < ColumnCount(); ++i) {
+			row(i) = (*this)(rowIdx, i);
+		}
+	}
+	return row;
+}
+
+
+template <class T, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+void Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed>::Column(size_t colIdx, const Stripe& column) {
+	assert(size_t(column.Dimension()) == RowCount());
+	if constexpr (Layout == eMatrixLayout::COLUMN_MAJOR) {
+		std::copy_n(column.data(), RowCount(), StripeData(colIdx));
+	}
+	else {
+		for (size_t i = 0; i < RowCount(); ++i) {
+			(*this)(i, colIdx) = column(i);
+		}
+	}
+}
+
+
+template <class T, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+void Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed>::Row(size_t rowIdx, const Stripe& row) {
+	assert(size_t(row.Dimension()) == ColumnCount());
+	if constexpr (Layout == eMatrixLayout::ROW_MAJOR) {
+		std::copy_n(row.data(), ColumnCount(), StripeData(rowIdx));
+	}
+	else {
+		for (size_t i = 0; i < ColumnCount(); ++i) {
+			(*this)(rowIdx, i) = row(i);
+		}
+	}
+}
+
+
+template <class T, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+auto Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed>::Extract(size_t whereRow, size_t whereCol, size_t rows, size_t columns) const -> Matrix {
+	assert(rows + whereRow <= RowCount());
+	assert(columns + whereCol <= ColumnCount());
+	Matrix submatrix(rows, columns);
+	for (size_t row = 0; row < rows; ++row) {
+		for (size_t column = 0; column < columns; ++column) {
+			submatrix(row, column) = (*this)(row + whereRow, column + whereCol);
+		}
+	}
+	return submatrix;
+}
+
+
+template <class T, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+void Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed>::Insert(size_t whereRow, size_t whereCol, const Matrix& submatrix) {
+	assert(submatrix.RowCount() + whereRow <= RowCount());
+	assert(submatrix.ColumnCount() + whereCol <= ColumnCount());
+	for (size_t row = 0; row < submatrix.RowCount(); ++row) {
+		for (size_t column = 0; column < submatrix.ColumnCount(); ++column) {
+			(*this)(row + whereRow, column + whereCol) = submatrix(row, column);
+		}
+	}
+}
+
+
+template <class T, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+size_t Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed>::StripeCount() const {
+	return Layout == eMatrixLayout::ROW_MAJOR ? m_rows : m_columns;
+}
+
+
+template <class T, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+size_t Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed>::StripeDimension() const {
+	return Layout == eMatrixLayout::ROW_MAJOR ? m_columns : m_rows;
+}
+
+
+template <class T, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+size_t Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed>::StripeStride() const {
+	return m_stride;
+}
+
+
+template <class T, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+T* Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed>::StripeData(size_t stripeIdx) {
+	assert(stripeIdx < StripeCount());
+	return m_elements.data() + stripeIdx * m_stride;
+}
+
+
+template <class T, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+const T* Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed>::StripeData(size_t stripeIdx) const {
+	assert(stripeIdx < StripeCount());
+	return m_elements.data() + stripeIdx * m_stride;
+}
+
+
+template <class T, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+size_t Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed>::GetStride(size_t stripeDim) {
+	return impl::PadLaneSize(stripeDim, Block::size);
+}
+
+
+//------------------------------------------------------------------------------
+// Kernels
+//------------------------------------------------------------------------------
+
+namespace impl {
+
+	/// <summary> Applies <paramref name="op"/> elementwise, stripe by stripe. </summary>
+	/// <param name="makeSources"> Functions that return the source for the given stripe index. </param>
+	template <class T, eMatrixOrder Order, eMatrixLayout Layout, bool Packed, class Op, class... SourceMakers>
+	void TransformStripes(Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed>& out, Op&& op, SourceMakers&&... makeSources) {
+		for (size_t stripeIdx = 0; stripeIdx < out.StripeCount(); ++stripeIdx) {
+			TransformElements(out.StripeData(stripeIdx), out.StripeDimension(), op, makeSources(stripeIdx)...);
+		}
+	}
+
+
+	/// <summary> Computes y[i] = y[i] - a * x[i] for the first <paramref name="count"/> elements. </summary>
+	/// <remarks> The arrays must be aligned for <see cref="LaneBlock"/>. </remarks>
+	template <class T>
+	void SubtractScaledElements(T* y, const T* x, const T& a, size_t count) {
+		TransformElements(
+			y, count, [](const auto& y, const auto& x, const auto& a) { return y - a * x; },
+			ElementSource<T>{ y }, ElementSource<T>{ x }, BroadcastElementSource<T>{ a });
+	}
+
+
+	/// <summary> Computes output stripe s as the sum of coef(s, k) * source stripe k over all k. </summary>
+	/// <remarks> This is the kernel of the matrix products. The coefficients are read from
+	///		<paramref name="coef"/>[s * coefOutStep + k * coefSourceStep].
+	///		Four output stripes are accumulated in SIMD registers at once so that each loaded
+	///		source block is reused four times, and the source stripes are traversed in panels
+	///		to keep the working set in the L1 cache. </remarks>
+	template <class T>
+	void AccumulateStripes(T* out, size_t outStride, size_t outCount,
+						   const T* source, size_t sourceStride, size_t sourceCount,
+						   size_t stripeDim,
+						   const T* coef, size_t coefOutStep, size_t coefSourceStep) {
+		using Block = LaneBlock<T>;
+		constexpr size_t panelSize = 128;
+		const size_t blockedDim = stripeDim / Block::size * Block::size;
+
+		for (size_t s = 0; s < outCount; ++s) {
+			std::fill_n(out + s * outStride, stripeDim, static_cast<T>(0));
+		}
+
+		for (size_t panelBegin = 0; panelBegin < sourceCount; panelBegin += panelSize) {
+			const size_t panelEnd = std::min(panelBegin + panelSize, sourceCount);
+
+			size_t s = 0;
+			for (; s + 4 <= outCount; s += 4) {
+				T* const out0 = out + (s + 0) * outStride;
+				T* const out1 = out + (s + 1) * outStride;
+				T* const out2 = out + (s + 2) * outStride;
+				T* const out3 = out + (s + 3) * outStride;
+				const T* const coef0 = coef + (s + 0) * coefOutStep;
+				const T* const coef1 = coef + (s + 1) * coefOutStep;
+				const T* const coef2 = coef + (s + 2) * coefOutStep;
+				const T* const coef3 = coef + (s + 3) * coefOutStep;
+				for (size_t j = 0; j < blockedDim; j += Block::size) {
+					auto acc0 = Block::Load(out0 + j);
+					auto acc1 = Block::Load(out1 + j);
+					auto acc2 = Block::Load(out2 + j);
+					auto acc3 = Block::Load(out3 + j);
+					for (size_t k = panelBegin; k < panelEnd; ++k) {
+						const auto b = Block::Load(source + k * sourceStride + j);
+						acc0 = madd{}(Block::Broadcast(coef0[k * coefSourceStep]), b, acc0);
+						acc1 = madd{}(Block::Broadcast(coef1[k * coefSourceStep]), b, acc1);
+						acc2 = madd{}(Block::Broadcast(coef2[k * coefSourceStep]), b, acc2);
+						acc3 = madd{}(Block::Broadcast(coef3[k * coefSourceStep]), b, acc3);
+					}
+					Block::Store(out0 + j, acc0);
+					Block::Store(out1 + j, acc1);
+					Block::Store(out2 + j, acc2);
+					Block::Store(out3 + j, acc3);
+				}
+			}
+			for (; s < outCount; ++s) {
+				T* const out0 = out + s * outStride;
+				const T* const coef0 = coef + s * coefOutStep;
+				for (size_t j = 0; j < blockedDim; j += Block::size) {
+					auto acc0 = Block::Load(out0 + j);
+					for (size_t k = panelBegin; k < panelEnd; ++k) {
+						acc0 = madd{}(Block::Broadcast(coef0[k * coefSourceStep]), Block::Load(source + k * sourceStride + j), acc0);
+					}
+					Block::Store(out0 + j, acc0);
+				}
+			}
+
+			// The end of the stripes that does not fill a whole SIMD register.
+			for (s = 0; s < outCount; ++s) {
+				for (size_t j = blockedDim; j < stripeDim; ++j) {
+					T acc = out[s * outStride + j];
+					for (size_t k = panelBegin; k < panelEnd; ++k) {
+						acc = madd{}(coef[s * coefOutStep + k * coefSourceStep], source[k * sourceStride + j], acc);
+					}
+					out[s * outStride + j] = acc;
+				}
+			}
+		}
+	}
+
+
+	/// <summary> Returns the matrix as is if it already has the requested type and layout, otherwise a converted copy. </summary>
+	template <class T, eMatrixLayout Layout, class T2, eMatrixOrder Order2, eMatrixLayout Layout2, bool Packed2>
+	decltype(auto) ConvertDynamic(const Matrix<T2, DYNAMIC, DYNAMIC, Order2, Layout2, Packed2>& m) {
+		if constexpr (std::is_same_v<T, T2> && Layout == Layout2) {
+			return (m);
+		}
+		else {
+			return Matrix<T, DYNAMIC, DYNAMIC, Order2, Layout, Packed2>(m);
+		}
+	}
+
+
+	/// <summary> Returns the vector as is if it already has the requested type, otherwise a converted copy. </summary>
+	template <class T, class T2, bool Packed2>
+	decltype(auto) ConvertDynamic(const Vector<T2, DYNAMIC, Packed2>& v) {
+		if constexpr (std::is_same_v<T, T2>) {
+			return (v);
+		}
+		else {
+			return Vector<T, DYNAMIC, Packed2>(v);
+		}
+	}
+
+
+	/// <summary> Wraps the vector into a column matrix for <see cref="eMatrixOrder::PRECEDE_VECTOR"/>
+	///		or a row matrix for <see cref="eMatrixOrder::FOLLOW_VECTOR"/>. </summary>
+	template <eMatrixOrder Order, eMatrixLayout Layout, class T, bool Packed>
+	auto VectorToMatrix(const Vector<T, DYNAMIC, Packed>& v) {
+		const size_t dim = v.Dimension();
+		Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed> m(Order == eMatrixOrder::PRECEDE_VECTOR ? dim : 1,
+															 Order == eMatrixOrder::PRECEDE_VECTOR ? 1 : dim);
+		if constexpr (Order == eMatrixOrder::PRECEDE_VECTOR) {
+			m.Column(0, v);
+		}
+		else {
+			m.Row(0, v);
+		}
+		return m;
+	}
+
+
+	/// <summary> The inverse of <see cref="VectorToMatrix"/>. </summary>
+	template <class T, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+	auto MatrixToVector(const Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed>& m) {
+		if constexpr (Order == eMatrixOrder::PRECEDE_VECTOR) {
+			return m.Column(0);
+		}
+		else {
+			return m.Row(0);
+		}
+	}
+
+} // namespace impl
+
+
+//------------------------------------------------------------------------------
+// Matrix product
+//------------------------------------------------------------------------------
+
+template <class T1, eMatrixLayout Layout1, bool Packed1,
+		  class T2, eMatrixLayout Layout2, bool Packed2,
+		  eMatrixOrder Order>
+auto operator*(const Matrix<T1, DYNAMIC, DYNAMIC, Order, Layout1, Packed1>& lhs,
+			   const Matrix<T2, DYNAMIC, DYNAMIC, Order, Layout2, Packed2>& rhs) {
+	assert(lhs.ColumnCount() == rhs.RowCount());
+	using T = common_arithmetic_type_t<T1, T2>;
+	Matrix<T, DYNAMIC, DYNAMIC, Order, Layout1, Packed1 && Packed2> m(lhs.RowCount(), rhs.ColumnCount());
+	if (m.StripeCount() == 0 || m.StripeDimension() == 0) {
+		return m;
+	}
+
+	if constexpr (Layout1 == eMatrixLayout::ROW_MAJOR) {
+		// Rows of the result are linear combinations of the rows of rhs.
+		const auto& a = impl::ConvertDynamic<T, Layout1>(lhs);
+		const auto& b = impl::ConvertDynamic<T, eMatrixLayout::ROW_MAJOR>(rhs);
+		impl::AccumulateStripes(m.StripeData(0), m.StripeStride(), m.StripeCount(),
+								b.StripeData(0), b.StripeStride(), b.StripeCount(),
+								m.StripeDimension(),
+								a.StripeData(0), a.StripeStride(), size_t(1));
+	}
+	else {
+		// Columns of the result are linear combinations of the columns of lhs.
+		const auto& a = impl::ConvertDynamic<T, Layout1>(lhs);
+		const auto& b = impl::ConvertDynamic<T, Layout2>(rhs);
+		constexpr bool isRhsRowMajor = Layout2 == eMatrixLayout::ROW_MAJOR;
+		impl::AccumulateStripes(m.StripeData(0), m.StripeStride(), m.StripeCount(),
+								a.StripeData(0), a.StripeStride(), a.StripeCount(),
+								m.StripeDimension(),
+								b.StripeData(0), isRhsRowMajor ? size_t(1) : b.StripeStride(), isRhsRowMajor ? b.StripeStride() : size_t(1));
+	}
+	return m;
+}
+
+
+template <class T1, bool Packed1,
+		  class T2, eMatrixLayout Layout2, bool Packed2>
+auto operator*(const Vector<T1, DYNAMIC, Packed1>& lhs,
+			   const Matrix<T2, DYNAMIC, DYNAMIC, eMatrixOrder::FOLLOW_VECTOR, Layout2, Packed2>& rhs) {
+	assert(size_t(lhs.Dimension()) == rhs.RowCount());
+	using T = common_arithmetic_type_t<T1, T2>;
+	const auto& v = impl::ConvertDynamic<T>(lhs);
+	const auto& m = impl::ConvertDynamic<T, Layout2>(rhs);
+	Vector<T, DYNAMIC, Packed1 && Packed2> result(m.ColumnCount());
+	if (m.RowCount() == 0 || m.ColumnCount() == 0) {
+		return result;
+	}
+
+	if constexpr (Layout2 == eMatrixLayout::ROW_MAJOR) {
+		impl::AccumulateStripes(result.data(), size_t(0), size_t(1),
+								m.StripeData(0), m.StripeStride(), m.StripeCount(),
+								m.StripeDimension(),
+								v.data(), size_t(0), size_t(1));
+	}
+	else {
+		for (size_t col = 0; col < m.ColumnCount(); ++col) {
+			result[col] = impl::DotElements(m.StripeData(col), v.data(), m.RowCount());
+		}
+	}
+	return result;
+}
+
+
+template <class T1, eMatrixLayout Layout1, bool Packed1,
+		  class T2, bool Packed2>
+auto operator*(const Matrix<T1, DYNAMIC, DYNAMIC, eMatrixOrder::PRECEDE_VECTOR, Layout1, Packed1>& lhs,
+			   const Vector<T2, DYNAMIC, Packed2>& rhs) {
+	return rhs * FlipLayoutAndOrder(lhs);
+}
+
+
+//------------------------------------------------------------------------------
+// Matrix x matrix elementwise operations
+//------------------------------------------------------------------------------
+
+#define MATHTER_MATRIX_DYNAMIC_ELEMENTWISE(NAME, FUNC)                                                \
+	template <class T1, eMatrixLayout Layout1, bool Packed1,                                          \
+			  class T2, eMatrixLayout Layout2, bool Packed2,                                          \
+			  eMatrixOrder Order>                                                                     \
+	auto NAME(const Matrix<T1, DYNAMIC, DYNAMIC, Order, Layout1, Packed1>& lhs,                       \
+			  const Matrix<T2, DYNAMIC, DYNAMIC, Order, Layout2, Packed2>& rhs) {                     \
+		assert(lhs.RowCount() == rhs.RowCount() && lhs.ColumnCount() == rhs.ColumnCount());           \
+		using T = std::invoke_result_t<FUNC<>, T1, T2>;                                               \
+		const auto& rhsLayout = impl::ConvertDynamic<T2, Layout1>(rhs);                               \
+		Matrix<T, DYNAMIC, DYNAMIC, Order, Layout1, Packed1 && Packed2> m(lhs.RowCount(), lhs.ColumnCount()); \
+		impl::TransformStripes(                                                                       \
+			m, FUNC<>{},                                                                              \
+			[&lhs](size_t stripeIdx) { return impl::ElementSource<T1>{ lhs.StripeData(stripeIdx) }; }, \
+			[&rhsLayout](size_t stripeIdx) { return impl::ElementSource<T2>{ rhsLayout.StripeData(stripeIdx) }; }); \
+		return m;                                                                                     \
+	}
+
+
+#define MATHTER_MATRIX_DYNAMIC_ELEMENTWISE_ASSIGN(OP)                                    \
+	template <class T1, eMatrixLayout Layout1, bool Packed1,                             \
+			  class T2, eMatrixLayout Layout2, bool Packed2,                             \
+			  eMatrixOrder Order>                                                        \
+	auto& operator OP##=(Matrix<T1, DYNAMIC, DYNAMIC, Order, Layout1, Packed1>& lhs,     \
+						 const Matrix<T2, DYNAMIC, DYNAMIC, Order, Layout2, Packed2>& rhs) { \
+		return lhs = lhs OP rhs;                                                         \
+	}
+
+
+MATHTER_MATRIX_DYNAMIC_ELEMENTWISE(operator+, std::plus);
+MATHTER_MATRIX_DYNAMIC_ELEMENTWISE(operator-, std::minus);
+MATHTER_MATRIX_DYNAMIC_ELEMENTWISE(operator/, std::divides);
+MATHTER_MATRIX_DYNAMIC_ELEMENTWISE(Hadamard, std::multiplies);
+
+MATHTER_MATRIX_DYNAMIC_ELEMENTWISE_ASSIGN(+);
+MATHTER_MATRIX_DYNAMIC_ELEMENTWISE_ASSIGN(-);
+MATHTER_MATRIX_DYNAMIC_ELEMENTWISE_ASSIGN(/);
+
+#undef MATHTER_MATRIX_DYNAMIC_ELEMENTWISE
+#undef MATHTER_MATRIX_DYNAMIC_ELEMENTWISE_ASSIGN
+
+
+//------------------------------------------------------------------------------
+// Matrix x scalar operations
+//------------------------------------------------------------------------------
+
+#define MATHTER_MATRIX_DYNAMIC_SCALAR(OP, FUNC)                                                                     \
+	template <class T1, eMatrixOrder Order1, eMatrixLayout Layout1, bool Packed1,                                   \
+			  class T2,                                                                                             \
+			  class = std::enable_if_t<is_scalar_v<T2>>>                                                            \
+	auto operator OP(const Matrix<T1, DYNAMIC, DYNAMIC, Order1, Layout1, Packed1>& lhs,                             \
+					 const T2& rhs) {                                                                               \
+		using T = std::invoke_result_t<FUNC<>, T1, T2>;                                                             \
+		Matrix<T, DYNAMIC, DYNAMIC, Order1, Layout1, Packed1> m(lhs.RowCount(), lhs.ColumnCount());                 \
+		const auto rhsSource = impl::MakeScalarSource<T1>(rhs, FUNC<>{});                                           \
+		impl::TransformStripes(                                                                                     \
+			m, FUNC<>{},                                                                                            \
+			[&lhs](size_t stripeIdx) { return impl::ElementSource<T1>{ lhs.StripeData(stripeIdx) }; },              \
+			[&rhsSource](size_t) { return rhsSource; });                                                            \
+		return m;                                                                                                   \
+	}
+
+
+#define MATHTER_MATRIX_DYNAMIC_SCALAR_ASSIGN(OP)                                                  \
+	template <class T1, eMatrixOrder Order1, eMatrixLayout Layout1, bool Packed1,                 \
+			  class T2,                                                                           \
+			  class = std::enable_if_t<is_scalar_v<T2>>>                                          \
+	auto& operator OP##=(Matrix<T1, DYNAMIC, DYNAMIC, Order1, Layout1, Packed1>& lhs,             \
+						 const T2 & rhs) {                                                        \
+		return lhs = lhs OP rhs;                                                                  \
+	}
+
+
+#define MATHTER_MATRIX_DYNAMIC_SCALAR_REVERSE(OP, FUNC)                                                             \
+	template <class T1,                                                                                             \
+			  class T2, eMatrixOrder Order2, eMatrixLayout Layout2, bool Packed2,                                   \
+			  class = std::enable_if_t<is_scalar_v<T1>>>                                                            \
+	auto operator OP(const T1& lhs,                                                                                 \
+					 const Matrix<T2, DYNAMIC, DYNAMIC, Order2, Layout2, Packed2>& rhs) {                           \
+		using T = std::invoke_result_t<FUNC<>, T1, T2>;                                                             \
+		Matrix<T, DYNAMIC, DYNAMIC, Order2, Layout2, Packed2> m(rhs.RowCount(), rhs.ColumnCount());                 \
+		const auto lhsSource = impl::MakeScalarSource<T2>(lhs, FUNC<>{});                                           \
+		impl::TransformStripes(                                                                                     \
+			m, FUNC<>{},                                                                                            \
+			[&lhsSource](size_t) { return lhsSource; },                                                             \
+			[&rhs](size_t stripeIdx) { return impl::ElementSource<T2>{ rhs.StripeData(stripeIdx) }; });             \
+		return m;                                                                                                   \
+	}
+
+
+MATHTER_MATRIX_DYNAMIC_SCALAR(*, std::multiplies);
+MATHTER_MATRIX_DYNAMIC_SCALAR(/, std::divides);
+MATHTER_MATRIX_DYNAMIC_SCALAR(+, std::plus);
+MATHTER_MATRIX_DYNAMIC_SCALAR(-, std::minus);
+
+MATHTER_MATRIX_DYNAMIC_SCALAR_ASSIGN(*);
+MATHTER_MATRIX_DYNAMIC_SCALAR_ASSIGN(/);
+MATHTER_MATRIX_DYNAMIC_SCALAR_ASSIGN(+);
+MATHTER_MATRIX_DYNAMIC_SCALAR_ASSIGN(-);
+
+MATHTER_MATRIX_DYNAMIC_SCALAR_REVERSE(*, std::multiplies);
+MATHTER_MATRIX_DYNAMIC_SCALAR_REVERSE(/, std::divides);
+MATHTER_MATRIX_DYNAMIC_SCALAR_REVERSE(+, std::plus);
+MATHTER_MATRIX_DYNAMIC_SCALAR_REVERSE(-, std::minus);
+
+#undef MATHTER_MATRIX_DYNAMIC_SCALAR
+#undef MATHTER_MATRIX_DYNAMIC_SCALAR_ASSIGN
+#undef MATHTER_MATRIX_DYNAMIC_SCALAR_REVERSE
+
+
+template <class T, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+auto operator-(const Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed>& arg) {
+	return arg * -static_cast<T>(1);
+}
+
+
+//------------------------------------------------------------------------------
+// Comparison
+//------------------------------------------------------------------------------
+
+template <class T1, class T2, eMatrixOrder Order, eMatrixLayout Layout1, eMatrixLayout Layout2, bool Packed1, bool Packed2>
+bool operator==(const Matrix<T1, DYNAMIC, DYNAMIC, Order, Layout1, Packed1>& lhs, const Matrix<T2, DYNAMIC, DYNAMIC, Order, Layout2, Packed2>& rhs) {
+	if (lhs.RowCount() != rhs.RowCount() || lhs.ColumnCount() != rhs.ColumnCount()) {
+		return false;
+	}
+	bool equal = true;
+	for (size_t i = 0; i < lhs.RowCount(); ++i) {
+		for (size_t j = 0; j < lhs.ColumnCount(); ++j) {
+			equal = equal && lhs(i, j) == rhs(i, j);
+		}
+	}
+	return equal;
+}
+
+
+template <class T1, class T2, eMatrixOrder Order, eMatrixLayout Layout1, eMatrixLayout Layout2, bool Packed1, bool Packed2>
+bool operator==(const Matrix<T1, DYNAMIC, DYNAMIC, Order, Layout1, Packed1>& lhs, const Matrix<T2, DYNAMIC, DYNAMIC, opposite_order_v<Order>, Layout2, Packed2>& rhs) {
+	if (lhs.RowCount() != rhs.ColumnCount() || lhs.ColumnCount() != rhs.RowCount()) {
+		return false;
+	}
+	bool equal = true;
+	for (size_t i = 0; i < lhs.RowCount(); ++i) {
+		for (size_t j = 0; j < lhs.ColumnCount(); ++j) {
+			equal = equal && lhs(i, j) == rhs(j, i);
+		}
+	}
+	return equal;
+}
+
+
+template <class T1, class T2, eMatrixOrder Order, eMatrixLayout Layout1, eMatrixLayout Layout2, bool Packed1, bool Packed2>
+bool operator!=(const Matrix<T1, DYNAMIC, DYNAMIC, Order, Layout1, Packed1>& lhs, const Matrix<T2, DYNAMIC, DYNAMIC, Order, Layout2, Packed2>& rhs) {
+	return !(lhs == rhs);
+}
+
+
+template <class T1, class T2, eMatrixOrder Order, eMatrixLayout Layout1, eMatrixLayout Layout2, bool Packed1, bool Packed2>
+bool operator!=(const Matrix<T1, DYNAMIC, DYNAMIC, Order, Layout1, Packed1>& lhs, const Matrix<T2, DYNAMIC, DYNAMIC, opposite_order_v<Order>, Layout2, Packed2>& rhs) {
+	return !(lhs == rhs);
+}
+
+
+//------------------------------------------------------------------------------
+// Cast
+//------------------------------------------------------------------------------
+
+/// <summary> Flip both the order and the layout of the matrix. </summary>
+/// <remarks> This essentially transposes the matrix, but leaves the stripes the same. </remarks>
+template <class T, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+auto FlipLayoutAndOrder(const Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed>& m) {
+	Matrix<T, DYNAMIC, DYNAMIC, opposite_order_v<Order>, opposite_layout_v<Layout>, Packed> out(m.ColumnCount(), m.RowCount());
+	for (size_t stripeIdx = 0; stripeIdx < m.StripeCount(); ++stripeIdx) {
+		std::copy_n(m.StripeData(stripeIdx), m.StripeDimension(), out.StripeData(stripeIdx));
+	}
+	return out;
+}
+
+
+/// <summary> Flip  the order of the matrix. </summary>
+/// <typeparam name="PreserveTransform"> If true, transposes the matrix to preserve transform,
+///		if false, preserves elements and is essentially a copy. </typeparam>
+template <eMatrixOrder DesiredOrder, class T, eMatrixOrder Order, eMatrixLayout Layout, bool Packed, bool PreserveTransform>
+auto SetOrder(const Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed>& m, std::integral_constant<bool, PreserveTransform>) {
+	using Mat = Matrix<T, DYNAMIC, DYNAMIC, DesiredOrder, Layout, Packed>;
+	const bool transpose = PreserveTransform && DesiredOrder != Order;
+	Mat out(transpose ? m.ColumnCount() : m.RowCount(), transpose ? m.RowCount() : m.ColumnCount());
+	for (size_t i = 0; i < m.RowCount(); ++i) {
+		for (size_t j = 0; j < m.ColumnCount(); ++j) {
+			(transpose ? out(j, i) : out(i, j)) = m(i, j);
+		}
+	}
+	return out;
+}
+
+
+/// <summary> Flip  the order of the matrix. </summary>
+/// <typeparam name="PreserveTransform"> If true, transposes the matrix to preserve transform,
+///		if false, preserves elements and is essentially a copy. </typeparam>
+template <class T, eMatrixOrder Order, eMatrixLayout Layout, bool Packed, bool PreserveTransform>
+auto FlipOrder(const Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed>& m, std::integral_constant<bool, PreserveTransform> preserveTransform) {
+	return SetOrder<opposite_order_v<Order>>(m, preserveTransform);
+}
+
+
+//------------------------------------------------------------------------------
+// Math
+//------------------------------------------------------------------------------
+
+/// <summary> Returns the minimum element of the matrix. </summary>
+template <class T, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+T Min(const Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed>& m) {
+	assert(m.StripeCount() > 0 && m.StripeDimension() > 0);
+	T minElement = m(0, 0);
+	for (size_t stripe = 0; stripe < m.StripeCount(); ++stripe) {
+		minElement = std::min(minElement, *std::min_element(m.StripeData(stripe), m.StripeData(stripe) + m.StripeDimension()));
+	}
+	return minElement;
+}
+
+
+/// <summary> Returns the maximum element of the matrix. </summary>
+template <class T, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+T Max(const Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed>& m) {
+	assert(m.StripeCount() > 0 && m.StripeDimension() > 0);
+	T maxElement = m(0, 0);
+	for (size_t stripe = 0; stripe < m.StripeCount(); ++stripe) {
+		maxElement = std::max(maxElement, *std::max_element(m.StripeData(stripe), m.StripeData(stripe) + m.StripeDimension()));
+	}
+	return maxElement;
+}
+
+
+/// <summary> Computes a divisor that scales the matrix so that its largest element is close to 1. </summary>
+template <class T, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+auto ScaleElements(const Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed>& m) {
+	static_assert(!std::is_integral_v<T>, "No need to scale integer matrices.");
+
+	remove_complex_t<T> scale(0);
+	for (size_t stripe = 0; stripe < m.StripeCount(); ++stripe) {
+		for (size_t i = 0; i < m.StripeDimension(); ++i) {
+			const auto& element = m.StripeData(stripe)[i];
+			scale = std::max({ scale, std::abs(std::real(element)), std::abs(std::imag(element)) });
+		}
+	}
+	return scale;
+}
+
+
+/// <summary> Returns the sum of the elements of the matrix. </summary>
+template <class T, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+T Sum(const Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed>& m) {
+	T sum(0);
+	for (size_t stripe = 0; stripe < m.StripeCount(); ++stripe) {
+		sum = std::accumulate(m.StripeData(stripe), m.StripeData(stripe) + m.StripeDimension(), sum);
+	}
+	return sum;
+}
+
+
+#define MATHTER_MATRIX_DYNAMIC_UNARY(NAME, FUNC)                                                            \
+	template <class T, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>                               \
+	auto NAME(const Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed>& m) {                                \
+		using R = std::invoke_result_t<FUNC, T>;                                                            \
+		Matrix<R, DYNAMIC, DYNAMIC, Order, Layout, Packed> r(m.RowCount(), m.ColumnCount());                \
+		impl::TransformStripes(r, FUNC{}, [&m](size_t stripeIdx) { return impl::ElementSource<T>{ m.StripeData(stripeIdx) }; }); \
+		return r;                                                                                           \
+	}
+
+/// <summary> Returns the elementwise absolute value of the matrix. </summary>
+MATHTER_MATRIX_DYNAMIC_UNARY(Abs, abs<>)
+
+/// <summary> Returns the real part of a real or complex matrix. </summary>
+MATHTER_MATRIX_DYNAMIC_UNARY(Real, real<>)
+
+/// <summary> Returns the imaginary part of a real or complex matrix. </summary>
+MATHTER_MATRIX_DYNAMIC_UNARY(Imag, imag<>)
+
+/// <summary> Returns the elementwise complex conjugate of the matrix. </summary>
+MATHTER_MATRIX_DYNAMIC_UNARY(Conj, conj<>)
+
+#undef MATHTER_MATRIX_DYNAMIC_UNARY
+
+
+/// <summary> Returns the trace (sum of diagonal elements) of the matrix. </summary>
+template <class T, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+T Trace(const Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed>& m) {
+	assert(m.RowCount() == m.ColumnCount());
+	T sum(0);
+	for (size_t i = 0; i < m.RowCount(); ++i) {
+		sum += m(i, i);
+	}
+	return sum;
+}
+
+
+/// <summary> Returns the determinant of the matrix. </summary>
+/// <remarks> Uses the Bareiss algorithm, which is exact for integer matrices. </remarks>
+template <class T, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+T Determinant(const Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed>& m) {
+	assert(m.RowCount() == m.ColumnCount());
+	const size_t dim = m.RowCount();
+	if (dim == 0) {
+		return static_cast<T>(1);
+	}
+
+	Matrix<T, DYNAMIC, DYNAMIC, Order, eMatrixLayout::ROW_MAJOR, Packed> inPlace = m;
+	bool flipSign = false;
+	for (size_t k = 0; k + 1 < dim; ++k) {
+		auto minor = k == 0 ? static_cast<T>(1) : inPlace(k - 1, k - 1);
+		for (size_t i = k; i < dim && minor == static_cast<T>(0); ++i) {
+			assert(k > 0); // Should be ensured as minor is always 1 for k=0.
+			const auto candidate = inPlace(i, k - 1);
+			if (candidate != static_cast<T>(0)) {
+				std::swap_ranges(inPlace.StripeData(k - 1), inPlace.StripeData(k - 1) + dim, inPlace.StripeData(i));
+				minor = candidate;
+				flipSign = !flipSign;
+			}
+		}
+
+		if (minor == static_cast<T>(0)) {
+			return static_cast<T>(0);
+		}
+
+		for (size_t i = k + 1; i < dim; ++i) {
+			for (size_t j = k + 1; j < dim; ++j) {
+				inPlace(i, j) = (inPlace(i, j) * inPlace(k, k) - inPlace(i, k) * inPlace(k, j)) / minor;
+			}
+		}
+	}
+
+	return flipSign ? -inPlace(dim - 1, dim - 1) : inPlace(dim - 1, dim - 1);
+}
+
+
+/// <summary> Transposes the matrix. </summary>
+template <class T, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+auto Transpose(const Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed>& m) {
+	Matrix<T, DYNAMIC, DYNAMIC, Order, Layout, Packed> result(m.ColumnCount(), m.RowCount());
+	for (size_t i = 0; i < m.RowCount(); ++i) {
+		for (size_t j = 0; j < m.ColumnCount(); ++j) {
+			result(j, i) = m(i, j);
+		}
+	}
+	return result;
+}
+
+
+} // namespace mathter
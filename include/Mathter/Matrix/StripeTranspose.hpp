@@ -0,0 +1,110 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#pragma once
+
+#include "../Common/OptimizationUtil.hpp"
+#include "../Common/TypeTraits.hpp"
+#include "../Vector/SIMDUtil.hpp"
+#include "../Vector/Vector.hpp"
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+
+namespace mathter {
+
+namespace impl {
+
+	/// <summary> Tells if the array of stripes <typeparamref name="StripesIn"/> can be transposed
+	///		into <typeparamref name="StripesOut"/> by shuffling whole SIMD registers. </summary>
+	/// <remarks> Both the input and the output stripes must be stored in the same SIMD register type,
+	///		and there can't be more stripes than the register has lanes. Fewer stripes are fine,
+	///		the missing ones are treated as zeros, which also keeps the padding of the output zero. </remarks>
+	template <class StripesOut, class StripesIn>
+	constexpr bool IsShuffleTransposable() {
+		using VecIn = typename StripesIn::value_type;
+		using VecOut = typename StripesOut::value_type;
+		using T = scalar_type_t<VecIn>;
+		using BatchIn = MakeBatch<T, dimension_v<VecIn>, is_packed_v<VecIn>>;
+		using BatchOut = MakeBatch<scalar_type_t<VecOut>, dimension_v<VecOut>, is_packed_v<VecOut>>;
+		if constexpr (std::is_arithmetic_v<T> && !std::is_void_v<BatchIn> && std::is_same_v<BatchIn, BatchOut>) {
+			constexpr size_t lanes = BatchIn::size;
+			constexpr bool isPowerOfTwo = (lanes & (lanes - 1)) == 0;
+			return isPowerOfTwo && std::tuple_size_v<StripesIn> <= lanes && std::tuple_size_v<StripesOut> <= lanes;
+		}
+		return false;
+	}
+
+
+#if MATHTER_ENABLE_SIMD
+	/// <summary> Interleaves the first half of the rows with the second half. </summary>
+	template <class Batch, size_t... Indices>
+	MATHTER_FORCEINLINE void InterleaveBatches(Batch (&rows)[Batch::size], std::index_sequence<Indices...>) {
+		constexpr size_t half = Batch::size / 2;
+		const Batch interleaved[] = { (Indices % 2 == 0 ? xsimd::zip_lo(rows[Indices / 2], rows[Indices / 2 + half])
+														: xsimd::zip_hi(rows[Indices / 2], rows[Indices / 2 + half]))... };
+		((rows[Indices] = interleaved[Indices]), ...);
+	}
+
+
+	/// <summary> Transposes a square block of registers in place. </summary>
+	/// <remarks> Each round interleaves the first half of the rows with the second half.
+	///		After log2(N) rounds, row i holds what was column i. The rounds are unrolled at compile time,
+	///		because the compiler would keep the rows in memory if it had to index them at runtime. </remarks>
+	template <class Batch, size_t Round = 1>
+	MATHTER_FORCEINLINE void TransposeBatches(Batch (&rows)[Batch::size]) {
+		if constexpr (Round < Batch::size) {
+			InterleaveBatches(rows, std::make_index_sequence<Batch::size>{});
+			TransposeBatches<Batch, Round * 2>(rows);
+		}
+	}
+#endif
+
+
+	/// <summary> Writes the i-th element of every input stripe into the i-th output stripe. </summary>
+	/// <remarks> This is the storage-level operation behind both transposing a matrix and changing its layout.
+	///		When the stripes are SIMD registers, it's done with shuffles instead of element by element. </remarks>
+	template <class StripesOut, class StripesIn>
+	MATHTER_FORCEINLINE void TransposeStripes(StripesOut& out, const StripesIn& in) {
+		constexpr size_t countIn = std::tuple_size_v<StripesIn>;
+		constexpr size_t countOut = std::tuple_size_v<StripesOut>;
+		static_assert(size_t(dimension_v<typename StripesOut::value_type>) == countIn);
+		static_assert(size_t(dimension_v<typename StripesIn::value_type>) == countOut);
+
+#if MATHTER_ENABLE_SIMD
+		if constexpr (IsShuffleTransposable<StripesOut, StripesIn>()) {
+			using VecIn = typename StripesIn::value_type;
+			using Batch = MakeBatch<scalar_type_t<VecIn>, dimension_v<VecIn>, is_packed_v<VecIn>>;
+
+			Batch rows[Batch::size];
+			for (size_t i = 0; i < countIn; ++i) {
+				rows[i] = in[i].elements.Load();
+			}
+			for (size_t i = countIn; i < Batch::size; ++i) {
+				rows[i] = Batch(scalar_type_t<VecIn>(0));
+			}
+			TransposeBatches(rows);
+			for (size_t j = 0; j < countOut; ++j) {
+				out[j].elements.Store(rows[j]);
+			}
+		}
+		else
+#endif
+		{
+			using TOut = scalar_type_t<typename StripesOut::value_type>;
+			for (size_t i = 0; i < countIn; ++i) {
+				for (size_t j = 0; j < countOut; ++j) {
+					out[j].elements.array[i] = static_cast<TOut>(in[i].elements.array[j]);
+				}
+			}
+		}
+	}
+
+} // namespace impl
+
+} // namespace mathter
@@ -0,0 +1,159 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#pragma once
+
+// This header is compiled with the flags of each architecture of the runtime dispatch.
+// It must not include anything besides xsimd and must not use any type or function template
+// that isn't specialized for the architecture, otherwise the linker could pick an instantiation
+// compiled for a newer CPU in the code paths of an older one.
+#if MATHTER_ENABLE_SIMD
+#include <xsimd/xsimd.hpp>
+#endif
+
+#include <cstddef>
+#include <type_traits>
+
+
+namespace mathter {
+
+
+namespace impl {
+
+	enum class eHomogeneousMode {
+		/// <summary> The vectors are points with w=1, the result is not divided by w. </summary>
+		POINT,
+		/// <summary> The vectors are points with w=1, the result is divided by w. </summary>
+		POINT_PERSPECTIVE,
+		/// <summary> The vectors are directions with w=0. </summary>
+		DIRECTION,
+	};
+
+
+	/// <summary> Transforms the vectors stored in three structure-of-arrays lanes. </summary>
+	/// <remarks> <typeparamref name="Register"/> is either <typeparamref name="T"/> or an xsimd batch of it.
+	///		The lanes must be aligned for the register and <paramref name="paddedCount"/> must be a multiple of its size.
+	///		The input and output lanes may be the same. </remarks>
+	/// <param name="coefficients"> The 4x4 coefficients in row-major order, see <see cref="HomogeneousCoefficients"/>. </param>
+	template <eHomogeneousMode Mode, class Register, class T>
+	void TransformLanes(const T* const* in,
+						T* const* out,
+						size_t paddedCount,
+						const T* coefficients) {
+		constexpr bool isScalar = std::is_same_v<Register, T>;
+		constexpr size_t size = sizeof(Register) / sizeof(T);
+		constexpr int outputs = Mode == eHomogeneousMode::POINT_PERSPECTIVE ? 4 : 3;
+
+		// Lambdas are unique to the instantiation, unlike helper templates that would be shared among architectures.
+		const auto load = [](const T* ptr) -> Register {
+			if constexpr (isScalar) {
+				return *ptr;
+			}
+			else {
+				return Register::load_aligned(ptr);
+			}
+		};
+		const auto store = [](T* ptr, const Register& value) {
+			if constexpr (isScalar) {
+				*ptr = value;
+			}
+			else {
+				value.store_aligned(ptr);
+			}
+		};
+		const auto madd = [](const Register& a, const Register& b, const Register& c) -> Register {
+#if MATHTER_ENABLE_SIMD
+			if constexpr (!isScalar) {
+				return xsimd::fma(a, b, c);
+			}
+			else
+#endif
+			{
+				return a * b + c;
+			}
+		};
+
+		// Broadcast up front so that the transform stays in registers for the whole loop.
+		Register c[4][4];
+		for (size_t i = 0; i < 4; ++i) {
+			for (size_t j = 0; j < 4; ++j) {
+				c[i][j] = Register(coefficients[4 * i + j]);
+			}
+		}
+
+		for (size_t index = 0; index < paddedCount; index += size) {
+			const Register x = load(in[0] + index);
+			const Register y = load(in[1] + index);
+			const Register z = load(in[2] + index);
+
+			Register result[4];
+			for (int j = 0; j < outputs; ++j) {
+				if constexpr (Mode != eHomogeneousMode::DIRECTION) {
+					result[j] = madd(z, c[2][j], madd(y, c[1][j], madd(x, c[0][j], c[3][j])));
+				}
+				else {
+					result[j] = madd(z, c[2][j], madd(y, c[1][j], x * c[0][j]));
+				}
+			}
+			if constexpr (Mode == eHomogeneousMode::POINT_PERSPECTIVE) {
+				const Register rcpW = Register(T(1)) / result[3];
+				for (int j = 0; j < 3; ++j) {
+					result[j] *= rcpW;
+				}
+			}
+
+			for (int j = 0; j < 3; ++j) {
+				store(out[j] + index, result[j]);
+			}
+		}
+	}
+
+
+	/// <summary> Runs <see cref="TransformLanes"/> for the architecture selected at runtime. </summary>
+	/// <remarks> Only instantiated for float and double, see <see cref="DispatchTransformLanes"/>. </remarks>
+	template <eHomogeneousMode Mode>
+	struct TransformLanesKernel {
+		template <class Arch, class T>
+		void operator()(Arch,
+						const T* const* in,
+						T* const* out,
+						size_t paddedCount,
+						const T* coefficients) const;
+	};
+
+
+#ifdef MATHTER_DISPATCH_INSTANTIATE
+	template <eHomogeneousMode Mode>
+	template <class Arch, class T>
+	void TransformLanesKernel<Mode>::operator()(Arch,
+												const T* const* in,
+												T* const* out,
+												size_t paddedCount,
+												const T* coefficients) const {
+		TransformLanes<Mode, xsimd::batch<T, Arch>>(in, out, paddedCount, coefficients);
+	}
+
+
+#define MATHTER_INSTANTIATE_TRANSFORM_LANES(MODE, TYPE)                                      \
+	template void TransformLanesKernel<MODE>::operator()<MATHTER_DISPATCH_INSTANTIATE, TYPE>( \
+		MATHTER_DISPATCH_INSTANTIATE,                                                        \
+		const TYPE* const*,                                                                  \
+		TYPE* const*,                                                                        \
+		size_t,                                                                              \
+		const TYPE*) const;
+
+	MATHTER_INSTANTIATE_TRANSFORM_LANES(eHomogeneousMode::POINT, float)
+	MATHTER_INSTANTIATE_TRANSFORM_LANES(eHomogeneousMode::POINT, double)
+	MATHTER_INSTANTIATE_TRANSFORM_LANES(eHomogeneousMode::POINT_PERSPECTIVE, float)
+	MATHTER_INSTANTIATE_TRANSFORM_LANES(eHomogeneousMode::POINT_PERSPECTIVE, double)
+	MATHTER_INSTANTIATE_TRANSFORM_LANES(eHomogeneousMode::DIRECTION, float)
+	MATHTER_INSTANTIATE_TRANSFORM_LANES(eHomogeneousMode::DIRECTION, double)
+
+#undef MATHTER_INSTANTIATE_TRANSFORM_LANES
+#endif
+
+} // namespace impl
+
+} // namespace mathter
@@ -0,0 +1,305 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#pragma once
+
+#include "../Common/Dispatch.hpp"
+#include "../Vector/SIMDUtil.hpp"
+#include "../Vector/Vector.hpp"
+#include "../Vector/VectorArray.hpp"
+#include "Math.hpp"
+#include "Matrix.hpp"
+#include "TransformLanes.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+
+namespace mathter {
+
+
+namespace impl {
+
+	/// <summary> The element [i][j] multiplies the i-th homogeneous input coordinate
+	///		in the sum for the j-th output coordinate, regardless of the order of the matrix. </summary>
+	/// <remarks> The kernels take the coefficients as a flat array of 16 scalars. </remarks>
+	template <class T>
+	using HomogeneousCoefficients = std::array<std::array<T, 4>, 4>;
+
+
+	/// <summary> Extracts the coefficients of a 4x4 transform or an affine 4x3 or 3x4 transform. </summary>
+	/// <remarks> Affine transforms are completed with the missing (0, 0, 0, 1) row or column. </remarks>
+	template <class T, class TM, int Rows, int Columns, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+	HomogeneousCoefficients<T> GetHomogeneousCoefficients(const Matrix<TM, Rows, Columns, Order, Layout, Packed>& m) {
+		constexpr int inputs = Order == eMatrixOrder::FOLLOW_VECTOR ? Rows : Columns;
+		constexpr int outputs = Order == eMatrixOrder::FOLLOW_VECTOR ? Columns : Rows;
+		static_assert(inputs == 4 && (outputs == 3 || outputs == 4), "Transform must be 4x4 or affine (4x3 follow or 3x4 precede).");
+
+		HomogeneousCoefficients<T> coefficients = {};
+		for (int i = 0; i < inputs; ++i) {
+			for (int j = 0; j < outputs; ++j) {
+				if constexpr (Order == eMatrixOrder::FOLLOW_VECTOR) {
+					coefficients[i][j] = static_cast<T>(m(i, j));
+				}
+				else {
+					coefficients[i][j] = static_cast<T>(m(j, i));
+				}
+			}
+		}
+		if constexpr (outputs == 3) {
+			coefficients[3][3] = T(1);
+		}
+		return coefficients;
+	}
+
+
+	/// <summary> Calls <see cref="TransformLanes"/> through runtime dispatch if enabled, or for the default architecture. </summary>
+	/// <remarks> The lanes must be padded to <see cref="LanePadding"/>. </remarks>
+	template <eHomogeneousMode Mode, class T>
+	void DispatchTransformLanes(const std::array<const T*, 3>& in,
+								const std::array<T*, 3>& out,
+								size_t paddedCount,
+								const HomogeneousCoefficients<T>& coefficients) {
+		const T* flatCoefficients = coefficients[0].data();
+#if MATHTER_ENABLE_DISPATCH
+		if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>) {
+			Dispatch(TransformLanesKernel<Mode>{}, in.data(), out.data(), paddedCount, flatCoefficients);
+		}
+		else {
+			TransformLanes<Mode, typename LaneBlock<T>::Block>(in.data(), out.data(), paddedCount, flatCoefficients);
+		}
+#else
+		TransformLanes<Mode, typename LaneBlock<T>::Block>(in.data(), out.data(), paddedCount, flatCoefficients);
+#endif
+	}
+
+
+	/// <summary> Transforms an array of vectors in array-of-structures layout. </summary>
+	/// <remarks> The vectors are deinterleaved into stack buffers a batch at a time,
+	///		transformed as lanes, then interleaved into the output.
+	///		Since each batch is fully read before it's written, in-place operation is allowed. </remarks>
+	template <eHomogeneousMode Mode, class T, bool PackedIn, bool PackedOut>
+	void TransformVectors(const Vector<T, 3, PackedIn>* in,
+						  size_t count,
+						  const HomogeneousCoefficients<T>& coefficients,
+						  Vector<T, 3, PackedOut>* out) {
+		constexpr size_t batchSize = PadLaneSize(16, LanePadding<T>());
+
+		alignas(laneAlignment) T stage[3][batchSize];
+		for (size_t first = 0; first < count; first += batchSize) {
+			const size_t batchCount = std::min(batchSize, count - first);
+			const size_t paddedCount = PadLaneSize(batchCount, LanePadding<T>());
+			for (size_t k = 0; k < batchCount; ++k) {
+				const auto& v = in[first + k];
+				stage[0][k] = v[0];
+				stage[1][k] = v[1];
+				stage[2][k] = v[2];
+			}
+			for (size_t k = batchCount; k < paddedCount; ++k) {
+				stage[0][k] = stage[1][k] = stage[2][k] = T(0);
+			}
+
+			DispatchTransformLanes<Mode, T>({ stage[0], stage[1], stage[2] }, { stage[0], stage[1], stage[2] }, paddedCount, coefficients);
+
+			for (size_t k = 0; k < batchCount; ++k) {
+				auto& v = out[first + k];
+				v[0] = stage[0][k];
+				v[1] = stage[1][k];
+				v[2] = stage[2][k];
+			}
+		}
+	}
+
+
+	template <eHomogeneousMode Mode, class T>
+	VectorArray<T, 3> TransformVectors(const VectorArray<T, 3>& in, const HomogeneousCoefficients<T>& coefficients) {
+		VectorArray<T, 3> out(in.Size());
+		DispatchTransformLanes<Mode, T>({ in.Lane(0), in.Lane(1), in.Lane(2) }, { out.Lane(0), out.Lane(1), out.Lane(2) }, in.PaddedSize(), coefficients);
+		return out;
+	}
+
+
+	/// <summary> Replaces the linear part of the transform with its inverse transpose, and drops the translation. </summary>
+	template <class T>
+	HomogeneousCoefficients<T> GetNormalCoefficients(const HomogeneousCoefficients<T>& coefficients) {
+		Matrix<T, 3, 3, eMatrixOrder::FOLLOW_VECTOR, eMatrixLayout::ROW_MAJOR, false> linear;
+		for (int i = 0; i < 3; ++i) {
+			for (int j = 0; j < 3; ++j) {
+				linear(i, j) = coefficients[i][j];
+			}
+		}
+		const auto inverse = Inverse(linear);
+
+		HomogeneousCoefficients<T> normalCoefficients = {};
+		for (int i = 0; i < 3; ++i) {
+			for (int j = 0; j < 3; ++j) {
+				normalCoefficients[i][j] = inverse(j, i);
+			}
+		}
+		return normalCoefficients;
+	}
+
+} // namespace impl
+
+
+//------------------------------------------------------------------------------
+// Points
+//------------------------------------------------------------------------------
+
+/// <summary> Transforms an array of points by an affine transform. </summary>
+/// <remarks> The points are augmented by w=1, but the results are not divided by w.
+///		Use <see cref="TransformPointsPerspective"/> for projective transforms.
+///		<paramref name="out"/> may be the same as <paramref name="points"/>, but they must not partially overlap. </remarks>
+/// <param name="points"> Pointer to the first point to transform. </param>
+/// <param name="count"> The number of points to transform. </param>
+/// <param name="transform"> A 4x4 matrix, or an affine 4x3 (follow) or 3x4 (precede) matrix. </param>
+/// <param name="out"> Where the transformed points are written. Must have room for <paramref name="count"/> points. </param>
+template <class T, bool PackedIn, bool PackedOut, class TM, int Rows, int Columns, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+void TransformPoints(const Vector<T, 3, PackedIn>* points,
+					 size_t count,
+					 const Matrix<TM, Rows, Columns, Order, Layout, Packed>& transform,
+					 Vector<T, 3, PackedOut>* out) {
+	const auto coefficients = impl::GetHomogeneousCoefficients<T>(transform);
+	impl::TransformVectors<impl::eHomogeneousMode::POINT>(points, count, coefficients, out);
+}
+
+
+/// <summary> Transforms a contiguous range of points by an affine transform. </summary>
+/// <remarks> Works with std::vector, std::array, std::span, or anything else that std::data and std::size accept.
+///		See the pointer overload for details. </remarks>
+template <class RangeIn, class Mat, class RangeOut>
+auto TransformPoints(const RangeIn& points, const Mat& transform, RangeOut&& out)
+	-> decltype(TransformPoints(std::data(points), std::size(points), transform, std::data(out))) {
+	assert(std::size(out) >= std::size(points));
+	return TransformPoints(std::data(points), std::size(points), transform, std::data(out));
+}
+
+
+/// <summary> Transforms an array of points by an affine transform. </summary>
+template <class T, class TM, int Rows, int Columns, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+VectorArray<T, 3> TransformPoints(const VectorArray<T, 3>& points, const Matrix<TM, Rows, Columns, Order, Layout, Packed>& transform) {
+	return impl::TransformVectors<impl::eHomogeneousMode::POINT>(points, impl::GetHomogeneousCoefficients<T>(transform));
+}
+
+
+/// <summary> Transforms an array of points by a projective transform. </summary>
+/// <remarks> The points are augmented by w=1, and the results are divided by w,
+///		same as multiplying a 3D vector by a 4x4 matrix.
+///		<paramref name="out"/> may be the same as <paramref name="points"/>, but they must not partially overlap. </remarks>
+/// <param name="points"> Pointer to the first point to transform. </param>
+/// <param name="count"> The number of points to transform. </param>
+/// <param name="transform"> A 4x4 matrix. </param>
+/// <param name="out"> Where the transformed points are written. Must have room for <paramref name="count"/> points. </param>
+template <class T, bool PackedIn, bool PackedOut, class TM, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+void TransformPointsPerspective(const Vector<T, 3, PackedIn>* points,
+								size_t count,
+								const Matrix<TM, 4, 4, Order, Layout, Packed>& transform,
+								Vector<T, 3, PackedOut>* out) {
+	const auto coefficients = impl::GetHomogeneousCoefficients<T>(transform);
+	impl::TransformVectors<impl::eHomogeneousMode::POINT_PERSPECTIVE>(points, count, coefficients, out);
+}
+
+
+/// <summary> Transforms a contiguous range of points by a projective transform. </summary>
+/// <remarks> See the pointer overload for details. </remarks>
+template <class RangeIn, class Mat, class RangeOut>
+auto TransformPointsPerspective(const RangeIn& points, const Mat& transform, RangeOut&& out)
+	-> decltype(TransformPointsPerspective(std::data(points), std::size(points), transform, std::data(out))) {
+	assert(std::size(out) >= std::size(points));
+	return TransformPointsPerspective(std::data(points), std::size(points), transform, std::data(out));
+}
+
+
+/// <summary> Transforms an array of points by a projective transform. </summary>
+template <class T, class TM, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+VectorArray<T, 3> TransformPointsPerspective(const VectorArray<T, 3>& points, const Matrix<TM, 4, 4, Order, Layout, Packed>& transform) {
+	return impl::TransformVectors<impl::eHomogeneousMode::POINT_PERSPECTIVE>(points, impl::GetHomogeneousCoefficients<T>(transform));
+}
+
+
+//------------------------------------------------------------------------------
+// Directions
+//------------------------------------------------------------------------------
+
+/// <summary> Transforms an array of direction vectors by an affine transform. </summary>
+/// <remarks> The vectors are augmented by w=0, so translation does not affect them.
+///		<paramref name="out"/> may be the same as <paramref name="directions"/>, but they must not partially overlap. </remarks>
+/// <param name="directions"> Pointer to the first vector to transform. </param>
+/// <param name="count"> The number of vectors to transform. </param>
+/// <param name="transform"> A 4x4 matrix, or an affine 4x3 (follow) or 3x4 (precede) matrix. </param>
+/// <param name="out"> Where the transformed vectors are written. Must have room for <paramref name="count"/> vectors. </param>
+template <class T, bool PackedIn, bool PackedOut, class TM, int Rows, int Columns, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+void TransformDirections(const Vector<T, 3, PackedIn>* directions,
+						 size_t count,
+						 const Matrix<TM, Rows, Columns, Order, Layout, Packed>& transform,
+						 Vector<T, 3, PackedOut>* out) {
+	const auto coefficients = impl::GetHomogeneousCoefficients<T>(transform);
+	impl::TransformVectors<impl::eHomogeneousMode::DIRECTION>(directions, count, coefficients, out);
+}
+
+
+/// <summary> Transforms a contiguous range of direction vectors by an affine transform. </summary>
+/// <remarks> See the pointer overload for details. </remarks>
+template <class RangeIn, class Mat, class RangeOut>
+auto TransformDirections(const RangeIn& directions, const Mat& transform, RangeOut&& out)
+	-> decltype(TransformDirections(std::data(directions), std::size(directions), transform, std::data(out))) {
+	assert(std::size(out) >= std::size(directions));
+	return TransformDirections(std::data(directions), std::size(directions), transform, std::data(out));
+}
+
+
+/// <summary> Transforms an array of direction vectors by an affine transform. </summary>
+template <class T, class TM, int Rows, int Columns, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+VectorArray<T, 3> TransformDirections(const VectorArray<T, 3>& directions, const Matrix<TM, Rows, Columns, Order, Layout, Packed>& transform) {
+	return impl::TransformVectors<impl::eHomogeneousMode::DIRECTION>(directions, impl::GetHomogeneousCoefficients<T>(transform));
+}
+
+
+//------------------------------------------------------------------------------
+// Normals
+//------------------------------------------------------------------------------
+
+/// <summary> Transforms an array of surface normals by an affine transform. </summary>
+/// <remarks> The normals are multiplied by the inverse transpose of the linear part of the transform,
+///		which keeps them perpendicular to the transformed surface even under non-uniform scaling.
+///		The inverse is calculated once for the whole array. The results are not normalized.
+///		<paramref name="out"/> may be the same as <paramref name="normals"/>, but they must not partially overlap. </remarks>
+/// <param name="normals"> Pointer to the first normal to transform. </param>
+/// <param name="count"> The number of normals to transform. </param>
+/// <param name="transform"> A 4x4 matrix, or an affine 4x3 (follow) or 3x4 (precede) matrix. The linear part must be invertible. </param>
+/// <param name="out"> Where the transformed normals are written. Must have room for <paramref name="count"/> normals. </param>
+template <class T, bool PackedIn, bool PackedOut, class TM, int Rows, int Columns, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+void TransformNormals(const Vector<T, 3, PackedIn>* normals,
+					  size_t count,
+					  const Matrix<TM, Rows, Columns, Order, Layout, Packed>& transform,
+					  Vector<T, 3, PackedOut>* out) {
+	const auto coefficients = impl::GetNormalCoefficients(impl::GetHomogeneousCoefficients<T>(transform));
+	impl::TransformVectors<impl::eHomogeneousMode::DIRECTION>(normals, count, coefficients, out);
+}
+
+
+/// <summary> Transforms a contiguous range of surface normals by an affine transform. </summary>
+/// <remarks> See the pointer overload for details. </remarks>
+template <class RangeIn, class Mat, class RangeOut>
+auto TransformNormals(const RangeIn& normals, const Mat& transform, RangeOut&& out)
+	-> decltype(TransformNormals(std::data(normals), std::size(normals), transform, std::data(out))) {
+	assert(std::size(out) >= std::size(normals));
+	return TransformNormals(std::data(normals), std::size(normals), transform, std::data(out));
+}
+
+
+/// <summary> Transforms an array of surface normals by an affine transform. </summary>
+template <class T, class TM, int Rows, int Columns, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+VectorArray<T, 3> TransformNormals(const VectorArray<T, 3>& normals, const Matrix<TM, Rows, Columns, Order, Layout, Packed>& transform) {
+	const auto coefficients = impl::GetNormalCoefficients(impl::GetHomogeneousCoefficients<T>(transform));
+	return impl::TransformVectors<impl::eHomogeneousMode::DIRECTION>(normals, coefficients);
+}
+
+
+} // namespace mathter
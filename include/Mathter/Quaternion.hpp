@@ -7,7 +7,10 @@
 
 #include "Quaternion/Arithmetic.hpp"
 #include "Quaternion/Comparison.hpp"
+#include "Quaternion/DualQuaternion.hpp"
+#include "Quaternion/Interpolation.hpp"
 #include "Quaternion/Literals.hpp"
 #include "Quaternion/Math.hpp"
 #include "Quaternion/Quaternion.hpp"
+#include "Quaternion/RotateVectors.hpp"
 #include "Quaternion/RotationArithmetic.hpp"
\ No newline at end of file
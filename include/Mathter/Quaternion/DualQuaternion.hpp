@@ -0,0 +1,442 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#pragma once
+
+#include "../Common/Functional.hpp"
+#include "../Matrix/Matrix.hpp"
+#include "../Vector/Math.hpp"
+#include "../Vector/SIMDUtil.hpp"
+#include "../Vector/Vector.hpp"
+#include "Arithmetic.hpp"
+#include "Comparison.hpp"
+#include "Math.hpp"
+#include "Quaternion.hpp"
+#include "RotationArithmetic.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+
+namespace mathter {
+
+
+/// <summary> Represents a rigid transform, that is, a rotation followed by a translation, in 8 scalars. </summary>
+/// <typeparam name="T"> The scalar type of the quaternions. </typeparam>
+/// <typeparam name="Layout"> The memory layout of the quaternions. </typeparam>
+/// <typeparam name="Packed"> If true, tightly packs the quaternions and disables SIMD optimization. </typeparam>
+/// <remarks>
+/// The dual quaternion is real + epsilon * dual, where epsilon^2 = 0. The real part is the unit quaternion of the rotation,
+/// and the dual part is half the translation, as a pure quaternion, multiplied by the rotation.
+/// Like quaternions, dual quaternions are combined right-to-left, so `a * b` applies `b` first.
+/// </remarks>
+template <class T, eQuaternionLayout Layout = eQuaternionLayout::SCALAR_FIRST, bool Packed = false>
+class DualQuaternion {
+public:
+	/// <summary> The rotation part of the transform. </summary>
+	Quaternion<T, Layout, Packed> real;
+	/// <summary> The translation part of the transform, mixed with the rotation. </summary>
+	Quaternion<T, Layout, Packed> dual;
+
+	//-----------------------------------------------
+	// Constructors
+	//-----------------------------------------------
+
+	/// <summary> Does NOT zero-initialize values. </summary>
+	DualQuaternion() = default;
+
+	/// <summary> Sets the real and dual parts directly. </summary>
+	DualQuaternion(const Quaternion<T, Layout, Packed>& real, const Quaternion<T, Layout, Packed>& dual);
+
+	/// <summary> Creates the transform that first rotates, then translates. </summary>
+	/// <param name="rotation"> A unit quaternion. </param>
+	DualQuaternion(const Quaternion<T, Layout, Packed>& rotation, const Vector<T, 3, Packed>& translation);
+
+	/// <summary> Convert from a dual quaternion of different (or same) type. </summary>
+	template <class TOther, eQuaternionLayout LayoutOther, bool PackedOther>
+	DualQuaternion(const DualQuaternion<TOther, LayoutOther, PackedOther>& rhs);
+
+	/// <summary> Converts a rigid transform matrix to the equivalent dual quaternion. </summary>
+	/// <remarks> The matrix must be 4x4, 4x3 with follow-vector order, or 3x4 with precede-vector order.
+	///		Its 3x3 part must be in SO(3). </remarks>
+	template <class TOther, int RowsOther, int ColumnsOther, eMatrixOrder OrderOther, eMatrixLayout LayoutOther, bool PackedOther>
+	explicit DualQuaternion(const Matrix<TOther, RowsOther, ColumnsOther, OrderOther, LayoutOther, PackedOther>& matrix);
+
+	//-----------------------------------------------
+	// Conversion operators
+	//-----------------------------------------------
+
+	/// <summary> Converts the dual quaternion into a rigid transform matrix. </summary>
+	/// <remarks> The matrix must be 4x4, 4x3 with follow-vector order, or 3x4 with precede-vector order. </remarks>
+	template <class TOther, int RowsOther, int ColumnsOther, eMatrixOrder OrderOther, eMatrixLayout LayoutOther, bool PackedOther>
+	explicit operator Matrix<TOther, RowsOther, ColumnsOther, OrderOther, LayoutOther, PackedOther>() const;
+
+	//-----------------------------------------------
+	// Rigid transform
+	//-----------------------------------------------
+
+	/// <summary> Returns the translation part of this unit dual quaternion. </summary>
+	Vector<T, 3, Packed> Translation() const;
+
+	/// <summary> Rotates then translates a point by this unit dual quaternion. </summary>
+	template <class TOther, bool PackedOther>
+	Vector<T, 3, Packed> operator()(const Vector<TOther, 3, PackedOther>& point) const;
+
+	//-----------------------------------------------
+	// Identity
+	//-----------------------------------------------
+
+	/// <summary> Returns the transform that leaves everything in place. </summary>
+	static DualQuaternion Identity();
+};
+
+
+//------------------------------------------------------------------------------
+// Helpers
+//------------------------------------------------------------------------------
+
+namespace impl {
+
+	template <eMatrixOrder Order, int Rows, int Columns>
+	constexpr bool IsRigidTransformShape() {
+		return (Rows == 4 && Columns == 4)
+			   || (Order == eMatrixOrder::FOLLOW_VECTOR && Rows == 4 && Columns == 3)
+			   || (Order == eMatrixOrder::PRECEDE_VECTOR && Rows == 3 && Columns == 4);
+	}
+
+} // namespace impl
+
+
+//------------------------------------------------------------------------------
+// Constructors
+//------------------------------------------------------------------------------
+
+template <class T, eQuaternionLayout Layout, bool Packed>
+DualQuaternion<T, Layout, Packed>::DualQuaternion(const Quaternion<T, Layout, Packed>& real, const Quaternion<T, Layout, Packed>& dual)
+	: real(real), dual(dual) {}
+
+
+template <class T, eQuaternionLayout Layout, bool Packed>
+DualQuaternion<T, Layout, Packed>::DualQuaternion(const Quaternion<T, Layout, Packed>& rotation, const Vector<T, 3, Packed>& translation)
+	: real(rotation), dual(Quaternion<T, Layout, Packed>(T(0.5) * translation) * rotation) {}
+
+
+template <class T, eQuaternionLayout Layout, bool Packed>
+template <class TOther, eQuaternionLayout LayoutOther, bool PackedOther>
+DualQuaternion<T, Layout, Packed>::DualQuaternion(const DualQuaternion<TOther, LayoutOther, PackedOther>& rhs)
+	: real(rhs.real), dual(rhs.dual) {}
+
+
+template <class T, eQuaternionLayout Layout, bool Packed>
+template <class TOther, int RowsOther, int ColumnsOther, eMatrixOrder OrderOther, eMatrixLayout LayoutOther, bool PackedOther>
+DualQuaternion<T, Layout, Packed>::DualQuaternion(const Matrix<TOther, RowsOther, ColumnsOther, OrderOther, LayoutOther, PackedOther>& matrix) {
+	static_assert(impl::IsRigidTransformShape<OrderOther, RowsOther, ColumnsOther>(), "Matrix does not represent a 3D rigid transform.");
+	Vector<T, 3, Packed> translation;
+	for (int i = 0; i < 3; ++i) {
+		if constexpr (OrderOther == eMatrixOrder::FOLLOW_VECTOR) {
+			translation[i] = static_cast<T>(matrix(3, i));
+		}
+		else {
+			translation[i] = static_cast<T>(matrix(i, 3));
+		}
+	}
+	*this = DualQuaternion(Quaternion<T, Layout, Packed>(matrix), translation);
+}
+
+
+template <class T, eQuaternionLayout Layout, bool Packed>
+template <class TOther, int RowsOther, int ColumnsOther, eMatrixOrder OrderOther, eMatrixLayout LayoutOther, bool PackedOther>
+DualQuaternion<T, Layout, Packed>::operator Matrix<TOther, RowsOther, ColumnsOther, OrderOther, LayoutOther, PackedOther>() const {
+	static_assert(impl::IsRigidTransformShape<OrderOther, RowsOther, ColumnsOther>(), "Matrix cannot represent a 3D rigid transform.");
+	auto matrix = Matrix<TOther, RowsOther, ColumnsOther, OrderOther, LayoutOther, PackedOther>(real);
+	const auto translation = Translation();
+	for (int i = 0; i < 3; ++i) {
+		if constexpr (OrderOther == eMatrixOrder::FOLLOW_VECTOR) {
+			matrix(3, i) = static_cast<TOther>(translation[i]);
+		}
+		else {
+			matrix(i, 3) = static_cast<TOther>(translation[i]);
+		}
+	}
+	return matrix;
+}
+
+
+template <class T, eQuaternionLayout Layout, bool Packed>
+Vector<T, 3, Packed> DualQuaternion<T, Layout, Packed>::Translation() const {
+	// The vector part of 2 * dual * Conj(real), without the scalar part.
+	const Vector<T, 3, Packed> realVector = real.vector;
+	const Vector<T, 3, Packed> dualVector = dual.vector;
+	const T realScalar = real.scalar;
+	const T dualScalar = dual.scalar;
+	return T(2) * (realScalar * dualVector - dualScalar * realVector + Cross(realVector, dualVector));
+}
+
+
+template <class T, eQuaternionLayout Layout, bool Packed>
+template <class TOther, bool PackedOther>
+Vector<T, 3, Packed> DualQuaternion<T, Layout, Packed>::operator()(const Vector<TOther, 3, PackedOther>& point) const {
+	return Vector<T, 3, Packed>(real(Vector<T, 3, Packed>(point)) + Translation());
+}
+
+
+template <class T, eQuaternionLayout Layout, bool Packed>
+DualQuaternion<T, Layout, Packed> DualQuaternion<T, Layout, Packed>::Identity() {
+	return { Quaternion<T, Layout, Packed>(T(1), T(0), T(0), T(0)), Quaternion<T, Layout, Packed>(T(0), T(0), T(0), T(0)) };
+}
+
+
+//------------------------------------------------------------------------------
+// Arithmetic
+//------------------------------------------------------------------------------
+
+template <class T, eQuaternionLayout Layout, bool Packed>
+DualQuaternion<T, Layout, Packed> operator+(const DualQuaternion<T, Layout, Packed>& lhs, const DualQuaternion<T, Layout, Packed>& rhs) {
+	return { lhs.real + rhs.real, lhs.dual + rhs.dual };
+}
+
+
+template <class T, eQuaternionLayout Layout, bool Packed>
+DualQuaternion<T, Layout, Packed> operator-(const DualQuaternion<T, Layout, Packed>& lhs, const DualQuaternion<T, Layout, Packed>& rhs) {
+	return { lhs.real - rhs.real, lhs.dual - rhs.dual };
+}
+
+
+/// <summary> Combines two transforms, <paramref name="rhs"/> is applied first. </summary>
+template <class T, eQuaternionLayout Layout, bool Packed>
+DualQuaternion<T, Layout, Packed> operator*(const DualQuaternion<T, Layout, Packed>& lhs, const DualQuaternion<T, Layout, Packed>& rhs) {
+	return { lhs.real * rhs.real, lhs.real * rhs.dual + lhs.dual * rhs.real };
+}
+
+
+template <class T, eQuaternionLayout Layout, bool Packed>
+DualQuaternion<T, Layout, Packed> operator*(const DualQuaternion<T, Layout, Packed>& lhs, const T& rhs) {
+	return { lhs.real * rhs, lhs.dual * rhs };
+}
+
+
+template <class T, eQuaternionLayout Layout, bool Packed>
+DualQuaternion<T, Layout, Packed> operator*(const T& lhs, const DualQuaternion<T, Layout, Packed>& rhs) {
+	return rhs * lhs;
+}
+
+
+template <class T, eQuaternionLayout Layout, bool Packed>
+DualQuaternion<T, Layout, Packed>& operator+=(DualQuaternion<T, Layout, Packed>& lhs, const DualQuaternion<T, Layout, Packed>& rhs) {
+	return lhs = lhs + rhs;
+}
+
+
+template <class T, eQuaternionLayout Layout, bool Packed>
+DualQuaternion<T, Layout, Packed>& operator-=(DualQuaternion<T, Layout, Packed>& lhs, const DualQuaternion<T, Layout, Packed>& rhs) {
+	return lhs = lhs - rhs;
+}
+
+
+template <class T, eQuaternionLayout Layout, bool Packed>
+DualQuaternion<T, Layout, Packed>& operator*=(DualQuaternion<T, Layout, Packed>& lhs, const DualQuaternion<T, Layout, Packed>& rhs) {
+	return lhs = lhs * rhs;
+}
+
+
+template <class T, eQuaternionLayout Layout, bool Packed>
+DualQuaternion<T, Layout, Packed>& operator*=(DualQuaternion<T, Layout, Packed>& lhs, const T& rhs) {
+	return lhs = lhs * rhs;
+}
+
+
+template <class T1, eQuaternionLayout Layout1, bool Packed1,
+		  class T2, eQuaternionLayout Layout2, bool Packed2>
+bool operator==(const DualQuaternion<T1, Layout1, Packed1>& lhs, const DualQuaternion<T2, Layout2, Packed2>& rhs) {
+	return lhs.real == rhs.real && lhs.dual == rhs.dual;
+}
+
+
+template <class T1, eQuaternionLayout Layout1, bool Packed1,
+		  class T2, eQuaternionLayout Layout2, bool Packed2>
+bool operator!=(const DualQuaternion<T1, Layout1, Packed1>& lhs, const DualQuaternion<T2, Layout2, Packed2>& rhs) {
+	return !(lhs == rhs);
+}
+
+
+//------------------------------------------------------------------------------
+// Math
+//------------------------------------------------------------------------------
+
+/// <summary> Conjugates the real and dual parts as quaternions. </summary>
+/// <remarks> For unit dual quaternions, this is the inverse transform. </remarks>
+template <class T, eQuaternionLayout Layout, bool Packed>
+DualQuaternion<T, Layout, Packed> Conj(const DualQuaternion<T, Layout, Packed>& dq) {
+	return { Conj(dq.real), Conj(dq.dual) };
+}
+
+
+/// <summary> Returns the inverse of a unit dual quaternion. </summary>
+template <class T, eQuaternionLayout Layout, bool Packed>
+DualQuaternion<T, Layout, Packed> Inverse(const DualQuaternion<T, Layout, Packed>& dq) {
+	return Conj(dq);
+}
+
+
+/// <summary> Returns the unit dual quaternion of the same transform. </summary>
+/// <remarks> Scales both parts so that the real part has unit length, then removes the component of
+///		the dual part that's parallel to the real part, which accumulates from rounding errors
+///		over many multiplications. The real part must not be zero. </remarks>
+template <class T, eQuaternionLayout Layout, bool Packed>
+DualQuaternion<T, Layout, Packed> Normalize(const DualQuaternion<T, Layout, Packed>& dq) {
+	const T rcpLength = T(1) / Length(dq.real);
+	const auto real = dq.real * rcpLength;
+	const auto dual = dq.dual * rcpLength;
+	return { real, dual - real * Dot(real, dual) };
+}
+
+
+/// <summary> Tells if the dual quaternion represents a rigid transform, within the given tolerance. </summary>
+template <class T, eQuaternionLayout Layout, bool Packed>
+bool IsNormalized(const DualQuaternion<T, Layout, Packed>& dq, T tolerance = T(1e-4)) {
+	return std::abs(LengthSquared(dq.real) - T(1)) <= tolerance && std::abs(Dot(dq.real, dq.dual)) <= tolerance;
+}
+
+
+//------------------------------------------------------------------------------
+// Blending
+//------------------------------------------------------------------------------
+
+/// <summary> Blends several rigid transforms with dual quaternion linear blending. </summary>
+/// <remarks> The dual quaternions are flipped into the same hemisphere as the first one, summed with their weights,
+///		then normalized with <see cref="Normalize"/>. Unlike blending matrices, this doesn't shrink or shear the result.
+///		The weights need not add up to one, but their weighted sum must not be zero. </remarks>
+/// <param name="transforms"> Pointer to the first of the unit dual quaternions to blend. </param>
+/// <param name="weights"> Pointer to the first of the weights of the transforms. </param>
+/// <param name="count"> The number of transforms and weights. Must be at least one. </param>
+template <class T, eQuaternionLayout Layout, bool Packed>
+DualQuaternion<T, Layout, Packed> Blend(const DualQuaternion<T, Layout, Packed>* transforms, const T* weights, size_t count) {
+	assert(count > 0);
+	const auto& reference = transforms[0].real;
+	auto sum = transforms[0] * weights[0];
+	for (size_t i = 1; i < count; ++i) {
+		const T weight = Dot(reference, transforms[i].real) < T(0) ? -weights[i] : weights[i];
+		sum += transforms[i] * weight;
+	}
+	return Normalize(sum);
+}
+
+
+/// <summary> Blends a contiguous range of rigid transforms with dual quaternion linear blending. </summary>
+/// <remarks> See the pointer overload for details. </remarks>
+template <class Transforms, class Weights>
+auto Blend(const Transforms& transforms, const Weights& weights)
+	-> decltype(Blend(std::data(transforms), std::data(weights), std::size(transforms))) {
+	assert(std::size(transforms) == std::size(weights));
+	return Blend(std::data(transforms), std::data(weights), std::size(transforms));
+}
+
+
+/// <summary> Blends the joint transforms for many skinned vertices at once. </summary>
+/// <remarks> The i-th output is the <see cref="Blend"/> of the joints that influence the i-th vertex.
+///		The joints of several vertices are gathered into SIMD registers and blended together.
+///		Only the joint transforms are stored as dual quaternions, which takes half the memory of affine matrices.
+///		Influences with zero weight still read their joint, so their index must be valid. </remarks>
+/// <param name="joints"> The unit dual quaternions of the joints of the skeleton. </param>
+/// <param name="indices"> The indices of the joints that influence the vertices, <paramref name="influences"/> per vertex. </param>
+/// <param name="weights"> The weights of the joints, same layout as <paramref name="indices"/>. </param>
+/// <param name="influences"> The number of joints that influence each vertex. Must be at least one. </param>
+/// <param name="count"> The number of vertices. </param>
+/// <param name="out"> Where the blended transforms are written. Must have room for <paramref name="count"/> transforms. </param>
+template <class T, eQuaternionLayout Layout, bool Packed, class Index>
+void Blend(const DualQuaternion<T, Layout, Packed>* joints,
+		   const Index* indices,
+		   const T* weights,
+		   size_t influences,
+		   size_t count,
+		   DualQuaternion<T, Layout, Packed>* out) {
+	static_assert(std::is_integral_v<Index>, "Joint indices must be integers.");
+	assert(influences > 0);
+
+	using Block = impl::LaneBlock<T>;
+	using Register = typename Block::Block;
+	constexpr size_t batchSize = impl::PadLaneSize(16, impl::LanePadding<T>());
+
+	// The 8 canonical elements of the gathered joints, real part first.
+	alignas(impl::laneAlignment) T stage[8][batchSize];
+	alignas(impl::laneAlignment) T stageWeights[batchSize];
+	alignas(impl::laneAlignment) T reference[4][batchSize];
+	alignas(impl::laneAlignment) T sum[8][batchSize];
+
+	const Register zero = Block::Broadcast(T(0));
+	const Register one = Block::Broadcast(T(1));
+	for (size_t first = 0; first < count; first += batchSize) {
+		const size_t batchCount = std::min(batchSize, count - first);
+		const size_t paddedCount = impl::PadLaneSize(batchCount, impl::LanePadding<T>());
+
+		for (size_t influence = 0; influence < influences; ++influence) {
+			for (size_t k = 0; k < paddedCount; ++k) {
+				// The padding is blended from identities so that it doesn't produce NaNs.
+				const auto joint = k < batchCount ? joints[indices[(first + k) * influences + influence]] : DualQuaternion<T, Layout, Packed>::Identity();
+				const Vector<T, 4, Packed> real = joint.real.canonical;
+				const Vector<T, 4, Packed> dual = joint.dual.canonical;
+				for (size_t c = 0; c < 4; ++c) {
+					stage[c][k] = real[c];
+					stage[c + 4][k] = dual[c];
+				}
+				stageWeights[k] = k < batchCount ? weights[(first + k) * influences + influence] : T(1);
+			}
+
+			for (size_t index = 0; index < paddedCount; index += Block::size) {
+				std::array<Register, 8> q;
+				for (size_t c = 0; c < 8; ++c) {
+					q[c] = Block::Load(stage[c] + index);
+				}
+				Register weight = Block::Load(stageWeights + index);
+				if (influence == 0) {
+					for (size_t c = 0; c < 4; ++c) {
+						Block::Store(reference[c] + index, q[c]);
+					}
+				}
+				else {
+					// Flip into the hemisphere of the first influence.
+					Register cosAngle = zero;
+					for (size_t c = 0; c < 4; ++c) {
+						cosAngle += q[c] * Block::Load(reference[c] + index);
+					}
+					weight = select<>{}(cosAngle < zero, -weight, weight);
+				}
+				for (size_t c = 0; c < 8; ++c) {
+					const Register previous = influence == 0 ? zero : Block::Load(sum[c] + index);
+					Block::Store(sum[c] + index, previous + weight * q[c]);
+				}
+			}
+		}
+
+		for (size_t index = 0; index < paddedCount; index += Block::size) {
+			std::array<Register, 8> q;
+			for (size_t c = 0; c < 8; ++c) {
+				q[c] = Block::Load(sum[c] + index);
+			}
+			// Same as the Normalize function.
+			const Register rcpLength = one / sqrt<>{}(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+			for (auto& element : q) {
+				element *= rcpLength;
+			}
+			const Register parallel = q[0] * q[4] + q[1] * q[5] + q[2] * q[6] + q[3] * q[7];
+			for (size_t c = 0; c < 4; ++c) {
+				Block::Store(sum[c] + index, q[c]);
+				Block::Store(sum[c + 4] + index, q[c + 4] - q[c] * parallel);
+			}
+		}
+
+		for (size_t k = 0; k < batchCount; ++k) {
+			auto& result = out[first + k];
+			result.real.canonical = Vector<T, 4, Packed>(sum[0][k], sum[1][k], sum[2][k], sum[3][k]);
+			result.dual.canonical = Vector<T, 4, Packed>(sum[4][k], sum[5][k], sum[6][k], sum[7][k]);
+		}
+	}
+}
+
+} // namespace mathter
@@ -0,0 +1,276 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#pragma once
+
+#include "../Common/Functional.hpp"
+#include "../Vector/SIMDUtil.hpp"
+#include "Math.hpp"
+#include "Quaternion.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+
+
+namespace mathter {
+
+
+namespace impl {
+
+	enum class eInterpolationMode {
+		/// <summary> Linear interpolation followed by normalization. </summary>
+		NLERP,
+		/// <summary> Spherical linear interpolation. </summary>
+		SLERP,
+	};
+
+
+	/// <summary> Four structure-of-arrays lanes that hold the canonical (s, i, j, k) elements of quaternions. </summary>
+	template <class T>
+	using QuaternionLanes = std::array<T*, 4>;
+
+
+	/// <summary> Interpolates between the quaternions stored in structure-of-arrays lanes. </summary>
+	/// <remarks> The lanes must be aligned and <paramref name="paddedCount"/> must be a multiple of the block size.
+	///		The output lanes may be the same as either of the input lanes. </remarks>
+	template <eInterpolationMode Mode, class T, class Arch = DefaultArch>
+	void InterpolateLanes(const QuaternionLanes<const T>& from,
+						  const QuaternionLanes<const T>& to,
+						  const QuaternionLanes<T>& out,
+						  size_t paddedCount,
+						  T t) {
+		using Block = LaneBlock<T, Arch>;
+		using Register = typename Block::Block;
+
+		const Register zero = Block::Broadcast(T(0));
+		const Register one = Block::Broadcast(T(1));
+		const Register tb = Block::Broadcast(t);
+
+		for (size_t index = 0; index < paddedCount; index += Block::size) {
+			std::array<Register, 4> a;
+			std::array<Register, 4> b;
+			for (size_t c = 0; c < 4; ++c) {
+				a[c] = Block::Load(from[c] + index);
+				b[c] = Block::Load(to[c] + index);
+			}
+
+			// Take the shorter path by flipping the target into the hemisphere of the source.
+			const Register cosAngle = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+			const Register sign = select<>{}(cosAngle < zero, -one, one);
+			for (auto& element : b) {
+				element *= sign;
+			}
+
+			std::array<Register, 4> result;
+			if constexpr (Mode == eInterpolationMode::NLERP) {
+				for (size_t c = 0; c < 4; ++c) {
+					result[c] = a[c] + tb * (b[c] - a[c]);
+				}
+				const Register lengthSq = result[0] * result[0] + result[1] * result[1] + result[2] * result[2] + result[3] * result[3];
+				const Register rcpLength = one / sqrt<>{}(lengthSq);
+				for (auto& element : result) {
+					element *= rcpLength;
+				}
+			}
+			else {
+				Register differenceSq = zero;
+				Register sumSq = zero;
+				for (size_t c = 0; c < 4; ++c) {
+					const Register difference = a[c] - b[c];
+					const Register sum = a[c] + b[c];
+					differenceSq += difference * difference;
+					sumSq += sum * sum;
+				}
+				const Register angle = Block::Broadcast(T(2)) * atan2<>{}(sqrt<>{}(differenceSq), sqrt<>{}(sumSq));
+				const auto isTiny = angle <= Block::Broadcast(std::numeric_limits<T>::epsilon());
+
+				// Tiny angles would divide zero by zero, they fall back to linear interpolation instead.
+				const Register safeAngle = select<>{}(isTiny, one, angle);
+				const Register rcpSinAngle = one / sin<>{}(safeAngle);
+				const Register weightFrom = select<>{}(isTiny, one - tb, sin<>{}((one - tb) * safeAngle) * rcpSinAngle);
+				const Register weightTo = select<>{}(isTiny, tb, sin<>{}(tb * safeAngle) * rcpSinAngle);
+				for (size_t c = 0; c < 4; ++c) {
+					result[c] = weightFrom * a[c] + weightTo * b[c];
+				}
+			}
+
+			for (size_t c = 0; c < 4; ++c) {
+				Block::Store(out[c] + index, result[c]);
+			}
+		}
+	}
+
+
+	/// <summary> Interpolates arrays of quaternions in array-of-structures layout. </summary>
+	/// <remarks> The quaternions are deinterleaved into stack buffers a batch at a time,
+	///		interpolated as lanes, then interleaved into the output.
+	///		Since each batch is fully read before it's written, in-place operation is allowed. </remarks>
+	template <eInterpolationMode Mode, class T, eQuaternionLayout Layout, bool Packed>
+	void InterpolateQuaternions(const Quaternion<T, Layout, Packed>* from,
+								const Quaternion<T, Layout, Packed>* to,
+								size_t count,
+								T t,
+								Quaternion<T, Layout, Packed>* out) {
+		constexpr size_t batchSize = PadLaneSize(16, LanePadding<T>());
+
+		alignas(laneAlignment) T stageFrom[4][batchSize];
+		alignas(laneAlignment) T stageTo[4][batchSize];
+		const QuaternionLanes<const T> fromLanes = { stageFrom[0], stageFrom[1], stageFrom[2], stageFrom[3] };
+		const QuaternionLanes<const T> toLanes = { stageTo[0], stageTo[1], stageTo[2], stageTo[3] };
+		const QuaternionLanes<T> outLanes = { stageFrom[0], stageFrom[1], stageFrom[2], stageFrom[3] };
+
+		for (size_t first = 0; first < count; first += batchSize) {
+			const size_t batchCount = std::min(batchSize, count - first);
+			const size_t paddedCount = PadLaneSize(batchCount, LanePadding<T>());
+			for (size_t k = 0; k < paddedCount; ++k) {
+				// The padding is filled with identities so that it doesn't produce NaNs.
+				const auto a = k < batchCount ? Vector<T, 4, Packed>(from[first + k].canonical) : Vector<T, 4, Packed>(1, 0, 0, 0);
+				const auto b = k < batchCount ? Vector<T, 4, Packed>(to[first + k].canonical) : Vector<T, 4, Packed>(1, 0, 0, 0);
+				for (size_t c = 0; c < 4; ++c) {
+					stageFrom[c][k] = a[c];
+					stageTo[c][k] = b[c];
+				}
+			}
+			InterpolateLanes<Mode, T>(fromLanes, toLanes, outLanes, paddedCount, t);
+			for (size_t k = 0; k < batchCount; ++k) {
+				out[first + k].canonical = Vector<T, 4, Packed>(stageFrom[0][k], stageFrom[1][k], stageFrom[2][k], stageFrom[3][k]);
+			}
+		}
+	}
+
+} // namespace impl
+
+
+/// <summary> Interpolates between two arrays of rotations element by element, using <see cref="Nlerp"/>. </summary>
+/// <remarks> Gives the same results as calling the single quaternion <see cref="Nlerp"/> on each pair,
+///		but several pairs are interpolated at once using SIMD. This is typically used to blend two poses
+///		of an animated skeleton. <paramref name="out"/> may be the same as either input,
+///		but they must not partially overlap. </remarks>
+/// <param name="from"> Pointer to the first quaternion to interpolate from. </param>
+/// <param name="to"> Pointer to the first quaternion to interpolate to. </param>
+/// <param name="count"> The number of quaternions to interpolate. </param>
+/// <param name="t"> The interpolation parameter, shared by all elements. </param>
+/// <param name="out"> Where the results are written. Must have room for <paramref name="count"/> quaternions. </param>
+template <class T, eQuaternionLayout Layout, bool Packed>
+void Nlerp(const Quaternion<T, Layout, Packed>* from,
+		   const Quaternion<T, Layout, Packed>* to,
+		   size_t count,
+		   T t,
+		   Quaternion<T, Layout, Packed>* out) {
+	impl::InterpolateQuaternions<impl::eInterpolationMode::NLERP>(from, to, count, t, out);
+}
+
+
+/// <summary> Interpolates between two contiguous ranges of rotations element by element, using <see cref="Nlerp"/>. </summary>
+/// <remarks> See the pointer overload for details. </remarks>
+template <class RangeFrom, class RangeTo, class T, class RangeOut>
+auto Nlerp(const RangeFrom& from, const RangeTo& to, T t, RangeOut&& out)
+	-> decltype(Nlerp(std::data(from), std::data(to), std::size(from), t, std::data(out))) {
+	assert(std::size(to) == std::size(from));
+	assert(std::size(out) >= std::size(from));
+	return Nlerp(std::data(from), std::data(to), std::size(from), t, std::data(out));
+}
+
+
+/// <summary> Interpolates between two arrays of rotations element by element, using <see cref="Slerp"/>. </summary>
+/// <remarks> Gives the same results as calling the single quaternion <see cref="Slerp"/> on each pair,
+///		but several pairs are interpolated at once using SIMD. <paramref name="out"/> may be the same as either input,
+///		but they must not partially overlap. </remarks>
+/// <param name="from"> Pointer to the first quaternion to interpolate from. </param>
+/// <param name="to"> Pointer to the first quaternion to interpolate to. </param>
+/// <param name="count"> The number of quaternions to interpolate. </param>
+/// <param name="t"> The interpolation parameter, shared by all elements. </param>
+/// <param name="out"> Where the results are written. Must have room for <paramref name="count"/> quaternions. </param>
+template <class T, eQuaternionLayout Layout, bool Packed>
+void Slerp(const Quaternion<T, Layout, Packed>* from,
+		   const Quaternion<T, Layout, Packed>* to,
+		   size_t count,
+		   T t,
+		   Quaternion<T, Layout, Packed>* out) {
+	impl::InterpolateQuaternions<impl::eInterpolationMode::SLERP>(from, to, count, t, out);
+}
+
+
+/// <summary> Interpolates between two contiguous ranges of rotations element by element, using <see cref="Slerp"/>. </summary>
+/// <remarks> See the pointer overload for details. </remarks>
+template <class RangeFrom, class RangeTo, class T, class RangeOut>
+auto Slerp(const RangeFrom& from, const RangeTo& to, T t, RangeOut&& out)
+	-> decltype(Slerp(std::data(from), std::data(to), std::size(from), t, std::data(out))) {
+	assert(std::size(to) == std::size(from));
+	assert(std::size(out) >= std::size(from));
+	return Slerp(std::data(from), std::data(to), std::size(from), t, std::data(out));
+}
+
+
+/// <summary> Calculates the element-wise weighted average of several arrays of rotations. </summary>
+/// <remarks> The i-th output is the <see cref="Average"/> of the i-th quaternion of each array.
+///		This is typically used to blend several poses of an animated skeleton.
+///		The arrays are accumulated one after the other in SIMD registers, so each pose is read only once.
+///		<paramref name="out"/> may be the same as any of the inputs, but they must not partially overlap. </remarks>
+/// <param name="arrays"> Pointer to the first of the arrays of unit quaternions to average. </param>
+/// <param name="weights"> The weight of each array, as many as there are arrays. </param>
+/// <param name="arrayCount"> The number of arrays to average. Must be at least one. </param>
+/// <param name="count"> The number of quaternions in each array. </param>
+/// <param name="out"> Where the results are written. Must have room for <paramref name="count"/> quaternions. </param>
+template <class T, eQuaternionLayout Layout, bool Packed>
+void Average(const Quaternion<T, Layout, Packed>* const* arrays,
+			 const T* weights,
+			 size_t arrayCount,
+			 size_t count,
+			 Quaternion<T, Layout, Packed>* out) {
+	assert(arrayCount > 0);
+
+	using Block = impl::LaneBlock<T>;
+	using Register = typename Block::Block;
+	constexpr size_t batchSize = impl::PadLaneSize(16, impl::LanePadding<T>());
+
+	alignas(impl::laneAlignment) T reference[4][batchSize];
+	alignas(impl::laneAlignment) T stage[4][batchSize];
+	alignas(impl::laneAlignment) T sum[4][batchSize];
+
+	const Register zero = Block::Broadcast(T(0));
+	for (size_t first = 0; first < count; first += batchSize) {
+		const size_t batchCount = std::min(batchSize, count - first);
+		const size_t paddedCount = impl::PadLaneSize(batchCount, impl::LanePadding<T>());
+
+		for (size_t array = 0; array < arrayCount; ++array) {
+			// The first array is kept in `reference`, as it defines the hemisphere the others are flipped into.
+			auto& target = array == 0 ? reference : stage;
+			for (size_t k = 0; k < paddedCount; ++k) {
+				const auto q = k < batchCount ? Vector<T, 4, Packed>(arrays[array][first + k].canonical) : Vector<T, 4, Packed>(1, 0, 0, 0);
+				for (size_t c = 0; c < 4; ++c) {
+					target[c][k] = q[c];
+				}
+			}
+
+			const Register weight = Block::Broadcast(weights[array]);
+			for (size_t index = 0; index < paddedCount; index += Block::size) {
+				std::array<Register, 4> q;
+				std::array<Register, 4> r;
+				for (size_t c = 0; c < 4; ++c) {
+					q[c] = Block::Load(target[c] + index);
+					r[c] = Block::Load(reference[c] + index);
+				}
+				const Register cosAngle = q[0] * r[0] + q[1] * r[1] + q[2] * r[2] + q[3] * r[3];
+				const Register signedWeight = select<>{}(cosAngle < zero, -weight, weight);
+				for (size_t c = 0; c < 4; ++c) {
+					const Register previous = array == 0 ? zero : Block::Load(sum[c] + index);
+					Block::Store(sum[c] + index, previous + signedWeight * q[c]);
+				}
+			}
+		}
+
+		for (size_t k = 0; k < batchCount; ++k) {
+			const Vector<T, 4, Packed> q(sum[0][k], sum[1][k], sum[2][k], sum[3][k]);
+			out[first + k].canonical = Normalize(q);
+		}
+	}
+}
+
+} // namespace mathter
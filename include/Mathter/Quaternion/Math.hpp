@@ -8,6 +8,12 @@
 #include "../Vector/Math.hpp"
 #include "Quaternion.hpp"
 
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+
 
 namespace mathter {
 
@@ -125,4 +131,76 @@ Quaternion<T, Layout, Packed> Inverse(const Quaternion<T, Layout, Packed>& q) {
 	return Conj(q) / LengthSquared(q);
 }
 
+/// <summary> Returns the cosine of the angle between two quaternions as 4-dimensional vectors. </summary>
+template <class T, eQuaternionLayout Layout, bool Packed>
+T Dot(const Quaternion<T, Layout, Packed>& lhs, const Quaternion<T, Layout, Packed>& rhs) {
+	return Dot(Vector(lhs), Vector(rhs));
+}
+
+
+/// <summary> Interpolates between two rotations along a straight line, then normalizes the result. </summary>
+/// <remarks> The inputs must be unit quaternions. The interpolation always takes the shorter path,
+///		by flipping <paramref name="to"/> if necessary. Unlike <see cref="Slerp"/>, the angular velocity
+///		is not constant for a uniformly changing <paramref name="t"/>, but the difference is negligible
+///		for rotations close to each other, and it's much cheaper. </remarks>
+/// <param name="t"> The interpolation parameter, 0 gives <paramref name="from"/>, 1 gives <paramref name="to"/>. </param>
+template <class T, eQuaternionLayout Layout, bool Packed>
+Quaternion<T, Layout, Packed> Nlerp(const Quaternion<T, Layout, Packed>& from, const Quaternion<T, Layout, Packed>& to, T t) {
+	const auto a = Vector(from);
+	const auto b = Dot(from, to) < T(0) ? -Vector(to) : Vector(to);
+	return Quaternion<T, Layout, Packed>{ Normalize(a + t * (b - a)) };
+}
+
+
+/// <summary> Interpolates between two rotations along the great arc with constant angular velocity. </summary>
+/// <remarks> The inputs must be unit quaternions. The interpolation always takes the shorter path,
+///		by flipping <paramref name="to"/> if necessary. </remarks>
+/// <param name="t"> The interpolation parameter, 0 gives <paramref name="from"/>, 1 gives <paramref name="to"/>. </param>
+template <class T, eQuaternionLayout Layout, bool Packed>
+Quaternion<T, Layout, Packed> Slerp(const Quaternion<T, Layout, Packed>& from, const Quaternion<T, Layout, Packed>& to, T t) {
+	const auto a = Vector(from);
+	const auto b = Dot(from, to) < T(0) ? -Vector(to) : Vector(to);
+
+	// More accurate than acos(Dot(a, b)) for nearly identical rotations.
+	const T angle = T(2) * std::atan2(Length(a - b), Length(a + b));
+	if (angle <= std::numeric_limits<T>::epsilon()) {
+		return Quaternion<T, Layout, Packed>{ a + t * (b - a) };
+	}
+	const T rcpSinAngle = T(1) / std::sin(angle);
+	const T weightFrom = std::sin((T(1) - t) * angle) * rcpSinAngle;
+	const T weightTo = std::sin(t * angle) * rcpSinAngle;
+	return Quaternion<T, Layout, Packed>{ weightFrom * a + weightTo * b };
+}
+
+
+/// <summary> Calculates the weighted average of several rotations. </summary>
+/// <remarks> The quaternions are flipped into the same hemisphere as the first one, summed with their weights,
+///		then normalized. This is what blending animation poses usually needs, and it's close to the true average
+///		when the rotations are within about 90 degrees of each other. The weights need not add up to one,
+///		but their weighted sum must not be zero. </remarks>
+/// <param name="quaternions"> Pointer to the first of the unit quaternions to average. </param>
+/// <param name="weights"> Pointer to the first of the weights of the quaternions. </param>
+/// <param name="count"> The number of quaternions and weights. Must be at least one. </param>
+template <class T, eQuaternionLayout Layout, bool Packed>
+Quaternion<T, Layout, Packed> Average(const Quaternion<T, Layout, Packed>* quaternions, const T* weights, size_t count) {
+	assert(count > 0);
+	const auto& reference = quaternions[0];
+	auto sum = Vector(reference) * weights[0];
+	for (size_t i = 1; i < count; ++i) {
+		const T weight = Dot(reference, quaternions[i]) < T(0) ? -weights[i] : weights[i];
+		sum += Vector(quaternions[i]) * weight;
+	}
+	return Quaternion<T, Layout, Packed>{ Normalize(sum) };
+}
+
+
+/// <summary> Calculates the weighted average of a contiguous range of rotations. </summary>
+/// <remarks> See the pointer overload for details. </remarks>
+template <class Quaternions, class Weights>
+auto Average(const Quaternions& quaternions, const Weights& weights)
+	-> decltype(Average(std::data(quaternions), std::data(weights), std::size(quaternions))) {
+	assert(std::size(quaternions) == std::size(weights));
+	return Average(std::data(quaternions), std::data(weights), std::size(quaternions));
+}
+
 } // namespace mathter
\ No newline at end of file
@@ -0,0 +1,68 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#pragma once
+
+#include "../Matrix/Matrix.hpp"
+#include "../Matrix/TransformPoints.hpp"
+#include "../Vector/Vector.hpp"
+#include "../Vector/VectorArray.hpp"
+#include "Quaternion.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+
+
+namespace mathter {
+
+namespace impl {
+
+	/// <summary> Returns the coefficients of the rotation matrix of a unit quaternion. </summary>
+	template <class T, class TQ, eQuaternionLayout Layout, bool Packed>
+	HomogeneousCoefficients<T> GetRotationCoefficients(const Quaternion<TQ, Layout, Packed>& q) {
+		const auto rotation = Matrix<T, 4, 4, eMatrixOrder::FOLLOW_VECTOR, eMatrixLayout::ROW_MAJOR, false>(q);
+		return GetHomogeneousCoefficients<T>(rotation);
+	}
+
+} // namespace impl
+
+
+/// <summary> Rotates an array of vectors by a unit quaternion. </summary>
+/// <remarks> Gives the same result as calling the quaternion's operator() on each vector, but the rotation matrix
+///		of the quaternion is calculated only once, and its coefficients are broadcast into SIMD registers to rotate
+///		several vectors at once, like <see cref="TransformDirections"/> does.
+///		<paramref name="out"/> may be the same as <paramref name="vectors"/>, but they must not partially overlap. </remarks>
+/// <param name="vectors"> Pointer to the first vector to rotate. </param>
+/// <param name="count"> The number of vectors to rotate. </param>
+/// <param name="rotation"> A unit quaternion. </param>
+/// <param name="out"> Where the rotated vectors are written. Must have room for <paramref name="count"/> vectors. </param>
+template <class T, bool PackedIn, bool PackedOut, class TQ, eQuaternionLayout Layout, bool Packed>
+void RotateVectors(const Vector<T, 3, PackedIn>* vectors,
+				   size_t count,
+				   const Quaternion<TQ, Layout, Packed>& rotation,
+				   Vector<T, 3, PackedOut>* out) {
+	const auto coefficients = impl::GetRotationCoefficients<T>(rotation);
+	impl::TransformVectors<impl::eHomogeneousMode::DIRECTION>(vectors, count, coefficients, out);
+}
+
+
+/// <summary> Rotates a contiguous range of vectors by a unit quaternion. </summary>
+/// <remarks> See the pointer overload for details. </remarks>
+template <class RangeIn, class Quat, class RangeOut>
+auto RotateVectors(const RangeIn& vectors, const Quat& rotation, RangeOut&& out)
+	-> decltype(RotateVectors(std::data(vectors), std::size(vectors), rotation, std::data(out))) {
+	assert(std::size(out) >= std::size(vectors));
+	return RotateVectors(std::data(vectors), std::size(vectors), rotation, std::data(out));
+}
+
+
+/// <summary> Rotates an array of vectors by a unit quaternion. </summary>
+template <class T, class TQ, eQuaternionLayout Layout, bool Packed>
+VectorArray<T, 3> RotateVectors(const VectorArray<T, 3>& vectors, const Quaternion<TQ, Layout, Packed>& rotation) {
+	return impl::TransformVectors<impl::eHomogeneousMode::DIRECTION>(vectors, impl::GetRotationCoefficients<T>(rotation));
+}
+
+} // namespace mathter
@@ -19,10 +19,12 @@ namespace mathter {
 template <class T, mathter::eQuaternionLayout Layout, bool Packed>
 template <class TOther, bool PackedOther>
 auto mathter::Quaternion<T, Layout, Packed>::operator()(const Vector<TOther, 3, PackedOther>& v) const {
-	// Sandwich product :)
-	const auto vq = Quaternion<T, Layout, Packed>(v);
-	const auto rotated = *this * vq * Inverse(*this);
-	return Vector(rotated.vector);
+	// The sandwich product q * v * q^-1 expanded for unit quaternions, which
+	// needs two cross products instead of two quaternion products and an inverse.
+	const Vector<T, 3, Packed> u = vector;
+	const Vector<T, 3, Packed> p(v);
+	const auto t = T(2) * Cross(u, p);
+	return Vector<T, 3, Packed>(p + T(scalar) * t + Cross(u, t));
 }
 
 
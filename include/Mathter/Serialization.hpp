@@ -0,0 +1,525 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#pragma once
+
+#include "Common/TypeTraits.hpp"
+#include "Matrix/Matrix.hpp"
+#include "Vector/Vector.hpp"
+
+#include <algorithm>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+
+namespace mathter {
+
+
+//------------------------------------------------------------------------------
+// Header
+//------------------------------------------------------------------------------
+
+/// <summary> The type of the scalars stored in a binary file. </summary>
+enum class eScalarType : uint8_t {
+	INT8 = 1,
+	INT16,
+	INT32,
+	INT64,
+	UINT8,
+	UINT16,
+	UINT32,
+	UINT64,
+	FLOAT32,
+	FLOAT64,
+	COMPLEX64,
+	COMPLEX128,
+};
+
+
+/// <summary> Whether a binary file stores vectors or matrices. </summary>
+enum class eElementKind : uint8_t {
+	VECTOR = 1,
+	MATRIX,
+};
+
+
+/// <summary> Describes the contents of a binary file of vectors or matrices. </summary>
+/// <remarks>
+/// The elements are stored as raw bytes in the same format as they are in memory, including the padding
+/// that SIMD alignment adds to vectors and matrix stripes. The strides in the header tell where the scalars are,
+/// so files can be read back with different compiler flags, or into a different type altogether.
+/// All values, including the header, are stored in the byte order of the machine that wrote the file.
+/// </remarks>
+struct BinaryHeader {
+	static constexpr char expectedMagic[4] = { 'M', 'T', 'H', 'R' };
+	static constexpr uint32_t expectedByteOrder = 0x01020304;
+	static constexpr uint16_t currentVersion = 1;
+
+	/// <summary> Always "MTHR". </summary>
+	char magic[4];
+	/// <summary> 0x01020304 as written by the machine that created the file. </summary>
+	uint32_t byteOrder;
+	/// <summary> The version of the file format. </summary>
+	uint16_t version;
+	eScalarType scalarType;
+	uint8_t scalarSize;
+	eElementKind kind;
+	/// <summary> 0 for precede-vector, 1 for follow-vector. Zero for vectors. </summary>
+	uint8_t order;
+	/// <summary> 0 for row-major, 1 for column-major. Zero for vectors. </summary>
+	uint8_t layout;
+	/// <summary> 1 if the elements were packed, 0 otherwise. </summary>
+	uint8_t packed;
+	/// <summary> The number of rows of the matrices, or the dimension of the vectors. </summary>
+	uint32_t rows;
+	/// <summary> The number of columns of the matrices, or 1 for vectors. </summary>
+	uint32_t columns;
+	/// <summary> The number of rows for row-major matrices, columns for column-major matrices, and 1 for vectors. </summary>
+	uint32_t stripeCount;
+	/// <summary> The distance between consecutive stripes of an element in bytes. </summary>
+	uint32_t stripeStride;
+	/// <summary> The distance between consecutive elements in bytes. </summary>
+	uint64_t elementStride;
+	/// <summary> The number of elements in the file. </summary>
+	uint64_t count;
+	/// <summary> The position of the first element relative to the start of the header in bytes. </summary>
+	uint64_t dataOffset;
+	uint8_t reserved[8];
+};
+
+static_assert(sizeof(BinaryHeader) == 64);
+static_assert(std::is_trivially_copyable_v<BinaryHeader>);
+
+
+namespace impl {
+
+	template <class T>
+	constexpr eScalarType GetScalarType() {
+		if constexpr (std::is_same_v<T, std::complex<float>>) {
+			return eScalarType::COMPLEX64;
+		}
+		else if constexpr (std::is_same_v<T, std::complex<double>>) {
+			return eScalarType::COMPLEX128;
+		}
+		else if constexpr (std::is_floating_point_v<T>) {
+			static_assert(sizeof(T) == 4 || sizeof(T) == 8, "Only 32 and 64 bit floating point types are supported.");
+			return sizeof(T) == 4 ? eScalarType::FLOAT32 : eScalarType::FLOAT64;
+		}
+		else {
+			static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool>, "Unsupported scalar type.");
+			constexpr int index = sizeof(T) == 1 ? 0 : sizeof(T) == 2 ? 1 : sizeof(T) == 4 ? 2 : 3;
+			constexpr auto first = std::is_signed_v<T> ? eScalarType::INT8 : eScalarType::UINT8;
+			return static_cast<eScalarType>(static_cast<uint8_t>(first) + index);
+		}
+	}
+
+
+	constexpr size_t GetScalarSize(eScalarType type) {
+		switch (type) {
+			case eScalarType::INT8: [[fallthrough]];
+			case eScalarType::UINT8: return 1;
+			case eScalarType::INT16: [[fallthrough]];
+			case eScalarType::UINT16: return 2;
+			case eScalarType::INT32: [[fallthrough]];
+			case eScalarType::UINT32: [[fallthrough]];
+			case eScalarType::FLOAT32: return 4;
+			case eScalarType::INT64: [[fallthrough]];
+			case eScalarType::UINT64: [[fallthrough]];
+			case eScalarType::FLOAT64: [[fallthrough]];
+			case eScalarType::COMPLEX64: return 8;
+			case eScalarType::COMPLEX128: return 16;
+		}
+		return 0;
+	}
+
+
+	template <class Element>
+	struct BinaryTraits {
+		static_assert(is_vector_v<Element> || is_matrix_v<Element>, "Only vectors and matrices can be serialized.");
+	};
+
+	template <class T, int Dim, bool Packed>
+	struct BinaryTraits<Vector<T, Dim, Packed>> {
+		static_assert(Dim != DYNAMIC, "Dynamically sized vectors cannot be serialized.");
+		using Scalar = T;
+		static constexpr eElementKind kind = eElementKind::VECTOR;
+		static constexpr uint8_t order = 0;
+		static constexpr uint8_t layout = 0;
+		static constexpr uint8_t packed = Packed;
+		static constexpr uint32_t rows = Dim;
+		static constexpr uint32_t columns = 1;
+		static constexpr uint32_t stripeCount = 1;
+		static constexpr uint32_t stripeStride = sizeof(Vector<T, Dim, Packed>);
+
+		static const T* Scalars(const Vector<T, Dim, Packed>& element, size_t) { return element.data(); }
+		static T* Scalars(Vector<T, Dim, Packed>& element, size_t) { return element.data(); }
+	};
+
+	template <class T, int Rows, int Columns, eMatrixOrder Order, eMatrixLayout Layout, bool Packed>
+	struct BinaryTraits<Matrix<T, Rows, Columns, Order, Layout, Packed>> {
+		static_assert(Rows != DYNAMIC && Columns != DYNAMIC, "Dynamically sized matrices cannot be serialized.");
+		using Scalar = T;
+		using MatrixType = Matrix<T, Rows, Columns, Order, Layout, Packed>;
+		static constexpr eElementKind kind = eElementKind::MATRIX;
+		static constexpr uint8_t order = Order == eMatrixOrder::FOLLOW_VECTOR;
+		static constexpr uint8_t layout = Layout == eMatrixLayout::COLUMN_MAJOR;
+		static constexpr uint8_t packed = Packed;
+		static constexpr uint32_t rows = Rows;
+		static constexpr uint32_t columns = Columns;
+		static constexpr uint32_t stripeCount = MatrixType::stripeCount;
+		static constexpr uint32_t stripeStride = sizeof(typename MatrixType::Stripe);
+
+		static const T* Scalars(const MatrixType& element, size_t stripe) { return element.stripes[stripe].data(); }
+		static T* Scalars(MatrixType& element, size_t stripe) { return element.stripes[stripe].data(); }
+	};
+
+
+	/// <summary> The number of bytes read from a stream at once. </summary>
+	inline constexpr size_t binaryStreamChunkBytes = size_t(1) << 20;
+
+
+	template <class Element>
+	constexpr bool IsDataOffsetAligned(uint64_t dataOffset) {
+		return dataOffset % alignof(Element) == 0;
+	}
+
+
+	inline void ValidateBinaryHeader(const BinaryHeader& header) {
+		if (std::memcmp(header.magic, BinaryHeader::expectedMagic, sizeof(header.magic)) != 0) {
+			throw std::invalid_argument("not a Mathter binary file");
+		}
+		if (header.byteOrder != BinaryHeader::expectedByteOrder) {
+			throw std::invalid_argument("binary file was written with a different byte order");
+		}
+		if (header.version != BinaryHeader::currentVersion) {
+			throw std::invalid_argument("unsupported binary file version");
+		}
+		if (GetScalarSize(header.scalarType) == 0 || GetScalarSize(header.scalarType) != header.scalarSize) {
+			throw std::invalid_argument("invalid scalar type in binary file");
+		}
+		const bool isVector = header.kind == eElementKind::VECTOR;
+		if ((!isVector && header.kind != eElementKind::MATRIX) || header.rows == 0 || header.columns == 0) {
+			throw std::invalid_argument("invalid element shape in binary file");
+		}
+		const uint64_t stripeCount = isVector ? 1 : header.layout ? header.columns : header.rows;
+		const uint64_t stripeSize = isVector ? header.rows : header.layout ? header.rows : header.columns;
+		if (header.dataOffset < sizeof(BinaryHeader)
+			|| header.stripeCount != stripeCount
+			|| header.stripeStride < stripeSize * header.scalarSize
+			|| header.elementStride < uint64_t(header.stripeCount) * header.stripeStride) {
+			throw std::invalid_argument("invalid element format in binary file");
+		}
+		// Padding never more than doubles a stripe or an element, anything beyond is a corrupted header.
+		if (header.stripeStride / 2 > stripeSize * header.scalarSize
+			|| header.elementStride / 2 > uint64_t(header.stripeCount) * header.stripeStride) {
+			throw std::invalid_argument("invalid element format in binary file");
+		}
+		if (header.elementStride > std::numeric_limits<size_t>::max()
+			|| header.count > std::numeric_limits<size_t>::max() / header.elementStride
+			|| header.dataOffset - sizeof(BinaryHeader) > uint64_t(std::numeric_limits<std::streamsize>::max())) {
+			throw std::invalid_argument("binary file is too large");
+		}
+	}
+
+
+	template <class Element>
+	void ValidateBinaryShape(const BinaryHeader& header) {
+		using Traits = BinaryTraits<Element>;
+		if (header.kind != Traits::kind || header.rows != Traits::rows || header.columns != Traits::columns) {
+			throw std::invalid_argument("binary file stores elements of a different shape");
+		}
+		if (header.order != Traits::order) {
+			throw std::invalid_argument("binary file stores matrices of a different order");
+		}
+	}
+
+
+	template <class Element>
+	bool IsMemoryCompatible(const BinaryHeader& header) {
+		using Traits = BinaryTraits<Element>;
+		return header.kind == Traits::kind
+			   && header.scalarType == GetScalarType<typename Traits::Scalar>()
+			   && header.rows == Traits::rows
+			   && header.columns == Traits::columns
+			   && header.order == Traits::order
+			   && header.layout == Traits::layout
+			   && header.stripeCount == Traits::stripeCount
+			   && header.stripeStride == Traits::stripeStride
+			   && header.elementStride == sizeof(Element);
+	}
+
+
+	template <class T>
+	T ReadScalar(const std::byte* source, eScalarType type) {
+		const auto load = [source](auto value) {
+			std::memcpy(&value, source, sizeof(value));
+			if constexpr (is_complex_v<decltype(value)> && !is_complex_v<T>) {
+				throw std::invalid_argument("cannot read complex scalars into real scalars");
+				return T{};
+			}
+			else if constexpr (is_complex_v<decltype(value)>) {
+				return T(value);
+			}
+			else {
+				return static_cast<T>(value);
+			}
+		};
+		switch (type) {
+			case eScalarType::INT8: return load(int8_t{});
+			case eScalarType::INT16: return load(int16_t{});
+			case eScalarType::INT32: return load(int32_t{});
+			case eScalarType::INT64: return load(int64_t{});
+			case eScalarType::UINT8: return load(uint8_t{});
+			case eScalarType::UINT16: return load(uint16_t{});
+			case eScalarType::UINT32: return load(uint32_t{});
+			case eScalarType::UINT64: return load(uint64_t{});
+			case eScalarType::FLOAT32: return load(float{});
+			case eScalarType::FLOAT64: return load(double{});
+			case eScalarType::COMPLEX64: return load(std::complex<float>{});
+			case eScalarType::COMPLEX128: return load(std::complex<double>{});
+		}
+		throw std::invalid_argument("invalid scalar type in binary file");
+	}
+
+
+	template <class Element>
+	void ConvertBinaryElements(const BinaryHeader& header, const std::byte* data, size_t count, Element* out) {
+		using Traits = BinaryTraits<Element>;
+		using T = typename Traits::Scalar;
+
+		// Vectors are a single column, stored as one stripe.
+		const bool sourceColumns = header.kind == eElementKind::VECTOR || header.layout;
+		constexpr bool targetColumns = Traits::kind == eElementKind::VECTOR || Traits::layout;
+
+		for (size_t index = 0; index < count; ++index) {
+			const std::byte* source = data + index * header.elementStride;
+			Element& element = out[index];
+			for (uint32_t row = 0; row < Traits::rows; ++row) {
+				for (uint32_t column = 0; column < Traits::columns; ++column) {
+					const uint32_t sourceStripe = sourceColumns ? column : row;
+					const uint32_t sourceIndex = sourceColumns ? row : column;
+					const uint32_t stripe = targetColumns ? column : row;
+					const uint32_t stripeIndex = targetColumns ? row : column;
+					const auto offset = uint64_t(sourceStripe) * header.stripeStride + uint64_t(sourceIndex) * header.scalarSize;
+					Traits::Scalars(element, stripe)[stripeIndex] = ReadScalar<T>(source + offset, header.scalarType);
+				}
+			}
+		}
+	}
+
+} // namespace impl
+
+
+/// <summary> Creates the header that describes <paramref name="count"/> elements of type <typeparamref name="Element"/>. </summary>
+template <class Element>
+BinaryHeader MakeBinaryHeader(size_t count) {
+	using Traits = impl::BinaryTraits<Element>;
+	using T = typename Traits::Scalar;
+
+	BinaryHeader header = {};
+	std::memcpy(header.magic, BinaryHeader::expectedMagic, sizeof(header.magic));
+	header.byteOrder = BinaryHeader::expectedByteOrder;
+	header.version = BinaryHeader::currentVersion;
+	header.scalarType = impl::GetScalarType<T>();
+	header.scalarSize = static_cast<uint8_t>(sizeof(T));
+	header.kind = Traits::kind;
+	header.order = Traits::order;
+	header.layout = Traits::layout;
+	header.packed = Traits::packed;
+	header.rows = Traits::rows;
+	header.columns = Traits::columns;
+	header.stripeCount = Traits::stripeCount;
+	header.stripeStride = Traits::stripeStride;
+	header.elementStride = sizeof(Element);
+	header.count = count;
+	header.dataOffset = sizeof(BinaryHeader);
+	static_assert(impl::IsDataOffsetAligned<Element>(sizeof(BinaryHeader)), "Element is aligned stricter than the header size.");
+	return header;
+}
+
+
+/// <summary> Reads and validates the header at the beginning of a memory region. </summary>
+/// <remarks> Throws std::invalid_argument if the region doesn't start with a valid header,
+///		or is too small to hold all the elements the header describes. </remarks>
+inline BinaryHeader ReadBinaryHeader(const void* data, size_t size) {
+	if (size < sizeof(BinaryHeader)) {
+		throw std::invalid_argument("binary file is too small");
+	}
+	BinaryHeader header;
+	std::memcpy(&header, data, sizeof(header));
+	impl::ValidateBinaryHeader(header);
+	if (header.dataOffset > size || header.count > (size - header.dataOffset) / header.elementStride) {
+		throw std::invalid_argument("binary file is truncated");
+	}
+	return header;
+}
+
+
+//------------------------------------------------------------------------------
+// Writing
+//------------------------------------------------------------------------------
+
+/// <summary> Writes an array of vectors or matrices to a binary stream. </summary>
+/// <remarks> The elements are copied byte by byte as they are in memory, after a <see cref="BinaryHeader"/>.
+///		The stream should be opened in binary mode. </remarks>
+template <class Char, class CharTraits, class Element>
+void WriteBinary(std::basic_ostream<Char, CharTraits>& os, const Element* elements, size_t count) {
+	static_assert(sizeof(Char) == 1, "Binary streams must have byte-sized characters.");
+	const auto header = MakeBinaryHeader<Element>(count);
+	os.write(reinterpret_cast<const Char*>(&header), sizeof(header));
+	os.write(reinterpret_cast<const Char*>(elements), static_cast<std::streamsize>(count * sizeof(Element)));
+	if (!os.good()) {
+		throw std::runtime_error("output stream failed");
+	}
+}
+
+
+/// <summary> Writes a contiguous range of vectors or matrices to a binary stream. </summary>
+template <class Char, class CharTraits, class Range>
+auto WriteBinary(std::basic_ostream<Char, CharTraits>& os, const Range& elements)
+	-> decltype(WriteBinary(os, std::data(elements), std::size(elements))) {
+	return WriteBinary(os, std::data(elements), std::size(elements));
+}
+
+
+//------------------------------------------------------------------------------
+// Zero-copy views
+//------------------------------------------------------------------------------
+
+/// <summary> A read-only view of the elements of a binary file that is already in memory. </summary>
+/// <remarks> The view doesn't own the memory, which must outlive the view. </remarks>
+template <class Element>
+class BinaryView {
+public:
+	BinaryView() = default;
+	BinaryView(const Element* data, size_t size) : m_data(data), m_size(size) {}
+
+	const Element* data() const { return m_data; }
+	size_t size() const { return m_size; }
+	bool empty() const { return m_size == 0; }
+
+	const Element* begin() const { return m_data; }
+	const Element* end() const { return m_data + m_size; }
+
+	const Element& operator[](size_t index) const { return m_data[index]; }
+
+private:
+	const Element* m_data = nullptr;
+	size_t m_size = 0;
+};
+
+
+/// <summary> Tells if <see cref="ViewBinary"/> can map the memory region without copying. </summary>
+/// <remarks> That requires the same scalar type, shape, order, and layout, the same padding
+///		of vectors and stripes, and data that is suitably aligned for <typeparamref name="Element"/>.
+///		Throws std::invalid_argument if the region doesn't contain a valid binary file. </remarks>
+template <class Element>
+bool CanViewBinary(const void* data, size_t size) {
+	const auto header = ReadBinaryHeader(data, size);
+	const auto first = reinterpret_cast<uintptr_t>(data) + header.dataOffset;
+	return impl::IsMemoryCompatible<Element>(header) && first % alignof(Element) == 0;
+}
+
+
+/// <summary> Maps the elements of a binary file in memory, such as a memory-mapped file, without copying them. </summary>
+/// <remarks> Throws std::invalid_argument if the file was written with a different memory format than
+///		<typeparamref name="Element"/> has, see <see cref="CanViewBinary"/>. Use <see cref="ReadBinary"/> in that case. </remarks>
+template <class Element>
+BinaryView<Element> ViewBinary(const void* data, size_t size) {
+	if (!CanViewBinary<Element>(data, size)) {
+		throw std::invalid_argument("binary file cannot be viewed as the requested type");
+	}
+	const auto header = ReadBinaryHeader(data, size);
+	const auto first = static_cast<const std::byte*>(data) + header.dataOffset;
+	return { reinterpret_cast<const Element*>(first), static_cast<size_t>(header.count) };
+}
+
+
+//------------------------------------------------------------------------------
+// Converting readers
+//------------------------------------------------------------------------------
+
+/// <summary> Copies the elements of a binary file in memory to <paramref name="out"/>, converting them as needed. </summary>
+/// <remarks> The file must store elements of the same shape and order as <typeparamref name="Element"/>,
+///		but the scalar type, layout, and padding may differ. Real scalars can be read as complex, but not vice versa.
+///		The memory is copied as a whole when its format matches. Throws std::invalid_argument on mismatch. </remarks>
+/// <param name="out"> Must have room for as many elements as the header says. Use <see cref="ReadBinaryHeader"/> to find out. </param>
+template <class Element>
+void ReadBinary(const void* data, size_t size, Element* out) {
+	const auto header = ReadBinaryHeader(data, size);
+	impl::ValidateBinaryShape<Element>(header);
+	const auto first = static_cast<const std::byte*>(data) + header.dataOffset;
+	if (impl::IsMemoryCompatible<Element>(header)) {
+		std::memcpy(static_cast<void*>(out), first, header.count * sizeof(Element));
+	}
+	else {
+		impl::ConvertBinaryElements(header, first, header.count, out);
+	}
+}
+
+
+/// <summary> Returns the elements of a binary file in memory, converting them as needed. </summary>
+/// <remarks> See the overload taking an output pointer for details. </remarks>
+template <class Element>
+std::vector<Element> ReadBinary(const void* data, size_t size) {
+	std::vector<Element> elements(ReadBinaryHeader(data, size).count);
+	ReadBinary(data, size, elements.data());
+	return elements;
+}
+
+
+/// <summary> Reads the elements of a binary file from a stream, converting them as needed. </summary>
+/// <remarks> See the overload taking an output pointer for details.
+///		The stream should be opened in binary mode. </remarks>
+template <class Element, class Char, class CharTraits>
+std::vector<Element> ReadBinary(std::basic_istream<Char, CharTraits>& is) {
+	static_assert(sizeof(Char) == 1, "Binary streams must have byte-sized characters.");
+	BinaryHeader header;
+	if (!is.read(reinterpret_cast<Char*>(&header), sizeof(header))) {
+		throw std::invalid_argument("unexpected end of stream");
+	}
+	impl::ValidateBinaryHeader(header);
+	impl::ValidateBinaryShape<Element>(header);
+	if (!is.ignore(static_cast<std::streamsize>(header.dataOffset - sizeof(header)))) {
+		throw std::invalid_argument("unexpected end of stream");
+	}
+
+	// Elements are read in chunks so that a corrupted count runs into the end of the stream
+	// instead of allocating all the memory up front.
+	const size_t count = static_cast<size_t>(header.count);
+	const size_t elementStride = static_cast<size_t>(header.elementStride);
+	const size_t chunkSize = std::max(size_t(1), impl::binaryStreamChunkBytes / elementStride);
+	const bool isMemoryCompatible = impl::IsMemoryCompatible<Element>(header);
+	std::vector<Element> elements;
+	std::vector<std::byte> buffer;
+	for (size_t first = 0; first < count; first += chunkSize) {
+		const size_t chunkCount = std::min(chunkSize, count - first);
+		elements.resize(first + chunkCount);
+		if (isMemoryCompatible) {
+			is.read(reinterpret_cast<Char*>(elements.data() + first), static_cast<std::streamsize>(chunkCount * sizeof(Element)));
+		}
+		else {
+			buffer.resize(chunkCount * elementStride);
+			is.read(reinterpret_cast<Char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+		}
+		if (!is.good()) {
+			throw std::invalid_argument("unexpected end of stream");
+		}
+		if (!isMemoryCompatible) {
+			impl::ConvertBinaryElements(header, buffer.data(), chunkCount, elements.data() + first);
+		}
+	}
+	return elements;
+}
+
+} // namespace mathter
@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include "../Common/TypeTraits.hpp"
 #include "../Matrix/Matrix.hpp"
 #include "../Quaternion/Quaternion.hpp"
 #include "ZeroBuilder.hpp"
@@ -31,6 +32,23 @@ namespace impl {
 		}
 	};
 
+
+	/// <summary> Creates an identity matrix of the given size. </summary>
+	/// <remarks> The size is only used by dynamically sized matrices, for which <see cref="Identity"/> cannot be used. </remarks>
+	template <class Mat>
+	Mat MakeIdentity(size_t rows, size_t columns) {
+		if constexpr (is_dynamic_v<Mat>) {
+			Mat m(rows, columns);
+			for (size_t i = 0; i < std::min(rows, columns); ++i) {
+				m(i, i) = static_cast<scalar_type_t<Mat>>(1);
+			}
+			return m;
+		}
+		else {
+			return Mat(IdentityBuilder{});
+		}
+	}
+
 } // namespace impl
 
 
@@ -7,6 +7,7 @@
 
 
 #include "../Common/OptimizationUtil.hpp"
+#include "../Common/TypeTraits.hpp"
 #include "../Matrix/Matrix.hpp"
 #include "../Quaternion/Quaternion.hpp"
 #include "../Vector/Vector.hpp"
@@ -40,6 +41,32 @@ namespace impl {
 		}
 	};
 
+
+	/// <summary> Creates a zero matrix of the given size. </summary>
+	/// <remarks> The size is only used by dynamically sized matrices, for which <see cref="Zero"/> cannot be used. </remarks>
+	template <class Mat>
+	Mat MakeZero(size_t rows, size_t columns) {
+		if constexpr (is_dynamic_v<Mat>) {
+			return Mat(rows, columns);
+		}
+		else {
+			return Mat(ZeroBuilder{});
+		}
+	}
+
+
+	/// <summary> Creates a zero vector of the given dimension. </summary>
+	/// <remarks> The dimension is only used by dynamically sized vectors. </remarks>
+	template <class Vec>
+	Vec MakeZero(size_t dimension) {
+		if constexpr (is_dynamic_v<Vec>) {
+			return Vec(dimension);
+		}
+		else {
+			return Vec(ZeroBuilder{});
+		}
+	}
+
 } // namespace impl
 
 
@@ -11,3 +11,5 @@
 #include "Vector/Math.hpp"
 #include "Vector/Swizzle.hpp"
 #include "Vector/Vector.hpp"
+#include "Vector/VectorArray.hpp"
+#include "Vector/VectorDynamic.hpp"
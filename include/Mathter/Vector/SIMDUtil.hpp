@@ -5,7 +5,10 @@
 #include <xsimd/xsimd.hpp>
 #endif
 
+#include <algorithm>
 #include <array>
+#include <cstddef>
+#include <type_traits>
 
 
 namespace mathter {
@@ -85,5 +88,91 @@ using Storage = std::array<T, GetStorageSize<T, Dim, Packed>()>;
 static_assert(std::is_standard_layout_v<Storage<float, 3, false>>);
 
 
+namespace impl {
+
+	/// <summary> Processes contiguous arrays of elements one element at a time. </summary>
+	template <class T>
+	struct ScalarLaneBlock {
+		using Block = T;
+		static constexpr size_t size = 1;
+
+		static T Load(const T* ptr) { return *ptr; }
+		static T LoadUnaligned(const T* ptr) { return *ptr; }
+		static T Broadcast(const T& value) { return value; }
+		static void Store(T* ptr, const T& value) { *ptr = value; }
+		static void StoreUnaligned(T* ptr, const T& value) { *ptr = value; }
+	};
+
+
+#if MATHTER_ENABLE_SIMD
+	/// <summary> Processes contiguous arrays of elements one full SIMD register at a time. </summary>
+	/// <remarks> Pointers passed to Load and Store must be aligned to the register, unlike for LoadUnaligned and StoreUnaligned. </remarks>
+	template <class T, class Arch>
+	struct BatchLaneBlock {
+		using Block = xsimd::batch<T, Arch>;
+		static constexpr size_t size = Block::size;
+
+		static Block Load(const T* ptr) { return Block::load_aligned(ptr); }
+		static Block LoadUnaligned(const T* ptr) { return Block::load_unaligned(ptr); }
+		static Block Broadcast(const T& value) { return Block(value); }
+		static void Store(T* ptr, const Block& value) { value.store_aligned(ptr); }
+		static void StoreUnaligned(T* ptr, const Block& value) { value.store_unaligned(ptr); }
+	};
+#endif
+
+
+#if MATHTER_ENABLE_SIMD
+	/// <summary> The architecture the kernels are compiled for when they are not dispatched at runtime. </summary>
+	using DefaultArch = xsimd::default_arch;
+#else
+	/// <summary> Stands in for the SIMD architecture when vectorization is disabled. </summary>
+	struct DefaultArch {};
+#endif
+
+
+	template <class T, class Arch, class = void>
+	struct lane_block {
+		using type = ScalarLaneBlock<T>;
+	};
+
+
+#if MATHTER_ENABLE_SIMD
+	template <class T, class Arch>
+	struct lane_block<T, Arch, std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<T, bool>
+												&& xsimd::types::has_simd_register<T, Arch>::value>> {
+		using type = BatchLaneBlock<T, Arch>;
+	};
+#endif
+
+
+	/// <summary> The widest block type that can process arrays of <typeparamref name="T"/> on <typeparamref name="Arch"/>. </summary>
+	template <class T, class Arch = DefaultArch>
+	using LaneBlock = typename lane_block<T, Arch>::type;
+
+
+	/// <summary> Heap arrays are aligned to the cache line, which also satisfies any SIMD register. </summary>
+	constexpr size_t laneAlignment = 64;
+
+
+	constexpr size_t PadLaneSize(size_t size, size_t blockSize) {
+		return (size + blockSize - 1) / blockSize * blockSize;
+	}
+
+
+	/// <summary> The lanes of arrays are padded to a multiple of this many elements. </summary>
+	/// <remarks> Kernels dispatched at runtime may use wider blocks than <see cref="LaneBlock"/>,
+	///		so with dispatch enabled, the padding is rounded up to the cache line, which fits any register. </remarks>
+	template <class T>
+	constexpr size_t LanePadding() {
+#if MATHTER_ENABLE_DISPATCH
+		return PadLaneSize(std::max(size_t(1), laneAlignment / sizeof(T)), LaneBlock<T>::size);
+#else
+		return LaneBlock<T>::size;
+#endif
+	}
+
+} // namespace impl
+
+
 
 } // namespace mathter
\ No newline at end of file
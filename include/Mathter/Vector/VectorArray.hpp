@@ -0,0 +1,538 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#pragma once
+
+#include "../Common/AlignedAllocator.hpp"
+#include "../Common/Functional.hpp"
+#include "../Common/TypeTraits.hpp"
+#include "SIMDUtil.hpp"
+#include "Vector.hpp"
+
+#if MATHTER_ENABLE_SIMD
+#include <xsimd/xsimd.hpp>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+
+namespace mathter {
+
+
+/// <summary> Stores a sequence of vectors in structure-of-arrays layout. </summary>
+/// <remarks> Each component of the vectors is stored in its own contiguous, aligned lane.
+///		Arithmetic and math functions on the array process as many vectors at a time as
+///		the widest available SIMD register fits, rather than one vector per register.
+///		Use <see cref="Gather"/> and <see cref="Scatter"/> to exchange individual vectors
+///		with the regular array-of-structures <see cref="Vector"/>. </remarks>
+/// <typeparam name="T"> The scalar type of the vectors. </typeparam>
+/// <typeparam name="Dim"> The dimension of the vectors. Must be a positive integer. </typeparam>
+template <class T, int Dim>
+class VectorArray {
+	static_assert(Dim >= 1, "Dimension must be positive integer.");
+
+public:
+	/// <summary> Describes how many elements of a lane are processed at once, and how they are loaded. </summary>
+	using Block = impl::LaneBlock<T>;
+	using LaneStorage = std::vector<T, AlignedAllocator<T, impl::laneAlignment>>;
+
+public:
+	//--------------------------------------------
+	// Constructors
+	//--------------------------------------------
+
+	/// <summary> Creates an empty array. </summary>
+	VectorArray() = default;
+
+	/// <summary> Creates an array of <paramref name="size"/> null vectors. </summary>
+	explicit VectorArray(size_t size);
+
+	/// <summary> Creates an array of <paramref name="size"/> copies of <paramref name="value"/>. </summary>
+	template <bool Packed>
+	VectorArray(size_t size, const Vector<T, Dim, Packed>& value);
+
+	/// <summary> Creates an array by gathering the vectors in the range [first, last). </summary>
+	template <class Iter, class = std::enable_if_t<is_vector_v<typename std::iterator_traits<Iter>::value_type>>>
+	VectorArray(Iter first, Iter last);
+
+	//--------------------------------------------
+	// Size
+	//--------------------------------------------
+
+	/// <summary> Returns the dimension of the stored vectors. </summary>
+	constexpr int Dimension() const;
+
+	/// <summary> Returns the number of stored vectors. </summary>
+	size_t Size() const;
+
+	/// <summary> Returns true if the array stores no vectors. </summary>
+	bool Empty() const;
+
+	/// <summary> Changes the number of vectors. New vectors are null vectors. </summary>
+	void Resize(size_t size);
+
+	/// <summary> Returns the number of elements allocated per lane. </summary>
+	/// <remarks> Always a multiple of <see cref="Block::size"/> and <see cref="impl::LanePadding"/>. The elements past
+	///		<see cref="Size"/> are padding, and kernels may overwrite them. </remarks>
+	size_t PaddedSize() const;
+
+	//--------------------------------------------
+	// Accessors
+	//--------------------------------------------
+
+	/// <summary> Returns the contiguous array holding the <paramref name="component"/>th element of each vector. </summary>
+	const T* Lane(int component) const;
+	/// <summary> Returns the contiguous array holding the <paramref name="component"/>th element of each vector. </summary>
+	T* Lane(int component);
+
+	/// <summary> Assembles the vector at <paramref name="index"/> from the lanes. </summary>
+	template <bool Packed = false>
+	Vector<T, Dim, Packed> Gather(size_t index) const;
+
+	/// <summary> Assembles the vectors in [first, first + count) and writes them to <paramref name="out"/>. </summary>
+	/// <returns> The output iterator past the last written vector. </returns>
+	template <class IterOut>
+	IterOut Gather(size_t first, size_t count, IterOut out) const;
+
+	/// <summary> Distributes the elements of <paramref name="value"/> into the lanes at <paramref name="index"/>. </summary>
+	template <bool Packed>
+	void Scatter(size_t index, const Vector<T, Dim, Packed>& value);
+
+	/// <summary> Distributes the vectors in the range [first, last) into the lanes starting at <paramref name="index"/>. </summary>
+	template <class Iter>
+	void Scatter(size_t index, Iter first, Iter last);
+
+private:
+	std::array<LaneStorage, Dim> m_lanes;
+	size_t m_size = 0;
+};
+
+
+template <class Iter, class Vec = typename std::iterator_traits<Iter>::value_type>
+VectorArray(Iter first, Iter last) -> VectorArray<scalar_type_t<Vec>, dimension_v<Vec>>;
+
+
+template <class T, int Dim>
+VectorArray<T, Dim>::VectorArray(size_t size) {
+	Resize(size);
+}
+
+
+template <class T, int Dim>
+template <bool Packed>
+VectorArray<T, Dim>::VectorArray(size_t size, const Vector<T, Dim, Packed>& value) : m_size(size) {
+	for (int component = 0; component < Dim; ++component) {
+		m_lanes[component].resize(impl::PadLaneSize(size, impl::LanePadding<T>()), value[component]);
+	}
+}
+
+
+template <class T, int Dim>
+template <class Iter, class>
+VectorArray<T, Dim>::VectorArray(Iter first, Iter last) {
+	Resize(size_t(std::distance(first, last)));
+	Scatter(0, first, last);
+}
+
+
+template <class T, int Dim>
+constexpr int VectorArray<T, Dim>::Dimension() const {
+	return Dim;
+}
+
+
+template <class T, int Dim>
+size_t VectorArray<T, Dim>::Size() const {
+	return m_size;
+}
+
+
+template <class T, int Dim>
+bool VectorArray<T, Dim>::Empty() const {
+	return m_size == 0;
+}
+
+
+template <class T, int Dim>
+void VectorArray<T, Dim>::Resize(size_t size) {
+	const size_t padded = impl::PadLaneSize(size, impl::LanePadding<T>());
+	for (auto& lane : m_lanes) {
+		// Padding may contain garbage written by the kernels, it has to be cleared when exposed.
+		const size_t dirtyEnd = std::min(size, lane.size());
+		std::fill(lane.begin() + std::min(m_size, dirtyEnd), lane.begin() + dirtyEnd, static_cast<T>(0));
+		lane.resize(padded, static_cast<T>(0));
+	}
+	m_size = size;
+}
+
+
+template <class T, int Dim>
+size_t VectorArray<T, Dim>::PaddedSize() const {
+	return m_lanes[0].size();
+}
+
+
+template <class T, int Dim>
+const T* VectorArray<T, Dim>::Lane(int component) const {
+	assert(0 <= component && component < Dim);
+	return m_lanes[component].data();
+}
+
+
+template <class T, int Dim>
+T* VectorArray<T, Dim>::Lane(int component) {
+	assert(0 <= component && component < Dim);
+	return m_lanes[component].data();
+}
+
+
+template <class T, int Dim>
+template <bool Packed>
+Vector<T, Dim, Packed> VectorArray<T, Dim>::Gather(size_t index) const {
+	assert(index < m_size);
+	Vector<T, Dim, Packed> value;
+	for (int component = 0; component < Dim; ++component) {
+		value[component] = m_lanes[component][index];
+	}
+	return value;
+}
+
+
+template <class T, int Dim>
+template <class IterOut>
+IterOut VectorArray<T, Dim>::Gather(size_t first, size_t count, IterOut out) const {
+	assert(first + count <= m_size);
+	using Vec = std::conditional_t<is_vector_v<typename std::iterator_traits<IterOut>::value_type>,
+								   typename std::iterator_traits<IterOut>::value_type,
+								   Vector<T, Dim, false>>;
+	for (size_t index = first; index < first + count; ++index, ++out) {
+		*out = Gather<is_packed_v<Vec>>(index);
+	}
+	return out;
+}
+
+
+template <class T, int Dim>
+template <bool Packed>
+void VectorArray<T, Dim>::Scatter(size_t index, const Vector<T, Dim, Packed>& value) {
+	assert(index < m_size);
+	for (int component = 0; component < Dim; ++component) {
+		m_lanes[component][index] = value[component];
+	}
+}
+
+
+template <class T, int Dim>
+template <class Iter>
+void VectorArray<T, Dim>::Scatter(size_t index, Iter first, Iter last) {
+	for (; first != last; ++first, ++index) {
+		Scatter(index, *first);
+	}
+}
+
+
+//------------------------------------------------------------------------------
+// Kernels
+//------------------------------------------------------------------------------
+
+namespace impl {
+
+	/// <summary> Reads a lane of a vector array, or lane 0 if it's an array of scalars. </summary>
+	template <class T, int Dim>
+	struct ArraySource {
+		const VectorArray<T, Dim>& array;
+
+		template <class Block>
+		auto Load(int component, size_t index) const {
+			return Block::Load(array.Lane(Dim == 1 ? 0 : component) + index);
+		}
+	};
+
+
+	/// <summary> Reads the same value for each vector, a separate one for each component. </summary>
+	template <class T, int Dim>
+	struct BroadcastSource {
+		std::array<T, Dim> values;
+
+		template <class Block>
+		auto Load(int component, size_t) const {
+			return Block::Broadcast(values[Dim == 1 ? 0 : component]);
+		}
+	};
+
+
+	template <class T, int Dim, bool Packed>
+	BroadcastSource<T, Dim> MakeBroadcastSource(const Vector<T, Dim, Packed>& value) {
+		BroadcastSource<T, Dim> source;
+		std::copy(value.begin(), value.end(), source.values.begin());
+		return source;
+	}
+
+
+	template <class T>
+	BroadcastSource<T, 1> MakeBroadcastSource(const T& value) {
+		return BroadcastSource<T, 1>{ { value } };
+	}
+
+
+	/// <summary> Applies <paramref name="op"/> element-wise to the sources, and writes the result to <paramref name="out"/>. </summary>
+	/// <remarks> The output may alias the sources. Padding is processed too so that no scalar tail loop is needed,
+	///		except for integers: integer division traps on the zeros in the padding, so the last elements are done one by one. </remarks>
+	template <class T, int Dim, class Op, class... Sources>
+	void TransformLanes(VectorArray<T, Dim>& out, Op op, const Sources&... sources) {
+		using Block = typename VectorArray<T, Dim>::Block;
+		constexpr bool isPaddingSkipped = std::is_integral_v<T>;
+		const size_t count = isPaddingSkipped ? out.Size() / Block::size * Block::size : out.PaddedSize();
+		for (int component = 0; component < Dim; ++component) {
+			T* const outLane = out.Lane(component);
+			for (size_t index = 0; index < count; index += Block::size) {
+				Block::Store(outLane + index, op(sources.template Load<Block>(component, index)...));
+			}
+			if constexpr (isPaddingSkipped) {
+				for (size_t index = count; index < out.Size(); ++index) {
+					outLane[index] = op(sources.template Load<ScalarLaneBlock<T>>(component, index)...);
+				}
+			}
+		}
+	}
+
+
+	template <class T, int Dim1, int Dim2>
+	constexpr int BroadcastDim() {
+		static_assert(Dim1 == Dim2 || Dim1 == 1 || Dim2 == 1, "Vector arrays must have the same dimension, or one must be an array of scalars.");
+		return Dim1 > Dim2 ? Dim1 : Dim2;
+	}
+
+} // namespace impl
+
+
+//------------------------------------------------------------------------------
+// Arithmetic
+//------------------------------------------------------------------------------
+
+#define MATHTER_ARITHMETIC_VECARR_x_VECARR(OP, FUNCTOR)                                           \
+	template <class T, int Dim1, int Dim2>                                                       \
+	auto operator OP(const VectorArray<T, Dim1>& lhs, const VectorArray<T, Dim2>& rhs) {         \
+		assert(lhs.Size() == rhs.Size());                                                        \
+		VectorArray<T, impl::BroadcastDim<T, Dim1, Dim2>()> result(lhs.Size());                  \
+		impl::TransformLanes(result, FUNCTOR{}, impl::ArraySource<T, Dim1>{ lhs }, impl::ArraySource<T, Dim2>{ rhs }); \
+		return result;                                                                           \
+	}
+
+
+#define MATHTER_ARITHMETIC_VECARR_x_VEC(OP, FUNCTOR)                                                       \
+	template <class T, int Dim, bool Packed>                                                              \
+	auto operator OP(const VectorArray<T, Dim>& lhs, const Vector<T, Dim, Packed>& rhs) {                 \
+		VectorArray<T, Dim> result(lhs.Size());                                                           \
+		impl::TransformLanes(result, FUNCTOR{}, impl::ArraySource<T, Dim>{ lhs }, impl::MakeBroadcastSource(rhs)); \
+		return result;                                                                                    \
+	}                                                                                                     \
+	template <class T, int Dim, bool Packed>                                                              \
+	auto operator OP(const Vector<T, Dim, Packed>& lhs, const VectorArray<T, Dim>& rhs) {                 \
+		VectorArray<T, Dim> result(rhs.Size());                                                           \
+		impl::TransformLanes(result, FUNCTOR{}, impl::MakeBroadcastSource(lhs), impl::ArraySource<T, Dim>{ rhs }); \
+		return result;                                                                                    \
+	}
+
+
+#define MATHTER_ARITHMETIC_VECARR_x_SCALAR(OP, FUNCTOR)                                                                  \
+	template <class T, int Dim, class U, std::enable_if_t<is_scalar_v<U>, int> = 0>                                     \
+	auto operator OP(const VectorArray<T, Dim>& lhs, const U& rhs) {                                                    \
+		VectorArray<T, Dim> result(lhs.Size());                                                                         \
+		impl::TransformLanes(result, FUNCTOR{}, impl::ArraySource<T, Dim>{ lhs }, impl::MakeBroadcastSource(T(rhs)));   \
+		return result;                                                                                                  \
+	}                                                                                                                   \
+	template <class T, int Dim, class U, std::enable_if_t<is_scalar_v<U>, int> = 0>                                     \
+	auto operator OP(const U& lhs, const VectorArray<T, Dim>& rhs) {                                                    \
+		VectorArray<T, Dim> result(rhs.Size());                                                                         \
+		impl::TransformLanes(result, FUNCTOR{}, impl::MakeBroadcastSource(T(lhs)), impl::ArraySource<T, Dim>{ rhs });   \
+		return result;                                                                                                  \
+	}
+
+
+#define MATHTER_ARITHMETIC_ASSIGN_VECARR(OP, FUNCTOR)                                                               \
+	template <class T, int Dim1, int Dim2>                                                                         \
+	VectorArray<T, Dim1>& operator OP(VectorArray<T, Dim1>& lhs, const VectorArray<T, Dim2>& rhs) {                \
+		static_assert(Dim2 == Dim1 || Dim2 == 1, "Vector arrays must have the same dimension, or rhs must be an array of scalars."); \
+		assert(lhs.Size() == rhs.Size());                                                                          \
+		impl::TransformLanes(lhs, FUNCTOR{}, impl::ArraySource<T, Dim1>{ lhs }, impl::ArraySource<T, Dim2>{ rhs });\
+		return lhs;                                                                                                \
+	}                                                                                                              \
+	template <class T, int Dim, bool Packed>                                                                       \
+	VectorArray<T, Dim>& operator OP(VectorArray<T, Dim>& lhs, const Vector<T, Dim, Packed>& rhs) {                \
+		impl::TransformLanes(lhs, FUNCTOR{}, impl::ArraySource<T, Dim>{ lhs }, impl::MakeBroadcastSource(rhs));    \
+		return lhs;                                                                                                \
+	}                                                                                                              \
+	template <class T, int Dim, class U, std::enable_if_t<is_scalar_v<U>, int> = 0>                                \
+	VectorArray<T, Dim>& operator OP(VectorArray<T, Dim>& lhs, const U& rhs) {                                     \
+		impl::TransformLanes(lhs, FUNCTOR{}, impl::ArraySource<T, Dim>{ lhs }, impl::MakeBroadcastSource(T(rhs))); \
+		return lhs;                                                                                                \
+	}
+
+
+MATHTER_ARITHMETIC_VECARR_x_VECARR(*, std::multiplies<>);
+MATHTER_ARITHMETIC_VECARR_x_VECARR(/, std::divides<>);
+MATHTER_ARITHMETIC_VECARR_x_VECARR(+, std::plus<>);
+MATHTER_ARITHMETIC_VECARR_x_VECARR(-, std::minus<>);
+
+MATHTER_ARITHMETIC_VECARR_x_VEC(*, std::multiplies<>);
+MATHTER_ARITHMETIC_VECARR_x_VEC(/, std::divides<>);
+MATHTER_ARITHMETIC_VECARR_x_VEC(+, std::plus<>);
+MATHTER_ARITHMETIC_VECARR_x_VEC(-, std::minus<>);
+
+MATHTER_ARITHMETIC_VECARR_x_SCALAR(*, std::multiplies<>);
+MATHTER_ARITHMETIC_VECARR_x_SCALAR(/, std::divides<>);
+MATHTER_ARITHMETIC_VECARR_x_SCALAR(+, std::plus<>);
+MATHTER_ARITHMETIC_VECARR_x_SCALAR(-, std::minus<>);
+
+MATHTER_ARITHMETIC_ASSIGN_VECARR(*=, std::multiplies<>);
+MATHTER_ARITHMETIC_ASSIGN_VECARR(/=, std::divides<>);
+MATHTER_ARITHMETIC_ASSIGN_VECARR(+=, std::plus<>);
+MATHTER_ARITHMETIC_ASSIGN_VECARR(-=, std::minus<>);
+
+
+#undef MATHTER_ARITHMETIC_VECARR_x_VECARR
+#undef MATHTER_ARITHMETIC_VECARR_x_VEC
+#undef MATHTER_ARITHMETIC_VECARR_x_SCALAR
+#undef MATHTER_ARITHMETIC_ASSIGN_VECARR
+
+
+template <class T, int Dim>
+auto operator-(const VectorArray<T, Dim>& arg) {
+	VectorArray<T, Dim> result(arg.Size());
+	impl::TransformLanes(result, std::negate<>{}, impl::ArraySource<T, Dim>{ arg });
+	return result;
+}
+
+
+template <class T, int Dim>
+auto operator+(const VectorArray<T, Dim>& arg) {
+	return arg;
+}
+
+
+/// <summary> Calculates <paramref name="a"/> * <paramref name="b"/> + <paramref name="c"/> for each vector. </summary>
+/// <remarks> Uses FMA instructions when available. </remarks>
+template <class T, int Dim1, int Dim2, int Dim3>
+auto MultiplyAdd(const VectorArray<T, Dim1>& a, const VectorArray<T, Dim2>& b, const VectorArray<T, Dim3>& c) {
+	assert(a.Size() == b.Size() && a.Size() == c.Size());
+	constexpr auto Dim = impl::BroadcastDim<T, impl::BroadcastDim<T, Dim1, Dim2>(), Dim3>();
+	VectorArray<T, Dim> result(a.Size());
+	impl::TransformLanes(result, madd{}, impl::ArraySource<T, Dim1>{ a }, impl::ArraySource<T, Dim2>{ b }, impl::ArraySource<T, Dim3>{ c });
+	return result;
+}
+
+
+//------------------------------------------------------------------------------
+// Math
+//------------------------------------------------------------------------------
+
+/// <summary> Calculates the scalar product (dot product) of each pair of vectors. </summary>
+template <class T, int Dim>
+VectorArray<T, 1> Dot(const VectorArray<T, Dim>& lhs, const VectorArray<T, Dim>& rhs) {
+	assert(lhs.Size() == rhs.Size());
+	using Block = typename VectorArray<T, Dim>::Block;
+
+	VectorArray<T, 1> result(lhs.Size());
+	T* const out = result.Lane(0);
+	for (size_t index = 0; index < result.PaddedSize(); index += Block::size) {
+		auto acc = Block::Load(lhs.Lane(0) + index) * conj{}(Block::Load(rhs.Lane(0) + index));
+		for (int component = 1; component < Dim; ++component) {
+			acc = madd{}(Block::Load(lhs.Lane(component) + index), conj{}(Block::Load(rhs.Lane(component) + index)), acc);
+		}
+		Block::Store(out + index, acc);
+	}
+	return result;
+}
+
+
+/// <summary> Returns the squared length of each vector. </summary>
+template <class T, int Dim>
+VectorArray<T, 1> LengthSquared(const VectorArray<T, Dim>& arg) {
+	return Dot(arg, arg);
+}
+
+
+/// <summary> Returns the length of each vector. </summary>
+template <class T, int Dim>
+VectorArray<T, 1> Length(const VectorArray<T, Dim>& arg) {
+	auto result = LengthSquared(arg);
+	impl::TransformLanes(result, sqrt{}, impl::ArraySource<T, 1>{ result });
+	return result;
+}
+
+
+/// <summary> Makes each vector a unit vector, but keeps its direction. </summary>
+/// <remarks> Like the regular <see cref="Normalize"/>, this does not handle null vectors. </remarks>
+template <class T, int Dim>
+VectorArray<T, Dim> Normalize(const VectorArray<T, Dim>& arg) {
+	using Block = typename VectorArray<T, Dim>::Block;
+
+	VectorArray<T, Dim> result(arg.Size());
+	for (size_t index = 0; index < result.PaddedSize(); index += Block::size) {
+		auto lengthSq = Block::Load(arg.Lane(0) + index) * conj{}(Block::Load(arg.Lane(0) + index));
+		for (int component = 1; component < Dim; ++component) {
+			const auto element = Block::Load(arg.Lane(component) + index);
+			lengthSq = madd{}(element, conj{}(element), lengthSq);
+		}
+		const auto rcpLength = static_cast<T>(1) / sqrt{}(lengthSq);
+		for (int component = 0; component < Dim; ++component) {
+			Block::Store(result.Lane(component) + index, Block::Load(arg.Lane(component) + index) * rcpLength);
+		}
+	}
+	return result;
+}
+
+
+/// <summary> Returns the 3-dimensional cross-product of each pair of vectors. </summary>
+template <class T>
+VectorArray<T, 3> Cross(const VectorArray<T, 3>& lhs, const VectorArray<T, 3>& rhs) {
+	assert(lhs.Size() == rhs.Size());
+	using Block = typename VectorArray<T, 3>::Block;
+
+	VectorArray<T, 3> result(lhs.Size());
+	for (size_t index = 0; index < result.PaddedSize(); index += Block::size) {
+		const auto lx = Block::Load(lhs.Lane(0) + index);
+		const auto ly = Block::Load(lhs.Lane(1) + index);
+		const auto lz = Block::Load(lhs.Lane(2) + index);
+		const auto rx = Block::Load(rhs.Lane(0) + index);
+		const auto ry = Block::Load(rhs.Lane(1) + index);
+		const auto rz = Block::Load(rhs.Lane(2) + index);
+		Block::Store(result.Lane(0) + index, madd{}(ly, rz, -(lz * ry)));
+		Block::Store(result.Lane(1) + index, madd{}(lz, rx, -(lx * rz)));
+		Block::Store(result.Lane(2) + index, madd{}(lx, ry, -(ly * rx)));
+	}
+	return result;
+}
+
+
+/// <summary> Returns the element-wise minimum of each pair of vectors. </summary>
+template <class T, int Dim>
+VectorArray<T, Dim> Min(const VectorArray<T, Dim>& lhs, const VectorArray<T, Dim>& rhs) {
+	assert(lhs.Size() == rhs.Size());
+	VectorArray<T, Dim> result(lhs.Size());
+	impl::TransformLanes(result, min{}, impl::ArraySource<T, Dim>{ lhs }, impl::ArraySource<T, Dim>{ rhs });
+	return result;
+}
+
+
+/// <summary> Returns the element-wise maximum of each pair of vectors. </summary>
+template <class T, int Dim>
+VectorArray<T, Dim> Max(const VectorArray<T, Dim>& lhs, const VectorArray<T, Dim>& rhs) {
+	assert(lhs.Size() == rhs.Size());
+	VectorArray<T, Dim> result(lhs.Size());
+	impl::TransformLanes(result, max{}, impl::ArraySource<T, Dim>{ lhs }, impl::ArraySource<T, Dim>{ rhs });
+	return result;
+}
+
+
+} // namespace mathter
@@ -0,0 +1,448 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#pragma once
+
+#include "../Common/AlignedAllocator.hpp"
+#include "../Common/Functional.hpp"
+#include "../Common/TypeTraits.hpp"
+#include "../Common/Types.hpp"
+#include "Arithmetic.hpp"
+#include "SIMDUtil.hpp"
+#include "Vector.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <type_traits>
+#include <vector>
+
+
+namespace mathter {
+
+
+/// <summary> Represents a vector whose dimension is set at runtime. </summary>
+/// <remarks> Select it by passing <see cref="DYNAMIC"/> as the dimension. The elements are stored
+///		on the heap, aligned for SIMD, and elementwise operations process a full SIMD register
+///		per step instead of one vector per register.
+///		Dynamically sized vectors only take part in operations with other dynamically
+///		sized vectors. Fixed size vectors have to be converted explicitly. </remarks>
+/// <typeparam name="T"> The scalar type on which the vector is based. </typeparam>
+/// <typeparam name="Packed"> Has no effect on the storage. Propagated to the results of operations. </typeparam>
+template <class T, bool Packed>
+class Vector<T, DYNAMIC, Packed> {
+public:
+	static constexpr auto isBatched = false;
+	using Batch = void;
+	using Storage = std::vector<T, AlignedAllocator<T, impl::laneAlignment>>;
+
+public:
+	//--------------------------------------------
+	// Constructors
+	//--------------------------------------------
+
+	/// <summary> Creates an empty vector. </summary>
+	Vector() = default;
+
+	/// <summary> Creates a null vector of dimension <paramref name="dimension"/>. </summary>
+	explicit Vector(size_t dimension);
+
+	/// <summary> Creates a vector of dimension <paramref name="dimension"/> with all elements set to <paramref name="all"/>. </summary>
+	Vector(size_t dimension, const T& all);
+
+	/// <summary> Creates a vector from its elements. </summary>
+	Vector(std::initializer_list<T> elements);
+
+	/// <summary> Creates a vector by converting the elements of a fixed or dynamically sized vector. </summary>
+	template <class T2, int Dim2, bool Packed2>
+	Vector(const Vector<T2, Dim2, Packed2>& other);
+
+	/// <summary> Converts the vector to a fixed size vector. </summary>
+	/// <remarks> The dimensions must match. </remarks>
+	template <class T2, int Dim2, bool Packed2, class = std::enable_if_t<(Dim2 >= 1)>>
+	explicit operator Vector<T2, Dim2, Packed2>() const;
+
+	//--------------------------------------------
+	// Accessors
+	//--------------------------------------------
+
+	/// <summary> Returns the number of dimensions of the vector. </summary>
+	int Dimension() const;
+
+	/// <summary> Changes the number of dimensions of the vector. </summary>
+	/// <remarks> Existing elements are kept, new elements are set to zero. </remarks>
+	void Resize(size_t dimension);
+
+	/// <summary> Returns the nth element of the vector. </summary>
+	const T& operator[](size_t idx) const;
+	/// <summary> Returns the nth element of the vector. </summary>
+	T& operator[](size_t idx);
+
+	/// <summary> Returns the nth element of the vector. </summary>
+	const T& operator()(size_t idx) const;
+	/// <summary> Returns the nth element of the vector. </summary>
+	T& operator()(size_t idx);
+
+	/// <summary> Returns an iterator to the first element. </summary>
+	auto cbegin() const;
+	/// <summary> Returns an iterator to the first element. </summary>
+	auto begin() const;
+	/// <summary> Returns an iterator to the first element. </summary>
+	auto begin();
+	/// <summary> Returns an iterator to the end of the vector (works like STL). </summary>
+	auto cend() const;
+	/// <summary> Returns an iterator to the end of the vector (works like STL). </summary>
+	auto end() const;
+	/// <summary> Returns an iterator to the end of the vector (works like STL). </summary>
+	auto end();
+
+	/// <summary> Returns a pointer to the underlying array of elements. </summary>
+	/// <remarks> The array is aligned to <see cref="impl::laneAlignment"/>. </remarks>
+	const T* Data() const;
+	/// <summary> Returns a pointer to the underlying array of elements. </summary>
+	/// <remarks> The array is aligned to <see cref="impl::laneAlignment"/>. </remarks>
+	T* Data();
+
+	/// <summary> Returns a pointer to the underlying array of elements. </summary>
+	const T* data() const;
+	/// <summary> Returns a pointer to the underlying array of elements. </summary>
+	T* data();
+
+private:
+	Storage m_elements;
+};
+
+
+template <class T, bool Packed>
+Vector<T, DYNAMIC, Packed>::Vector(size_t dimension) : m_elements(dimension, static_cast<T>(0)) {}
+
+
+template <class T, bool Packed>
+Vector<T, DYNAMIC, Packed>::Vector(size_t dimension, const T& all) : m_elements(dimension, all) {}
+
+
+template <class T, bool Packed>
+Vector<T, DYNAMIC, Packed>::Vector(std::initializer_list<T> elements) : m_elements(elements.begin(), elements.end()) {}
+
+
+template <class T, bool Packed>
+template <class T2, int Dim2, bool Packed2>
+Vector<T, DYNAMIC, Packed>::Vector(const Vector<T2, Dim2, Packed2>& other) : m_elements(other.Dimension()) {
+	std::transform(other.begin(), other.end(), m_elements.begin(), [](const T2& element) { return static_cast<T>(element); });
+}
+
+
+template <class T, bool Packed>
+template <class T2, int Dim2, bool Packed2, class>
+Vector<T, DYNAMIC, Packed>::operator Vector<T2, Dim2, Packed2>() const {
+	assert(Dimension() == Dim2);
+	Vector<T2, Dim2, Packed2> v;
+	for (int i = 0; i < Dim2; ++i) {
+		v[i] = static_cast<T2>(m_elements[i]);
+	}
+	return v;
+}
+
+
+template <class T, bool Packed>
+int Vector<T, DYNAMIC, Packed>::Dimension() const {
+	return static_cast<int>(m_elements.size());
+}
+
+
+template <class T, bool Packed>
+void Vector<T, DYNAMIC, Packed>::Resize(size_t dimension) {
+	m_elements.resize(dimension, static_cast<T>(0));
+}
+
+
+template <class T, bool Packed>
+const T& Vector<T, DYNAMIC, Packed>::operator[](size_t idx) const {
+	assert(idx < m_elements.size());
+	return m_elements[idx];
+}
+
+
+template <class T, bool Packed>
+T& Vector<T, DYNAMIC, Packed>::operator[](size_t idx) {
+	assert(idx < m_elements.size());
+	return m_elements[idx];
+}
+
+
+template <class T, bool Packed>
+const T& Vector<T, DYNAMIC, Packed>::operator()(size_t idx) const {
+	return (*this)[idx];
+}
+
+
+template <class T, bool Packed>
+T& Vector<T, DYNAMIC, Packed>::operator()(size_t idx) {
+	return (*this)[idx];
+}
+
+
+template <class T, bool Packed>
+auto Vector<T, DYNAMIC, Packed>::cbegin() const {
+	return m_elements.data();
+}
+
+
+template <class T, bool Packed>
+auto Vector<T, DYNAMIC, Packed>::begin() const {
+	return m_elements.data();
+}
+
+
+template <class T, bool Packed>
+auto Vector<T, DYNAMIC, Packed>::begin() {
+	return m_elements.data();
+}
+
+
+template <class T, bool Packed>
+auto Vector<T, DYNAMIC, Packed>::cend() const {
+	return m_elements.data() + m_elements.size();
+}
+
+
+template <class T, bool Packed>
+auto Vector<T, DYNAMIC, Packed>::end() const {
+	return m_elements.data() + m_elements.size();
+}
+
+
+template <class T, bool Packed>
+auto Vector<T, DYNAMIC, Packed>::end() {
+	return m_elements.data() + m_elements.size();
+}
+
+
+template <class T, bool Packed>
+const T* Vector<T, DYNAMIC, Packed>::Data() const {
+	return m_elements.data();
+}
+
+
+template <class T, bool Packed>
+T* Vector<T, DYNAMIC, Packed>::Data() {
+	return m_elements.data();
+}
+
+
+template <class T, bool Packed>
+const T* Vector<T, DYNAMIC, Packed>::data() const {
+	return m_elements.data();
+}
+
+
+template <class T, bool Packed>
+T* Vector<T, DYNAMIC, Packed>::data() {
+	return m_elements.data();
+}
+
+
+//------------------------------------------------------------------------------
+// Elementwise kernels
+//------------------------------------------------------------------------------
+
+namespace impl {
+
+	/// <summary> Reads the elements of an aligned array. </summary>
+	template <class T>
+	struct ElementSource {
+		using value_type = T;
+		const T* data;
+
+		template <class Block>
+		auto Load(size_t index) const { return Block::Load(data + index); }
+		const T& Get(size_t index) const { return data[index]; }
+	};
+
+
+	/// <summary> Reads the same value for every element. </summary>
+	template <class T>
+	struct BroadcastElementSource {
+		using value_type = T;
+		T value;
+
+		template <class Block>
+		auto Load(size_t) const { return Block::Broadcast(value); }
+		const T& Get(size_t) const { return value; }
+	};
+
+
+	/// <summary> Computes out[i] = op(sources[i]...) for the first <paramref name="count"/> elements. </summary>
+	/// <remarks> When all sources have the same type as the output, and <paramref name="op"/>
+	///		accepts SIMD batches, the arrays are processed a full register at a time and
+	///		only the remainder is processed element by element. The arrays must start
+	///		at an address aligned for <see cref="LaneBlock"/>. <paramref name="out"/> may alias a source. </remarks>
+	template <class R, class Op, class... Sources>
+	void TransformElements(R* out, size_t count, Op&& op, const Sources&... sources) {
+		size_t index = 0;
+		if constexpr ((... && std::is_same_v<typename Sources::value_type, R>)) {
+			using Block = LaneBlock<R>;
+			if constexpr (Block::size > 1) {
+				if constexpr (std::is_invocable_r_v<typename Block::Block, Op, decltype(sources.template Load<Block>(0))...>) {
+					for (; index + Block::size <= count; index += Block::size) {
+						Block::Store(out + index, op(sources.template Load<Block>(index)...));
+					}
+				}
+			}
+		}
+		for (; index < count; ++index) {
+			out[index] = op(sources.Get(index)...);
+		}
+	}
+
+
+	/// <summary> Computes the sum of a[i] * b[i] for the first <paramref name="count"/> elements. </summary>
+	/// <remarks> The arrays must be aligned for <see cref="LaneBlock"/>. </remarks>
+	template <class T>
+	T DotElements(const T* a, const T* b, size_t count) {
+		size_t index = 0;
+		T sum = static_cast<T>(0);
+#if MATHTER_ENABLE_SIMD
+		using Block = LaneBlock<T>;
+		if constexpr (Block::size > 1) {
+			if (count >= Block::size) {
+				auto acc = Block::Load(a) * Block::Load(b);
+				for (index = Block::size; index + Block::size <= count; index += Block::size) {
+					acc = madd{}(Block::Load(a + index), Block::Load(b + index), acc);
+				}
+				sum = xsimd::reduce_add(acc);
+			}
+		}
+#endif
+		for (; index < count; ++index) {
+			sum += a[index] * b[index];
+		}
+		return sum;
+	}
+
+} // namespace impl
+
+
+//------------------------------------------------------------------------------
+// Operations
+//------------------------------------------------------------------------------
+
+template <class T>
+struct divides_safe<T, DYNAMIC> : std::divides<T> {};
+
+
+template <>
+struct divides_safe<void, DYNAMIC> : std::divides<> {};
+
+
+template <class T, bool Packed, class Fun>
+auto DoUnaryOp(const Vector<T, DYNAMIC, Packed>& arg, Fun&& fun) {
+	using R = std::invoke_result_t<Fun, T>;
+	Vector<R, DYNAMIC, Packed> result(arg.Dimension());
+	impl::TransformElements(result.data(), result.Dimension(), fun, impl::ElementSource<T>{ arg.data() });
+	return result;
+}
+
+
+template <class T1, class T2, bool Packed1, bool Packed2, class Fun>
+auto DoBinaryOp(const Vector<T1, DYNAMIC, Packed1>& lhs, const Vector<T2, DYNAMIC, Packed2>& rhs, Fun&& fun) {
+	assert(lhs.Dimension() == rhs.Dimension());
+	using R = std::invoke_result_t<Fun, T1, T2>;
+	Vector<R, DYNAMIC, Packed1 && Packed2> result(lhs.Dimension());
+	impl::TransformElements(result.data(), result.Dimension(), fun,
+							impl::ElementSource<T1>{ lhs.data() },
+							impl::ElementSource<T2>{ rhs.data() });
+	return result;
+}
+
+
+template <class T1, class T2, class T3, bool Packed1, bool Packed2, bool Packed3, class Fun>
+auto DoTernaryOp(const Vector<T1, DYNAMIC, Packed1>& a, const Vector<T2, DYNAMIC, Packed2>& b, const Vector<T3, DYNAMIC, Packed3>& c, Fun&& fun) {
+	assert(a.Dimension() == b.Dimension() && a.Dimension() == c.Dimension());
+	using R = std::invoke_result_t<Fun, T1, T2, T3>;
+	Vector<R, DYNAMIC, Packed1 && Packed2 && Packed3> result(a.Dimension());
+	impl::TransformElements(result.data(), result.Dimension(), fun,
+							impl::ElementSource<T1>{ a.data() },
+							impl::ElementSource<T2>{ b.data() },
+							impl::ElementSource<T3>{ c.data() });
+	return result;
+}
+
+
+namespace impl {
+
+	/// <summary> Broadcasts a scalar operand, converted to the vector's type if that does not change the result. </summary>
+	template <class TVec, class TScalar, class Fun>
+	auto MakeScalarSource(const TScalar& scalar, Fun&&) {
+		using R = std::invoke_result_t<Fun, TVec, TScalar>;
+		if constexpr (std::is_arithmetic_v<TVec> && std::is_arithmetic_v<TScalar> && std::is_same_v<R, TVec>) {
+			return BroadcastElementSource<TVec>{ static_cast<TVec>(scalar) };
+		}
+		else {
+			return BroadcastElementSource<TScalar>{ scalar };
+		}
+	}
+
+} // namespace impl
+
+
+#define MATHTER_ARITHMETIC_DYNAMIC_VEC_x_SCALAR(OP, FUNCTOR)                                                      \
+	template <class T1, bool Packed1, class T2, std::enable_if_t<is_scalar_v<T2>, int> = 0>                       \
+	auto operator OP(const Vector<T1, DYNAMIC, Packed1>& lhs, const T2& rhs) {                                    \
+		using R = std::invoke_result_t<FUNCTOR<>, T1, T2>;                                                        \
+		Vector<R, DYNAMIC, Packed1> result(lhs.Dimension());                                                      \
+		impl::TransformElements(result.data(), result.Dimension(), FUNCTOR<>{},                                   \
+								impl::ElementSource<T1>{ lhs.data() }, impl::MakeScalarSource<T1>(rhs, FUNCTOR<>{})); \
+		return result;                                                                                            \
+	}
+
+
+#define MATHTER_ARITHMETIC_DYNAMIC_SCALAR_x_VEC(OP, FUNCTOR)                                                      \
+	template <class T1, class T2, bool Packed2, std::enable_if_t<is_scalar_v<T1>, int> = 0>                       \
+	auto operator OP(const T1& lhs, const Vector<T2, DYNAMIC, Packed2>& rhs) {                                    \
+		using R = std::invoke_result_t<FUNCTOR<>, T1, T2>;                                                        \
+		Vector<R, DYNAMIC, Packed2> result(rhs.Dimension());                                                      \
+		impl::TransformElements(result.data(), result.Dimension(), FUNCTOR<>{},                                   \
+								impl::MakeScalarSource<T2>(lhs, FUNCTOR<>{}), impl::ElementSource<T2>{ rhs.data() }); \
+		return result;                                                                                            \
+	}
+
+
+MATHTER_ARITHMETIC_DYNAMIC_VEC_x_SCALAR(*, std::multiplies);
+MATHTER_ARITHMETIC_DYNAMIC_VEC_x_SCALAR(/, std::divides);
+MATHTER_ARITHMETIC_DYNAMIC_VEC_x_SCALAR(+, std::plus);
+MATHTER_ARITHMETIC_DYNAMIC_VEC_x_SCALAR(-, std::minus);
+
+MATHTER_ARITHMETIC_DYNAMIC_SCALAR_x_VEC(*, std::multiplies);
+MATHTER_ARITHMETIC_DYNAMIC_SCALAR_x_VEC(/, std::divides);
+MATHTER_ARITHMETIC_DYNAMIC_SCALAR_x_VEC(+, std::plus);
+MATHTER_ARITHMETIC_DYNAMIC_SCALAR_x_VEC(-, std::minus);
+
+#undef MATHTER_ARITHMETIC_DYNAMIC_VEC_x_SCALAR
+#undef MATHTER_ARITHMETIC_DYNAMIC_SCALAR_x_VEC
+
+
+/// <summary> Clamps all elements into range [lower, upper]. </summary>
+template <class T, bool Packed>
+Vector<T, DYNAMIC, Packed> Clamp(const Vector<T, DYNAMIC, Packed>& arg, T lower, T upper) {
+	Vector<T, DYNAMIC, Packed> result(arg.Dimension());
+	std::transform(arg.begin(), arg.end(), result.begin(), [&](const T& element) { return std::clamp(element, lower, upper); });
+	return result;
+}
+
+
+/// <summary> Makes a unit vector, but keeps direction. </summary>
+/// <remarks> Unlike the regular <see cref="Normalize"/>, this does can handle null vectors and under/overflow. </remarks>
+template <class T, bool Packed>
+Vector<T, DYNAMIC, Packed> NormalizePrecise(const Vector<T, DYNAMIC, Packed>& v) {
+	Vector<T, DYNAMIC, Packed> degenerate(v.Dimension());
+	degenerate[0] = static_cast<T>(1);
+	return NormalizePrecise(v, degenerate);
+}
+
+
+} // namespace mathter
@@ -38,6 +38,7 @@ using ScalarsComplex = TemplateArgumentList<std::complex<float>, std::complex<do
 using ScalarsComplex32 = TemplateArgumentList<std::complex<float>>;
 using ScalarsFloatingAndComplex = TemplateArgumentList<float, double, std::complex<float>, std::complex<double>>;
 using ScalarsFloatingAndComplex32 = TemplateArgumentList<float, std::complex<float>>;
+using ScalarsFloatingAndComplex64 = TemplateArgumentList<double, std::complex<double>>;
 using ScalarsAll = TemplateArgumentList<float, double, int32_t, int64_t, std::complex<float>, std::complex<double>>;
 
 using OrdersFollow = NTTemplateArgumentList<mathter::eMatrixOrder, mathter::eMatrixOrder::FOLLOW_VECTOR>;
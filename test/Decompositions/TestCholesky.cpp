@@ -0,0 +1,211 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#pragma warning(disable : 4244)
+
+#include "../ApplyTransform.hpp"
+#include "../Approx.hpp"
+#include "../Cases.hpp"
+#include "../MatrixUtil.hpp"
+
+#include <Mathter/Decompositions/DecomposeCholesky.hpp>
+#include <Mathter/Matrix/Arithmetic.hpp>
+#include <Mathter/Matrix/Math.hpp>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+
+
+using namespace mathter;
+using namespace test_util;
+
+
+template <class Mat>
+static Mat MakePositiveDefinite(const Mat& m) {
+	const auto dim = m.RowCount();
+	auto result = m * ConjTranspose(m);
+	for (size_t i = 0; i < dim; ++i) {
+		result(i, i) += static_cast<scalar_type_t<Mat>>(dim);
+	}
+	return result;
+}
+
+
+template <class Mat, class Vec>
+static Mat Diagonal(const Vec& D) {
+	Mat m = impl::MakeZero<Mat>(D.Dimension(), D.Dimension());
+	for (size_t i = 0; i < size_t(D.Dimension()); ++i) {
+		m(i, i) = D[i];
+	}
+	return m;
+}
+
+
+template <class Mat>
+static void VerifyCholesky(const Mat& A) {
+	using Real = remove_complex_t<scalar_type_t<Mat>>;
+	constexpr auto tolerance = Real(15) * std::numeric_limits<Real>::epsilon();
+
+	const auto [L] = DecomposeCholesky(A);
+	REQUIRE(NormPrecise(ZeroLowerTriangle(L)) < tolerance * NormPrecise(L));
+	for (size_t i = 0; i < L.RowCount(); ++i) {
+		REQUIRE(std::real(L(i, i)) > 0);
+		REQUIRE(std::imag(L(i, i)) == 0);
+	}
+	REQUIRE(L * ConjTranspose(L) == test_util::Approx(A, Real(100) * std::numeric_limits<Real>::epsilon()));
+}
+
+
+template <class Mat>
+static void VerifyLDLT(const Mat& A) {
+	using Real = remove_complex_t<scalar_type_t<Mat>>;
+	constexpr auto tolerance = Real(15) * std::numeric_limits<Real>::epsilon();
+
+	const auto [L, D] = DecomposeLDLT(A);
+	REQUIRE(NormPrecise(ZeroLowerTriangle(L)) < tolerance * NormPrecise(L));
+	for (size_t i = 0; i < L.RowCount(); ++i) {
+		REQUIRE(L(i, i) == scalar_type_t<Mat>(1));
+	}
+	REQUIRE(L * Diagonal<Mat>(D) * ConjTranspose(L) == test_util::Approx(A, Real(100) * std::numeric_limits<Real>::epsilon()));
+}
+
+
+TEMPLATE_LIST_TEST_CASE("Cholesky decomposition: real", "[Cholesky]",
+						decltype(MatrixCaseList<ScalarsFloating, OrdersAll, LayoutsAll, PackingsAll>{})) {
+	using Mat = typename TestType::template Matrix<3, 3>;
+
+	const Mat m = MakePositiveDefinite(Mat{
+		1.92f, 1.17f, 0.85f,
+		0.78f, 0.09f, -1.21f,
+		3.98f, 0.07f, -2.92f });
+
+	SECTION("Cholesky") {
+		VerifyCholesky(m);
+	}
+	SECTION("LDLT") {
+		VerifyLDLT(m);
+	}
+}
+
+
+TEMPLATE_LIST_TEST_CASE("Cholesky decomposition: complex", "[Cholesky]",
+						decltype(MatrixCaseList<ScalarsComplex, OrdersAll, LayoutsAll, PackingsAll>{})) {
+	using Mat = typename TestType::template Matrix<3, 3>;
+
+	using namespace std::complex_literals;
+
+	const Mat m = MakePositiveDefinite(Mat{
+		1.f + 0.7if, 0.5f + 1.2if, -1.3f - 0.9if,
+		2.f - 0.2if, -1.1f - 1.0if, -0.7f + 0.6if,
+		-1.f + 0.3if, 0.3f + 1.2if, 0.3f - 0.1if });
+
+	SECTION("Cholesky") {
+		VerifyCholesky(m);
+	}
+	SECTION("LDLT") {
+		VerifyLDLT(m);
+	}
+}
+
+
+TEMPLATE_LIST_TEST_CASE("Cholesky decomposition: large", "[Cholesky]",
+						decltype(MatrixCaseList<ScalarsFloatingAndComplex, OrdersAll, LayoutsAll, PackingsAll>{})) {
+	// Larger than the limit of the unrolled factorization.
+	using Mat = typename TestType::template Matrix<8, 8>;
+	using Scalar = scalar_type_t<Mat>;
+
+	Mat m;
+	for (size_t i = 0; i < 8; ++i) {
+		for (size_t j = 0; j < 8; ++j) {
+			m(i, j) = static_cast<Scalar>(int(i * 7 + j * 3) % 11 - 5);
+		}
+	}
+	m = MakePositiveDefinite(m);
+
+	SECTION("Cholesky") {
+		VerifyCholesky(m);
+	}
+	SECTION("LDLT") {
+		VerifyLDLT(m);
+	}
+}
+
+
+TEMPLATE_LIST_TEST_CASE("Cholesky decomposition: indefinite", "[Cholesky]",
+						decltype(MatrixCaseList<ScalarsFloating, OrdersAll, LayoutsAll, PackingsAll>{})) {
+	using Mat = typename TestType::template Matrix<3, 3>;
+
+	const Mat m = {
+		4, 1, 2,
+		1, -3, 0.5f,
+		2, 0.5f, 1
+	};
+
+	SECTION("LDLT") {
+		VerifyLDLT(m);
+		const auto [L, D] = DecomposeLDLT(m);
+		REQUIRE(D[1] < 0);
+	}
+}
+
+
+TEMPLATE_LIST_TEST_CASE("Cholesky decomposition: solve system of equations", "[Cholesky]",
+						decltype(MatrixCaseList<ScalarsFloating, OrdersAll, LayoutsAll, PackingsAll>{})) {
+	using Mat = typename TestType::template Matrix<3, 3>;
+	using Scalar = scalar_type_t<Mat>;
+	using Vec = Vector<Scalar, 3, false>;
+
+	const Mat m = MakePositiveDefinite(Mat{
+		1.92f, 1.17f, 0.85f,
+		0.78f, 0.09f, -1.21f,
+		3.98f, 0.07f, -2.92f });
+	const Vec b = { 1.0f, 2.0f, 3.0f };
+	const Mat identity = Identity();
+
+	SECTION("Cholesky") {
+		const auto decomposition = DecomposeCholesky(m);
+		const auto x = decomposition.Solve(b);
+		REQUIRE(ApplyTransform(m, x) == test_util::Approx(b, 1e-5f));
+		REQUIRE(m * decomposition.Inverse() == test_util::Approx(identity, 1e-5f));
+	}
+	SECTION("LDLT") {
+		const auto decomposition = DecomposeLDLT(m);
+		const auto x = decomposition.Solve(b);
+		REQUIRE(ApplyTransform(m, x) == test_util::Approx(b, 1e-5f));
+		REQUIRE(m * decomposition.Inverse() == test_util::Approx(identity, 1e-5f));
+	}
+}
+
+
+TEMPLATE_LIST_TEST_CASE("Cholesky decomposition: dynamic", "[Cholesky]",
+						decltype(MatrixCaseList<ScalarsFloatingAndComplex, OrdersAll, LayoutsAll, PackingsNo>{})) {
+	using Mat = typename TestType::template Matrix<DYNAMIC, DYNAMIC>;
+	using Scalar = scalar_type_t<Mat>;
+	using Real = remove_complex_t<Scalar>;
+	using Vec = Vector<Scalar, DYNAMIC, false>;
+	constexpr auto tolerance = Real(100) * std::numeric_limits<Real>::epsilon();
+
+	constexpr size_t dim = 23;
+	Mat m(dim, dim);
+	for (size_t i = 0; i < dim; ++i) {
+		for (size_t j = 0; j < dim; ++j) {
+			m(i, j) = static_cast<Scalar>(int(i * 7 + j * 3) % 11 - 5);
+		}
+	}
+	m = MakePositiveDefinite(m);
+	Vec b(dim);
+	for (size_t i = 0; i < dim; ++i) {
+		b[i] = static_cast<Scalar>(int(i % 7) - 3);
+	}
+
+	SECTION("Cholesky") {
+		VerifyCholesky(m);
+		REQUIRE(ApplyTransform(m, DecomposeCholesky(m).Solve(b)) == test_util::Approx(b, tolerance));
+	}
+	SECTION("LDLT") {
+		VerifyLDLT(m);
+		REQUIRE(ApplyTransform(m, DecomposeLDLT(m).Solve(b)) == test_util::Approx(b, tolerance));
+	}
+}
@@ -0,0 +1,210 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#pragma warning(disable : 4244)
+
+#include "../ApplyTransform.hpp"
+#include "../Approx.hpp"
+#include "../Cases.hpp"
+
+#include <Mathter/Decompositions/DecomposeArray.hpp>
+#include <Mathter/Decompositions/DecomposeLU.hpp>
+#include <Mathter/Decompositions/DecomposeSVD.hpp>
+#include <Mathter/Matrix/Arithmetic.hpp>
+#include <Mathter/Matrix/Math.hpp>
+#include <Mathter/Transforms/IdentityBuilder.hpp>
+#include <Mathter/Transforms/ZeroBuilder.hpp>
+
+#include <catch2/catch_template_test_macros.hpp>
+
+#include <vector>
+
+
+using namespace mathter;
+using namespace test_util;
+
+
+namespace {
+
+// Not a multiple of any SIMD width to exercise the padding.
+constexpr size_t arraySize = 37;
+
+
+template <class Mat>
+std::vector<Mat> MakeMatrices(size_t count) {
+	std::vector<Mat> matrices;
+	unsigned state = 12345u;
+	for (size_t i = 0; i < count; ++i) {
+		Mat m;
+		for (int row = 0; row < row_count_v<Mat>; ++row) {
+			for (int col = 0; col < column_count_v<Mat>; ++col) {
+				state = state * 1103515245u + 12345u;
+				m(row, col) = static_cast<scalar_type_t<Mat>>(int((state >> 16) % 21) - 10);
+			}
+		}
+		matrices.push_back(m);
+	}
+	return matrices;
+}
+
+
+template <class Vec>
+std::vector<Vec> MakeVectors(size_t count) {
+	std::vector<Vec> vectors;
+	for (size_t i = 0; i < count; ++i) {
+		Vec v;
+		for (int c = 0; c < dimension_v<Vec>; ++c) {
+			v[c] = static_cast<scalar_type_t<Vec>>(1 + (int(i) * 5 + c * 3) % 7);
+		}
+		vectors.push_back(v);
+	}
+	return vectors;
+}
+
+
+template <class Mat, class T, int Rows, int Columns>
+Mat Gather(const MatrixArray<T, Rows, Columns>& array, size_t index) {
+	return array.template Gather<order_v<Mat>, layout_v<Mat>, is_packed_v<Mat>>(index);
+}
+
+} // namespace
+
+
+TEMPLATE_LIST_TEST_CASE("Batched decomposition - LUP", "[DecomposeArray]",
+						decltype(MatrixCaseList<ScalarsFloating, OrdersPrecede, LayoutsAll, PackingsNo>{})) {
+	using Mat = typename TestType::template Matrix<6, 6>;
+	using Scalar = scalar_type_t<Mat>;
+	using Vec = Vector<Scalar, 6>;
+	const auto tolerance = Scalar(1000) * std::numeric_limits<Scalar>::epsilon();
+
+	const auto matrices = MakeMatrices<Mat>(arraySize);
+	const auto vectors = MakeVectors<Vec>(arraySize);
+	const MatrixArray array(matrices.begin(), matrices.end());
+	const VectorArray b(vectors.begin(), vectors.end());
+
+	const auto decomposition = DecomposeLUP(array);
+	const auto x = decomposition.Solve(b);
+	for (size_t i = 0; i < arraySize; ++i) {
+		const auto L = Gather<Mat>(decomposition.L, i);
+		const auto U = Gather<Mat>(decomposition.U, i);
+		Mat PA;
+		for (int row = 0; row < 6; ++row) {
+			PA.Row(row, matrices[i].Row(int(decomposition.P.Gather(i)[row])));
+		}
+		const auto reference = DecomposeLUP(matrices[i]);
+		REQUIRE(L == test_util::Approx(reference.L, tolerance));
+		REQUIRE(U == test_util::Approx(reference.U, tolerance));
+		REQUIRE(L * U == test_util::Approx(PA, tolerance));
+		REQUIRE(ApplyTransform(matrices[i], x.Gather(i)) == test_util::Approx(vectors[i], tolerance));
+	}
+}
+
+
+TEMPLATE_LIST_TEST_CASE("Batched decomposition - QR", "[DecomposeArray]",
+						decltype(MatrixCaseList<ScalarsFloating, OrdersPrecede, LayoutsAll, PackingsNo>{})) {
+	using Mat = typename TestType::template Matrix<5, 3>;
+	using MatR = typename TestType::template Matrix<3, 3>;
+	using Scalar = scalar_type_t<Mat>;
+	using Vec = Vector<Scalar, 5>;
+	const auto tolerance = Scalar(1000) * std::numeric_limits<Scalar>::epsilon();
+
+	const auto matrices = MakeMatrices<Mat>(arraySize);
+	const auto vectors = MakeVectors<Vec>(arraySize);
+	const MatrixArray array(matrices.begin(), matrices.end());
+	const VectorArray b(vectors.begin(), vectors.end());
+
+	const auto decomposition = DecomposeQR(array);
+	const auto x = decomposition.Solve(b);
+	for (size_t i = 0; i < arraySize; ++i) {
+		const auto Q = Gather<Mat>(decomposition.Q, i);
+		const auto R = Gather<MatR>(decomposition.R, i);
+		REQUIRE(Q * R == test_util::Approx(matrices[i], tolerance));
+		REQUIRE(Transpose(Q) * Q == test_util::Approx(MatR(Identity()), tolerance));
+		for (int row = 1; row < 3; ++row) {
+			for (int col = 0; col < row; ++col) {
+				REQUIRE(R(row, col) == 0);
+			}
+		}
+		// The residual of the least squares solution is orthogonal to the column space.
+		const auto residual = ApplyTransform(matrices[i], x.Gather(i)) - vectors[i];
+		REQUIRE(Length(ApplyTransform(Transpose(matrices[i]), residual)) < tolerance * Length(vectors[i]) * NormPrecise(matrices[i]));
+	}
+}
+
+
+TEMPLATE_LIST_TEST_CASE("Batched decomposition - SVD", "[DecomposeArray]",
+						decltype(MatrixCaseList<ScalarsFloating, OrdersPrecede, LayoutsAll, PackingsNo>{})) {
+	using Mat = typename TestType::template Matrix<5, 3>;
+	using MatSquare = typename TestType::template Matrix<3, 3>;
+	using Scalar = scalar_type_t<Mat>;
+	using Vec = Vector<Scalar, 5>;
+	const auto tolerance = Scalar(1000) * std::numeric_limits<Scalar>::epsilon();
+
+	const auto matrices = MakeMatrices<Mat>(arraySize);
+	const auto vectors = MakeVectors<Vec>(arraySize);
+	const MatrixArray array(matrices.begin(), matrices.end());
+	const VectorArray b(vectors.begin(), vectors.end());
+
+	const auto decomposition = DecomposeSVD(array);
+	const auto x = decomposition.Solve(b);
+	for (size_t i = 0; i < arraySize; ++i) {
+		const auto U = Gather<Mat>(decomposition.U, i);
+		const auto S = decomposition.S.Gather(i);
+		const auto V = Gather<MatSquare>(decomposition.V, i);
+		MatSquare SM = Zero();
+		for (int k = 0; k < 3; ++k) {
+			SM(k, k) = S[k];
+		}
+		const auto reference = DecomposeSVD(matrices[i], SVDAlgorithmOneSided);
+		REQUIRE(S == test_util::Approx(reference.S, tolerance));
+		REQUIRE(S[0] >= S[1]);
+		REQUIRE(S[1] >= S[2]);
+		REQUIRE(U * SM * V == test_util::Approx(matrices[i], tolerance));
+		REQUIRE(Transpose(U) * U == test_util::Approx(MatSquare(Identity()), tolerance));
+		REQUIRE(V * Transpose(V) == test_util::Approx(MatSquare(Identity()), tolerance));
+		REQUIRE(x.Gather(i) == test_util::Approx(reference.Solve(vectors[i]), tolerance));
+	}
+}
+
+
+TEMPLATE_LIST_TEST_CASE("Batched decomposition - degenerate lanes", "[DecomposeArray]",
+						decltype(MatrixCaseList<ScalarsFloating, OrdersPrecede, LayoutsRM, PackingsNo>{})) {
+	using Mat = typename TestType::template Matrix<4, 4>;
+	using Scalar = scalar_type_t<Mat>;
+	const auto tolerance = Scalar(1000) * std::numeric_limits<Scalar>::epsilon();
+
+	// A zero matrix must not disturb the matrices processed in the neighboring lanes.
+	auto matrices = MakeMatrices<Mat>(arraySize);
+	matrices[1] = Zero();
+	const MatrixArray array(matrices.begin(), matrices.end());
+
+	SECTION("QR") {
+		const auto decomposition = DecomposeQR(array);
+		for (size_t i = 0; i < arraySize; ++i) {
+			const auto Q = Gather<Mat>(decomposition.Q, i);
+			const auto R = Gather<Mat>(decomposition.R, i);
+			REQUIRE(Transpose(Q) * Q == test_util::Approx(Mat(Identity()), tolerance));
+			if (i != 1) {
+				REQUIRE(Q * R == test_util::Approx(matrices[i], tolerance));
+			}
+			else {
+				REQUIRE(R == Mat(Zero()));
+			}
+		}
+	}
+	SECTION("SVD") {
+		const auto decomposition = DecomposeSVD(array);
+		for (size_t i = 0; i < arraySize; ++i) {
+			const auto S = decomposition.S.Gather(i);
+			if (i != 1) {
+				REQUIRE(S == test_util::Approx(DecomposeSVD(matrices[i], SVDAlgorithmOneSided).S, tolerance));
+			}
+			else {
+				REQUIRE(S == Vector<Scalar, 4>(Scalar(0)));
+				REQUIRE(Gather<Mat>(decomposition.U, i) == Mat(Zero()));
+			}
+		}
+	}
+}
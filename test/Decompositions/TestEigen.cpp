@@ -0,0 +1,206 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#pragma warning(disable : 4244)
+
+#include "../ApplyTransform.hpp"
+#include "../Approx.hpp"
+#include "../Cases.hpp"
+
+#include <Mathter/Decompositions/DecomposeEigen.hpp>
+#include <Mathter/Matrix/Arithmetic.hpp>
+#include <Mathter/Matrix/Math.hpp>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+
+
+using namespace mathter;
+using namespace test_util;
+
+
+template <class Mat>
+static Mat MakeHermitian(const Mat& m) {
+	return m + ConjTranspose(m);
+}
+
+
+template <class Mat, class Vec>
+static Mat Diagonal(const Vec& D) {
+	Mat m = impl::MakeZero<Mat>(D.Dimension(), D.Dimension());
+	for (size_t i = 0; i < size_t(D.Dimension()); ++i) {
+		m(i, i) = D[i];
+	}
+	return m;
+}
+
+
+template <class Mat, class Decomposition>
+static void VerifyEigen(const Mat& A, const Decomposition& decomposition, remove_complex_t<scalar_type_t<Mat>> tolerance) {
+	const auto& [V, D] = decomposition;
+	const auto identity = impl::MakeIdentity<Mat>(A.RowCount(), A.ColumnCount());
+	REQUIRE(ConjTranspose(V) * V == test_util::Approx(identity, tolerance));
+	REQUIRE(V * Diagonal<Mat>(D) * ConjTranspose(V) == test_util::Approx(A, tolerance));
+	for (size_t i = 1; i < size_t(D.Dimension()); ++i) {
+		REQUIRE(D[i - 1] >= D[i]);
+	}
+}
+
+
+TEMPLATE_LIST_TEST_CASE("Eigendecomposition: real", "[Eigen]",
+						decltype(MatrixCaseList<ScalarsFloating, OrdersAll, LayoutsAll, PackingsAll>{})) {
+	using Mat = typename TestType::template Matrix<3, 3>;
+	using Real = scalar_type_t<Mat>;
+	constexpr auto tolerance = Real(100) * std::numeric_limits<Real>::epsilon();
+
+	const Mat m = MakeHermitian(Mat{
+		1.92f, 1.17f, 0.85f,
+		0.78f, 0.09f, -1.21f,
+		3.98f, 0.07f, -2.92f });
+
+	SECTION("Jacobi") {
+		VerifyEigen(m, impl::DecomposeEigenHermitianJacobi(m), tolerance);
+	}
+	SECTION("Analytic") {
+		VerifyEigen(m, impl::DecomposeEigenHermitianAnalytic(m), tolerance);
+	}
+	SECTION("Same eigenvalues") {
+		const auto [V1, D1] = impl::DecomposeEigenHermitianJacobi(m);
+		const auto [V2, D2] = impl::DecomposeEigenHermitianAnalytic(m);
+		REQUIRE(D1 == test_util::Approx(D2, tolerance));
+	}
+	SECTION("Reads lower triangle") {
+		Mat lower = m;
+		lower(0, 1) = lower(0, 2) = lower(1, 2) = Real(1000);
+		VerifyEigen(m, impl::DecomposeEigenHermitianJacobi(lower), tolerance);
+		VerifyEigen(m, impl::DecomposeEigenHermitianAnalytic(lower), tolerance);
+	}
+}
+
+
+TEMPLATE_LIST_TEST_CASE("Eigendecomposition: repeated eigenvalues", "[Eigen]",
+						decltype(MatrixCaseList<ScalarsFloating, OrdersAll, LayoutsAll, PackingsAll>{})) {
+	using Mat = typename TestType::template Matrix<3, 3>;
+	using Real = scalar_type_t<Mat>;
+	constexpr auto tolerance = Real(100) * std::numeric_limits<Real>::epsilon();
+
+	// Q * diag(4, 4, -2) * Q^T for a rotation Q.
+	const Mat Q = {
+		Real(2) / 3, Real(-2) / 3, Real(1) / 3,
+		Real(1) / 3, Real(2) / 3, Real(2) / 3,
+		Real(-2) / 3, Real(-1) / 3, Real(2) / 3
+	};
+	const Mat m = Q * Diagonal<Mat>(Vector<Real, 3>(4, 4, -2)) * Transpose(Q);
+
+	SECTION("Jacobi") {
+		const auto decomposition = impl::DecomposeEigenHermitianJacobi(m);
+		VerifyEigen(m, decomposition, tolerance);
+		REQUIRE(decomposition.D == test_util::Approx(Vector<Real, 3>(4, 4, -2), tolerance));
+	}
+	SECTION("Analytic") {
+		const auto decomposition = impl::DecomposeEigenHermitianAnalytic(m);
+		VerifyEigen(m, decomposition, tolerance);
+		REQUIRE(decomposition.D == test_util::Approx(Vector<Real, 3>(4, 4, -2), tolerance));
+	}
+	SECTION("Diagonal") {
+		const Mat diagonal = Diagonal<Mat>(Vector<Real, 3>(1, 3, 2));
+		const auto decomposition = DecomposeEigenHermitian(diagonal);
+		VerifyEigen(diagonal, decomposition, tolerance);
+		REQUIRE(decomposition.D == Vector<Real, 3>(3, 2, 1));
+	}
+	SECTION("Zero") {
+		const Mat zero = impl::MakeZero<Mat>(3, 3);
+		const auto [V, D] = DecomposeEigenHermitian(zero);
+		REQUIRE(V == Mat(Identity()));
+		REQUIRE(D == Vector<Real, 3>(Real(0)));
+	}
+}
+
+
+TEMPLATE_LIST_TEST_CASE("Eigendecomposition: complex", "[Eigen]",
+						decltype(MatrixCaseList<ScalarsComplex, OrdersAll, LayoutsAll, PackingsAll>{})) {
+	using Mat = typename TestType::template Matrix<3, 3>;
+	using Real = remove_complex_t<scalar_type_t<Mat>>;
+	constexpr auto tolerance = Real(100) * std::numeric_limits<Real>::epsilon();
+
+	using namespace std::complex_literals;
+
+	const Mat m = MakeHermitian(Mat{
+		1.f + 0.7if, 0.5f + 1.2if, -1.3f - 0.9if,
+		2.f - 0.2if, -1.1f - 1.0if, -0.7f + 0.6if,
+		-1.f + 0.3if, 0.3f + 1.2if, 0.3f - 0.1if });
+
+	VerifyEigen(m, DecomposeEigenHermitian(m), tolerance);
+}
+
+
+TEMPLATE_LIST_TEST_CASE("Eigendecomposition: large", "[Eigen]",
+						decltype(MatrixCaseList<ScalarsFloatingAndComplex, OrdersAll, LayoutsAll, PackingsAll>{})) {
+	using Mat = typename TestType::template Matrix<8, 8>;
+	using Scalar = scalar_type_t<Mat>;
+	using Real = remove_complex_t<Scalar>;
+	constexpr auto tolerance = Real(100) * std::numeric_limits<Real>::epsilon();
+
+	Mat m;
+	for (size_t i = 0; i < 8; ++i) {
+		for (size_t j = 0; j < 8; ++j) {
+			m(i, j) = static_cast<Scalar>(int(i * 7 + j * 3) % 11 - 5);
+		}
+	}
+	m = MakeHermitian(m);
+
+	VerifyEigen(m, DecomposeEigenHermitian(m), tolerance);
+}
+
+
+TEMPLATE_LIST_TEST_CASE("Eigendecomposition: solve system of equations", "[Eigen]",
+						decltype(MatrixCaseList<ScalarsFloating, OrdersAll, LayoutsAll, PackingsAll>{})) {
+	using Mat = typename TestType::template Matrix<4, 4>;
+	using Scalar = scalar_type_t<Mat>;
+	using Vec = Vector<Scalar, 4, false>;
+
+	const Mat m = MakeHermitian(Mat{
+		1.92f, 1.17f, 0.85f, 0.5f,
+		0.78f, 0.09f, -1.21f, 1.3f,
+		3.98f, 0.07f, -2.92f, -0.4f,
+		0.1f, 2.2f, 0.3f, 1.1f });
+	const Vec b = { 1.0f, 2.0f, 3.0f, 4.0f };
+	const Mat identity = Identity();
+
+	const auto decomposition = DecomposeEigenHermitian(m);
+	const auto x = decomposition.Solve(b);
+	REQUIRE(ApplyTransform(m, x) == test_util::Approx(b, 1e-4f));
+	REQUIRE(m * decomposition.Inverse() == test_util::Approx(identity, 1e-4f));
+}
+
+
+TEMPLATE_LIST_TEST_CASE("Eigendecomposition: dynamic", "[Eigen]",
+						decltype(MatrixCaseList<ScalarsFloatingAndComplex, OrdersAll, LayoutsAll, PackingsNo>{})) {
+	using Mat = typename TestType::template Matrix<DYNAMIC, DYNAMIC>;
+	using Scalar = scalar_type_t<Mat>;
+	using Real = remove_complex_t<Scalar>;
+	using Vec = Vector<Scalar, DYNAMIC, false>;
+	constexpr auto tolerance = Real(1000) * std::numeric_limits<Real>::epsilon();
+
+	constexpr size_t dim = 13;
+	Mat m(dim, dim);
+	for (size_t i = 0; i < dim; ++i) {
+		for (size_t j = 0; j < dim; ++j) {
+			m(i, j) = static_cast<Scalar>(int(i * 7 + j * 3) % 11 - 5);
+		}
+	}
+	m = MakeHermitian(m);
+	for (size_t i = 0; i < dim; ++i) {
+		m(i, i) += static_cast<Scalar>(dim);
+	}
+	Vec b(dim);
+	for (size_t i = 0; i < dim; ++i) {
+		b[i] = static_cast<Scalar>(int(i % 7) - 3);
+	}
+
+	const auto decomposition = DecomposeEigenHermitian(m);
+	VerifyEigen(m, decomposition, tolerance);
+	REQUIRE(ApplyTransform(m, decomposition.Solve(b)) == test_util::Approx(b, tolerance * Real(dim)));
+}
@@ -0,0 +1,163 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#pragma warning(disable : 4244)
+
+#include "../ApplyTransform.hpp"
+#include "../Approx.hpp"
+#include "../Cases.hpp"
+
+#include <Mathter/Decompositions/IterativeRefinement.hpp>
+#include <Mathter/Matrix/Arithmetic.hpp>
+
+#include <catch2/catch_template_test_macros.hpp>
+
+
+using namespace mathter;
+using namespace test_util;
+
+
+template <class Mat>
+static Mat MakeWellConditioned() {
+	using Scalar = scalar_type_t<Mat>;
+	using Real = remove_complex_t<Scalar>;
+
+	Mat m;
+	for (int i = 0; i < row_count_v<Mat>; ++i) {
+		for (int j = 0; j < column_count_v<Mat>; ++j) {
+			const auto re = Real(std::sin(1.3 * i + 0.7 * j + 0.1)) + (i == j ? Real(4) : Real(0));
+			if constexpr (is_complex_v<Scalar>) {
+				m(i, j) = Scalar(re, Real(std::cos(0.9 * i - 1.1 * j)));
+			}
+			else {
+				m(i, j) = re;
+			}
+		}
+	}
+	return m;
+}
+
+
+template <class Mat>
+static Mat MakeHilbert() {
+	using Scalar = scalar_type_t<Mat>;
+
+	Mat m;
+	for (int i = 0; i < row_count_v<Mat>; ++i) {
+		for (int j = 0; j < column_count_v<Mat>; ++j) {
+			m(i, j) = Scalar(1.0 / double(i + j + 1));
+		}
+	}
+	return m;
+}
+
+
+template <class Vec>
+static Vec MakeRightHandSide() {
+	using Scalar = scalar_type_t<Vec>;
+	using Real = remove_complex_t<Scalar>;
+
+	Vec b;
+	for (int i = 0; i < dimension_v<Vec>; ++i) {
+		b[i] = Scalar(Real(i % 5) - Real(2) + Real(1) / Real(i + 3));
+	}
+	return b;
+}
+
+
+template <class Mat, class Vec>
+static auto MaxResidual(const Mat& A, const Vec& x, const Vec& b) {
+	return ScaleElements(Vec(b - ApplyTransform(A, x)));
+}
+
+
+TEMPLATE_LIST_TEST_CASE("Iterative refinement: LUP", "[IterativeRefinement]",
+						decltype(MatrixCaseList<ScalarsFloatingAndComplex64, OrdersAll, LayoutsAll, PackingsAll>{})) {
+	using Mat = typename TestType::template Matrix<16, 16>;
+	using Scalar = scalar_type_t<Mat>;
+	using Real = remove_complex_t<Scalar>;
+	using Vec = Vector<Scalar, 16, is_packed_v<Mat>>;
+	constexpr auto tolerance = Real(16) * std::numeric_limits<Real>::epsilon();
+
+	const auto A = MakeWellConditioned<Mat>();
+	const auto b = MakeRightHandSide<Vec>();
+
+	SECTION("Vector") {
+		const auto [x, iterations, converged] = SolveRefined(A, b);
+		REQUIRE(converged);
+		REQUIRE(iterations >= 1);
+		REQUIRE(iterations <= 4);
+		REQUIRE(MaxResidual(A, x, b) <= tolerance * ScaleElements(A) * ScaleElements(x));
+		REQUIRE(x == test_util::Approx(DecomposeLUPCompact(A).Solve(b), Real(1e-13)));
+	}
+	SECTION("Matrix") {
+		const Mat B = MakeWellConditioned<Mat>() * Scalar(2);
+		const auto [X, iterations, converged] = SolveRefined(A, B, RefinedDecompositionLUP);
+		REQUIRE(converged);
+		REQUIRE(iterations <= 4);
+		REQUIRE(X == test_util::Approx(DecomposeLUPCompact(A).Solve(B), Real(1e-13)));
+	}
+}
+
+
+TEMPLATE_LIST_TEST_CASE("Iterative refinement: QR", "[IterativeRefinement]",
+						decltype(MatrixCaseList<ScalarsFloatingAndComplex64, OrdersPrecede, LayoutsAll, PackingsAll>{})) {
+	using Mat = typename TestType::template Matrix<16, 16>;
+	using Scalar = scalar_type_t<Mat>;
+	using Real = remove_complex_t<Scalar>;
+	using Vec = Vector<Scalar, 16, is_packed_v<Mat>>;
+	constexpr auto tolerance = Real(16) * std::numeric_limits<Real>::epsilon();
+
+	const auto A = MakeWellConditioned<Mat>();
+	const auto b = MakeRightHandSide<Vec>();
+
+	const auto [x, iterations, converged] = SolveRefined(A, b, RefinedDecompositionQR);
+	REQUIRE(converged);
+	REQUIRE(iterations >= 1);
+	REQUIRE(iterations <= 4);
+	REQUIRE(MaxResidual(A, x, b) <= tolerance * ScaleElements(A) * ScaleElements(x));
+	REQUIRE(x == test_util::Approx(DecomposeQRCompact(A).Solve(b), Real(1e-13)));
+}
+
+
+TEMPLATE_LIST_TEST_CASE("Iterative refinement: fallback", "[IterativeRefinement]",
+						decltype(MatrixCaseList<ScalarsFloatingAndComplex64, OrdersAll, LayoutsAll, PackingsAll>{})) {
+	using Mat = typename TestType::template Matrix<10, 10>;
+	using Scalar = scalar_type_t<Mat>;
+	using Vec = Vector<Scalar, 10, is_packed_v<Mat>>;
+
+	const auto b = MakeRightHandSide<Vec>();
+
+	SECTION("Ill-conditioned") {
+		// The condition number of the 10x10 Hilbert matrix is about 1e13, way too much for single precision.
+		const auto A = MakeHilbert<Mat>();
+		const auto [x, iterations, converged] = SolveRefined(A, b);
+		REQUIRE(!converged);
+		REQUIRE(x == DecomposeLUPCompact(A).Solve(b));
+	}
+	SECTION("Out of range") {
+		const auto A = MakeWellConditioned<Mat>() * Scalar(1e300);
+		const auto [x, iterations, converged] = SolveRefined(A, b);
+		REQUIRE(!converged);
+		REQUIRE(iterations == 0);
+		REQUIRE(x == DecomposeLUPCompact(A).Solve(b));
+	}
+}
+
+
+TEMPLATE_LIST_TEST_CASE("Iterative refinement: zero right-hand side", "[IterativeRefinement]",
+						decltype(MatrixCaseList<ScalarsFloatingAndComplex64, OrdersAll, LayoutsAll, PackingsAll>{})) {
+	using Mat = typename TestType::template Matrix<6, 6>;
+	using Scalar = scalar_type_t<Mat>;
+	using Vec = Vector<Scalar, 6, is_packed_v<Mat>>;
+
+	const auto A = MakeWellConditioned<Mat>();
+	const Vec b(Scalar(0));
+
+	const auto [x, iterations, converged] = SolveRefined(A, b);
+	REQUIRE(converged);
+	REQUIRE(iterations == 0);
+	REQUIRE(x == Vec(Scalar(0)));
+}
@@ -186,4 +186,88 @@ TEMPLATE_LIST_TEST_CASE("LU decomposition: inverse", "[LU]",
 		const auto inverse = LUP.Inverse();
 		REQUIRE(m * inverse == test_util::Approx(Mat(Identity())));
 	}
-}
\ No newline at end of file
+}
+
+template <class Mat>
+static Mat MakePivotingMatrix() {
+	// A permutation matrix plus a small perturbation, so that every step must pivot, but it stays well-conditioned.
+	using Scalar = scalar_type_t<Mat>;
+	using Real = remove_complex_t<Scalar>;
+	constexpr int dim = row_count_v<Mat>;
+
+	Mat m;
+	for (int i = 0; i < dim; ++i) {
+		for (int j = 0; j < dim; ++j) {
+			const auto re = Real(std::sin(1.3 * i + 0.7 * j + 0.1)) / Real(2 * dim) + (j == (7 * i + 3) % dim ? Real(1) : Real(0));
+			if constexpr (is_complex_v<Scalar>) {
+				m(i, j) = Scalar(re, Real(std::cos(0.9 * i - 1.1 * j)) / Real(2 * dim));
+			}
+			else {
+				m(i, j) = re;
+			}
+		}
+	}
+	return m;
+}
+
+
+template <class Mat>
+static void TestCompactLU() {
+	using Scalar = scalar_type_t<Mat>;
+	using Real = remove_complex_t<Scalar>;
+	using Vec = Vector<Scalar, row_count_v<Mat>, false>;
+	constexpr int dim = row_count_v<Mat>;
+	constexpr auto tolerance = Real(100) * std::numeric_limits<Real>::epsilon();
+
+	const auto m = MakePivotingMatrix<Mat>();
+	const auto compact = DecomposeLUPCompact(m);
+
+	SECTION("Extract factors") {
+		const auto L = compact.ExtractL();
+		const auto U = compact.ExtractU();
+		const auto P = compact.ExpandPermutation();
+		REQUIRE(compact.pivots[0] != 0); // Make sure permutation is not identity.
+		REQUIRE(NormPrecise(ZeroLowerTriangle(L)) == 0);
+		REQUIRE(NormPrecise(ZeroUpperTriangle(U)) == 0);
+		REQUIRE(L * U == test_util::Approx(P * m, tolerance));
+	}
+	SECTION("Solve") {
+		Vec b;
+		for (int i = 0; i < dim; ++i) {
+			b[i] = Scalar(Real(i % 5) - Real(2));
+		}
+		const auto x = compact.Solve(b);
+		REQUIRE(ApplyTransform(m, x) == test_util::Approx(b, tolerance));
+		REQUIRE(x == test_util::Approx(DecomposeLUP(m).Solve(b), tolerance));
+	}
+	SECTION("Inverse") {
+		const auto inverse = compact.Inverse();
+		REQUIRE(m * inverse == test_util::Approx(Mat(Identity()), tolerance));
+	}
+}
+
+
+TEMPLATE_LIST_TEST_CASE("LU decomposition: compact", "[LU]",
+						decltype(MatrixCaseList<ScalarsFloatingAndComplex, OrdersAll, LayoutsAll, PackingsAll>{})) {
+	SECTION("6x6") {
+		TestCompactLU<typename TestType::template Matrix<6, 6>>();
+	}
+	SECTION("17x17") {
+		TestCompactLU<typename TestType::template Matrix<17, 17>>();
+	}
+	SECTION("32x32") {
+		TestCompactLU<typename TestType::template Matrix<32, 32>>();
+	}
+}
+
+
+TEMPLATE_LIST_TEST_CASE("LU decomposition: compact zero matrix", "[LU]",
+						decltype(MatrixCaseList<ScalarsFloatingAndComplex, OrdersAll, LayoutsAll, PackingsAll>{})) {
+	using Mat = typename TestType::template Matrix<3, 3>;
+
+	const Mat m = Zero();
+	const auto compact = DecomposeLUPCompact(m);
+
+	REQUIRE(compact.pivots == decltype(compact.pivots){ 0, 1, 2 });
+	REQUIRE(NormPrecise(compact.ExtractU()) == 0);
+}
@@ -335,6 +335,92 @@ TEMPLATE_LIST_TEST_CASE("QR decomposition: solve least squares problem", "[QR]",
 }
 
 
+template <class Mat>
+static Mat MakeWellConditioned() {
+	using Scalar = scalar_type_t<Mat>;
+	using Real = remove_complex_t<Scalar>;
+
+	Mat m;
+	for (int i = 0; i < row_count_v<Mat>; ++i) {
+		for (int j = 0; j < column_count_v<Mat>; ++j) {
+			const auto re = Real(std::sin(1.3 * i + 0.7 * j + 0.1)) + (i == j ? Real(2) : Real(0));
+			if constexpr (is_complex_v<Scalar>) {
+				m(i, j) = Scalar(re, Real(std::cos(0.9 * i - 1.1 * j)));
+			}
+			else {
+				m(i, j) = re;
+			}
+		}
+	}
+	return m;
+}
+
+
+template <class Mat>
+static void TestCompactQR() {
+	using Scalar = scalar_type_t<Mat>;
+	using Real = remove_complex_t<Scalar>;
+	constexpr auto tolerance = Real(100) * std::numeric_limits<Real>::epsilon();
+
+	const auto m = MakeWellConditioned<Mat>();
+	const auto compact = DecomposeQRCompact(m);
+
+	SECTION("Extract factors") {
+		const auto Q = compact.ExtractQ();
+		const auto R = compact.ExtractR();
+		VerifyUnitary(Q, tolerance);
+		REQUIRE(Q * R == test_util::Approx(m, tolerance));
+		REQUIRE(NormPrecise(ZeroUpperTriangle(R)) == 0);
+	}
+	SECTION("Solve") {
+		Matrix<Scalar, row_count_v<Mat>, 2, eMatrixOrder::PRECEDE_VECTOR, layout_v<Mat>, is_packed_v<Mat>> b;
+		for (int i = 0; i < row_count_v<Mat>; ++i) {
+			b(i, 0) = Scalar(Real(i % 5) - Real(2));
+			b(i, 1) = Scalar(Real(1) / Real(i + 1));
+		}
+		const auto x = compact.Solve(b);
+		const auto xRef = DecomposeQR(m).Solve(b);
+		REQUIRE(x == test_util::Approx(xRef, tolerance));
+
+		const auto xv = compact.Solve(b.Column(0));
+		REQUIRE(xv == test_util::Approx(xRef.Column(0), tolerance));
+	}
+	SECTION("Inverse") {
+		const auto inverse = compact.Inverse();
+		VerifyPseudoinverse(m, inverse, tolerance);
+	}
+}
+
+
+TEMPLATE_LIST_TEST_CASE("QR decomposition: compact", "[QR]",
+						decltype(MatrixCaseList<ScalarsFloatingAndComplex, OrdersPrecede, LayoutsAll, PackingsAll>{})) {
+	SECTION("3x3") {
+		TestCompactQR<typename TestType::template Matrix<3, 3>>();
+	}
+	SECTION("8x8") {
+		TestCompactQR<typename TestType::template Matrix<8, 8>>();
+	}
+	SECTION("17x17") {
+		TestCompactQR<typename TestType::template Matrix<17, 17>>();
+	}
+	SECTION("20x13") {
+		TestCompactQR<typename TestType::template Matrix<20, 13>>();
+	}
+}
+
+
+TEMPLATE_LIST_TEST_CASE("QR decomposition: compact zero matrix", "[QR]",
+						decltype(MatrixCaseList<ScalarsFloating, OrdersPrecede, LayoutsAll, PackingsAll>{})) {
+	using Mat = typename TestType::template Matrix<10, 9>;
+
+	const Mat m = Zero();
+	const auto compact = DecomposeQRCompact(m);
+
+	VerifyUnitary(compact.ExtractQ(), 1e-6f);
+	REQUIRE(Max(Abs(compact.ExtractR())) == 0);
+}
+
+
 TEMPLATE_LIST_TEST_CASE("QR decomposition: QR/LQ selection", "[QR]",
 						decltype(MatrixCaseList<ScalarsFloating, OrdersAll, LayoutsAll, PackingsAll>{})) {
 	SECTION("Rectangular") {
@@ -0,0 +1,105 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#pragma warning(disable : 4244)
+
+#include "../Approx.hpp"
+#include "../Cases.hpp"
+
+#include <Mathter/Geometry/AABB.hpp>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+
+using namespace mathter;
+using namespace test_util;
+
+
+TEMPLATE_LIST_TEST_CASE("AABB: Constructor", "[AABB]",
+						decltype(ScalarCaseList<ScalarsFloating>{})) {
+	using Scalar = typename TestType::Scalar;
+	using Vec = Vector<Scalar, 3>;
+
+	const AABB<Scalar, 3> box(Vec(1, 2, 3), Vec(4, 6, 8));
+	REQUIRE(box.minimum == Vec(1, 2, 3));
+	REQUIRE(box.maximum == Vec(4, 6, 8));
+	REQUIRE(!box.IsEmpty());
+	REQUIRE(box.Center() == test_util::Approx(Vec(2.5, 4, 5.5)));
+	REQUIRE(box.Size() == test_util::Approx(Vec(3, 4, 5)));
+}
+
+
+TEMPLATE_LIST_TEST_CASE("AABB: converting ctor", "[AABB]",
+						decltype(BinaryCaseList<ScalarCaseList<ScalarsFloating>,
+												ScalarCaseList<ScalarsFloating>>{})) {
+	using ScalarLhs = typename TestType::Lhs::Scalar;
+	using ScalarRhs = typename TestType::Rhs::Scalar;
+
+	const AABB<ScalarLhs, 2> box(Vector<ScalarLhs, 2>(1, 2), Vector<ScalarLhs, 2>(3, 4));
+	const AABB<ScalarRhs, 2> converted(box);
+	REQUIRE(converted.minimum == Vector<ScalarRhs, 2>(1, 2));
+	REQUIRE(converted.maximum == Vector<ScalarRhs, 2>(3, 4));
+}
+
+
+TEMPLATE_LIST_TEST_CASE("AABB: Empty", "[AABB]",
+						decltype(ScalarCaseList<ScalarsFloating>{})) {
+	using Scalar = typename TestType::Scalar;
+	using Vec = Vector<Scalar, 3>;
+
+	auto box = AABB<Scalar, 3>::Empty();
+	REQUIRE(box.IsEmpty());
+	REQUIRE(!box.Contains(Vec(0, 0, 0)));
+
+	box.Expand(Vec(1, 2, 3));
+	REQUIRE(!box.IsEmpty());
+	REQUIRE(box.minimum == Vec(1, 2, 3));
+	REQUIRE(box.maximum == Vec(1, 2, 3));
+	REQUIRE(box.Contains(Vec(1, 2, 3)));
+}
+
+
+TEMPLATE_LIST_TEST_CASE("AABB: Expand", "[AABB]",
+						decltype(ScalarCaseList<ScalarsFloating>{})) {
+	using Scalar = typename TestType::Scalar;
+	using Vec = Vector<Scalar, 3>;
+
+	AABB<Scalar, 3> box(Vec(0, 0, 0), Vec(1, 1, 1));
+
+	SECTION("Point") {
+		box.Expand(Vec(-1, 0.5, 3));
+		REQUIRE(box.minimum == Vec(-1, 0, 0));
+		REQUIRE(box.maximum == Vec(1, 1, 3));
+	}
+	SECTION("Box") {
+		box.Expand(AABB<Scalar, 3>(Vec(0.5, -2, 0.5), Vec(0.7, 0.5, 4)));
+		REQUIRE(box.minimum == Vec(0, -2, 0));
+		REQUIRE(box.maximum == Vec(1, 1, 4));
+	}
+	SECTION("Union") {
+		const auto united = Union(box, AABB<Scalar, 3>(Vec(2, 2, 2), Vec(3, 3, 3)));
+		REQUIRE(united.minimum == Vec(0, 0, 0));
+		REQUIRE(united.maximum == Vec(3, 3, 3));
+	}
+	SECTION("Union with empty") {
+		const auto united = Union(box, AABB<Scalar, 3>::Empty());
+		REQUIRE(united.minimum == box.minimum);
+		REQUIRE(united.maximum == box.maximum);
+	}
+}
+
+
+TEMPLATE_LIST_TEST_CASE("AABB: Contains", "[AABB]",
+						decltype(ScalarCaseList<ScalarsFloating>{})) {
+	using Scalar = typename TestType::Scalar;
+	using Vec = Vector<Scalar, 2>;
+
+	const AABB<Scalar, 2> box(Vec(0, 0), Vec(2, 1));
+	REQUIRE(box.Contains(Vec(1, 0.5)));
+	REQUIRE(box.Contains(Vec(2, 1)));
+	REQUIRE(box.Contains(Vec(0, 0.5)));
+	REQUIRE(!box.Contains(Vec(-0.1, 0.5)));
+	REQUIRE(!box.Contains(Vec(1, 1.1)));
+}
@@ -0,0 +1,203 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#pragma warning(disable : 4244)
+
+#include "../Cases.hpp"
+
+#include <Mathter/Geometry/Bvh.hpp>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+using namespace mathter;
+using namespace test_util;
+
+
+namespace {
+
+template <class T>
+Ray<T, 3> RayThrough(const Vector<T, 3>& base, const Vector<T, 3>& target) {
+	return Ray<T, 3>(base, NormalizePrecise(target - base));
+}
+
+
+template <class T>
+class TriangleSoup {
+public:
+	T Next() {
+		m_state = m_state * 1103515245u + 12345u;
+		return T((m_state >> 8) % 20001u) / T(1000) - T(10);
+	}
+
+	Vector<T, 3> NextPoint() {
+		const T x = Next();
+		const T y = Next();
+		const T z = Next();
+		return { x, y, z };
+	}
+
+	std::vector<Triangle<T, 3>> Triangles(size_t count) {
+		std::vector<Triangle<T, 3>> triangles;
+		for (size_t i = 0; i < count; ++i) {
+			const auto center = NextPoint();
+			const auto a = center + NextPoint() / T(10);
+			const auto b = center + NextPoint() / T(10);
+			const auto c = center + NextPoint() / T(10);
+			triangles.emplace_back(a, b, c);
+		}
+		return triangles;
+	}
+
+	Ray<T, 3> NextRay() {
+		const auto base = NextPoint() * T(2);
+		const auto target = NextPoint() / T(2);
+		return RayThrough(base, target);
+	}
+
+private:
+	uint32_t m_state = 2463534242u;
+};
+
+
+template <class T>
+std::optional<std::pair<size_t, T>> BruteForceClosest(const std::vector<Triangle<T, 3>>& triangles, const Ray<T, 3>& ray) {
+	std::optional<std::pair<size_t, T>> closest;
+	for (size_t i = 0; i < triangles.size(); ++i) {
+		if (const auto point = Intersect(ray, triangles[i])) {
+			const T distance = Dot(*point - ray.Base(), ray.Direction());
+			if (!closest || distance < closest->second) {
+				closest = { i, distance };
+			}
+		}
+	}
+	return closest;
+}
+
+} // namespace
+
+
+TEMPLATE_LIST_TEST_CASE("Bvh - Empty", "[Bvh]", decltype(ScalarCaseList<ScalarsFloating>{})) {
+	using Scalar = typename TestType::Scalar;
+	using Vec = Vector<Scalar, 3>;
+
+	const Bvh<Scalar> bvh;
+	const auto ray = RayThrough(Vec(0, 0, -1), Vec(0, 0, 1));
+	REQUIRE(bvh.Empty());
+	REQUIRE(!bvh.ClosestHit(ray));
+	REQUIRE(!bvh.AnyHit(ray));
+}
+
+
+TEMPLATE_LIST_TEST_CASE("Bvh - Single triangle", "[Bvh]", decltype(ScalarCaseList<ScalarsFloating>{})) {
+	using Scalar = typename TestType::Scalar;
+	using Vec = Vector<Scalar, 3>;
+
+	const std::vector<Triangle<Scalar, 3>> triangles = {
+		{ Vec(-1, -1, 2), Vec(1, -1, 2), Vec(0, 1, 2) },
+	};
+	const Bvh<Scalar> bvh(triangles);
+	REQUIRE(bvh.Size() == 1);
+
+	SECTION("Hit") {
+		const auto ray = RayThrough(Vec(0, 0, 0), Vec(0, 0, 1));
+		const auto hit = bvh.ClosestHit(ray);
+		REQUIRE(hit);
+		REQUIRE(hit->triangle == 0);
+		REQUIRE(hit->distance == Catch::Approx(2));
+		REQUIRE(bvh.AnyHit(ray));
+	}
+	SECTION("Miss") {
+		const auto ray = RayThrough(Vec(0, 0, 0), Vec(0, 0, -1));
+		REQUIRE(!bvh.ClosestHit(ray));
+		REQUIRE(!bvh.AnyHit(ray));
+	}
+	SECTION("Beyond max distance") {
+		const auto ray = RayThrough(Vec(0, 0, 0), Vec(0, 0, 1));
+		REQUIRE(!bvh.ClosestHit(ray, Scalar(1.5)));
+		REQUIRE(!bvh.AnyHit(ray, Scalar(1.5)));
+	}
+	SECTION("Axis-aligned ray on the bounds") {
+		// The ray lies in the plane of the bounding box's face, and is parallel to two of the slabs.
+		const auto ray = RayThrough(Vec(-1, 0, 2), Vec(1, 0, 2));
+		REQUIRE(!bvh.ClosestHit(ray));
+	}
+}
+
+
+TEMPLATE_LIST_TEST_CASE("Bvh - Matches brute force", "[Bvh]", decltype(ScalarCaseList<ScalarsFloating>{})) {
+	using Scalar = typename TestType::Scalar;
+
+	TriangleSoup<Scalar> soup;
+	const auto triangles = soup.Triangles(2000);
+	const unsigned threads = GENERATE(1u, 4u);
+	const Bvh<Scalar> bvh(triangles, threads);
+	REQUIRE(bvh.Size() == triangles.size());
+
+	size_t hits = 0;
+	for (int i = 0; i < 500; ++i) {
+		const auto ray = soup.NextRay();
+		const auto expected = BruteForceClosest(triangles, ray);
+		const auto hit = bvh.ClosestHit(ray);
+		REQUIRE(hit.has_value() == expected.has_value());
+		REQUIRE(bvh.AnyHit(ray) == expected.has_value());
+		if (expected) {
+			++hits;
+			REQUIRE(hit->distance == Catch::Approx(expected->second));
+			REQUIRE(Dot(hit->point - ray.Base(), ray.Direction()) == Catch::Approx(hit->distance));
+			REQUIRE(bvh.AnyHit(ray, expected->second * Scalar(1.01)));
+			REQUIRE(!bvh.AnyHit(ray, expected->second * Scalar(0.99)));
+		}
+	}
+	REQUIRE(hits > 50);
+}
+
+
+TEMPLATE_LIST_TEST_CASE("Bvh - Parallel build", "[Bvh]", decltype(ScalarCaseList<ScalarsFloating>{})) {
+	using Scalar = typename TestType::Scalar;
+
+	TriangleSoup<Scalar> soup;
+	const auto triangles = soup.Triangles(20000);
+	const Bvh<Scalar> serial(triangles, 1);
+	const Bvh<Scalar> parallel(triangles, 4);
+
+	// The partitioning is deterministic, so the threads must produce the same tree.
+	REQUIRE(serial.Nodes().size() == parallel.Nodes().size());
+	for (size_t i = 0; i < serial.Nodes().size(); ++i) {
+		REQUIRE(serial.Nodes()[i].offset == parallel.Nodes()[i].offset);
+		REQUIRE(serial.Nodes()[i].count == parallel.Nodes()[i].count);
+	}
+
+	for (int i = 0; i < 200; ++i) {
+		const auto ray = soup.NextRay();
+		const auto expected = serial.ClosestHit(ray);
+		const auto hit = parallel.ClosestHit(ray);
+		REQUIRE(hit.has_value() == expected.has_value());
+		if (expected) {
+			REQUIRE(hit->triangle == expected->triangle);
+		}
+	}
+}
+
+
+TEMPLATE_LIST_TEST_CASE("Bvh - Coincident triangles", "[Bvh]", decltype(ScalarCaseList<ScalarsFloating>{})) {
+	using Scalar = typename TestType::Scalar;
+	using Vec = Vector<Scalar, 3>;
+
+	// The centroids are all the same, so the heuristic can't separate them.
+	const std::vector<Triangle<Scalar, 3>> triangles(100, Triangle<Scalar, 3>{ Vec(-1, -1, 2), Vec(1, -1, 2), Vec(0, 1, 2) });
+	const Bvh<Scalar> bvh(triangles);
+	for (const auto& node : bvh.Nodes()) {
+		REQUIRE((!node.IsLeaf() || node.count <= 16));
+	}
+
+	const auto hit = bvh.ClosestHit(RayThrough(Vec(0, 0, 0), Vec(0, 0, 1)));
+	REQUIRE(hit);
+	REQUIRE(hit->distance == Catch::Approx(2));
+}
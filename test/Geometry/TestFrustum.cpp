@@ -0,0 +1,220 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#pragma warning(disable : 4244)
+
+#include "../ApplyTransform.hpp"
+#include "../Cases.hpp"
+
+#include <Mathter/Geometry/Frustum.hpp>
+#include <Mathter/Matrix.hpp>
+#include <Mathter/Transforms.hpp>
+
+#include <catch2/catch_template_test_macros.hpp>
+
+#include <cstdint>
+#include <vector>
+
+using namespace mathter;
+using namespace test_util;
+
+
+namespace {
+
+template <class T>
+class RandomObjects {
+public:
+	T Next() {
+		m_state = m_state * 1103515245u + 12345u;
+		return T((m_state >> 8) % 20001u) / T(1000) - T(10);
+	}
+
+	Vector<T, 3> NextPoint() {
+		const T x = Next();
+		const T y = Next();
+		const T z = Next();
+		return { x, y, z };
+	}
+
+	AABB<T, 3> NextBox() {
+		const auto center = NextPoint();
+		const auto halfSize = Abs(NextPoint()) / T(8);
+		return { center - halfSize, center + halfSize };
+	}
+
+	Sphere<T, 3> NextSphere() {
+		return { NextPoint(), std::abs(Next()) / T(8) };
+	}
+
+private:
+	uint32_t m_state = 2463534242u;
+};
+
+
+template <eMatrixOrder Order, class T>
+Matrix<T, 4, 4, Order, eMatrixLayout::ROW_MAJOR, false> MakeViewProjection(const Vector<T, 3>& eye, T projNearPlane, T projFarPlane) {
+	using Mat = Matrix<T, 4, 4, Order, eMatrixLayout::ROW_MAJOR, false>;
+	const Mat view = LookAt(eye, Vector<T, 3>(0, 0, 0), Vector<T, 3>(0, 0, 1), true, false, false);
+	const Mat projection = Perspective(T(1.2), T(1.5), T(0.5), T(12), projNearPlane, projFarPlane);
+	return Order == eMatrixOrder::PRECEDE_VECTOR ? projection * view : view * projection;
+}
+
+
+// Tests the point in clip space. Returns 0 for points too close to the boundary to tell.
+template <class Mat, class T>
+int ClipSpaceContains(const Mat& viewProjection, const Vector<T, 3>& point, T projNearPlane, T projFarPlane) {
+	const Vector<T, 4> clip = ApplyTransform(viewProjection, Vector<T, 4>(point, T(1)));
+	const T w = clip[3];
+	const T margin = T(1e-3) * std::abs(w);
+	const T lower = std::min(projNearPlane, projFarPlane);
+	const T upper = std::max(projNearPlane, projFarPlane);
+	const std::array<T, 6> distances = { w + clip[0], w - clip[0], w + clip[1], w - clip[1], clip[2] - lower * w, upper * w - clip[2] };
+	if (w <= T(0)) {
+		return -1;
+	}
+	for (const auto& distance : distances) {
+		if (std::abs(distance) < margin) {
+			return 0;
+		}
+	}
+	return std::all_of(distances.begin(), distances.end(), [](T distance) { return distance > 0; }) ? 1 : -1;
+}
+
+
+template <class T>
+std::vector<Vector<T, 3>> Corners(const AABB<T, 3>& box) {
+	std::vector<Vector<T, 3>> corners;
+	for (int i = 0; i < 8; ++i) {
+		corners.emplace_back(i & 1 ? box.maximum[0] : box.minimum[0],
+							 i & 2 ? box.maximum[1] : box.minimum[1],
+							 i & 4 ? box.maximum[2] : box.minimum[2]);
+	}
+	return corners;
+}
+
+} // namespace
+
+
+TEMPLATE_LIST_TEST_CASE("Frustum: extract from matrix", "[Frustum]",
+						decltype(ScalarCaseList<ScalarsFloating>{})) {
+	using Scalar = typename TestType::Scalar;
+	using Vec = Vector<Scalar, 3>;
+
+	const Vec eye(4, -6, 3);
+	const auto [projNearPlane, projFarPlane] = GENERATE(std::pair{ Scalar(0), Scalar(1) }, std::pair{ Scalar(1), Scalar(0) }, std::pair{ Scalar(-1), Scalar(1) });
+
+	const auto precede = MakeViewProjection<eMatrixOrder::PRECEDE_VECTOR>(eye, projNearPlane, projFarPlane);
+	const auto follow = MakeViewProjection<eMatrixOrder::FOLLOW_VECTOR>(eye, projNearPlane, projFarPlane);
+	const Frustum<Scalar> frustum(precede, projNearPlane, projFarPlane);
+	const Frustum<Scalar> frustumFollow(follow, projNearPlane, projFarPlane);
+
+	RandomObjects<Scalar> objects;
+	int insideCount = 0;
+	for (int i = 0; i < 2000; ++i) {
+		const auto point = objects.NextPoint();
+		const int expected = ClipSpaceContains(precede, point, projNearPlane, projFarPlane);
+		if (expected != 0) {
+			REQUIRE(frustum.Contains(point) == (expected > 0));
+			REQUIRE(frustumFollow.Contains(point) == (expected > 0));
+			insideCount += expected > 0;
+		}
+	}
+	REQUIRE(insideCount > 50);
+
+	// The camera looks at the origin, so that's inside, and the camera is behind the near plane.
+	REQUIRE(frustum.Contains(Vec(0, 0, 0)));
+	REQUIRE(!frustum.Contains(eye));
+}
+
+
+TEMPLATE_LIST_TEST_CASE("Frustum: classify objects", "[Frustum]",
+						decltype(ScalarCaseList<ScalarsFloating>{})) {
+	using Scalar = typename TestType::Scalar;
+	using Vec = Vector<Scalar, 3>;
+
+	const Frustum<Scalar> frustum(MakeViewProjection<eMatrixOrder::PRECEDE_VECTOR>(Vec(4, -6, 3), Scalar(0), Scalar(1)));
+
+	RandomObjects<Scalar> objects;
+	std::array<int, 3> counts = {};
+	for (int i = 0; i < 2000; ++i) {
+		const auto box = objects.NextBox();
+		const auto classification = frustum.Classify(box);
+		const auto corners = Corners(box);
+		const int cornersInside = int(std::count_if(corners.begin(), corners.end(), [&](const Vec& corner) { return frustum.Contains(corner); }));
+		if (classification == eClassification::INSIDE) {
+			REQUIRE(cornersInside == 8);
+		}
+		if (classification == eClassification::OUTSIDE) {
+			REQUIRE(cornersInside == 0);
+			REQUIRE(!frustum.Contains(box.Center()));
+		}
+		if (cornersInside == 8) {
+			REQUIRE(classification == eClassification::INSIDE);
+		}
+		++counts[int(classification)];
+
+		const auto sphere = objects.NextSphere();
+		const auto sphereClassification = frustum.Classify(sphere);
+		if (sphereClassification == eClassification::OUTSIDE) {
+			REQUIRE(!frustum.Contains(sphere.center));
+		}
+		if (sphereClassification == eClassification::INSIDE) {
+			REQUIRE(frustum.Contains(sphere.center + Vec(sphere.radius, 0, 0)));
+			REQUIRE(frustum.Contains(sphere.center - Vec(0, 0, sphere.radius)));
+		}
+	}
+	REQUIRE(counts[0] > 50);
+	REQUIRE(counts[1] > 10);
+	REQUIRE(counts[2] > 10);
+}
+
+
+TEMPLATE_LIST_TEST_CASE("Frustum: classify arrays", "[Frustum]",
+						decltype(ScalarCaseList<ScalarsFloating>{})) {
+	using Scalar = typename TestType::Scalar;
+	using Vec = Vector<Scalar, 3>;
+
+	RandomObjects<Scalar> objects;
+	const size_t count = GENERATE(size_t(0), size_t(1), size_t(203));
+
+	std::vector<AABB<Scalar, 3>> boxes;
+	std::vector<Sphere<Scalar, 3>> spheres;
+	VectorArray<Scalar, 3> minima(count), maxima(count), centers(count);
+	VectorArray<Scalar, 1> radii(count);
+	for (size_t i = 0; i < count; ++i) {
+		boxes.push_back(objects.NextBox());
+		spheres.push_back(objects.NextSphere());
+		minima.Scatter(i, boxes[i].minimum);
+		maxima.Scatter(i, boxes[i].maximum);
+		centers.Scatter(i, spheres[i].center);
+		radii.Scatter(i, Vector<Scalar, 1>(spheres[i].radius));
+	}
+
+	std::vector<uint8_t> boxCache;
+	std::vector<uint8_t> sphereCache;
+	for (int frame = 0; frame < 10; ++frame) {
+		// The camera moves a little each frame, so the cached planes are mostly right but not always.
+		const Vec eye(4 + Scalar(0.3) * frame, -6 + Scalar(0.2) * frame, 3);
+		const Frustum<Scalar> frustum(MakeViewProjection<eMatrixOrder::PRECEDE_VECTOR>(eye, Scalar(0), Scalar(1)));
+
+		const auto boxClasses = frustum.Classify(minima, maxima);
+		const auto cachedBoxClasses = frustum.Classify(minima, maxima, boxCache);
+		const auto sphereClasses = frustum.Classify(centers, radii);
+		const auto cachedSphereClasses = frustum.Classify(centers, radii, sphereCache);
+		REQUIRE(boxClasses.size() == count);
+		REQUIRE(boxCache.size() == count);
+
+		for (size_t i = 0; i < count; ++i) {
+			REQUIRE(boxClasses[i] == frustum.Classify(boxes[i]));
+			REQUIRE(cachedBoxClasses[i] == boxClasses[i]);
+			REQUIRE(sphereClasses[i] == frustum.Classify(spheres[i]));
+			REQUIRE(cachedSphereClasses[i] == sphereClasses[i]);
+			if (boxClasses[i] == eClassification::OUTSIDE) {
+				const auto& plane = frustum.planes[boxCache[i]];
+				REQUIRE(plane.Distance(boxes[i].Center()) < 0);
+			}
+		}
+	}
+}
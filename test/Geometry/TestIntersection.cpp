@@ -285,4 +285,72 @@ TEMPLATE_LIST_TEST_CASE("Intersection: ray<3> - triangle<3>", "[Intersection]",
 		REQUIRE(intersection == Intersect(triangle, ray));
 		REQUIRE(!intersection.has_value());
 	}
-}
\ No newline at end of file
+}
+
+
+TEMPLATE_LIST_TEST_CASE("Intersection: ray - box", "[Intersection]",
+						decltype(BinaryCaseList<ScalarCaseList<ScalarsFloating>,
+												ScalarCaseList<ScalarsFloating>>{})) {
+	using S1 = typename TestType::Lhs::Scalar;
+	using S2 = typename TestType::Rhs::Scalar;
+	using VecR = Vector<S1, 3>;
+	using VecB = Vector<S2, 3>;
+
+	const AABB<S2, 3> box(VecB(1, -1, -1), VecB(3, 1, 1));
+
+	SECTION("Hit") {
+		const Ray<S1, 3> ray(VecR(0, 0.5, 0), Normalize(VecR(1, 0, 0.1)));
+		const auto intersection = Intersect(ray, box);
+		REQUIRE(intersection == Intersect(box, ray));
+		REQUIRE(intersection.has_value());
+		REQUIRE(intersection.value() == test_util::Approx(VecB(1, 0.5, 0.1), 1e-6f));
+	}
+	SECTION("Inside") {
+		const Ray<S1, 3> ray(VecR(2, 0, 0), VecR(0, 0, 1));
+		const auto intersection = Intersect(ray, box);
+		REQUIRE(intersection.has_value());
+		REQUIRE(intersection.value() == test_util::Approx(VecB(2, 0, 0), 1e-6f));
+	}
+	SECTION("Miss") {
+		const Ray<S1, 3> ray(VecR(0, 0, 0), Normalize(VecR(1, 2, 0)));
+		REQUIRE(!Intersect(ray, box).has_value());
+	}
+	SECTION("Behind") {
+		const Ray<S1, 3> ray(VecR(4, 0, 0), VecR(1, 0, 0));
+		REQUIRE(!Intersect(ray, box).has_value());
+	}
+}
+
+
+TEMPLATE_LIST_TEST_CASE("Intersection: ray - sphere", "[Intersection]",
+						decltype(BinaryCaseList<ScalarCaseList<ScalarsFloating>,
+												ScalarCaseList<ScalarsFloating>>{})) {
+	using S1 = typename TestType::Lhs::Scalar;
+	using S2 = typename TestType::Rhs::Scalar;
+	using VecR = Vector<S1, 3>;
+	using VecS = Vector<S2, 3>;
+
+	const Sphere<S2, 3> sphere(VecS(3, 0, 0), 1);
+
+	SECTION("Hit") {
+		const Ray<S1, 3> ray(VecR(0, 0, 0), VecR(1, 0, 0));
+		const auto intersection = Intersect(ray, sphere);
+		REQUIRE(intersection == Intersect(sphere, ray));
+		REQUIRE(intersection.has_value());
+		REQUIRE(intersection.value() == test_util::Approx(VecS(2, 0, 0), 1e-6f));
+	}
+	SECTION("Inside") {
+		const Ray<S1, 3> ray(VecR(3, 0.5, 0), VecR(0, 1, 0));
+		const auto intersection = Intersect(ray, sphere);
+		REQUIRE(intersection.has_value());
+		REQUIRE(intersection.value() == test_util::Approx(VecS(3, 0.5, 0), 1e-6f));
+	}
+	SECTION("Miss") {
+		const Ray<S1, 3> ray(VecR(0, 0, 0), Normalize(VecR(1, 1, 0)));
+		REQUIRE(!Intersect(ray, sphere).has_value());
+	}
+	SECTION("Behind") {
+		const Ray<S1, 3> ray(VecR(0, 0, 0), VecR(-1, 0, 0));
+		REQUIRE(!Intersect(ray, sphere).has_value());
+	}
+}
@@ -0,0 +1,174 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#pragma warning(disable : 4244)
+
+#include "../Cases.hpp"
+
+#include <Mathter/Geometry/Overlap.hpp>
+
+#include <catch2/catch_template_test_macros.hpp>
+
+#include <cstdint>
+#include <vector>
+
+using namespace mathter;
+using namespace test_util;
+
+
+namespace {
+
+template <class T>
+class RandomVolumes {
+public:
+	T Next() {
+		m_state = m_state * 1103515245u + 12345u;
+		return T((m_state >> 8) % 20001u) / T(1000) - T(10);
+	}
+
+	Vector<T, 3> NextPoint() {
+		const T x = Next();
+		const T y = Next();
+		const T z = Next();
+		return { x, y, z };
+	}
+
+	AABB<T, 3> NextBox() {
+		const auto center = NextPoint();
+		const auto halfSize = Abs(NextPoint()) / T(4);
+		return { center - halfSize, center + halfSize };
+	}
+
+	Sphere<T, 3> NextSphere() {
+		return { NextPoint(), std::abs(Next()) / T(3) };
+	}
+
+	Ray<T, 3> NextRay() {
+		const auto base = NextPoint() * T(2);
+		const auto target = NextPoint() / T(2);
+		return Ray<T, 3>(base, NormalizePrecise(target - base));
+	}
+
+private:
+	uint32_t m_state = 2463534242u;
+};
+
+
+bool Bit(const std::vector<uint64_t>& bits, size_t index) {
+	return (bits[index / 64] >> (index % 64)) & 1u;
+}
+
+} // namespace
+
+
+TEMPLATE_LIST_TEST_CASE("Overlap: box - box", "[Overlap]",
+						decltype(ScalarCaseList<ScalarsFloating>{})) {
+	using Scalar = typename TestType::Scalar;
+	using Vec = Vector<Scalar, 2>;
+
+	const AABB<Scalar, 2> box(Vec(0, 0), Vec(2, 2));
+	REQUIRE(Overlaps(box, AABB<Scalar, 2>(Vec(1, 1), Vec(3, 3))));
+	REQUIRE(Overlaps(box, AABB<Scalar, 2>(Vec(2, 0), Vec(3, 1)))); // Touching.
+	REQUIRE(Overlaps(box, AABB<Scalar, 2>(Vec(0.5, 0.5), Vec(1, 1)))); // Contained.
+	REQUIRE(!Overlaps(box, AABB<Scalar, 2>(Vec(2.1, 0), Vec(3, 1))));
+	REQUIRE(!Overlaps(box, AABB<Scalar, 2>(Vec(0, 2.1), Vec(1, 3))));
+	REQUIRE(!Overlaps(box, AABB<Scalar, 2>::Empty()));
+}
+
+
+TEMPLATE_LIST_TEST_CASE("Overlap: sphere - sphere", "[Overlap]",
+						decltype(ScalarCaseList<ScalarsFloating>{})) {
+	using Scalar = typename TestType::Scalar;
+	using Vec = Vector<Scalar, 3>;
+
+	const Sphere<Scalar, 3> sphere(Vec(0, 0, 0), 1);
+	REQUIRE(Overlaps(sphere, Sphere<Scalar, 3>(Vec(1.5, 0, 0), 1)));
+	REQUIRE(Overlaps(sphere, Sphere<Scalar, 3>(Vec(0, 0, 0.5), 0.1)));
+	REQUIRE(!Overlaps(sphere, Sphere<Scalar, 3>(Vec(2.5, 0, 0), 1)));
+	REQUIRE(!Overlaps(sphere, Sphere<Scalar, 3>::Empty()));
+}
+
+
+TEMPLATE_LIST_TEST_CASE("Overlap: sphere - box", "[Overlap]",
+						decltype(ScalarCaseList<ScalarsFloating>{})) {
+	using Scalar = typename TestType::Scalar;
+	using Vec = Vector<Scalar, 2>;
+
+	const AABB<Scalar, 2> box(Vec(0, 0), Vec(2, 2));
+	REQUIRE(Overlaps(Sphere<Scalar, 2>(Vec(1, 1), 0.1), box)); // Inside.
+	REQUIRE(Overlaps(Sphere<Scalar, 2>(Vec(3, 1), 1.1), box)); // Side.
+	REQUIRE(!Overlaps(Sphere<Scalar, 2>(Vec(3, 1), 0.9), box));
+	REQUIRE(Overlaps(box, Sphere<Scalar, 2>(Vec(3, 3), 1.5))); // Corner.
+	REQUIRE(!Overlaps(box, Sphere<Scalar, 2>(Vec(3, 3), 1.4)));
+	REQUIRE(!Overlaps(box, Sphere<Scalar, 2>::Empty()));
+}
+
+
+TEMPLATE_LIST_TEST_CASE("Overlap: ray - box", "[Overlap]",
+						decltype(ScalarCaseList<ScalarsFloating>{})) {
+	using Scalar = typename TestType::Scalar;
+	using Vec = Vector<Scalar, 3>;
+
+	const AABB<Scalar, 3> box(Vec(1, -1, -1), Vec(3, 1, 1));
+	REQUIRE(Overlaps(Ray<Scalar, 3>(Vec(0, 0, 0), Vec(1, 0, 0)), box));
+	REQUIRE(Overlaps(Ray<Scalar, 3>(Vec(2, 0, 0), Vec(0, 1, 0)), box)); // Starts inside.
+	REQUIRE(!Overlaps(Ray<Scalar, 3>(Vec(0, 0, 0), Vec(-1, 0, 0)), box)); // Points away.
+	REQUIRE(!Overlaps(Ray<Scalar, 3>(Vec(0, 0, 0), Vec(1, 0, 0)), box, Scalar(0.5))); // Too short.
+	REQUIRE(Overlaps(Ray<Scalar, 3>(Vec(0, 1, 0), Vec(1, 0, 0)), box)); // Parallel on the boundary.
+	REQUIRE(!Overlaps(Ray<Scalar, 3>(Vec(0, 1.1, 0), Vec(1, 0, 0)), box)); // Parallel outside.
+}
+
+
+TEMPLATE_LIST_TEST_CASE("Overlap: arrays match single objects", "[Overlap]",
+						decltype(ScalarCaseList<ScalarsFloating>{})) {
+	using Scalar = typename TestType::Scalar;
+
+	RandomVolumes<Scalar> volumes;
+	const size_t count = GENERATE(size_t(0), size_t(1), size_t(64), size_t(203));
+
+	std::vector<AABB<Scalar, 3>> boxes;
+	std::vector<Sphere<Scalar, 3>> spheres;
+	std::vector<Vector<Scalar, 3>> points;
+	VectorArray<Scalar, 3> minima(count), maxima(count), centers(count), pointArray(count);
+	VectorArray<Scalar, 1> radii(count);
+	for (size_t i = 0; i < count; ++i) {
+		boxes.push_back(volumes.NextBox());
+		spheres.push_back(volumes.NextSphere());
+		points.push_back(volumes.NextPoint());
+		minima.Scatter(i, boxes[i].minimum);
+		maxima.Scatter(i, boxes[i].maximum);
+		centers.Scatter(i, spheres[i].center);
+		radii.Scatter(i, Vector<Scalar, 1>(spheres[i].radius));
+		pointArray.Scatter(i, points[i]);
+	}
+
+	for (int rep = 0; rep < 20; ++rep) {
+		const auto box = volumes.NextBox();
+		const auto sphere = volumes.NextSphere();
+		const auto ray = volumes.NextRay();
+		const Scalar maxDistance = rep % 2 == 0 ? std::numeric_limits<Scalar>::infinity() : Scalar(20);
+
+		const auto boxBox = Overlaps(box, minima, maxima);
+		const auto sphereBox = Overlaps(sphere, minima, maxima);
+		const auto sphereSphere = Overlaps(sphere, centers, radii);
+		const auto rayBox = Overlaps(ray, minima, maxima, maxDistance);
+		const auto boxPoint = Contains(box, pointArray);
+		const auto spherePoint = Contains(sphere, pointArray);
+		REQUIRE(boxBox.size() == (count + 63) / 64);
+
+		for (size_t i = 0; i < count; ++i) {
+			REQUIRE(Bit(boxBox, i) == Overlaps(box, boxes[i]));
+			REQUIRE(Bit(sphereBox, i) == Overlaps(sphere, boxes[i]));
+			REQUIRE(Bit(sphereSphere, i) == Overlaps(sphere, spheres[i]));
+			REQUIRE(Bit(rayBox, i) == Overlaps(ray, boxes[i], maxDistance));
+			REQUIRE(Bit(boxPoint, i) == box.Contains(points[i]));
+			REQUIRE(Bit(spherePoint, i) == sphere.Contains(points[i]));
+		}
+		if (count % 64 != 0) {
+			REQUIRE(boxBox.back() >> (count % 64) == 0);
+			REQUIRE(rayBox.back() >> (count % 64) == 0);
+		}
+	}
+}
@@ -0,0 +1,147 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#pragma warning(disable : 4244)
+
+#include "../Approx.hpp"
+#include "../Cases.hpp"
+
+#include <Mathter/Geometry/Intersection.hpp>
+#include <Mathter/Geometry/Packet.hpp>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+
+#include <cstdint>
+#include <limits>
+
+using namespace mathter;
+using namespace test_util;
+
+
+namespace {
+
+template <class T>
+class RandomScene {
+public:
+	T Next() {
+		m_state = m_state * 1103515245u + 12345u;
+		return T((m_state >> 8) % 20001u) / T(10000) - T(1);
+	}
+
+	Vector<T, 3> NextPoint() {
+		const T x = Next();
+		const T y = Next();
+		const T z = Next();
+		return { x, y, z };
+	}
+
+	Triangle<T, 3> NextTriangle() {
+		const auto center = NextPoint() + Vector<T, 3>(0, 0, 4);
+		return { center + NextPoint(), center + NextPoint(), center + NextPoint() };
+	}
+
+	Ray<T, 3> NextRay() {
+		const auto base = NextPoint() / T(4);
+		const auto target = NextPoint() + Vector<T, 3>(0, 0, 4);
+		return Ray<T, 3>(base, NormalizePrecise(target - base));
+	}
+
+private:
+	uint32_t m_state = 2463534242u;
+};
+
+
+template <class T, int Size>
+void RequireHit(const PacketHits<T, Size>& hits, int index, const Ray<T, 3>& ray, const Triangle<T, 3>& triangle) {
+	const auto expected = Intersect(ray, triangle);
+	REQUIRE(hits.Hit(index) == expected.has_value());
+	if (expected) {
+		const T u = hits.u[index];
+		const T v = hits.v[index];
+		const auto point = (T(1) - u - v) * triangle.corners[0] + u * triangle.corners[1] + v * triangle.corners[2];
+		REQUIRE(hits.distance[index] == Catch::Approx(Dot(*expected - ray.Base(), ray.Direction())));
+		REQUIRE(point == test_util::Approx(*expected, T(1e-4)));
+	}
+	else {
+		REQUIRE(hits.distance[index] == std::numeric_limits<T>::infinity());
+	}
+}
+
+} // namespace
+
+
+TEMPLATE_LIST_TEST_CASE("Packet - Rays against triangle", "[Packet]", decltype(ScalarCaseList<ScalarsFloating>{})) {
+	using Scalar = typename TestType::Scalar;
+	constexpr int size = 16;
+
+	RandomScene<Scalar> scene;
+	int hitCount = 0;
+	for (int rep = 0; rep < 200; ++rep) {
+		const auto triangle = scene.NextTriangle();
+		RayPacket<Scalar, size> rays;
+		for (int i = 0; i < size; ++i) {
+			rays.Set(i, scene.NextRay());
+		}
+		const auto hits = Intersect(rays, triangle);
+		for (int i = 0; i < size; ++i) {
+			RequireHit(hits, i, rays.Get(i), triangle);
+		}
+		hitCount += hits.mask != 0;
+	}
+	REQUIRE(hitCount > 20);
+}
+
+
+TEMPLATE_LIST_TEST_CASE("Packet - Ray against triangles", "[Packet]", decltype(ScalarCaseList<ScalarsFloating>{})) {
+	using Scalar = typename TestType::Scalar;
+	constexpr int size = 8;
+
+	RandomScene<Scalar> scene;
+	int hitCount = 0;
+	for (int rep = 0; rep < 200; ++rep) {
+		const auto ray = scene.NextRay();
+		TrianglePacket<Scalar, size> triangles;
+		for (int i = 0; i < size; ++i) {
+			triangles.Set(i, scene.NextTriangle());
+		}
+		const auto hits = Intersect(ray, triangles);
+		for (int i = 0; i < size; ++i) {
+			RequireHit(hits, i, ray, triangles.Get(i));
+		}
+		hitCount += hits.mask != 0;
+	}
+	REQUIRE(hitCount > 20);
+}
+
+
+TEMPLATE_LIST_TEST_CASE("Packet - Partial packet", "[Packet]", decltype(ScalarCaseList<ScalarsFloating>{})) {
+	using Scalar = typename TestType::Scalar;
+	using Vec = Vector<Scalar, 3>;
+	constexpr int size = 5;
+
+	const Triangle<Scalar, 3> triangle(Vec(-1, -1, 2), Vec(1, -1, 2), Vec(0, 1, 2));
+	const Ray<Scalar, 3> ray(Vec(0, 0, 0), Vec(0, 0, 1));
+
+	SECTION("Rays") {
+		RayPacket<Scalar, size> rays;
+		for (int i = 0; i < size; ++i) {
+			rays.Set(i, ray);
+		}
+		const auto hits = Intersect(rays, triangle);
+		REQUIRE(hits.mask == 0b11111);
+		REQUIRE(hits.distance[4] == Catch::Approx(2));
+	}
+	SECTION("Triangles") {
+		TrianglePacket<Scalar, size> triangles;
+		triangles.Set(1, triangle);
+		triangles.Set(3, triangle);
+		const auto hits = Intersect(ray, triangles);
+		REQUIRE(hits.mask == 0b01010);
+		REQUIRE(hits.distance[3] == Catch::Approx(2));
+		REQUIRE(hits.u[3] == Catch::Approx(0.25));
+		REQUIRE(hits.v[3] == Catch::Approx(0.5));
+	}
+}
@@ -0,0 +1,102 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#pragma warning(disable : 4244)
+
+#include "../Approx.hpp"
+#include "../Cases.hpp"
+
+#include <Mathter/Geometry/Sphere.hpp>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+
+using namespace mathter;
+using namespace test_util;
+
+
+TEMPLATE_LIST_TEST_CASE("Sphere: Constructor", "[Sphere]",
+						decltype(ScalarCaseList<ScalarsFloating>{})) {
+	using Scalar = typename TestType::Scalar;
+	using Vec = Vector<Scalar, 3>;
+
+	const Sphere<Scalar, 3> sphere(Vec(1, 2, 3), 2);
+	REQUIRE(sphere.center == Vec(1, 2, 3));
+	REQUIRE(sphere.radius == 2);
+	REQUIRE(!sphere.IsEmpty());
+
+	const auto bounds = sphere.Bounds();
+	REQUIRE(bounds.minimum == test_util::Approx(Vec(-1, 0, 1)));
+	REQUIRE(bounds.maximum == test_util::Approx(Vec(3, 4, 5)));
+}
+
+
+TEMPLATE_LIST_TEST_CASE("Sphere: converting ctor", "[Sphere]",
+						decltype(BinaryCaseList<ScalarCaseList<ScalarsFloating>,
+												ScalarCaseList<ScalarsFloating>>{})) {
+	using ScalarLhs = typename TestType::Lhs::Scalar;
+	using ScalarRhs = typename TestType::Rhs::Scalar;
+
+	const Sphere<ScalarLhs, 2> sphere(Vector<ScalarLhs, 2>(1, 2), 3);
+	const Sphere<ScalarRhs, 2> converted(sphere);
+	REQUIRE(converted.center == Vector<ScalarRhs, 2>(1, 2));
+	REQUIRE(converted.radius == ScalarRhs(3));
+}
+
+
+TEMPLATE_LIST_TEST_CASE("Sphere: Expand", "[Sphere]",
+						decltype(ScalarCaseList<ScalarsFloating>{})) {
+	using Scalar = typename TestType::Scalar;
+	using Vec = Vector<Scalar, 3>;
+
+	Sphere<Scalar, 3> sphere(Vec(0, 0, 0), 1);
+
+	SECTION("Empty") {
+		auto empty = Sphere<Scalar, 3>::Empty();
+		REQUIRE(empty.IsEmpty());
+		REQUIRE(!empty.Contains(Vec(0, 0, 0)));
+		empty.Expand(Vec(1, 2, 3));
+		REQUIRE(empty.center == Vec(1, 2, 3));
+		REQUIRE(empty.radius == 0);
+	}
+	SECTION("Point inside") {
+		sphere.Expand(Vec(0.5, 0, 0));
+		REQUIRE(sphere.center == Vec(0, 0, 0));
+		REQUIRE(sphere.radius == 1);
+	}
+	SECTION("Point outside") {
+		sphere.Expand(Vec(3, 0, 0));
+		REQUIRE(sphere.center == test_util::Approx(Vec(1, 0, 0)));
+		REQUIRE(sphere.radius == Catch::Approx(2));
+	}
+	SECTION("Union") {
+		const auto united = Union(sphere, Sphere<Scalar, 3>(Vec(0, 4, 0), 1));
+		REQUIRE(united.center == test_util::Approx(Vec(0, 2, 0)));
+		REQUIRE(united.radius == Catch::Approx(3));
+	}
+	SECTION("Union containing") {
+		const Sphere<Scalar, 3> large(Vec(0.5, 0, 0), 3);
+		REQUIRE(Union(sphere, large).center == large.center);
+		REQUIRE(Union(large, sphere).radius == large.radius);
+	}
+	SECTION("Union with empty") {
+		const auto united = Union(Sphere<Scalar, 3>::Empty(), sphere);
+		REQUIRE(united.center == sphere.center);
+		REQUIRE(united.radius == sphere.radius);
+	}
+}
+
+
+TEMPLATE_LIST_TEST_CASE("Sphere: Contains", "[Sphere]",
+						decltype(ScalarCaseList<ScalarsFloating>{})) {
+	using Scalar = typename TestType::Scalar;
+	using Vec = Vector<Scalar, 2>;
+
+	const Sphere<Scalar, 2> sphere(Vec(1, 1), 2);
+	REQUIRE(sphere.Contains(Vec(1, 1)));
+	REQUIRE(sphere.Contains(Vec(3, 1)));
+	REQUIRE(sphere.Contains(Vec(2, 2)));
+	REQUIRE(!sphere.Contains(Vec(3, 3)));
+}
@@ -0,0 +1,118 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#pragma warning(disable : 4244)
+
+#include "../ApplyTransform.hpp"
+#include "../Approx.hpp"
+#include "../Cases.hpp"
+
+#include <Mathter/Matrix/Affine.hpp>
+#include <Mathter/Transforms.hpp>
+
+#include <catch2/catch_template_test_macros.hpp>
+
+#include <vector>
+
+
+using namespace mathter;
+using namespace test_util;
+
+
+TEMPLATE_LIST_TEST_CASE("Affine - Construction", "[Affine]",
+						decltype(VectorCaseList<ScalarsFloating, PackingsAll>{})) {
+	using Vec = typename TestType::template Vector<3>;
+	using Scalar = scalar_type_t<Vec>;
+	using Aff = Affine<Scalar, 3, is_packed_v<Vec>>;
+	using Mat = Matrix<Scalar, 4, 4, eMatrixOrder::PRECEDE_VECTOR, eMatrixLayout::ROW_MAJOR, is_packed_v<Vec>>;
+
+	const Vec point = { 1, -2, 3 };
+
+	SECTION("Linear and translation") {
+		const typename Aff::LinearType linear = Scale(2, 3, 4);
+		const Aff transform(linear, Vec(5, 6, 7));
+		REQUIRE(transform.Linear() == linear);
+		REQUIRE(transform.Translation() == Vec(5, 6, 7));
+		REQUIRE(TransformPoint(transform, point) == test_util::Approx(Vec(7, 0, 19)));
+	}
+	SECTION("Builders") {
+		const Aff identity = Identity();
+		const Aff translation = Translation(Vec(5, 6, 7));
+		const Aff rotation = RotationAxisAngle(Normalize(Vec(1, 2, 3)), Scalar(0.7));
+		const Aff scale = Scale(Vec(2, 3, 4));
+		REQUIRE(TransformPoint(identity, point) == test_util::Approx(point));
+		REQUIRE(TransformPoint(translation, point) == test_util::Approx(Vec(6, 4, 10)));
+		REQUIRE(TransformPoint(scale, point) == test_util::Approx(Vec(2, -6, 12)));
+
+		const Mat rotationMatrix = RotationAxisAngle(Normalize(Vec(1, 2, 3)), Scalar(0.7));
+		REQUIRE(TransformPoint(rotation, point) == test_util::Approx(Vec((rotationMatrix * Vector(point, 1)).xyz)));
+	}
+	SECTION("To and from matrices") {
+		const Aff transform = Translation(Vec(5, 6, 7));
+		const auto precede = Mat(transform);
+		const auto follow = Matrix<Scalar, 4, 4, eMatrixOrder::FOLLOW_VECTOR, eMatrixLayout::COLUMN_MAJOR, is_packed_v<Vec>>(transform);
+		const auto followAffine = Matrix<Scalar, 4, 3, eMatrixOrder::FOLLOW_VECTOR, eMatrixLayout::ROW_MAJOR, is_packed_v<Vec>>(transform);
+		const Mat expected = Translation(Vec(5, 6, 7));
+		REQUIRE(precede == expected);
+		REQUIRE(ApplyTransform(follow, Vector(point, 1)) == test_util::Approx(Vector(Vec(6, 4, 10), 1)));
+		REQUIRE(ApplyTransform(followAffine, Vector(point, 1)) == test_util::Approx(Vec(6, 4, 10)));
+		REQUIRE(Aff(precede) == transform);
+		REQUIRE(Aff(follow) == transform);
+		REQUIRE(Aff(followAffine) == transform);
+	}
+}
+
+
+TEMPLATE_LIST_TEST_CASE("Affine - Arithmetic", "[Affine]",
+						decltype(VectorCaseList<ScalarsFloating, PackingsAll>{})) {
+	using Vec = typename TestType::template Vector<3>;
+	using Scalar = scalar_type_t<Vec>;
+	using Aff = Affine<Scalar, 3, is_packed_v<Vec>>;
+	using Mat = Matrix<Scalar, 4, 4, eMatrixOrder::PRECEDE_VECTOR, eMatrixLayout::ROW_MAJOR, is_packed_v<Vec>>;
+
+	const Aff rotation = RotationAxisAngle(Normalize(Vec(1, 2, 3)), Scalar(0.7));
+	const Aff translation = Translation(Vec(5, -6, 7));
+	const Aff scale = Scale(Vec(2, 3, 4));
+	const Aff rigid = translation * rotation;
+	const Aff general = translation * rotation * scale;
+	const Vec point = { 1, -2, 3 };
+
+	SECTION("Compose") {
+		REQUIRE(Mat(general) == test_util::Approx(Mat(translation) * Mat(rotation) * Mat(scale)));
+		REQUIRE(TransformPoint(rigid, point) == test_util::Approx(TransformPoint(translation, TransformPoint(rotation, point))));
+		auto copy = translation;
+		copy *= rotation;
+		REQUIRE(copy == rigid);
+	}
+	SECTION("Direction") {
+		REQUIRE(TransformDirection(rigid, point) == test_util::Approx(TransformPoint(rotation, point)));
+	}
+	SECTION("Inverse") {
+		const auto inverse = Inverse(general);
+		REQUIRE(Mat(inverse) == test_util::Approx(Inverse(Mat(general))));
+		REQUIRE(TransformPoint(inverse, TransformPoint(general, point)) == test_util::Approx(point));
+	}
+	SECTION("Inverse rigid") {
+		const auto inverse = InverseRigid(rigid);
+		REQUIRE(Mat(inverse) == test_util::Approx(Mat(Inverse(rigid))));
+		REQUIRE(TransformPoint(inverse, TransformPoint(rigid, point)) == test_util::Approx(point));
+	}
+	SECTION("Transform arrays") {
+		std::vector<Vec> points;
+		for (int i = 0; i < 37; ++i) {
+			points.push_back(Vec(Scalar(i % 5), Scalar(i % 7) - 3, Scalar(i % 3) + 1));
+		}
+		std::vector<Vec> transformed(points.size());
+		std::vector<Vec> directions(points.size());
+		TransformPoints(points, general, transformed);
+		TransformDirections(points.data(), points.size(), general, directions.data());
+		const auto array = TransformPoints(VectorArray(points.begin(), points.end()), general);
+		for (size_t i = 0; i < points.size(); ++i) {
+			REQUIRE(transformed[i] == test_util::Approx(TransformPoint(general, points[i])));
+			REQUIRE(directions[i] == test_util::Approx(TransformDirection(general, points[i])));
+			REQUIRE(array.Gather(i) == test_util::Approx(transformed[i]));
+		}
+	}
+}
@@ -11,6 +11,8 @@
 
 #include <catch2/catch_template_test_macros.hpp>
 
+#include <vector>
+
 
 using namespace mathter;
 using namespace test_util;
@@ -65,6 +67,107 @@ TEMPLATE_LIST_TEST_CASE("Matrix - Multiplication (precede)", "[Matrix]",
 }
 
 
+template <class MatLhs, class MatRhs>
+static void TestLargeMultiplication() {
+	constexpr int rows = row_count_v<MatLhs>;
+	constexpr int match = column_count_v<MatLhs>;
+	constexpr int columns = column_count_v<MatRhs>;
+
+	// Small integers keep every partial sum exact, so the order of summation doesn't matter.
+	MatLhs a;
+	MatRhs b;
+	for (int i = 0; i < rows; ++i) {
+		for (int k = 0; k < match; ++k) {
+			a(i, k) = static_cast<scalar_type_t<MatLhs>>((i * 7 + k * 3) % 11 - 5);
+		}
+	}
+	for (int k = 0; k < match; ++k) {
+		for (int j = 0; j < columns; ++j) {
+			b(k, j) = static_cast<scalar_type_t<MatRhs>>((k * 5 + j * 2) % 13 - 6);
+		}
+	}
+
+	const auto r = a * b;
+	using Scalar = scalar_type_t<std::decay_t<decltype(r)>>;
+
+	for (int i = 0; i < rows; ++i) {
+		for (int j = 0; j < columns; ++j) {
+			Scalar expected = 0;
+			for (int k = 0; k < match; ++k) {
+				expected += Scalar(a(i, k)) * Scalar(b(k, j));
+			}
+			REQUIRE(r(i, j) == expected);
+		}
+	}
+}
+
+
+TEMPLATE_LIST_TEST_CASE("Matrix - Multiplication (large)", "[Matrix]",
+						decltype(BinaryCaseList<MatrixCaseList<ScalarsFloating, OrdersFollow, LayoutsAll, PackingsAll>,
+												MatrixCaseList<ScalarsFloating, OrdersFollow, LayoutsAll, PackingsAll>>{})) {
+	SECTION("8x8 * 8x8") {
+		TestLargeMultiplication<typename TestType::Lhs::template Matrix<8, 8>, typename TestType::Rhs::template Matrix<8, 8>>();
+	}
+	SECTION("13x9 * 9x11") {
+		TestLargeMultiplication<typename TestType::Lhs::template Matrix<13, 9>, typename TestType::Rhs::template Matrix<9, 11>>();
+	}
+	SECTION("16x16 * 16x16") {
+		TestLargeMultiplication<typename TestType::Lhs::template Matrix<16, 16>, typename TestType::Rhs::template Matrix<16, 16>>();
+	}
+	SECTION("21x12 * 12x35") {
+		TestLargeMultiplication<typename TestType::Lhs::template Matrix<21, 12>, typename TestType::Rhs::template Matrix<12, 35>>();
+	}
+}
+
+
+template <int Rows, int Match, int Columns, class T>
+static void TestBlockedMultiply() {
+	// The strides are larger than the rows to check that the kernel doesn't touch the gaps.
+	constexpr size_t lhsStride = Match + 3;
+	constexpr size_t rhsStride = Columns + 5;
+	constexpr size_t outStride = Columns + 2;
+
+	std::vector<T> lhs(Rows * lhsStride, T(100));
+	std::vector<T> rhs(Match * rhsStride, T(100));
+	std::vector<T> out(Rows * outStride, T(-1));
+	for (int i = 0; i < Rows; ++i) {
+		for (int k = 0; k < Match; ++k) {
+			lhs[i * lhsStride + k] = T((i * 7 + k * 3) % 11 - 5);
+		}
+	}
+	for (int k = 0; k < Match; ++k) {
+		for (int j = 0; j < Columns; ++j) {
+			rhs[k * rhsStride + j] = T((k * 5 + j * 2) % 13 - 6);
+		}
+	}
+
+	impl::BlockedMultiply<Rows, Match, Columns>(lhs.data(), lhsStride, rhs.data(), rhsStride, out.data(), outStride);
+
+	for (int i = 0; i < Rows; ++i) {
+		for (int j = 0; j < Columns; ++j) {
+			T expected = 0;
+			for (int k = 0; k < Match; ++k) {
+				expected += lhs[i * lhsStride + k] * rhs[k * rhsStride + j];
+			}
+			REQUIRE(out[i * outStride + j] == expected);
+		}
+		for (size_t j = Columns; j < outStride; ++j) {
+			REQUIRE(out[i * outStride + j] == T(-1));
+		}
+	}
+}
+
+
+TEMPLATE_LIST_TEST_CASE("Matrix - Blocked multiply kernel", "[Matrix]", ScalarsFloating) {
+	TestBlockedMultiply<1, 1, 1, TestType>();
+	TestBlockedMultiply<4, 8, 8, TestType>();
+	TestBlockedMultiply<7, 5, 3, TestType>();
+	TestBlockedMultiply<13, 9, 11, TestType>();
+	TestBlockedMultiply<21, 12, 35, TestType>();
+	TestBlockedMultiply<64, 64, 64, TestType>();
+}
+
+
 //------------------------------------------------------------------------------
 // Elementwise
 //------------------------------------------------------------------------------
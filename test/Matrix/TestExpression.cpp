@@ -0,0 +1,165 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#pragma warning(disable : 4244)
+
+#include "../Approx.hpp"
+#include "../Cases.hpp"
+
+#include <Mathter/Matrix/Comparison.hpp>
+#include <Mathter/Matrix/Expression.hpp>
+#include <Mathter/Vector/Comparison.hpp>
+
+#include <catch2/catch_template_test_macros.hpp>
+
+
+using namespace mathter;
+using namespace test_util;
+
+
+template <class Mat>
+static Mat MakeMatrix(int seed) {
+	Mat m;
+	for (int row = 0; row < row_count_v<Mat>; ++row) {
+		for (int col = 0; col < column_count_v<Mat>; ++col) {
+			m(row, col) = static_cast<scalar_type_t<Mat>>((seed * 5 + row * 3 + col * 7) % 11 - 5);
+		}
+	}
+	return m;
+}
+
+
+static_assert(impl::ChainSplits<3>({ 10, 100, 5, 50 })[0][2] == 1, "(AB)C is cheaper");
+static_assert(impl::ChainSplits<3>({ 50, 5, 100, 10 })[0][2] == 0, "A(BC) is cheaper");
+
+
+TEMPLATE_LIST_TEST_CASE("Expression - Elementwise", "[Expression]",
+						decltype(MatrixCaseList<ScalarsFloating, OrdersAll, LayoutsAll, PackingsAll>{})) {
+	using Mat = typename TestType::template Matrix<3, 4>;
+	using Scalar = scalar_type_t<Mat>;
+
+	const auto a = MakeMatrix<Mat>(1);
+	const auto b = MakeMatrix<Mat>(2);
+	const auto c = MakeMatrix<Mat>(3);
+
+	SECTION("Add & subtract") {
+		const auto expr = Lazy(a) + b - Lazy(c);
+		static_assert(std::is_same_v<decltype(Evaluate(expr)), decltype(a + b - c)>);
+		REQUIRE(Evaluate(expr) == a + b - c);
+	}
+	SECTION("Scalar") {
+		const Mat r = Scalar(2) * Lazy(a) / Scalar(4) - Scalar(1);
+		REQUIRE(r == Scalar(2) * a / Scalar(4) - Scalar(1));
+	}
+	SECTION("Multiply-add") {
+		const Mat r1 = Scalar(3) * Lazy(a) + b;
+		const Mat r2 = c - Lazy(a) * Scalar(3);
+		const Mat r3 = Lazy(a) * Scalar(3) - c;
+		REQUIRE(r1 == Scalar(3) * a + b);
+		REQUIRE(r2 == c - a * Scalar(3));
+		REQUIRE(r3 == a * Scalar(3) - c);
+	}
+	SECTION("Negate") {
+		const Mat r = -(Lazy(a) - b);
+		REQUIRE(r == -(a - b));
+	}
+	SECTION("Rvalue operands") {
+		const auto expr = Lazy(a + b) * Scalar(2) + Mat(c);
+		REQUIRE(Evaluate(expr) == (a + b) * Scalar(2) + c);
+	}
+}
+
+
+TEMPLATE_LIST_TEST_CASE("Expression - Elementwise mixed layout", "[Expression]",
+						decltype(BinaryCaseList<MatrixCaseList<ScalarsFloat32, OrdersFollow, LayoutsAll, PackingsAll>,
+												MatrixCaseList<ScalarsFloat32, OrdersFollow, LayoutsAll, PackingsAll>>{})) {
+	using MatLhs = typename TestType::Lhs::template Matrix<3, 4>;
+	using MatRhs = typename TestType::Rhs::template Matrix<3, 4>;
+
+	const auto a = MakeMatrix<MatLhs>(1);
+	const auto b = MakeMatrix<MatRhs>(2);
+
+	const auto r = Evaluate(Lazy(a) - Lazy(b) * 2.0f);
+	static_assert(std::is_same_v<decltype(r), const decltype(a - b * 2.0f)>);
+	REQUIRE(r == a - b * 2.0f);
+}
+
+
+TEMPLATE_LIST_TEST_CASE("Expression - Vector", "[Expression]",
+						decltype(VectorCaseList<ScalarsFloating, PackingsAll>{})) {
+	using Vec = typename TestType::template Vector<3>;
+	using Scalar = scalar_type_t<Vec>;
+
+	const Vec u = { 1, 2, 3 };
+	const Vec v = { 4, -5, 6 };
+	const Vec w = { -7, 8, 9 };
+
+	const Vec r1 = Lazy(u) * v + w;
+	const Vec r2 = w - Lazy(u) * Scalar(2) / v;
+	REQUIRE(r1 == u * v + w);
+	REQUIRE(r2 == test_util::Approx(w - u * Scalar(2) / v));
+}
+
+
+TEMPLATE_LIST_TEST_CASE("Expression - Product chain", "[Expression]",
+						decltype(MatrixCaseList<ScalarsFloating, OrdersAll, LayoutsAll, PackingsAll>{})) {
+	using MatA = typename TestType::template Matrix<2, 5>;
+	using MatB = typename TestType::template Matrix<5, 3>;
+	using MatC = typename TestType::template Matrix<3, 4>;
+	using Scalar = scalar_type_t<MatA>;
+
+	const auto a = MakeMatrix<MatA>(1);
+	const auto b = MakeMatrix<MatB>(2);
+	const auto c = MakeMatrix<MatC>(3);
+
+	SECTION("Matrices") {
+		const auto left = Evaluate((Lazy(a) * b) * c);
+		const auto right = Evaluate(Lazy(a) * (Lazy(b) * c));
+		static_assert(std::is_same_v<decltype(left), const decltype(a * b * c)>);
+		REQUIRE(left == a * b * c);
+		REQUIRE(right == a * b * c);
+	}
+	SECTION("Products in elementwise expressions") {
+		const auto d = MakeMatrix<typename TestType::template Matrix<2, 4>>(4);
+		const auto r = Evaluate(d - Scalar(2) * Lazy(a) * (Lazy(b) * c));
+		REQUIRE(r == d - Scalar(2) * a * (b * c));
+	}
+}
+
+
+TEMPLATE_LIST_TEST_CASE("Expression - Vector product chain", "[Expression]",
+						decltype(MatrixCaseList<ScalarsFloating, OrdersAll, LayoutsAll, PackingsAll>{})) {
+	using Mat = typename TestType::template Matrix<4, 4>;
+	using Vec = Vector<scalar_type_t<Mat>, 4, is_packed_v<Mat>>;
+
+	const auto a = MakeMatrix<Mat>(1);
+	const auto b = MakeMatrix<Mat>(2);
+	const Vec v = { 1, 2, 3, 4 };
+
+	if constexpr (order_v<Mat> == eMatrixOrder::FOLLOW_VECTOR) {
+		const Vec r = Lazy(v) * a * b;
+		REQUIRE(r == test_util::Approx(v * a * b));
+	}
+	else {
+		const Vec r = Lazy(a) * b * v;
+		REQUIRE(r == test_util::Approx(a * b * v));
+	}
+}
+
+
+TEMPLATE_LIST_TEST_CASE("Expression - Householder update", "[Expression]",
+						decltype(MatrixCaseList<ScalarsFloating, OrdersAll, LayoutsAll, PackingsAll>{})) {
+	using Mat = typename TestType::template Matrix<4, 4>;
+	using MatColumn = typename TestType::template Matrix<4, 1>;
+	using MatRow = typename TestType::template Matrix<1, 4>;
+	using Scalar = scalar_type_t<Mat>;
+
+	const auto R = MakeMatrix<Mat>(1);
+	const auto v = MakeMatrix<MatColumn>(2);
+	const auto vT = MakeMatrix<MatRow>(2);
+
+	const Mat r = R - Scalar(2) * Lazy(v) * vT * R;
+	REQUIRE(r == R - Scalar(2) * v * (vT * R));
+}
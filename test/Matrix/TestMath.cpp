@@ -190,6 +190,35 @@ TEMPLATE_LIST_TEST_CASE("Matrix - Transpose", "[Matrix]",
 }
 
 
+template <class Mat>
+static void TestTransposeSquare() {
+	using Scalar = scalar_type_t<Mat>;
+	constexpr int dim = row_count_v<Mat>;
+
+	Mat value;
+	for (int i = 0; i < dim; ++i) {
+		for (int j = 0; j < dim; ++j) {
+			value(i, j) = static_cast<Scalar>(i * dim + j);
+		}
+	}
+	const Mat transpose = Transpose(value);
+	for (int i = 0; i < dim; ++i) {
+		for (int j = 0; j < dim; ++j) {
+			REQUIRE(transpose(j, i) == value(i, j));
+		}
+	}
+}
+
+
+TEMPLATE_LIST_TEST_CASE("Matrix - Transpose square", "[Matrix]",
+						decltype(MatrixCaseList<ScalarsAll, OrdersAll, LayoutsAll, PackingsAll>{})) {
+	TestTransposeSquare<typename TestType::template Matrix<2, 2>>();
+	TestTransposeSquare<typename TestType::template Matrix<3, 3>>();
+	TestTransposeSquare<typename TestType::template Matrix<4, 4>>();
+	TestTransposeSquare<typename TestType::template Matrix<8, 8>>();
+}
+
+
 TEMPLATE_LIST_TEST_CASE("Matrix - Conjugate transpose", "[Matrix]",
 						decltype(MatrixCaseList<ScalarsComplex, OrdersAll, LayoutsAll, PackingsAll>{})) {
 	using M42 = typename TestType::template Matrix<4, 2>;
@@ -7,10 +7,13 @@
 
 #include "../Cases.hpp"
 
+#include <Mathter/Matrix/Cast.hpp>
 #include <Mathter/Matrix/Matrix.hpp>
 
 #include <catch2/catch_template_test_macros.hpp>
 
+#include <vector>
+
 
 using namespace mathter;
 using namespace test_util;
@@ -274,4 +277,67 @@ TEMPLATE_LIST_TEST_CASE("Matrix - Convert to vector", "[Matrix]",
 		REQUIRE(v[1] == static_cast<Scalar>(2));
 		REQUIRE(v[2] == static_cast<Scalar>(3));
 	}
-}
\ No newline at end of file
+}
+
+
+template <class Mat>
+static Mat MakeIndexMatrix(int offset = 0) {
+	Mat m;
+	for (int i = 0; i < row_count_v<Mat>; ++i) {
+		for (int j = 0; j < column_count_v<Mat>; ++j) {
+			m(i, j) = static_cast<scalar_type_t<Mat>>(offset + i * column_count_v<Mat> + j);
+		}
+	}
+	return m;
+}
+
+
+template <class Mat>
+static void TestFlipLayout() {
+	using Flipped = Matrix<scalar_type_t<Mat>, row_count_v<Mat>, column_count_v<Mat>, order_v<Mat>, opposite_layout_v<layout_v<Mat>>, is_packed_v<Mat>>;
+
+	const auto m = MakeIndexMatrix<Mat>();
+	const Flipped converted(m);
+	const auto flipped = FlipLayout(m);
+	static_assert(std::is_same_v<std::decay_t<decltype(flipped)>, Flipped>);
+	for (int i = 0; i < row_count_v<Mat>; ++i) {
+		for (int j = 0; j < column_count_v<Mat>; ++j) {
+			REQUIRE(converted(i, j) == m(i, j));
+			REQUIRE(flipped(i, j) == m(i, j));
+		}
+	}
+
+	// Transposed dimensions with the same layout go through the same conversion.
+	const auto transposed = flip_layout_and_order_t<Flipped>(m);
+	for (int i = 0; i < row_count_v<Mat>; ++i) {
+		for (int j = 0; j < column_count_v<Mat>; ++j) {
+			REQUIRE(transposed(j, i) == m(i, j));
+		}
+	}
+
+	std::vector<Mat> matrices;
+	for (int k = 0; k < 5; ++k) {
+		matrices.push_back(MakeIndexMatrix<Mat>(k * 100));
+	}
+	std::vector<Flipped> converteds(matrices.size());
+	const auto end = FlipLayout(matrices.begin(), matrices.end(), converteds.begin());
+	REQUIRE(end == converteds.end());
+	for (size_t k = 0; k < matrices.size(); ++k) {
+		for (int i = 0; i < row_count_v<Mat>; ++i) {
+			for (int j = 0; j < column_count_v<Mat>; ++j) {
+				REQUIRE(converteds[k](i, j) == matrices[k](i, j));
+			}
+		}
+	}
+}
+
+
+TEMPLATE_LIST_TEST_CASE("Matrix - Flip layout", "[Matrix]",
+						decltype(MatrixCaseList<ScalarsAll, OrdersAll, LayoutsAll, PackingsAll>{})) {
+	TestFlipLayout<typename TestType::template Matrix<2, 2>>();
+	TestFlipLayout<typename TestType::template Matrix<3, 3>>();
+	TestFlipLayout<typename TestType::template Matrix<4, 4>>();
+	TestFlipLayout<typename TestType::template Matrix<8, 8>>();
+	TestFlipLayout<typename TestType::template Matrix<3, 5>>();
+	TestFlipLayout<typename TestType::template Matrix<4, 3>>();
+}
@@ -0,0 +1,82 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#pragma warning(disable : 4244)
+
+#include "../Cases.hpp"
+
+#include <Mathter/Matrix/Comparison.hpp>
+#include <Mathter/Matrix/MatrixArray.hpp>
+#include <Mathter/Transforms/ZeroBuilder.hpp>
+
+#include <catch2/catch_template_test_macros.hpp>
+
+#include <vector>
+
+
+using namespace mathter;
+using namespace test_util;
+
+
+namespace {
+
+// Not a multiple of any SIMD width to exercise the padding.
+constexpr size_t arraySize = 37;
+
+
+template <class Mat>
+std::vector<Mat> MakeMatrices(size_t count) {
+	std::vector<Mat> matrices;
+	for (size_t i = 0; i < count; ++i) {
+		Mat m;
+		for (int row = 0; row < row_count_v<Mat>; ++row) {
+			for (int col = 0; col < column_count_v<Mat>; ++col) {
+				m(row, col) = static_cast<scalar_type_t<Mat>>(1 + (int(i) * 7 + row * 3 + col * 5) % 11);
+			}
+		}
+		matrices.push_back(m);
+	}
+	return matrices;
+}
+
+} // namespace
+
+
+TEMPLATE_LIST_TEST_CASE("MatrixArray - Gather & scatter", "[MatrixArray]",
+						decltype(MatrixCaseList<ScalarsFloatAndInt32, OrdersAll, LayoutsAll, PackingsAll>{})) {
+	using Mat = typename TestType::template Matrix<2, 3>;
+	using Arr = MatrixArray<scalar_type_t<Mat>, 2, 3>;
+
+	const auto matrices = MakeMatrices<Mat>(arraySize);
+
+	SECTION("Construct from range") {
+		const MatrixArray array(matrices.begin(), matrices.end());
+		static_assert(std::is_same_v<std::decay_t<decltype(array)>, Arr>);
+		REQUIRE(array.Size() == arraySize);
+		REQUIRE(array.RowCount() == 2);
+		REQUIRE(array.ColumnCount() == 3);
+		REQUIRE(array.PaddedSize() % Arr::Block::size == 0);
+		for (size_t i = 0; i < arraySize; ++i) {
+			REQUIRE(array.template Gather<order_v<Mat>, layout_v<Mat>, is_packed_v<Mat>>(i) == matrices[i]);
+			REQUIRE(array.Lane(1, 2)[i] == matrices[i](1, 2));
+		}
+	}
+	SECTION("Scatter single") {
+		Arr array(arraySize);
+		array.Scatter(5, matrices[5]);
+		REQUIRE(array.template Gather<order_v<Mat>, layout_v<Mat>, is_packed_v<Mat>>(5) == matrices[5]);
+		REQUIRE(array.template Gather<order_v<Mat>, layout_v<Mat>, is_packed_v<Mat>>(4) == Mat(Zero()));
+	}
+	SECTION("Resize") {
+		Arr array(matrices.begin(), matrices.end());
+		array.Resize(3);
+		array.Resize(arraySize + 5);
+		REQUIRE(array.Size() == arraySize + 5);
+		REQUIRE(array.template Gather<order_v<Mat>, layout_v<Mat>, is_packed_v<Mat>>(2) == matrices[2]);
+		for (size_t i = 3; i < array.Size(); ++i) {
+			REQUIRE(array.template Gather<order_v<Mat>, layout_v<Mat>, is_packed_v<Mat>>(i) == Mat(Zero()));
+		}
+	}
+}
@@ -0,0 +1,344 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#pragma warning(disable : 4244)
+
+#include "../ApplyTransform.hpp"
+#include "../Approx.hpp"
+#include "../Cases.hpp"
+
+#include <Mathter/Decompositions/DecomposeLU.hpp>
+#include <Mathter/Decompositions/DecomposeQR.hpp>
+#include <Mathter/Decompositions/DecomposeSVD.hpp>
+#include <Mathter/Matrix/Arithmetic.hpp>
+#include <Mathter/Matrix/Comparison.hpp>
+#include <Mathter/Matrix/Math.hpp>
+#include <Mathter/Matrix/MatrixDynamic.hpp>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+
+
+using namespace mathter;
+using namespace test_util;
+
+
+namespace {
+
+template <class Mat>
+Mat MakeMatrix(size_t rows, size_t columns, int seed) {
+	Mat m(rows, columns);
+	for (size_t i = 0; i < rows; ++i) {
+		for (size_t j = 0; j < columns; ++j) {
+			m(i, j) = static_cast<scalar_type_t<Mat>>((int(i) * 7 + int(j) * 3 + seed) % 11 - 5);
+		}
+	}
+	return m;
+}
+
+
+template <class Mat>
+Mat ConditionedMatrix(size_t dim) {
+	auto m = MakeMatrix<Mat>(dim, dim, 0);
+	for (size_t i = 0; i < dim; ++i) {
+		m(i, i) += static_cast<scalar_type_t<Mat>>(3 * dim);
+	}
+	return m;
+}
+
+
+template <class Mat>
+Mat Reference(const Mat& lhs, const Mat& rhs) {
+	Mat result(lhs.RowCount(), rhs.ColumnCount());
+	for (size_t i = 0; i < lhs.RowCount(); ++i) {
+		for (size_t j = 0; j < rhs.ColumnCount(); ++j) {
+			for (size_t k = 0; k < lhs.ColumnCount(); ++k) {
+				result(i, j) += lhs(i, k) * rhs(k, j);
+			}
+		}
+	}
+	return result;
+}
+
+} // namespace
+
+
+TEMPLATE_LIST_TEST_CASE("MatrixDynamic - Construct", "[MatrixDynamic]",
+						decltype(MatrixCaseList<ScalarsFloatAndInt32, OrdersAll, LayoutsAll, PackingsAll>{})) {
+	using Mat = typename TestType::template Matrix<DYNAMIC, DYNAMIC>;
+	using MatFixed = typename TestType::template Matrix<2, 3>;
+
+	static_assert(is_dynamic_v<Mat>);
+
+	SECTION("Size") {
+		const Mat m(5, 7);
+		REQUIRE(m.RowCount() == 5);
+		REQUIRE(m.ColumnCount() == 7);
+		REQUIRE(m.StripeStride() % Mat::Block::size == 0);
+		for (size_t i = 0; i < m.StripeCount(); ++i) {
+			REQUIRE(reinterpret_cast<uintptr_t>(m.StripeData(i)) % (Mat::Block::size * sizeof(scalar_type_t<Mat>)) == 0);
+		}
+		REQUIRE(m == Mat(5, 7));
+	}
+	SECTION("Initializer list") {
+		const Mat m(2, 3, { 1, 2, 3, 4, 5, 6 });
+		REQUIRE(m(0, 0) == 1);
+		REQUIRE(m(0, 2) == 3);
+		REQUIRE(m(1, 0) == 4);
+		REQUIRE(m(1, 2) == 6);
+	}
+	SECTION("From and to fixed size") {
+		const MatFixed fixed = { 1, 2, 3, 4, 5, 6 };
+		const Mat m = fixed;
+		REQUIRE(m == Mat(2, 3, { 1, 2, 3, 4, 5, 6 }));
+		REQUIRE(static_cast<MatFixed>(m) == fixed);
+	}
+	SECTION("Resize") {
+		Mat m(2, 3, { 1, 2, 3, 4, 5, 6 });
+		m.Resize(3, 2);
+		REQUIRE(m == Mat(3, 2, { 1, 2, 4, 5, 0, 0 }));
+	}
+	SECTION("Rows & columns") {
+		Mat m(2, 3, { 1, 2, 3, 4, 5, 6 });
+		REQUIRE(m.Row(1) == typename Mat::Stripe{ 4, 5, 6 });
+		REQUIRE(m.Column(1) == typename Mat::Stripe{ 2, 5 });
+		m.Row(0, { 7, 8, 9 });
+		m.Column(2, { 0, 0 });
+		REQUIRE(m == Mat(2, 3, { 7, 8, 0, 4, 5, 0 }));
+	}
+	SECTION("Extract & insert") {
+		Mat m(2, 3, { 1, 2, 3, 4, 5, 6 });
+		REQUIRE(m.Extract(0, 1, 2, 2) == Mat(2, 2, { 2, 3, 5, 6 }));
+		m.Insert(1, 0, Mat(1, 2, { 8, 9 }));
+		REQUIRE(m == Mat(2, 3, { 1, 2, 3, 8, 9, 6 }));
+	}
+}
+
+
+TEMPLATE_LIST_TEST_CASE("MatrixDynamic - Multiply", "[MatrixDynamic]",
+						decltype(MatrixCaseList<ScalarsFloatAndInt32, OrdersAll, LayoutsAll, PackingsAll>{})) {
+	using Mat = typename TestType::template Matrix<DYNAMIC, DYNAMIC>;
+	using MatRM = Matrix<scalar_type_t<Mat>, DYNAMIC, DYNAMIC, order_v<Mat>, eMatrixLayout::ROW_MAJOR, is_packed_v<Mat>>;
+	using MatCM = Matrix<scalar_type_t<Mat>, DYNAMIC, DYNAMIC, order_v<Mat>, eMatrixLayout::COLUMN_MAJOR, is_packed_v<Mat>>;
+
+	// Sizes are not multiples of the SIMD width or the number of stripes processed at once.
+	const auto lhs = MakeMatrix<Mat>(11, 37, 0);
+	const auto rhs = MakeMatrix<Mat>(37, 19, 4);
+	const auto expected = Reference(lhs, rhs);
+
+	SECTION("Same layout") {
+		const auto result = lhs * rhs;
+		static_assert(std::is_same_v<std::decay_t<decltype(result)>, Mat>);
+		REQUIRE(result == expected);
+	}
+	SECTION("Row-major rhs") {
+		REQUIRE(lhs * MatRM(rhs) == expected);
+	}
+	SECTION("Column-major rhs") {
+		REQUIRE(lhs * MatCM(rhs) == expected);
+	}
+	SECTION("Compound") {
+		auto result = MakeMatrix<Mat>(11, 11, 1);
+		const auto square = MakeMatrix<Mat>(11, 11, 2);
+		const auto expectedSquare = Reference(result, square);
+		result *= square;
+		REQUIRE(result == expectedSquare);
+	}
+	SECTION("Same as fixed size") {
+		using MatFixed = typename TestType::template Matrix<4, 4>;
+		const MatFixed a = MatFixed(MakeMatrix<Mat>(4, 4, 0));
+		const MatFixed b = MatFixed(MakeMatrix<Mat>(4, 4, 1));
+		REQUIRE(MatFixed(Mat(a) * Mat(b)) == a * b);
+	}
+}
+
+
+TEMPLATE_LIST_TEST_CASE("MatrixDynamic - Multiply vector", "[MatrixDynamic]",
+						decltype(MatrixCaseList<ScalarsFloatAndInt32, OrdersAll, LayoutsAll, PackingsAll>{})) {
+	using Mat = typename TestType::template Matrix<DYNAMIC, DYNAMIC>;
+	using Scalar = scalar_type_t<Mat>;
+	using Vec = Vector<Scalar, DYNAMIC, is_packed_v<Mat>>;
+
+	constexpr bool precede = order_v<Mat> == eMatrixOrder::PRECEDE_VECTOR;
+	const auto m = MakeMatrix<Mat>(precede ? 13 : 37, precede ? 37 : 13, 0);
+	Vec v(37);
+	for (size_t i = 0; i < 37; ++i) {
+		v[i] = static_cast<Scalar>(i % 5);
+	}
+
+	const auto result = ApplyTransform(m, v);
+	static_assert(std::is_same_v<std::decay_t<decltype(result)>, Vec>);
+	REQUIRE(result.Dimension() == 13);
+	for (size_t i = 0; i < 13; ++i) {
+		Scalar expected = 0;
+		for (size_t k = 0; k < 37; ++k) {
+			expected += (precede ? m(i, k) : m(k, i)) * v[k];
+		}
+		REQUIRE(result[i] == expected);
+	}
+}
+
+
+TEMPLATE_LIST_TEST_CASE("MatrixDynamic - Elementwise & scalar", "[MatrixDynamic]",
+						decltype(MatrixCaseList<ScalarsFloatAndInt32, OrdersAll, LayoutsAll, PackingsAll>{})) {
+	using Mat = typename TestType::template Matrix<DYNAMIC, DYNAMIC>;
+	using MatCM = Matrix<scalar_type_t<Mat>, DYNAMIC, DYNAMIC, order_v<Mat>, eMatrixLayout::COLUMN_MAJOR, is_packed_v<Mat>>;
+	using Scalar = scalar_type_t<Mat>;
+
+	const auto lhs = MakeMatrix<Mat>(7, 19, 0);
+	const auto rhs = MakeMatrix<Mat>(7, 19, 4) + Scalar(10);
+
+	SECTION("Matrix x matrix") {
+		const auto sum = lhs + MatCM(rhs);
+		const auto diff = lhs - rhs;
+		const auto quot = lhs / rhs;
+		const auto prod = Hadamard(lhs, rhs);
+		for (size_t i = 0; i < 7; ++i) {
+			for (size_t j = 0; j < 19; ++j) {
+				REQUIRE(sum(i, j) == lhs(i, j) + rhs(i, j));
+				REQUIRE(diff(i, j) == lhs(i, j) - rhs(i, j));
+				REQUIRE(quot(i, j) == lhs(i, j) / rhs(i, j));
+				REQUIRE(prod(i, j) == lhs(i, j) * rhs(i, j));
+			}
+		}
+	}
+	SECTION("Matrix x scalar") {
+		const auto prod = lhs * Scalar(3);
+		const auto diff = Scalar(3) - lhs;
+		auto assigned = lhs;
+		assigned += rhs;
+		assigned *= Scalar(2);
+		for (size_t i = 0; i < 7; ++i) {
+			for (size_t j = 0; j < 19; ++j) {
+				REQUIRE(prod(i, j) == lhs(i, j) * Scalar(3));
+				REQUIRE(diff(i, j) == Scalar(3) - lhs(i, j));
+				REQUIRE(assigned(i, j) == (lhs(i, j) + rhs(i, j)) * Scalar(2));
+			}
+		}
+	}
+	SECTION("Negation") {
+		REQUIRE(-lhs == lhs * Scalar(-1));
+	}
+}
+
+
+TEMPLATE_LIST_TEST_CASE("MatrixDynamic - Math", "[MatrixDynamic]",
+						decltype(MatrixCaseList<ScalarsFloating, OrdersAll, LayoutsAll, PackingsAll>{})) {
+	using Mat = typename TestType::template Matrix<DYNAMIC, DYNAMIC>;
+	using MatFixed = typename TestType::template Matrix<5, 5>;
+
+	const auto m = MakeMatrix<Mat>(5, 5, 3);
+	const auto fixed = MatFixed(m);
+
+	SECTION("Transpose") {
+		REQUIRE(Transpose(MakeMatrix<Mat>(3, 7, 0)).RowCount() == 7);
+		REQUIRE(MatFixed(Transpose(m)) == Transpose(fixed));
+	}
+	SECTION("Reductions") {
+		REQUIRE(Min(m) == Min(fixed));
+		REQUIRE(Max(m) == Max(fixed));
+		REQUIRE(Sum(m) == Catch::Approx(Sum(fixed)));
+		REQUIRE(Trace(m) == Catch::Approx(Trace(fixed)));
+		REQUIRE(Norm(m) == Catch::Approx(Norm(fixed)));
+		REQUIRE(NormPrecise(m) == Catch::Approx(NormPrecise(fixed)));
+	}
+	SECTION("Determinant") {
+		REQUIRE(Determinant(m) == Catch::Approx(Determinant(fixed)));
+	}
+	SECTION("Flip layout and order") {
+		const auto flipped = FlipLayoutAndOrder(m);
+		REQUIRE(flipped.RowCount() == m.ColumnCount());
+		REQUIRE(flipped == m);
+		REQUIRE(FlipLayoutAndOrder(flipped) == m);
+	}
+}
+
+
+TEMPLATE_LIST_TEST_CASE("MatrixDynamic - Decompositions", "[MatrixDynamic]",
+						decltype(MatrixCaseList<ScalarsFloating, OrdersAll, LayoutsAll, PackingsNo>{})) {
+	using Mat = typename TestType::template Matrix<DYNAMIC, DYNAMIC>;
+	using Scalar = scalar_type_t<Mat>;
+	using Vec = Vector<Scalar, DYNAMIC, false>;
+	using Real = remove_complex_t<Scalar>;
+	constexpr auto tolerance = Real(100) * std::numeric_limits<Real>::epsilon();
+
+	constexpr size_t dim = 23;
+	const auto m = ConditionedMatrix<Mat>(dim);
+	const auto identity = impl::MakeIdentity<Mat>(dim, dim);
+	Vec b(dim);
+	for (size_t i = 0; i < dim; ++i) {
+		b[i] = static_cast<Scalar>(int(i % 7) - 3);
+	}
+
+	SECTION("LU") {
+		const auto LU = DecomposeLU(m);
+		REQUIRE(LU.L * LU.U == test_util::Approx(m, tolerance));
+		REQUIRE(ApplyTransform(m, LU.Solve(b)) == test_util::Approx(b, tolerance));
+		REQUIRE(m * LU.Inverse() == test_util::Approx(identity, tolerance));
+	}
+	SECTION("LUP") {
+		const auto LUP = DecomposeLUP(m);
+		REQUIRE(LUP.P.Dimension() == dim);
+		REQUIRE(ApplyTransform(m, LUP.Solve(b)) == test_util::Approx(b, tolerance));
+		REQUIRE(Inverse(m) * m == test_util::Approx(identity, tolerance));
+	}
+	SECTION("QR or LQ") {
+		const auto QR = DecomposeQRorLQ(m);
+		REQUIRE(ApplyTransform(m, QR.Solve(b)) == test_util::Approx(b, tolerance));
+		REQUIRE(m * QR.Inverse() == test_util::Approx(identity, tolerance));
+	}
+	SECTION("SVD") {
+		const auto SVD = DecomposeSVD(m);
+		REQUIRE(SVD.S.Dimension() == dim);
+		REQUIRE(ApplyTransform(m, SVD.Solve(b)) == test_util::Approx(b, tolerance));
+		REQUIRE(m * SVD.Inverse() == test_util::Approx(identity, tolerance));
+	}
+}
+
+
+TEMPLATE_LIST_TEST_CASE("MatrixDynamic - Decompositions of non-square matrices", "[MatrixDynamic]",
+						decltype(MatrixCaseList<ScalarsFloating, OrdersAll, LayoutsAll, PackingsNo>{})) {
+	using Mat = typename TestType::template Matrix<DYNAMIC, DYNAMIC>;
+	using MatFixed = typename TestType::template Matrix<7, 4>;
+	using Real = remove_complex_t<scalar_type_t<Mat>>;
+	constexpr auto tolerance = Real(100) * std::numeric_limits<Real>::epsilon();
+
+	auto m = MakeMatrix<Mat>(7, 4, 2);
+	for (size_t i = 0; i < 4; ++i) {
+		m(i, i) += 10;
+	}
+	const auto fixed = MatFixed(m);
+
+	SECTION("QR") {
+		const auto [Q, R] = DecomposeQR(m);
+		REQUIRE(Q.RowCount() == 7);
+		REQUIRE(R.RowCount() == 4);
+		REQUIRE(Q * R == test_util::Approx(m, tolerance));
+	}
+	SECTION("SVD tall") {
+		const auto [U, S, V] = DecomposeSVD(m);
+		const auto [UFixed, SFixed, VFixed] = DecomposeSVD(fixed);
+		for (size_t i = 0; i < 4; ++i) {
+			REQUIRE(S[i] == Catch::Approx(SFixed[i]));
+		}
+		Mat US = U;
+		for (size_t i = 0; i < 4; ++i) {
+			US.Column(i, US.Column(i) * S[i]);
+		}
+		REQUIRE(US * V == test_util::Approx(m, tolerance));
+	}
+	SECTION("SVD wide") {
+		const auto wide = Transpose(m);
+		const auto [U, S, V] = DecomposeSVD(wide);
+		REQUIRE(U.RowCount() == 4);
+		REQUIRE(V.RowCount() == 4);
+		REQUIRE(V.ColumnCount() == 7);
+		Mat US = U;
+		for (size_t i = 0; i < 4; ++i) {
+			US.Column(i, US.Column(i) * S[i]);
+		}
+		REQUIRE(US * V == test_util::Approx(wide, tolerance));
+	}
+}
@@ -0,0 +1,155 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#pragma warning(disable : 4244)
+
+#include "../ApplyTransform.hpp"
+#include "../Approx.hpp"
+#include "../Cases.hpp"
+
+#include <Mathter/Matrix/Arithmetic.hpp>
+#include <Mathter/Matrix/Math.hpp>
+#include <Mathter/Matrix/TransformPoints.hpp>
+
+#include <catch2/catch_template_test_macros.hpp>
+
+#include <vector>
+
+
+using namespace mathter;
+using namespace test_util;
+
+
+namespace {
+
+// Not a multiple of any SIMD width or the batch size to exercise the remainder.
+constexpr size_t pointCount = 37;
+
+
+template <class Vec>
+std::vector<Vec> MakePoints(size_t count) {
+	std::vector<Vec> points;
+	for (size_t i = 0; i < count; ++i) {
+		points.push_back(Vec{
+			static_cast<scalar_type_t<Vec>>(int(i * 7 % 11) - 5),
+			static_cast<scalar_type_t<Vec>>(int(i * 5 % 13) - 6),
+			static_cast<scalar_type_t<Vec>>(int(i * 3 % 7) - 3),
+		});
+	}
+	return points;
+}
+
+
+template <class Mat>
+Mat MakeTransform(bool perspective) {
+	using Scalar = scalar_type_t<Mat>;
+	const Matrix<Scalar, 4, 4, eMatrixOrder::FOLLOW_VECTOR> follow = {
+		2, 1, 0, perspective ? Scalar(0.125) : Scalar(0),
+		-1, 3, 1, perspective ? Scalar(-0.0625) : Scalar(0),
+		0, 1, 4, perspective ? Scalar(0.03125) : Scalar(0),
+		5, -6, 7, perspective ? Scalar(2) : Scalar(1)
+	};
+	return Mat(follow);
+}
+
+} // namespace
+
+
+TEMPLATE_LIST_TEST_CASE("TransformPoints - Points", "[TransformPoints]",
+						decltype(MatrixCaseList<ScalarsFloating, OrdersAll, LayoutsAll, PackingsAll>{})) {
+	using Mat = typename TestType::template Matrix<4, 4>;
+	using Scalar = scalar_type_t<Mat>;
+	using Vec = Vector<Scalar, 3, is_packed_v<Mat>>;
+
+	const auto points = MakePoints<Vec>(pointCount);
+
+	SECTION("Affine") {
+		const auto m = MakeTransform<Mat>(false);
+		std::vector<Vec> result(pointCount);
+		TransformPoints(points, m, result);
+		for (size_t i = 0; i < pointCount; ++i) {
+			REQUIRE(result[i] == test_util::Approx(ApplyTransform(m, points[i])));
+		}
+	}
+	SECTION("Affine 4x3") {
+		using MatAffine = std::conditional_t<order_v<Mat> == eMatrixOrder::FOLLOW_VECTOR,
+											 typename TestType::template Matrix<4, 3>,
+											 typename TestType::template Matrix<3, 4>>;
+		const auto m = MakeTransform<Mat>(false);
+		const auto affine = m.template Extract<row_count_v<MatAffine>, column_count_v<MatAffine>>(0, 0);
+		std::vector<Vec> result(pointCount);
+		TransformPoints(points.data(), points.size(), affine, result.data());
+		for (size_t i = 0; i < pointCount; ++i) {
+			REQUIRE(result[i] == test_util::Approx(ApplyTransform(m, points[i])));
+		}
+	}
+	SECTION("Perspective") {
+		const auto m = MakeTransform<Mat>(true);
+		std::vector<Vec> result(pointCount);
+		TransformPointsPerspective(points, m, result);
+		for (size_t i = 0; i < pointCount; ++i) {
+			REQUIRE(result[i] == test_util::Approx(ApplyTransform(m, points[i]), Scalar(100) * DefaultTolerance<Scalar>()));
+		}
+	}
+	SECTION("In-place") {
+		const auto m = MakeTransform<Mat>(true);
+		auto result = points;
+		TransformPointsPerspective(result, m, result);
+		for (size_t i = 0; i < pointCount; ++i) {
+			REQUIRE(result[i] == test_util::Approx(ApplyTransform(m, points[i]), Scalar(100) * DefaultTolerance<Scalar>()));
+		}
+	}
+	SECTION("Vector array") {
+		const auto m = MakeTransform<Mat>(true);
+		const auto result = TransformPointsPerspective(VectorArray(points.begin(), points.end()), m);
+		REQUIRE(result.Size() == pointCount);
+		for (size_t i = 0; i < pointCount; ++i) {
+			REQUIRE(result.Gather(i) == test_util::Approx(ApplyTransform(m, points[i]), Scalar(100) * DefaultTolerance<Scalar>()));
+		}
+	}
+}
+
+
+TEMPLATE_LIST_TEST_CASE("TransformPoints - Directions and normals", "[TransformPoints]",
+						decltype(MatrixCaseList<ScalarsFloating, OrdersAll, LayoutsAll, PackingsAll>{})) {
+	using Mat = typename TestType::template Matrix<4, 4>;
+	using Scalar = scalar_type_t<Mat>;
+	using Vec = Vector<Scalar, 3, is_packed_v<Mat>>;
+
+	const auto directions = MakePoints<Vec>(pointCount);
+	const auto m = MakeTransform<Mat>(false);
+	const auto linear = m.template Extract<3, 3>(0, 0);
+
+	SECTION("Directions") {
+		std::vector<Vec> result(pointCount);
+		TransformDirections(directions, m, result);
+		for (size_t i = 0; i < pointCount; ++i) {
+			REQUIRE(result[i] == test_util::Approx(ApplyTransform(linear, directions[i])));
+		}
+		const auto array = TransformDirections(VectorArray(directions.begin(), directions.end()), m);
+		for (size_t i = 0; i < pointCount; ++i) {
+			REQUIRE(array.Gather(i) == test_util::Approx(result[i]));
+		}
+	}
+	SECTION("Normals") {
+		const auto normalTransform = Transpose(Inverse(linear));
+		std::vector<Vec> result(pointCount);
+		TransformNormals(directions, m, result);
+		for (size_t i = 0; i < pointCount; ++i) {
+			REQUIRE(result[i] == test_util::Approx(ApplyTransform(normalTransform, directions[i]), Scalar(100) * DefaultTolerance<Scalar>()));
+		}
+	}
+	SECTION("Normals stay perpendicular") {
+		const Vec tangent = { 1, 2, -1 };
+		const Vec normal = { 1, 0, 1 };
+		REQUIRE(Dot(tangent, normal) == 0);
+
+		Vec transformedTangent;
+		Vec transformedNormal;
+		TransformDirections(&tangent, 1, m, &transformedTangent);
+		TransformNormals(&normal, 1, m, &transformedNormal);
+		REQUIRE(std::abs(Dot(transformedTangent, transformedNormal)) < Scalar(100) * DefaultTolerance<Scalar>());
+	}
+}
@@ -9,8 +9,8 @@ namespace test_util {
 template <class Mat>
 Mat ZeroLowerTriangle(const Mat& m) {
 	auto copy = m;
-	for (size_t row = 0; row < mathter::row_count_v<Mat>; ++row) {
-		for (size_t col = 0; col <= row && col < mathter::column_count_v<Mat>; ++col) {
+	for (size_t row = 0; row < m.RowCount(); ++row) {
+		for (size_t col = 0; col <= row && col < m.ColumnCount(); ++col) {
 			copy(row, col) = mathter::scalar_type_t<Mat>(0);
 		}
 	}
@@ -21,8 +21,8 @@ Mat ZeroLowerTriangle(const Mat& m) {
 template <class Mat>
 Mat ZeroUpperTriangle(const Mat& m) {
 	auto copy = m;
-	for (size_t row = 0; row < mathter::row_count_v<Mat>; ++row) {
-		for (size_t col = row; col < mathter::column_count_v<Mat>; ++col) {
+	for (size_t row = 0; row < m.RowCount(); ++row) {
+		for (size_t col = row; col < m.ColumnCount(); ++col) {
 			copy(row, col) = mathter::scalar_type_t<Mat>(0);
 		}
 	}
@@ -0,0 +1,179 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#pragma warning(disable : 4244)
+
+#include "../ApplyTransform.hpp"
+#include "../Approx.hpp"
+#include "../Cases.hpp"
+
+#include <Mathter/Matrix/Arithmetic.hpp>
+#include <Mathter/Quaternion/DualQuaternion.hpp>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+
+#include <cstdint>
+#include <vector>
+
+
+using namespace mathter;
+using namespace test_util;
+
+
+namespace {
+
+template <class Quat>
+struct DualOf;
+
+template <class T, eQuaternionLayout Layout, bool Packed>
+struct DualOf<Quaternion<T, Layout, Packed>> {
+	using type = DualQuaternion<T, Layout, Packed>;
+};
+
+
+template <class Quat>
+Quat MakeRotation(scalar_type_t<Quat> angle, Vector<scalar_type_t<Quat>, 3, is_packed_v<Quat>> axis) {
+	return Quat(std::cos(angle / 2), std::sin(angle / 2) * Normalize(axis));
+}
+
+
+template <class DualQuat>
+DualQuat MakeTransform(int seed) {
+	using Quat = std::decay_t<decltype(std::declval<DualQuat>().real)>;
+	using Scalar = scalar_type_t<Quat>;
+	using Vec = Vector<Scalar, 3, is_packed_v<Quat>>;
+	const Scalar angle = Scalar(seed * 37 % 61) / Scalar(10) - Scalar(3);
+	const Vec axis = { Scalar(seed * 7 % 11) - Scalar(5.5), Scalar(seed * 5 % 13) - Scalar(6.5), Scalar(seed * 3 % 7) - Scalar(3.5) };
+	const Vec translation = { Scalar(seed % 5) - 2, Scalar(seed % 3), Scalar(seed % 7) - 4 };
+	return DualQuat(MakeRotation<Quat>(angle, axis), translation);
+}
+
+} // namespace
+
+
+TEMPLATE_LIST_TEST_CASE("DualQuaternion - Rigid transform", "[DualQuaternion]",
+						decltype(QuaternionCaseList<ScalarsFloating, QuatLayoutsAll, PackingsAll>{})) {
+	using Quat = typename TestType::Quat;
+	using Scalar = scalar_type_t<Quat>;
+	using Vec = Vector<Scalar, 3, is_packed_v<Quat>>;
+	using DualQuat = typename DualOf<Quat>::type;
+
+	const auto rotation = MakeRotation<Quat>(Scalar(0.8), Vec(1, 2, 3));
+	const Vec translation = { 4, -2, 1 };
+	const DualQuat dq(rotation, translation);
+	const Vec point = { 1, 5, -3 };
+
+	SECTION("Translation") {
+		REQUIRE(dq.Translation() == test_util::Approx(translation));
+		REQUIRE(dq.real == rotation);
+	}
+	SECTION("Transform point") {
+		REQUIRE(dq(point) == test_util::Approx(Vec(rotation(point) + translation)));
+	}
+	SECTION("Identity") {
+		REQUIRE(DualQuat::Identity()(point) == test_util::Approx(point));
+	}
+	SECTION("Multiplication") {
+		const auto other = MakeTransform<DualQuat>(3);
+		REQUIRE((dq * other)(point) == test_util::Approx(dq(other(point))));
+	}
+	SECTION("Inverse") {
+		REQUIRE((Inverse(dq) * dq)(point) == test_util::Approx(point));
+		REQUIRE(Inverse(dq)(dq(point)) == test_util::Approx(point));
+	}
+	SECTION("Normalize") {
+		const auto scaled = dq * Scalar(3);
+		REQUIRE(!IsNormalized(scaled));
+		const auto normalized = Normalize(scaled);
+		REQUIRE(IsNormalized(normalized));
+		REQUIRE(normalized.real == test_util::Approx(dq.real));
+		REQUIRE(normalized.dual == test_util::Approx(dq.dual));
+	}
+}
+
+
+TEMPLATE_LIST_TEST_CASE("DualQuaternion - Matrix conversion", "[DualQuaternion]",
+						decltype(MatrixCaseList<ScalarsFloating, OrdersAll, LayoutsAll, PackingsAll>{})) {
+	using Mat = typename TestType::template Matrix<4, 4>;
+	using Scalar = scalar_type_t<Mat>;
+	using Vec = Vector<Scalar, 3, is_packed_v<Mat>>;
+	using Vec4 = Vector<Scalar, 4, is_packed_v<Mat>>;
+	using DualQuat = DualQuaternion<Scalar, eQuaternionLayout::SCALAR_FIRST, is_packed_v<Mat>>;
+
+	const auto dq = MakeTransform<DualQuat>(5);
+	const Vec point = { 1, 5, -3 };
+
+	SECTION("To 4x4") {
+		const auto m = Mat(dq);
+		const auto transformed = ApplyTransform(m, Vec4(point, 1));
+		REQUIRE(Vec(transformed.xyz) == test_util::Approx(dq(point)));
+		REQUIRE(transformed[3] == Catch::Approx(1));
+	}
+	SECTION("To affine") {
+		using MatAffine = std::conditional_t<order_v<Mat> == eMatrixOrder::FOLLOW_VECTOR,
+											 typename TestType::template Matrix<4, 3>,
+											 typename TestType::template Matrix<3, 4>>;
+		const auto m = MatAffine(dq);
+		REQUIRE(ApplyTransform(m, Vec4(point, 1)) == test_util::Approx(dq(point)));
+	}
+	SECTION("Round trip") {
+		const auto converted = DualQuat(Mat(dq));
+		REQUIRE(converted.real == test_util::Approx(dq.real));
+		REQUIRE(converted.dual == test_util::Approx(dq.dual));
+	}
+}
+
+
+TEMPLATE_LIST_TEST_CASE("DualQuaternion - Blend", "[DualQuaternion]",
+						decltype(QuaternionCaseList<ScalarsFloating, QuatLayoutsAll, PackingsAll>{})) {
+	using Quat = typename TestType::Quat;
+	using Scalar = scalar_type_t<Quat>;
+	using Vec = Vector<Scalar, 3, is_packed_v<Quat>>;
+	using DualQuat = typename DualOf<Quat>::type;
+
+	SECTION("Translations") {
+		const auto rotation = MakeRotation<Quat>(Scalar(0.8), Vec(1, 2, 3));
+		const DualQuat transforms[] = { DualQuat(rotation, Vec(1, 0, 0)), DualQuat(Scalar(-1) * rotation, Vec(0, 4, 0)) };
+		const Scalar weights[] = { Scalar(0.75), Scalar(0.25) };
+		const auto blended = Blend(transforms, weights);
+		REQUIRE(blended.real == test_util::Approx(rotation));
+		REQUIRE(blended.Translation() == test_util::Approx(Vec(0.75, 1, 0)));
+	}
+	SECTION("Rigid") {
+		const DualQuat transforms[] = { MakeTransform<DualQuat>(1), MakeTransform<DualQuat>(2), MakeTransform<DualQuat>(3) };
+		const Scalar weights[] = { Scalar(0.5), Scalar(0.2), Scalar(0.3) };
+		REQUIRE(IsNormalized(Blend(transforms, weights)));
+	}
+	SECTION("Skinning") {
+		// Not a multiple of any SIMD width or the batch size to exercise the remainder.
+		constexpr size_t vertexCount = 37;
+		constexpr size_t influences = 3;
+
+		std::vector<DualQuat> joints;
+		for (int i = 0; i < 7; ++i) {
+			const auto joint = MakeTransform<DualQuat>(i);
+			joints.push_back(i % 2 == 0 ? joint * Scalar(-1) : joint);
+		}
+		std::vector<uint16_t> indices;
+		std::vector<Scalar> weights;
+		for (size_t i = 0; i < vertexCount * influences; ++i) {
+			indices.push_back(uint16_t(i * 5 % joints.size()));
+			weights.push_back(Scalar(1 + i % 4));
+		}
+
+		std::vector<DualQuat> result(vertexCount);
+		Blend(joints.data(), indices.data(), weights.data(), influences, vertexCount, result.data());
+		for (size_t v = 0; v < vertexCount; ++v) {
+			DualQuat influencing[influences];
+			for (size_t k = 0; k < influences; ++k) {
+				influencing[k] = joints[indices[v * influences + k]];
+			}
+			const auto expected = Blend(influencing, weights.data() + v * influences, influences);
+			REQUIRE(result[v].real == test_util::Approx(expected.real));
+			REQUIRE(result[v].dual == test_util::Approx(expected.dual));
+		}
+	}
+}
@@ -0,0 +1,205 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#pragma warning(disable : 4244)
+
+#include "../Approx.hpp"
+#include "../Cases.hpp"
+
+#include <Mathter/Quaternion/Arithmetic.hpp>
+#include <Mathter/Quaternion/Interpolation.hpp>
+#include <Mathter/Quaternion/Math.hpp>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+
+#include <vector>
+
+
+using namespace mathter;
+using namespace test_util;
+
+
+namespace {
+
+// Not a multiple of any SIMD width or the batch size to exercise the remainder.
+constexpr size_t quaternionCount = 37;
+
+
+template <class Quat>
+Quat MakeRotation(scalar_type_t<Quat> angle, Vector<scalar_type_t<Quat>, 3, is_packed_v<Quat>> axis) {
+	using Scalar = scalar_type_t<Quat>;
+	return Quat(std::cos(angle / 2), std::sin(angle / 2) * Normalize(axis));
+}
+
+
+template <class Quat>
+std::vector<Quat> MakeRotations(size_t count, int seed) {
+	using Scalar = scalar_type_t<Quat>;
+	std::vector<Quat> rotations;
+	for (size_t i = 0; i < count; ++i) {
+		const auto n = int(i) + seed;
+		const Scalar angle = Scalar(n * 37 % 61) / Scalar(10) - Scalar(3);
+		const Vector<Scalar, 3, is_packed_v<Quat>> axis = {
+			Scalar(n * 7 % 11) - Scalar(5.5),
+			Scalar(n * 5 % 13) - Scalar(6.5),
+			Scalar(n * 3 % 7) - Scalar(3.5),
+		};
+		const auto q = MakeRotation<Quat>(angle, axis);
+		// Some of them in the opposite hemisphere to test the shortest path.
+		rotations.push_back(n % 3 == 0 ? Scalar(-1) * q : q);
+	}
+	return rotations;
+}
+
+
+template <class Quat>
+auto AngleBetween(const Quat& lhs, const Quat& rhs) {
+	return Angle(Normalize(lhs * Inverse(rhs)));
+}
+
+} // namespace
+
+
+TEMPLATE_LIST_TEST_CASE("Quaternion - Nlerp", "[Quaternion]",
+						decltype(QuaternionCaseList<ScalarsFloating, QuatLayoutsAll, PackingsAll>{})) {
+	using Quat = typename TestType::Quat;
+	using Scalar = scalar_type_t<Quat>;
+	using Vec = Vector<Scalar, 3, is_packed_v<Quat>>;
+
+	const auto from = MakeRotation<Quat>(Scalar(0.3), Vec(1, 2, 3));
+	const auto to = MakeRotation<Quat>(Scalar(1.1), Vec(-1, 2, 1));
+
+	SECTION("Endpoints") {
+		REQUIRE(Nlerp(from, to, Scalar(0)) == test_util::Approx(from));
+		REQUIRE(Nlerp(from, to, Scalar(1)) == test_util::Approx(to));
+	}
+	SECTION("Unit length") {
+		REQUIRE(Length(Nlerp(from, to, Scalar(0.37))) == Catch::Approx(1));
+	}
+	SECTION("Midpoint") {
+		const auto mid = Nlerp(from, to, Scalar(0.5));
+		REQUIRE(AngleBetween(from, mid) == Catch::Approx(AngleBetween(mid, to)));
+	}
+	SECTION("Shortest path") {
+		REQUIRE(Nlerp(from, Scalar(-1) * to, Scalar(0.37)) == test_util::Approx(Nlerp(from, to, Scalar(0.37))));
+	}
+}
+
+
+TEMPLATE_LIST_TEST_CASE("Quaternion - Slerp", "[Quaternion]",
+						decltype(QuaternionCaseList<ScalarsFloating, QuatLayoutsAll, PackingsAll>{})) {
+	using Quat = typename TestType::Quat;
+	using Scalar = scalar_type_t<Quat>;
+	using Vec = Vector<Scalar, 3, is_packed_v<Quat>>;
+
+	const auto from = MakeRotation<Quat>(Scalar(0.3), Vec(1, 2, 3));
+	const auto to = MakeRotation<Quat>(Scalar(1.1), Vec(-1, 2, 1));
+
+	SECTION("Endpoints") {
+		REQUIRE(Slerp(from, to, Scalar(0)) == test_util::Approx(from));
+		REQUIRE(Slerp(from, to, Scalar(1)) == test_util::Approx(to));
+	}
+	SECTION("Unit length") {
+		REQUIRE(Length(Slerp(from, to, Scalar(0.37))) == Catch::Approx(1));
+	}
+	SECTION("Constant angular velocity") {
+		const auto angle = AngleBetween(from, to);
+		for (const auto t : { Scalar(0.1), Scalar(0.37), Scalar(0.5), Scalar(0.9) }) {
+			const auto q = Slerp(from, to, t);
+			REQUIRE(AngleBetween(from, q) == Catch::Approx(t * angle).epsilon(1e-4));
+		}
+	}
+	SECTION("Same axis") {
+		const auto q = Slerp(MakeRotation<Quat>(Scalar(0.2), Vec(1, 2, 3)), MakeRotation<Quat>(Scalar(1.0), Vec(1, 2, 3)), Scalar(0.25));
+		REQUIRE(q == test_util::Approx(MakeRotation<Quat>(Scalar(0.4), Vec(1, 2, 3))));
+	}
+	SECTION("Shortest path") {
+		REQUIRE(Slerp(from, Scalar(-1) * to, Scalar(0.37)) == test_util::Approx(Slerp(from, to, Scalar(0.37))));
+	}
+	SECTION("Identical") {
+		REQUIRE(Slerp(from, from, Scalar(0.37)) == test_util::Approx(from));
+	}
+}
+
+
+TEMPLATE_LIST_TEST_CASE("Quaternion - Average", "[Quaternion]",
+						decltype(QuaternionCaseList<ScalarsFloating, QuatLayoutsAll, PackingsAll>{})) {
+	using Quat = typename TestType::Quat;
+	using Scalar = scalar_type_t<Quat>;
+	using Vec = Vector<Scalar, 3, is_packed_v<Quat>>;
+
+	const auto from = MakeRotation<Quat>(Scalar(0.3), Vec(1, 2, 3));
+	const auto to = MakeRotation<Quat>(Scalar(1.1), Vec(-1, 2, 1));
+
+	SECTION("Single") {
+		const Quat quaternions[] = { from };
+		const Scalar weights[] = { Scalar(0.6) };
+		REQUIRE(Average(quaternions, weights) == test_util::Approx(from));
+	}
+	SECTION("Two matches Nlerp") {
+		const Quat quaternions[] = { from, Scalar(-1) * to };
+		const Scalar weights[] = { Scalar(0.75), Scalar(0.25) };
+		REQUIRE(Average(quaternions, weights) == test_util::Approx(Nlerp(from, to, Scalar(0.25))));
+	}
+	SECTION("Symmetric") {
+		const auto center = MakeRotation<Quat>(Scalar(0.5), Vec(0, 0, 1));
+		const auto offset = MakeRotation<Quat>(Scalar(0.2), Vec(1, 0, 0));
+		const Quat quaternions[] = { center * offset, center * Inverse(offset), Scalar(-1) * center };
+		const Scalar weights[] = { Scalar(1), Scalar(1), Scalar(2) };
+		REQUIRE(Average(quaternions, weights) == test_util::Approx(center));
+	}
+}
+
+
+TEMPLATE_LIST_TEST_CASE("Quaternion - Interpolate arrays", "[Quaternion]",
+						decltype(QuaternionCaseList<ScalarsFloating, QuatLayoutsAll, PackingsAll>{})) {
+	using Quat = typename TestType::Quat;
+	using Scalar = scalar_type_t<Quat>;
+
+	const auto from = MakeRotations<Quat>(quaternionCount, 0);
+	const auto to = MakeRotations<Quat>(quaternionCount, 100);
+	const auto t = Scalar(0.37);
+
+	SECTION("Nlerp") {
+		std::vector<Quat> result(quaternionCount);
+		Nlerp(from, to, t, result);
+		for (size_t i = 0; i < quaternionCount; ++i) {
+			REQUIRE(result[i] == test_util::Approx(Nlerp(from[i], to[i], t)));
+		}
+	}
+	SECTION("Slerp") {
+		std::vector<Quat> result(quaternionCount);
+		Slerp(from.data(), to.data(), from.size(), t, result.data());
+		for (size_t i = 0; i < quaternionCount; ++i) {
+			REQUIRE(result[i] == test_util::Approx(Slerp(from[i], to[i], t)));
+		}
+	}
+	SECTION("In-place") {
+		auto result = from;
+		Slerp(result, to, t, result);
+		for (size_t i = 0; i < quaternionCount; ++i) {
+			REQUIRE(result[i] == test_util::Approx(Slerp(from[i], to[i], t)));
+		}
+	}
+	SECTION("Identical") {
+		std::vector<Quat> result(quaternionCount);
+		Slerp(from, from, t, result);
+		for (size_t i = 0; i < quaternionCount; ++i) {
+			REQUIRE(result[i] == test_util::Approx(from[i]));
+		}
+	}
+	SECTION("Average") {
+		const auto third = MakeRotations<Quat>(quaternionCount, 200);
+		const Quat* const arrays[] = { from.data(), to.data(), third.data() };
+		const Scalar weights[] = { Scalar(0.5), Scalar(0.3), Scalar(0.2) };
+		std::vector<Quat> result(quaternionCount);
+		Average(arrays, weights, 3, quaternionCount, result.data());
+		for (size_t i = 0; i < quaternionCount; ++i) {
+			const Quat quaternions[] = { from[i], to[i], third[i] };
+			REQUIRE(result[i] == test_util::Approx(Average(quaternions, weights)));
+		}
+	}
+}
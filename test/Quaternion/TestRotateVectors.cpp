@@ -0,0 +1,93 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#pragma warning(disable : 4244)
+
+#include "../Approx.hpp"
+#include "../Cases.hpp"
+
+#include <Mathter/Quaternion/RotateVectors.hpp>
+#include <Mathter/Quaternion/RotationArithmetic.hpp>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+
+#include <vector>
+
+
+using namespace mathter;
+using namespace test_util;
+
+
+namespace {
+
+// Not a multiple of any SIMD width or the batch size to exercise the remainder.
+constexpr size_t vectorCount = 37;
+
+
+template <class Vec>
+std::vector<Vec> MakeVectors(size_t count) {
+	std::vector<Vec> vectors;
+	for (size_t i = 0; i < count; ++i) {
+		vectors.push_back(Vec{
+			static_cast<scalar_type_t<Vec>>(int(i * 7 % 11) - 5),
+			static_cast<scalar_type_t<Vec>>(int(i * 5 % 13) - 6),
+			static_cast<scalar_type_t<Vec>>(int(i * 3 % 7) - 3),
+		});
+	}
+	return vectors;
+}
+
+} // namespace
+
+
+TEMPLATE_LIST_TEST_CASE("Quaternion - RotateVectors", "[Quaternion]",
+						decltype(QuaternionCaseList<ScalarsFloating, QuatLayoutsAll, PackingsAll>{})) {
+	using Quat = typename TestType::Quat;
+	using Scalar = scalar_type_t<Quat>;
+	using Vec = Vector<Scalar, 3, is_packed_v<Quat>>;
+
+	const auto theta = Scalar(-0.78);
+	const auto axis = Normalize(Vec(1, 2, 3));
+	const Quat q(std::cos(theta / 2), std::sin(theta / 2) * axis);
+
+	const auto vectors = MakeVectors<Vec>(vectorCount);
+
+	SECTION("Pointer") {
+		std::vector<Vec> result(vectorCount);
+		RotateVectors(vectors.data(), vectors.size(), q, result.data());
+		for (size_t i = 0; i < vectorCount; ++i) {
+			REQUIRE(result[i] == test_util::Approx(q(vectors[i])));
+		}
+	}
+	SECTION("Range") {
+		std::vector<Vec> result(vectorCount);
+		RotateVectors(vectors, q, result);
+		for (size_t i = 0; i < vectorCount; ++i) {
+			REQUIRE(result[i] == test_util::Approx(q(vectors[i])));
+		}
+	}
+	SECTION("In-place") {
+		auto result = vectors;
+		RotateVectors(result, q, result);
+		for (size_t i = 0; i < vectorCount; ++i) {
+			REQUIRE(result[i] == test_util::Approx(q(vectors[i])));
+		}
+	}
+	SECTION("Vector array") {
+		const auto result = RotateVectors(VectorArray(vectors.begin(), vectors.end()), q);
+		REQUIRE(result.Size() == vectorCount);
+		for (size_t i = 0; i < vectorCount; ++i) {
+			REQUIRE(result.Gather(i) == test_util::Approx(q(vectors[i])));
+		}
+	}
+	SECTION("Preserves length") {
+		std::vector<Vec> result(vectorCount);
+		RotateVectors(vectors, q, result);
+		for (size_t i = 0; i < vectorCount; ++i) {
+			REQUIRE(Length(result[i]) == Catch::Approx(Length(vectors[i])).epsilon(1e-5));
+		}
+	}
+}
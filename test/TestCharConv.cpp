@@ -0,0 +1,159 @@
+#include <Mathter/CharConv.hpp>
+#include <Mathter/IoStream.hpp>
+#include <Mathter/Matrix/Comparison.hpp>
+#include <Mathter/Vector/Comparison.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <complex>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+
+using namespace mathter;
+
+
+namespace {
+
+template <class Value>
+std::string Format(const Value& value) {
+	char buffer[256];
+	const auto [ptr, ec] = ToChars(buffer, buffer + sizeof(buffer), value);
+	REQUIRE(ec == std::errc{});
+	return std::string(buffer, ptr);
+}
+
+} // namespace
+
+
+TEST_CASE("CharConv: format vector", "[CharConv]") {
+	SECTION("Integer") {
+		REQUIRE(Format(Vector(1, -2, 3)) == "[1, -2, 3]");
+	}
+	SECTION("Float") {
+		REQUIRE(Format(Vector(1.1f, 2.2f, 3.3f)) == "[1.1, 2.2, 3.3]");
+	}
+	SECTION("Complex") {
+		using namespace std::complex_literals;
+		REQUIRE(Format(Vector(1.1f + 0.1if, 2.2f, 3.3f + 0.3if)) == "[1.1 + 0.1j, 2.2, 3.3 + 0.3j]");
+	}
+	SECTION("Same as stream") {
+		const auto v = Vector(1, 2, 3, 4);
+		std::stringstream ss;
+		ss << v;
+		REQUIRE(Format(v) == ss.str());
+	}
+	SECTION("Buffer too small") {
+		char buffer[8];
+		const auto [ptr, ec] = ToChars(buffer, buffer + sizeof(buffer), Vector(1.5f, 2.5f, 3.5f));
+		REQUIRE(ec == std::errc::value_too_large);
+		REQUIRE(ptr == buffer + sizeof(buffer));
+	}
+}
+
+
+TEST_CASE("CharConv: format matrix", "[CharConv]") {
+	const std::string_view expected = "[[1, 2, 3], [4, 5, 6]]";
+
+	SECTION("Row major") {
+		const auto m = Matrix<int, 2, 3, eMatrixOrder::FOLLOW_VECTOR, eMatrixLayout::ROW_MAJOR, false>(1, 2, 3, 4, 5, 6);
+		REQUIRE(Format(m) == expected);
+	}
+	SECTION("Column major") {
+		const auto m = Matrix<int, 2, 3, eMatrixOrder::FOLLOW_VECTOR, eMatrixLayout::COLUMN_MAJOR, false>(1, 2, 3, 4, 5, 6);
+		REQUIRE(Format(m) == expected);
+	}
+}
+
+
+TEST_CASE("CharConv: parse vector", "[CharConv]") {
+	SECTION("Integer") {
+		Vector<int, 3> v;
+		const std::string_view text = "[1, -2, +3]";
+		const auto [ptr, ec] = FromChars(text, v);
+		REQUIRE(ec == std::errc{});
+		REQUIRE(ptr == text.data() + text.size());
+		REQUIRE(v == Vector(1, -2, 3));
+	}
+	SECTION("Float with whitespace") {
+		Vector<float, 3> v;
+		const std::string_view text = " \n[ 1.5,2.5 ,\t3e2 ] tail";
+		const auto [ptr, ec] = FromChars(text, v);
+		REQUIRE(ec == std::errc{});
+		REQUIRE(std::string_view(ptr) == " tail");
+		REQUIRE(v == Vector(1.5f, 2.5f, 300.0f));
+	}
+	SECTION("Complex") {
+		using namespace std::complex_literals;
+		Vector<std::complex<double>, 2> v;
+		REQUIRE(FromChars("[1 + 2j, 3.5]", v).ec == std::errc{});
+		REQUIRE(v == Vector(1.0 + 2.0i, std::complex<double>(3.5)));
+	}
+	SECTION("Round trip") {
+		const auto v = Vector(0.1f, 1.0f / 3.0f, -1e-20f, 12345.678f);
+		Vector<float, 4> parsed;
+		REQUIRE(FromChars(Format(v), parsed).ec == std::errc{});
+		REQUIRE(parsed == v);
+	}
+	SECTION("Consecutive") {
+		const std::string_view text = "[1, 2] [3, 4]";
+		Vector<int, 2> first;
+		Vector<int, 2> second;
+		const auto result = FromChars(text, first);
+		REQUIRE(FromChars(result.ptr, text.data() + text.size(), second).ec == std::errc{});
+		REQUIRE(first == Vector(1, 2));
+		REQUIRE(second == Vector(3, 4));
+	}
+}
+
+
+TEST_CASE("CharConv: parse matrix", "[CharConv]") {
+	const std::string_view text = "[[1, 2, 3], [4, 5, 6]]";
+
+	SECTION("Row major") {
+		using Mat = Matrix<int, 2, 3, eMatrixOrder::FOLLOW_VECTOR, eMatrixLayout::ROW_MAJOR, false>;
+		Mat m;
+		REQUIRE(FromChars(text, m).ec == std::errc{});
+		REQUIRE(m == Mat(1, 2, 3, 4, 5, 6));
+	}
+	SECTION("Column major") {
+		using Mat = Matrix<int, 2, 3, eMatrixOrder::FOLLOW_VECTOR, eMatrixLayout::COLUMN_MAJOR, false>;
+		Mat m;
+		REQUIRE(FromChars(text, m).ec == std::errc{});
+		REQUIRE(m == Mat(1, 2, 3, 4, 5, 6));
+	}
+}
+
+
+TEST_CASE("CharConv: parse errors", "[CharConv]") {
+	const auto original = Vector(7, 8, 9);
+	auto v = original;
+
+	SECTION("Missing bracket") {
+		const std::string_view text = "1, 2, 3]";
+		const auto [ptr, ec] = FromChars(text, v);
+		REQUIRE(ec == std::errc::invalid_argument);
+		REQUIRE(ptr == text.data());
+	}
+	SECTION("Too few elements") {
+		const std::string_view text = "[1, 2]";
+		const auto [ptr, ec] = FromChars(text, v);
+		REQUIRE(ec == std::errc::invalid_argument);
+		REQUIRE(ptr == text.data() + 5);
+	}
+	SECTION("Too many elements") {
+		REQUIRE(FromChars("[1, 2, 3, 4]", v).ec == std::errc::invalid_argument);
+	}
+	SECTION("Not a number") {
+		REQUIRE(FromChars("[1, x, 3]", v).ec == std::errc::invalid_argument);
+	}
+	SECTION("Out of range") {
+		REQUIRE(FromChars("[1, 99999999999, 3]", v).ec == std::errc::result_out_of_range);
+	}
+	SECTION("Truncated") {
+		REQUIRE(FromChars("[1, 2, 3", v).ec == std::errc::invalid_argument);
+		REQUIRE(FromChars("", v).ec == std::errc::invalid_argument);
+	}
+	REQUIRE(v == original);
+}
@@ -1,7 +1,9 @@
+#include <Mathter/CharConv.hpp>
 #include <Mathter/Geometry.hpp>
 #include <Mathter/IoStream.hpp>
 #include <Mathter/Matrix.hpp>
 #include <Mathter/Quaternion.hpp>
+#include <Mathter/Serialization.hpp>
 #include <Mathter/Transforms.hpp>
 #include <Mathter/Utility.hpp>
 #include <Mathter/Vector.hpp>
\ No newline at end of file
@@ -0,0 +1,187 @@
+#include "Approx.hpp"
+
+#include <Mathter/Matrix/Comparison.hpp>
+#include <Mathter/Serialization.hpp>
+#include <Mathter/Vector/Comparison.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <complex>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+using namespace mathter;
+
+
+namespace {
+
+template <class Element>
+std::string Serialize(const std::vector<Element>& elements) {
+	std::stringstream ss;
+	WriteBinary(ss, elements);
+	return ss.str();
+}
+
+
+// Copies the file into memory that is aligned the same way a memory-mapped file would be.
+struct MappedFile {
+	explicit MappedFile(const std::string& content) : storage((content.size() + 63) / 64) {
+		std::memcpy(storage.data(), content.data(), content.size());
+		size = content.size();
+	}
+	const void* data() const { return storage.data(); }
+
+	struct alignas(64) Line {
+		std::byte bytes[64];
+	};
+	std::vector<Line> storage;
+	size_t size;
+};
+
+} // namespace
+
+
+TEST_CASE("Serialization: header", "[Serialization]") {
+	using Mat = Matrix<float, 3, 4, eMatrixOrder::FOLLOW_VECTOR, eMatrixLayout::COLUMN_MAJOR, false>;
+	const auto header = MakeBinaryHeader<Mat>(7);
+	REQUIRE(header.scalarType == eScalarType::FLOAT32);
+	REQUIRE(header.scalarSize == 4);
+	REQUIRE(header.kind == eElementKind::MATRIX);
+	REQUIRE(header.order == 1);
+	REQUIRE(header.layout == 1);
+	REQUIRE(header.rows == 3);
+	REQUIRE(header.columns == 4);
+	REQUIRE(header.stripeCount == 4);
+	REQUIRE(header.stripeStride == sizeof(Mat::Stripe));
+	REQUIRE(header.elementStride == sizeof(Mat));
+	REQUIRE(header.count == 7);
+	REQUIRE(header.dataOffset == sizeof(BinaryHeader));
+
+	REQUIRE(MakeBinaryHeader<Vector<int16_t, 2>>(0).scalarType == eScalarType::INT16);
+	REQUIRE(MakeBinaryHeader<Vector<uint64_t, 2>>(0).scalarType == eScalarType::UINT64);
+	REQUIRE(MakeBinaryHeader<Vector<std::complex<double>, 2>>(0).scalarType == eScalarType::COMPLEX128);
+}
+
+
+TEST_CASE("Serialization: view vectors", "[Serialization]") {
+	const std::vector<Vector<float, 3>> vectors = { { 1, 2, 3 }, { 4, 5, 6 }, { 7, 8, 9 } };
+	const MappedFile file(Serialize(vectors));
+
+	REQUIRE(CanViewBinary<Vector<float, 3>>(file.data(), file.size));
+	const auto view = ViewBinary<Vector<float, 3>>(file.data(), file.size);
+	REQUIRE(view.size() == vectors.size());
+	REQUIRE(static_cast<const void*>(view.data()) == static_cast<const std::byte*>(file.data()) + sizeof(BinaryHeader));
+	REQUIRE(std::vector(view.begin(), view.end()) == vectors);
+
+	REQUIRE(!CanViewBinary<Vector<double, 3>>(file.data(), file.size));
+	REQUIRE_THROWS_AS((ViewBinary<Vector<double, 3>>(file.data(), file.size)), std::invalid_argument);
+}
+
+
+TEST_CASE("Serialization: view matrices", "[Serialization]") {
+	using Mat = Matrix<double, 2, 3, eMatrixOrder::PRECEDE_VECTOR, eMatrixLayout::ROW_MAJOR, false>;
+	using MatColumn = Matrix<double, 2, 3, eMatrixOrder::PRECEDE_VECTOR, eMatrixLayout::COLUMN_MAJOR, false>;
+	const std::vector<Mat> matrices = { Mat(1, 2, 3, 4, 5, 6), Mat(7, 8, 9, 10, 11, 12) };
+	const MappedFile file(Serialize(matrices));
+
+	const auto view = ViewBinary<Mat>(file.data(), file.size);
+	REQUIRE(view.size() == 2);
+	REQUIRE(view[0] == matrices[0]);
+	REQUIRE(view[1] == matrices[1]);
+	REQUIRE(!CanViewBinary<MatColumn>(file.data(), file.size));
+}
+
+
+TEST_CASE("Serialization: read with conversion", "[Serialization]") {
+	SECTION("Same type") {
+		const std::vector<Vector<float, 4>> vectors = { { 1, 2, 3, 4 }, { 5, 6, 7, 8 } };
+		const auto file = Serialize(vectors);
+		REQUIRE(ReadBinary<Vector<float, 4>>(file.data(), file.size()) == vectors);
+	}
+	SECTION("Padding") {
+		const std::vector<Vector<float, 3, false>> vectors = { { 1, 2, 3 }, { 4, 5, 6 } };
+		const auto file = Serialize(vectors);
+		const auto packed = ReadBinary<Vector<float, 3, true>>(file.data(), file.size());
+		REQUIRE(packed.size() == 2);
+		REQUIRE(packed[0] == Vector<float, 3, true>(1, 2, 3));
+		REQUIRE(packed[1] == Vector<float, 3, true>(4, 5, 6));
+	}
+	SECTION("Scalar type") {
+		const std::vector<Vector<int32_t, 2>> vectors = { { 1, -2 }, { 3, -4 } };
+		const auto file = Serialize(vectors);
+		const auto doubles = ReadBinary<Vector<double, 2>>(file.data(), file.size());
+		REQUIRE(doubles[0] == Vector<double, 2>(1, -2));
+		REQUIRE(doubles[1] == Vector<double, 2>(3, -4));
+		const auto complex = ReadBinary<Vector<std::complex<float>, 2>>(file.data(), file.size());
+		REQUIRE(complex[1] == Vector<std::complex<float>, 2>(3, -4));
+	}
+	SECTION("Layout") {
+		using Mat = Matrix<float, 2, 3, eMatrixOrder::FOLLOW_VECTOR, eMatrixLayout::ROW_MAJOR, false>;
+		using MatColumn = Matrix<double, 2, 3, eMatrixOrder::FOLLOW_VECTOR, eMatrixLayout::COLUMN_MAJOR, true>;
+		const std::vector<Mat> matrices = { Mat(1, 2, 3, 4, 5, 6) };
+		const auto file = Serialize(matrices);
+		const auto converted = ReadBinary<MatColumn>(file.data(), file.size());
+		REQUIRE(converted.size() == 1);
+		REQUIRE(converted[0] == MatColumn(1, 2, 3, 4, 5, 6));
+	}
+	SECTION("Stream") {
+		using Mat = Matrix<float, 3, 3, eMatrixOrder::FOLLOW_VECTOR, eMatrixLayout::ROW_MAJOR, false>;
+		using MatColumn = Matrix<float, 3, 3, eMatrixOrder::FOLLOW_VECTOR, eMatrixLayout::COLUMN_MAJOR, false>;
+		const std::vector<Mat> matrices = { Mat(1, 2, 3, 4, 5, 6, 7, 8, 9), Mat(9, 8, 7, 6, 5, 4, 3, 2, 1) };
+		std::stringstream ss;
+		WriteBinary(ss, matrices);
+		REQUIRE(ReadBinary<Mat>(ss) == matrices);
+		ss.seekg(0);
+		const auto converted = ReadBinary<MatColumn>(ss);
+		REQUIRE(converted[0] == MatColumn(matrices[0]));
+		REQUIRE(converted[1] == MatColumn(matrices[1]));
+	}
+}
+
+
+TEST_CASE("Serialization: invalid files", "[Serialization]") {
+	const std::vector<Vector<float, 3>> vectors = { { 1, 2, 3 }, { 4, 5, 6 } };
+	auto file = Serialize(vectors);
+
+	SECTION("Shape mismatch") {
+		REQUIRE_THROWS_AS((ReadBinary<Vector<float, 2>>(file.data(), file.size())), std::invalid_argument);
+		REQUIRE_THROWS_AS((ReadBinary<Matrix<float, 3, 1>>(file.data(), file.size())), std::invalid_argument);
+	}
+	SECTION("Truncated") {
+		REQUIRE_THROWS_AS((ReadBinary<Vector<float, 3>>(file.data(), file.size() - 1)), std::invalid_argument);
+		REQUIRE_THROWS_AS((ReadBinaryHeader(file.data(), sizeof(BinaryHeader) - 1)), std::invalid_argument);
+		std::stringstream ss(file.substr(0, file.size() - 1));
+		REQUIRE_THROWS_AS((ReadBinary<Vector<float, 3>>(ss)), std::invalid_argument);
+	}
+	SECTION("Corrupted") {
+		file[0] = 'X';
+		REQUIRE_THROWS_AS((ReadBinaryHeader(file.data(), file.size())), std::invalid_argument);
+	}
+	SECTION("Malformed sizes") {
+		const auto modify = [](std::string content, auto&& change) {
+			BinaryHeader header;
+			std::memcpy(&header, content.data(), sizeof(header));
+			change(header);
+			std::memcpy(content.data(), &header, sizeof(header));
+			return content;
+		};
+		const auto packedFile = Serialize(std::vector<Vector<float, 3, true>>{ { 1, 2, 3 }, { 4, 5, 6 } });
+		const auto hugeStride = modify(packedFile, [](BinaryHeader& header) { header.elementStride = uint64_t(1) << 62; header.count = 4; });
+		const auto hugeCount = modify(packedFile, [](BinaryHeader& header) { header.count = uint64_t(1) << 60; });
+		const auto hugeOffset = modify(packedFile, [](BinaryHeader& header) { header.dataOffset = ~uint64_t(0); });
+		for (const auto& malformed : { hugeStride, hugeCount, hugeOffset }) {
+			REQUIRE_THROWS_AS((ReadBinaryHeader(malformed.data(), malformed.size())), std::invalid_argument);
+			std::stringstream converted(malformed);
+			REQUIRE_THROWS_AS((ReadBinary<Vector<double, 3, true>>(converted)), std::invalid_argument);
+			std::stringstream copied(malformed);
+			REQUIRE_THROWS_AS((ReadBinary<Vector<float, 3, true>>(copied)), std::invalid_argument);
+		}
+	}
+	SECTION("Complex to real") {
+		const auto complexFile = Serialize(std::vector<Vector<std::complex<float>, 2>>{ { 1, 2 } });
+		REQUIRE_THROWS_AS((ReadBinary<Vector<float, 2>>(complexFile.data(), complexFile.size())), std::invalid_argument);
+	}
+}
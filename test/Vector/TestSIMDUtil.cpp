@@ -9,6 +9,8 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <cstdint>
+
 
 using namespace mathter;
 
@@ -83,4 +85,17 @@ TEST_CASE("SIMDUtil - Alignment", "[SIMDUtil]") {
 		REQUIRE(GetStorageAlignment<float, 4, true>() == 4);
 		REQUIRE(GetStorageAlignment<float, 17, true>() == 4);
 	}
-}
\ No newline at end of file
+}
+
+TEST_CASE("SIMDUtil - LanePadding", "[SIMDUtil]") {
+	REQUIRE(impl::LanePadding<float>() % impl::LaneBlock<float>::size == 0);
+	REQUIRE(impl::LanePadding<double>() % impl::LaneBlock<double>::size == 0);
+	REQUIRE(impl::LanePadding<int32_t>() % impl::LaneBlock<int32_t>::size == 0);
+#if MATHTER_ENABLE_DISPATCH
+	SECTION("Dispatch") {
+		// Wide enough for the 512-bit registers of any architecture the kernels may be dispatched to.
+		REQUIRE(impl::LanePadding<float>() * sizeof(float) % 64 == 0);
+		REQUIRE(impl::LanePadding<double>() * sizeof(double) % 64 == 0);
+	}
+#endif
+}
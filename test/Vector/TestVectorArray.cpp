@@ -0,0 +1,218 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#pragma warning(disable : 4244)
+
+#include "../Approx.hpp"
+#include "../Cases.hpp"
+
+#include <Mathter/Vector/Arithmetic.hpp>
+#include <Mathter/Vector/Comparison.hpp>
+#include <Mathter/Vector/Math.hpp>
+#include <Mathter/Vector/VectorArray.hpp>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+
+#include <vector>
+
+
+using namespace mathter;
+using namespace test_util;
+
+
+namespace {
+
+// Not a multiple of any SIMD width to exercise the padding.
+constexpr size_t arraySize = 37;
+
+
+template <class Vec>
+std::vector<Vec> MakeVectors(size_t count, int seed) {
+	std::vector<Vec> vectors;
+	for (size_t i = 0; i < count; ++i) {
+		Vec v;
+		for (int c = 0; c < dimension_v<Vec>; ++c) {
+			v[c] = static_cast<scalar_type_t<Vec>>(1 + (int(i) * 7 + c * 3 + seed) % 11);
+		}
+		vectors.push_back(v);
+	}
+	return vectors;
+}
+
+} // namespace
+
+
+TEMPLATE_LIST_TEST_CASE("VectorArray - Gather & scatter", "[VectorArray]",
+						decltype(VectorCaseList<ScalarsFloatAndInt32, PackingsAll>{})) {
+	using Vec = typename TestType::template Vector<3>;
+	using Arr = VectorArray<scalar_type_t<Vec>, 3>;
+
+	const auto vectors = MakeVectors<Vec>(arraySize, 0);
+
+	SECTION("Construct from range") {
+		const VectorArray array(vectors.begin(), vectors.end());
+		static_assert(std::is_same_v<std::decay_t<decltype(array)>, Arr>);
+		REQUIRE(array.Size() == arraySize);
+		REQUIRE(array.PaddedSize() % Arr::Block::size == 0);
+		for (size_t i = 0; i < arraySize; ++i) {
+			REQUIRE(array.Gather(i) == vectors[i]);
+			REQUIRE(array.Lane(1)[i] == vectors[i][1]);
+		}
+	}
+	SECTION("Construct with value") {
+		const Arr array(arraySize, vectors[3]);
+		REQUIRE(array.Size() == arraySize);
+		for (size_t i = 0; i < arraySize; ++i) {
+			REQUIRE(array.Gather(i) == vectors[3]);
+		}
+	}
+	SECTION("Scatter single") {
+		Arr array(arraySize);
+		array.Scatter(5, vectors[5]);
+		REQUIRE(array.Gather(5) == vectors[5]);
+		REQUIRE(array.Gather(4) == Vec(scalar_type_t<Vec>(0)));
+	}
+	SECTION("Gather range") {
+		const Arr array(vectors.begin(), vectors.end());
+		std::vector<Vec> gathered(4);
+		const auto last = array.Gather(10, 4, gathered.begin());
+		REQUIRE(last == gathered.end());
+		for (size_t i = 0; i < 4; ++i) {
+			REQUIRE(gathered[i] == vectors[10 + i]);
+		}
+	}
+	SECTION("Resize") {
+		Arr array(vectors.begin(), vectors.end());
+		array *= Vec(scalar_type_t<Vec>(0));
+		array.Resize(3);
+		array.Resize(arraySize + 5);
+		REQUIRE(array.Size() == arraySize + 5);
+		for (size_t i = 0; i < array.Size(); ++i) {
+			REQUIRE(array.Gather(i) == Vec(scalar_type_t<Vec>(0)));
+		}
+	}
+}
+
+
+TEMPLATE_LIST_TEST_CASE("VectorArray - Arithmetic", "[VectorArray]",
+						decltype(VectorCaseList<ScalarsFloatAndInt32, PackingsAll>{})) {
+	using Vec = typename TestType::template Vector<3>;
+	using Scalar = scalar_type_t<Vec>;
+	using Arr = VectorArray<Scalar, 3>;
+
+	const auto lhsVectors = MakeVectors<Vec>(arraySize, 0);
+	const auto rhsVectors = MakeVectors<Vec>(arraySize, 5);
+	const Arr lhs(lhsVectors.begin(), lhsVectors.end());
+	const Arr rhs(rhsVectors.begin(), rhsVectors.end());
+	const Vec vec = { 2, 3, 4 };
+	const Scalar scalar = 3;
+
+	SECTION("Array x array") {
+		const auto sum = lhs + rhs;
+		const auto diff = lhs - rhs;
+		const auto prod = lhs * rhs;
+		const auto quot = lhs / rhs;
+		for (size_t i = 0; i < arraySize; ++i) {
+			REQUIRE(sum.Gather(i) == lhsVectors[i] + rhsVectors[i]);
+			REQUIRE(diff.Gather(i) == lhsVectors[i] - rhsVectors[i]);
+			REQUIRE(prod.Gather(i) == lhsVectors[i] * rhsVectors[i]);
+			REQUIRE(quot.Gather(i) == lhsVectors[i] / rhsVectors[i]);
+		}
+	}
+	SECTION("Array x vector") {
+		const auto prod = lhs * vec;
+		const auto diff = vec - lhs;
+		for (size_t i = 0; i < arraySize; ++i) {
+			REQUIRE(prod.Gather(i) == lhsVectors[i] * vec);
+			REQUIRE(diff.Gather(i) == vec - lhsVectors[i]);
+		}
+	}
+	SECTION("Array x scalar") {
+		const auto prod = lhs * scalar;
+		const auto diff = scalar - lhs;
+		for (size_t i = 0; i < arraySize; ++i) {
+			REQUIRE(prod.Gather(i) == lhsVectors[i] * scalar);
+			REQUIRE(diff.Gather(i) == scalar - lhsVectors[i]);
+		}
+	}
+	SECTION("Array x scalar array") {
+		VectorArray<Scalar, 1> scalars(arraySize);
+		for (size_t i = 0; i < arraySize; ++i) {
+			scalars.Lane(0)[i] = Scalar(i);
+		}
+		const auto prod = lhs * scalars;
+		for (size_t i = 0; i < arraySize; ++i) {
+			REQUIRE(prod.Gather(i) == lhsVectors[i] * Scalar(i));
+		}
+	}
+	SECTION("Compound assignment") {
+		Arr result = lhs;
+		result += rhs;
+		result *= vec;
+		result -= scalar;
+		for (size_t i = 0; i < arraySize; ++i) {
+			REQUIRE(result.Gather(i) == (lhsVectors[i] + rhsVectors[i]) * vec - scalar);
+		}
+	}
+	SECTION("Negation") {
+		const auto result = -lhs;
+		for (size_t i = 0; i < arraySize; ++i) {
+			REQUIRE(result.Gather(i) == -lhsVectors[i]);
+		}
+	}
+}
+
+
+TEMPLATE_LIST_TEST_CASE("VectorArray - Math", "[VectorArray]",
+						decltype(VectorCaseList<ScalarsFloating, PackingsAll>{})) {
+	using Vec = typename TestType::template Vector<3>;
+	using Scalar = scalar_type_t<Vec>;
+	using Arr = VectorArray<Scalar, 3>;
+
+	const auto lhsVectors = MakeVectors<Vec>(arraySize, 0);
+	const auto rhsVectors = MakeVectors<Vec>(arraySize, 5);
+	const Arr lhs(lhsVectors.begin(), lhsVectors.end());
+	const Arr rhs(rhsVectors.begin(), rhsVectors.end());
+
+	SECTION("Dot") {
+		const auto result = Dot(lhs, rhs);
+		for (size_t i = 0; i < arraySize; ++i) {
+			REQUIRE(result.Lane(0)[i] == Catch::Approx(Dot(lhsVectors[i], rhsVectors[i])));
+		}
+	}
+	SECTION("Length") {
+		const auto result = Length(lhs);
+		for (size_t i = 0; i < arraySize; ++i) {
+			REQUIRE(result.Lane(0)[i] == Catch::Approx(Length(lhsVectors[i])));
+		}
+	}
+	SECTION("Normalize") {
+		const auto result = Normalize(lhs);
+		for (size_t i = 0; i < arraySize; ++i) {
+			REQUIRE(result.Gather(i) == test_util::Approx(Normalize(lhsVectors[i])));
+		}
+	}
+	SECTION("Cross") {
+		const auto result = Cross(lhs, rhs);
+		for (size_t i = 0; i < arraySize; ++i) {
+			REQUIRE(result.Gather(i) == test_util::Approx(Cross(lhsVectors[i], rhsVectors[i])));
+		}
+	}
+	SECTION("Multiply-add") {
+		const auto result = MultiplyAdd(lhs, rhs, lhs);
+		for (size_t i = 0; i < arraySize; ++i) {
+			REQUIRE(result.Gather(i) == test_util::Approx(lhsVectors[i] * rhsVectors[i] + lhsVectors[i]));
+		}
+	}
+	SECTION("Min / Max") {
+		const auto resultMin = Min(lhs, rhs);
+		const auto resultMax = Max(lhs, rhs);
+		for (size_t i = 0; i < arraySize; ++i) {
+			REQUIRE(resultMin.Gather(i) == Min(lhsVectors[i], rhsVectors[i]));
+			REQUIRE(resultMax.Gather(i) == Max(lhsVectors[i], rhsVectors[i]));
+		}
+	}
+}
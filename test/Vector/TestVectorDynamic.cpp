@@ -0,0 +1,188 @@
+// L=============================================================================
+// L This software is distributed under the MIT license.
+// L Copyright 2024 Péter Kardos
+// L=============================================================================
+
+#pragma warning(disable : 4244)
+
+#include "../Approx.hpp"
+#include "../Cases.hpp"
+
+#include <Mathter/Vector/Arithmetic.hpp>
+#include <Mathter/Vector/Comparison.hpp>
+#include <Mathter/Vector/Math.hpp>
+#include <Mathter/Vector/VectorDynamic.hpp>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+
+
+using namespace mathter;
+using namespace test_util;
+
+
+namespace {
+
+// Not a multiple of any SIMD width to exercise the remainder.
+constexpr size_t dynamicSize = 37;
+
+
+template <class Vec>
+Vec MakeVector(size_t dim, int seed) {
+	Vec v(dim);
+	for (size_t i = 0; i < dim; ++i) {
+		v[i] = static_cast<scalar_type_t<Vec>>(1 + (int(i) * 7 + seed) % 11);
+	}
+	return v;
+}
+
+} // namespace
+
+
+TEMPLATE_LIST_TEST_CASE("VectorDynamic - Construct", "[VectorDynamic]",
+						decltype(VectorCaseList<ScalarsFloatAndInt32, PackingsAll>{})) {
+	using Vec = typename TestType::template Vector<DYNAMIC>;
+	using Scalar = scalar_type_t<Vec>;
+
+	static_assert(is_dynamic_v<Vec>);
+	static_assert(!is_dynamic_v<typename TestType::template Vector<3>>);
+
+	SECTION("Dimension") {
+		const Vec v(dynamicSize);
+		REQUIRE(v.Dimension() == dynamicSize);
+		REQUIRE(reinterpret_cast<uintptr_t>(v.Data()) % impl::laneAlignment == 0);
+		for (size_t i = 0; i < dynamicSize; ++i) {
+			REQUIRE(v[i] == 0);
+		}
+	}
+	SECTION("All") {
+		const Vec v(dynamicSize, Scalar(3));
+		REQUIRE(v.Dimension() == dynamicSize);
+		for (size_t i = 0; i < dynamicSize; ++i) {
+			REQUIRE(v[i] == 3);
+		}
+	}
+	SECTION("Initializer list") {
+		const Vec v = { 1, 2, 3 };
+		REQUIRE(v.Dimension() == 3);
+		REQUIRE(v[0] == 1);
+		REQUIRE(v[1] == 2);
+		REQUIRE(v[2] == 3);
+	}
+	SECTION("From and to fixed size") {
+		const typename TestType::template Vector<3> fixed = { 1, 2, 3 };
+		const Vec v = fixed;
+		REQUIRE(v.Dimension() == 3);
+		REQUIRE(v[2] == 3);
+		REQUIRE(static_cast<typename TestType::template Vector<3>>(v) == fixed);
+	}
+	SECTION("Resize") {
+		Vec v = { 1, 2, 3 };
+		v.Resize(dynamicSize);
+		REQUIRE(v.Dimension() == dynamicSize);
+		REQUIRE(v[2] == 3);
+		REQUIRE(v[3] == 0);
+		v.Resize(2);
+		REQUIRE(v == Vec{ 1, 2 });
+	}
+}
+
+
+TEMPLATE_LIST_TEST_CASE("VectorDynamic - Arithmetic", "[VectorDynamic]",
+						decltype(VectorCaseList<ScalarsFloatAndInt32, PackingsAll>{})) {
+	using Vec = typename TestType::template Vector<DYNAMIC>;
+	using Scalar = scalar_type_t<Vec>;
+
+	const auto lhs = MakeVector<Vec>(dynamicSize, 0);
+	const auto rhs = MakeVector<Vec>(dynamicSize, 5);
+	const Scalar scalar = 3;
+
+	SECTION("Vector x vector") {
+		const auto sum = lhs + rhs;
+		const auto diff = lhs - rhs;
+		const auto prod = lhs * rhs;
+		const auto quot = lhs / rhs;
+		static_assert(std::is_same_v<std::decay_t<decltype(sum)>, Vec>);
+		for (size_t i = 0; i < dynamicSize; ++i) {
+			REQUIRE(sum[i] == lhs[i] + rhs[i]);
+			REQUIRE(diff[i] == lhs[i] - rhs[i]);
+			REQUIRE(prod[i] == lhs[i] * rhs[i]);
+			REQUIRE(quot[i] == lhs[i] / rhs[i]);
+		}
+	}
+	SECTION("Vector x scalar") {
+		const auto prod = lhs * scalar;
+		const auto diff = scalar - lhs;
+		const auto quot = lhs / scalar;
+		for (size_t i = 0; i < dynamicSize; ++i) {
+			REQUIRE(prod[i] == lhs[i] * scalar);
+			REQUIRE(diff[i] == scalar - lhs[i]);
+			REQUIRE(quot[i] == lhs[i] / scalar);
+		}
+	}
+	SECTION("Compound assignment") {
+		Vec result = lhs;
+		result += rhs;
+		result *= scalar;
+		for (size_t i = 0; i < dynamicSize; ++i) {
+			REQUIRE(result[i] == (lhs[i] + rhs[i]) * scalar);
+		}
+	}
+	SECTION("Negation") {
+		const auto result = -lhs;
+		for (size_t i = 0; i < dynamicSize; ++i) {
+			REQUIRE(result[i] == -lhs[i]);
+		}
+	}
+	SECTION("Comparison") {
+		REQUIRE(lhs == lhs);
+		REQUIRE(lhs != rhs);
+	}
+}
+
+
+TEMPLATE_LIST_TEST_CASE("VectorDynamic - Math", "[VectorDynamic]",
+						decltype(VectorCaseList<ScalarsFloating, PackingsAll>{})) {
+	using Vec = typename TestType::template Vector<DYNAMIC>;
+	using Scalar = scalar_type_t<Vec>;
+
+	const auto lhs = MakeVector<Vec>(dynamicSize, 0);
+	const auto rhs = MakeVector<Vec>(dynamicSize, 5);
+
+	Scalar dot = 0;
+	for (size_t i = 0; i < dynamicSize; ++i) {
+		dot += lhs[i] * rhs[i];
+	}
+
+	SECTION("Dot") {
+		REQUIRE(Dot(lhs, rhs) == Catch::Approx(dot));
+	}
+	SECTION("Length") {
+		REQUIRE(Length(lhs) == Catch::Approx(std::sqrt(Dot(lhs, lhs))));
+		REQUIRE(LengthPrecise(lhs) == Catch::Approx(std::sqrt(Dot(lhs, lhs))));
+	}
+	SECTION("Normalize") {
+		REQUIRE(Length(Normalize(lhs)) == Catch::Approx(1));
+		REQUIRE(Length(NormalizePrecise(lhs)) == Catch::Approx(1));
+	}
+	SECTION("Min / Max") {
+		REQUIRE(Min(lhs) == 1);
+		REQUIRE(Max(lhs) == 11);
+		const auto resultMin = Min(lhs, rhs);
+		for (size_t i = 0; i < dynamicSize; ++i) {
+			REQUIRE(resultMin[i] == std::min(lhs[i], rhs[i]));
+		}
+	}
+	SECTION("Clamp") {
+		const auto result = Clamp(lhs, Scalar(3), Scalar(5));
+		REQUIRE(Min(result) == 3);
+		REQUIRE(Max(result) == 5);
+	}
+	SECTION("Sum") {
+		Scalar sum = 0;
+		for (size_t i = 0; i < dynamicSize; ++i) {
+			sum += lhs[i];
+		}
+		REQUIRE(Sum(lhs) == Catch::Approx(sum));
+	}
+}